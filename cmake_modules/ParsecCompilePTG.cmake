@@ -10,7 +10,7 @@ function(target_ptg_source_ex)
   set(oneValueArgs TARGET MODE SOURCE DESTINATION DESTINATION_C DESTINATION_H FUNCTION_NAME DEP_MANAGEMENT)
   set(multipleValueArgs WARNINGS IGNORE_PROPERTIES PTGPP_FLAGS)
   cmake_parse_arguments(PARSEC_PTGPP "${options}" "${oneValueArgs}"
-          "${multiValueArgs}" ${ARGN} )
+          "${multipleValueArgs}" ${ARGN} )
 
   if(NOT DEFINED PARSEC_PTGPP_TARGET)
     message(FATAL_ERROR "TARGET not defined in call to target_ptg_sources_ex")
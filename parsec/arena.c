@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010-2023 The University of Tennessee and The University
+ * Copyright (c) 2010-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  */
@@ -11,7 +11,15 @@
 #include "parsec/data_internal.h"
 #include "parsec/utils/debug.h"
 #include "parsec/papi_sde.h"
+#include "parsec/execution_stream.h"
+#include "parsec/metrics.h"
+#include "parsec/parsec_hwloc.h"
 #include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(PARSEC_HAVE_SYS_MMAN_H)
+#include <sys/mman.h>
+#endif  /* defined(PARSEC_HAVE_SYS_MMAN_H) */
 
 #if defined(PARSEC_PROF_TRACE_ACTIVE_ARENA_SET)
 
@@ -54,6 +62,46 @@ extern int arena_memory_used_key, arena_memory_unused_key;
 
 size_t parsec_arena_max_allocated_memory = SIZE_MAX;  /* unlimited */
 size_t parsec_arena_max_cached_memory    = 256*1024*1024; /* limited to 256MB */
+int    parsec_arena_magazine_size        = 16;
+int    parsec_arena_hugepages            = 0;
+int    parsec_arena_nb_magazines         = 0;
+int    parsec_arena_numa                 = 0;
+int    parsec_arena_nb_numa_nodes        = 0;
+
+parsec_arena_numa_counters_t parsec_arena_numa_counters[PARSEC_ARENA_MAX_NUMA_NODES];
+
+volatile int64_t parsec_arena_magazine_hits   = 0;
+volatile int64_t parsec_arena_magazine_misses = 0;
+volatile int64_t parsec_arena_slab_memory     = 0;
+
+#define PARSEC_ARENA_HUGEPAGE_SIZE (2*1024*1024)
+
+/**
+ * A magazine is a small stack of single element chunks owned by a single
+ * execution stream. It is padded to a cache line to avoid false sharing
+ * between the streams. The hits and misses are accumulated locally, and
+ * folded into the global counters every time the magazine goes to the
+ * shared LIFO.
+ */
+struct parsec_arena_magazine_s {
+    parsec_list_item_t *items;     /**< cached chunks, chained by list_next */
+    int32_t             nb_items;
+    int32_t             hits;
+    int32_t             misses;
+    uint8_t             padding[PARSEC_ARENA_ALIGNMENT_CL1 - sizeof(parsec_list_item_t*) - 3*sizeof(int32_t)];
+};
+
+/**
+ * Slabs are never released before the destruction of the arena: the
+ * chunks carved out of them are always cached.
+ */
+struct parsec_arena_slab_s {
+    parsec_arena_slab_t *next;
+    void                *base;
+    size_t               length;
+    int                  mmapped;  /**< allocated by mmap(MAP_HUGETLB), or by posix_memalign */
+    int                  numa_node;  /**< NUMA node the slab is bound to, -1 if none */
+};
 
 
 int parsec_arena_construct_ex(parsec_arena_t* arena,
@@ -83,6 +131,25 @@ int parsec_arena_construct_ex(parsec_arena_t* arena,
     arena->max_released = (max_cached_memory / elem_size > (size_t)INT32_MAX)? INT32_MAX: max_cached_memory / elem_size;
     arena->data_malloc  = parsec_data_allocate;
     arena->data_free    = parsec_data_free;
+    /* An arena that does not cache (max_released == 0) behaves as a wrapper
+     * around malloc/free, keep it this way. */
+    arena->magazine_size = (0 == arena->max_released) ? 0 : parsec_arena_magazine_size;
+    arena->nb_magazines = 0;
+    arena->magazines    = NULL;
+    arena->slabs        = NULL;
+    arena->use_slabs    = parsec_arena_hugepages && (0 != arena->max_released);
+    arena->nb_numa_nodes = parsec_arena_nb_numa_nodes;
+    arena->numa_lifos   = NULL;
+    if( 0 != arena->nb_numa_nodes ) {
+        if( 0 != posix_memalign((void**)&arena->numa_lifos, PARSEC_ARENA_ALIGNMENT_CL1,
+                                arena->nb_numa_nodes * sizeof(parsec_lifo_t)) ) {
+            PARSEC_OBJ_DESTRUCT(&arena->area_lifo);
+            arena->elem_size = 0;
+            return PARSEC_ERR_OUT_OF_RESOURCE;
+        }
+        for( int i = 0; i < arena->nb_numa_nodes; i++ )
+            PARSEC_OBJ_CONSTRUCT(&arena->numa_lifos[i], parsec_lifo_t);
+    }
     return PARSEC_SUCCESS;
 }
 
@@ -96,9 +163,102 @@ int parsec_arena_construct(parsec_arena_t* arena,
                                     parsec_arena_max_cached_memory);
 }
 
+static void parsec_arena_magazine_flush_stats(parsec_arena_magazine_t *mag)
+{
+    if( 0 != mag->hits )
+        (void)parsec_atomic_fetch_add_int64(&parsec_arena_magazine_hits, mag->hits);
+    if( 0 != mag->misses )
+        (void)parsec_atomic_fetch_add_int64(&parsec_arena_magazine_misses, mag->misses);
+    mag->hits = mag->misses = 0;
+}
+
+static inline size_t parsec_arena_chunk_size(parsec_arena_t *arena, size_t count)
+{
+    return PARSEC_ALIGN(arena->elem_size * count + arena->alignment + sizeof(parsec_arena_chunk_t),
+                        arena->alignment, size_t);
+}
+
+/**
+ * Returns the NUMA node the chunks requested by the execution stream es
+ * should come from, or -1 to use the default freelist.
+ */
+static inline int
+parsec_arena_numa_node(parsec_arena_t *arena, parsec_execution_stream_t *es)
+{
+    if( (NULL == arena->numa_lifos) || (NULL == es) ||
+        (es->numa_id < 0) || (es->numa_id >= arena->nb_numa_nodes) )
+        return -1;
+    return es->numa_id;
+}
+
+static inline parsec_lifo_t *
+parsec_arena_lifo(parsec_arena_t *arena, int node)
+{
+    return (node < 0) ? &arena->area_lifo : &arena->numa_lifos[node];
+}
+
+/**
+ * Allocate the memory of a chunk, bound to the NUMA node *node if it is
+ * not negative. On return *node is the node the memory is bound to, or
+ * -1 if it has been allocated by the arena's data_malloc.
+ */
+static void *
+parsec_arena_chunk_alloc(parsec_arena_t *arena, size_t size, int *node)
+{
+    void *ptr;
+
+    if( *node >= 0 ) {
+        if( NULL != (ptr = parsec_hwloc_alloc_membind(size, *node)) ) {
+            (void)parsec_atomic_fetch_inc_int64(&parsec_arena_numa_counters[*node].nb_allocs);
+            (void)parsec_atomic_fetch_add_int64(&parsec_arena_numa_counters[*node].bytes, (int64_t)size);
+            return ptr;
+        }
+        *node = -1;
+    }
+    return arena->data_malloc(size);
+}
+
+static void
+parsec_arena_chunk_free(parsec_arena_t *arena, parsec_arena_chunk_t *chunk, size_t count)
+{
+    TRACE_FREE(arena_memory_free_key, -arena->elem_size*count, chunk);
+    if( chunk->numa_node >= 0 ) {
+        size_t size = parsec_arena_chunk_size(arena, count);
+        (void)parsec_atomic_fetch_sub_int64(&parsec_arena_numa_counters[chunk->numa_node].bytes, (int64_t)size);
+        parsec_hwloc_free_membind(chunk, size);
+        return;
+    }
+    arena->data_free(chunk);
+}
+
 static void parsec_arena_destructor(parsec_arena_t* arena)
 {
     parsec_list_item_t* item;
+    parsec_arena_slab_t* slab;
+    int i;
+
+    /* If elem_size == 0, the arena has not been initialized */
+    if ( 0 == arena->elem_size ) {
+        return;
+    }
+
+    /* Return the content of the magazines to the freelists, all execution
+     * streams are supposed to be done with this arena by now. */
+    if( NULL != arena->magazines ) {
+        for( i = 0; i < arena->nb_magazines; i++ ) {
+            parsec_arena_magazine_t *mag = &arena->magazines[i];
+            while( NULL != (item = mag->items) ) {
+                mag->items = (parsec_list_item_t*)item->list_next;
+                parsec_lifo_push(parsec_arena_lifo(arena, ((parsec_arena_chunk_t*)item)->numa_node), item);
+                if( arena->max_released != INT32_MAX )
+                    arena->released++;
+            }
+            mag->nb_items = 0;
+            parsec_arena_magazine_flush_stats(mag);
+        }
+        free(arena->magazines);
+        arena->magazines = NULL;
+    }
 
     assert( arena->used == arena->released
          || arena->max_released == 0
@@ -106,45 +266,322 @@ static void parsec_arena_destructor(parsec_arena_t* arena)
          || arena->max_used == 0
          || arena->max_used == INT32_MAX );
 
-    /* If elem_size == 0, the arena has not been initialized */
-    if ( 0 != arena->elem_size ) {
-        while(NULL != (item = parsec_lifo_pop(&arena->area_lifo))) {
+    for( i = -1; i < (NULL == arena->numa_lifos ? 0 : arena->nb_numa_nodes); i++ ) {
+        while(NULL != (item = parsec_lifo_pop(parsec_arena_lifo(arena, i)))) {
+            if( arena->use_slabs )  /* released with the slabs */
+                continue;
             PARSEC_DEBUG_VERBOSE(20, parsec_debug_output, "Arena:\tfree element base ptr %p, data ptr %p (from arena %p)",
                                 item, ((parsec_arena_chunk_t*)item)->data, arena);
-            TRACE_FREE(arena_memory_free_key, -arena->elem_size, item);
-            arena->data_free(item);
+            parsec_arena_chunk_free(arena, (parsec_arena_chunk_t*)item, 1);
         }
-        PARSEC_OBJ_DESTRUCT(&arena->area_lifo);
+        PARSEC_OBJ_DESTRUCT(parsec_arena_lifo(arena, i));
+    }
+    free(arena->numa_lifos);
+    arena->numa_lifos = NULL;
+
+    while( NULL != (slab = arena->slabs) ) {
+        arena->slabs = slab->next;
+        PARSEC_DEBUG_VERBOSE(20, parsec_debug_output, "Arena:\tfree slab %p of %zu bytes (from arena %p)",
+                             slab->base, slab->length, arena);
+        TRACE_FREE(arena_memory_free_key, -slab->length, slab->base);
+#if defined(PARSEC_HAVE_SYS_MMAN_H)
+        if( slab->mmapped )
+            munmap(slab->base, slab->length);
+        else
+#endif  /* defined(PARSEC_HAVE_SYS_MMAN_H) */
+            free(slab->base);
+        (void)parsec_atomic_fetch_add_int64(&parsec_arena_slab_memory, -(int64_t)slab->length);
+        if( slab->numa_node >= 0 )
+            (void)parsec_atomic_fetch_sub_int64(&parsec_arena_numa_counters[slab->numa_node].bytes, (int64_t)slab->length);
+        free(slab);
     }
 }
 
 PARSEC_OBJ_CLASS_INSTANCE(parsec_arena_t, parsec_object_t, NULL, parsec_arena_destructor);
 
+/**
+ * Returns the magazine of the execution stream es, or NULL if es is not
+ * a computation thread or if the magazines are disabled.
+ * The magazines are allocated when first needed, as the number of
+ * execution streams is not known when the arena is constructed.
+ */
+static inline parsec_arena_magazine_t *
+parsec_arena_my_magazine(parsec_arena_t *arena, parsec_execution_stream_t *es)
+{
+    parsec_arena_magazine_t *mags;
+    int nb;
+
+    if( 0 == arena->magazine_size )
+        return NULL;
+    if( (NULL == es) || (es->arena_magazine_id < 0) )
+        return NULL;
+    if( NULL == (mags = arena->magazines) ) {
+        nb = parsec_arena_nb_magazines;
+        if( 0 == nb )
+            return NULL;
+        if( 0 != posix_memalign((void**)&mags, PARSEC_ARENA_ALIGNMENT_CL1, nb * sizeof(parsec_arena_magazine_t)) )
+            return NULL;
+        memset(mags, 0, nb * sizeof(parsec_arena_magazine_t));
+        if( !parsec_atomic_cas_ptr(&arena->magazines, NULL, mags) ) {
+            free(mags);
+            mags = arena->magazines;
+        } else {
+            parsec_atomic_wmb();
+            arena->nb_magazines = nb;
+        }
+    }
+    if( es->arena_magazine_id >= arena->nb_magazines )
+        return NULL;
+    return &mags[es->arena_magazine_id];
+}
+
+/**
+ * Carve a new slab backed by huge pages into chunks of the given size.
+ * The slab is bound to the NUMA node node if it is not negative.
+ * The chunks are returned as a NULL terminated list chained by list_next,
+ * and are accounted as used. Returns the number of chunks.
+ */
+static int32_t
+parsec_arena_slab_grow(parsec_arena_t *arena, size_t size, int node, parsec_list_item_t **list)
+{
+    size_t stride = PARSEC_ALIGN(size, PARSEC_ARENA_ALIGNMENT_CL1, size_t);
+    size_t length = PARSEC_ALIGN(stride, PARSEC_ARENA_HUGEPAGE_SIZE, size_t);
+    int32_t nb = (int32_t)(length / stride), i;
+    parsec_arena_slab_t *slab;
+    parsec_list_item_t *item;
+    void *base = NULL;
+
+    *list = NULL;
+    if(arena->max_used != INT32_MAX) {
+        int32_t current = parsec_atomic_fetch_add_int32(&arena->used, nb) + nb;
+        if(current > arena->max_used) {
+            int32_t over = (current - arena->max_used) < nb ? (current - arena->max_used) : nb;
+            (void)parsec_atomic_fetch_sub_int32(&arena->used, over);
+            nb -= over;
+            if( 0 == nb ) return 0;
+        }
+    }
+    slab = (parsec_arena_slab_t*)malloc(sizeof(parsec_arena_slab_t));
+    slab->length  = length;
+    slab->mmapped = 0;
+#if defined(PARSEC_HAVE_SYS_MMAN_H) && defined(MAP_HUGETLB)
+    base = mmap(NULL, length, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if( MAP_FAILED == base )
+        base = NULL;
+    else
+        slab->mmapped = 1;
+#endif  /* defined(PARSEC_HAVE_SYS_MMAN_H) && defined(MAP_HUGETLB) */
+    if( NULL == base ) {
+        /* No reserved huge pages, fall back on transparent huge pages */
+        if( 0 != posix_memalign(&base, PARSEC_ARENA_HUGEPAGE_SIZE, length) ) {
+            free(slab);
+            if(arena->max_used != INT32_MAX)
+                (void)parsec_atomic_fetch_sub_int32(&arena->used, nb);
+            return 0;
+        }
+#if defined(PARSEC_HAVE_SYS_MMAN_H) && defined(MADV_HUGEPAGE)
+        (void)madvise(base, length, MADV_HUGEPAGE);
+#endif  /* defined(PARSEC_HAVE_SYS_MMAN_H) && defined(MADV_HUGEPAGE) */
+    }
+    /* The pages have not been touched yet, binding them is enough */
+    if( (node >= 0) && (PARSEC_SUCCESS != parsec_hwloc_bind_memory(base, length, node)) )
+        node = -1;
+    if( node >= 0 ) {
+        (void)parsec_atomic_fetch_add_int64(&parsec_arena_numa_counters[node].nb_allocs, nb);
+        (void)parsec_atomic_fetch_add_int64(&parsec_arena_numa_counters[node].bytes, (int64_t)length);
+    }
+    slab->base = base;
+    slab->numa_node = node;
+    TRACE_MALLOC(arena_memory_alloc_key, length, base);
+    (void)parsec_atomic_fetch_add_int64(&parsec_arena_slab_memory, (int64_t)length);
+    PARSEC_DEBUG_VERBOSE(20, parsec_debug_output, "Arena:\tallocate slab %p of %zu bytes (%d chunks of %zu bytes, %s, NUMA node %d) for arena %p",
+                         base, length, nb, stride, slab->mmapped ? "hugetlb" : "thp", node, arena);
+    do {
+        slab->next = arena->slabs;
+    } while( !parsec_atomic_cas_ptr(&arena->slabs, slab->next, slab) );
+
+    for( i = nb - 1; i >= 0; i-- ) {
+        item = (parsec_list_item_t*)((char*)base + i * stride);
+        PARSEC_OBJ_CONSTRUCT(item, parsec_list_item_t);
+        ((parsec_arena_chunk_t*)item)->numa_node = node;
+        item->list_next = *list;
+        *list = item;
+    }
+    return nb;
+}
+
+/**
+ * Push a NULL terminated list of nb chunks, chained by list_next, into the
+ * freelist lifo, using a single atomic operation.
+ */
+static void
+parsec_arena_chain_chunks(parsec_arena_t *arena, parsec_lifo_t *lifo,
+                          parsec_list_item_t *first, int32_t nb)
+{
+    parsec_list_item_t *last = first;
+    int32_t i;
+
+    if( 0 == nb ) return;
+    for( i = 1; i < nb; i++ )
+        last = (parsec_list_item_t*)last->list_next;
+    if( arena->max_released != INT32_MAX )
+        (void)parsec_atomic_fetch_add_int32(&arena->released, nb);
+    parsec_lifo_chain(lifo, parsec_list_item_ring(first, last));
+}
+
+/**
+ * Pop a chunk from the freelist of the NUMA node node, or from the
+ * default freelist if the former is empty.
+ */
+static inline parsec_list_item_t *
+parsec_arena_pop_chunk(parsec_arena_t *arena, int node)
+{
+    parsec_list_item_t *item;
+
+    if( node >= 0 ) {
+        if( NULL != (item = parsec_lifo_pop(&arena->numa_lifos[node])) ) {
+            (void)parsec_atomic_fetch_inc_int64(&parsec_arena_numa_counters[node].nb_reuses);
+            return item;
+        }
+    }
+    return parsec_lifo_pop(&arena->area_lifo);
+}
+
+/**
+ * Move half a magazine worth of chunks from the shared freelists into an
+ * empty magazine.
+ */
+static void
+parsec_arena_magazine_refill(parsec_arena_t *arena, parsec_arena_magazine_t *mag, int node)
+{
+    int32_t nb = 0, batch = (arena->magazine_size + 1) / 2;
+    parsec_list_item_t *item;
+
+    while( (nb < batch) && (NULL != (item = parsec_arena_pop_chunk(arena, node))) ) {
+        item->list_next = mag->items;
+        mag->items = item;
+        nb++;
+    }
+    if( (0 != nb) && (arena->max_released != INT32_MAX) )
+        (void)parsec_atomic_fetch_sub_int32(&arena->released, nb);
+    mag->nb_items += nb;
+    parsec_arena_magazine_flush_stats(mag);
+}
+
+/**
+ * Move half of a full magazine into the shared freelists, or release it
+ * if the freelists already cache more than max_released elements. The
+ * magazine of a stream bound to the NUMA node node only holds chunks
+ * of that node or of the default freelist.
+ */
+static void
+parsec_arena_magazine_drain(parsec_arena_t *arena, parsec_arena_magazine_t *mag, int node)
+{
+    int32_t nb = mag->nb_items / 2, room, nb_local = 0, nb_other = 0;
+    parsec_list_item_t *local = NULL, *other = NULL, *item;
+
+    mag->nb_items -= nb;
+    parsec_arena_magazine_flush_stats(mag);
+
+    room = INT32_MAX;
+    if( !arena->use_slabs && (arena->max_released != INT32_MAX) )
+        room = arena->max_released - arena->released;
+    for( ; nb > 0; nb-- ) {
+        item = mag->items;
+        mag->items = (parsec_list_item_t*)item->list_next;
+        if( room <= 0 ) {
+            if(arena->max_used != 0 && arena->max_used != INT32_MAX)
+                (void)parsec_atomic_fetch_dec_int32(&arena->used);
+            parsec_arena_chunk_free(arena, (parsec_arena_chunk_t*)item, 1);
+            continue;
+        }
+        room--;
+        if( (node >= 0) && (((parsec_arena_chunk_t*)item)->numa_node == node) ) {
+            item->list_next = local; local = item; nb_local++;
+        } else {
+            item->list_next = other; other = item; nb_other++;
+        }
+    }
+    if( 0 != nb_local )
+        parsec_arena_chain_chunks(arena, &arena->numa_lifos[node], local, nb_local);
+    parsec_arena_chain_chunks(arena, &arena->area_lifo, other, nb_other);
+}
+
 static inline parsec_list_item_t*
 parsec_arena_get_chunk( parsec_arena_t *arena, size_t size, parsec_data_allocate_t alloc )
 {
-    parsec_lifo_t *list = &arena->area_lifo;
+    parsec_execution_stream_t *es = parsec_my_execution_stream();
+    parsec_arena_magazine_t *mag = parsec_arena_my_magazine(arena, es);
+    int node = parsec_arena_numa_node(arena, es);
     parsec_list_item_t *item;
-    item = parsec_lifo_pop(list);
-    if( NULL != item ) {
-        if( arena->max_released != INT32_MAX )
-            (void)parsec_atomic_fetch_dec_int32(&arena->released);
+
+    if( NULL != mag ) {
+        if( NULL != mag->items ) {
+            mag->hits++;
+        } else {
+            mag->misses++;
+            parsec_arena_magazine_refill(arena, mag, node);
+        }
+        if( NULL != (item = mag->items) ) {
+            mag->items = (parsec_list_item_t*)item->list_next;
+            mag->nb_items--;
+            PARSEC_METRICS_INC(es, PARSEC_METRICS_ARENA_HITS);
+            goto done;
+        }
+    } else {
+        item = parsec_arena_pop_chunk(arena, node);
+        if( NULL != item ) {
+            if( arena->max_released != INT32_MAX )
+                (void)parsec_atomic_fetch_dec_int32(&arena->released);
+            /* es may be the communication stream, shared by several threads */
+            if( NULL != es ) PARSEC_METRICS_ATOMIC_ADD(es, PARSEC_METRICS_ARENA_HITS, 1);
+            goto done;
+        }
     }
-    else {
-        if(arena->max_used != INT32_MAX) {
-            int32_t current = parsec_atomic_fetch_inc_int32(&arena->used) + 1;
-            if(current > arena->max_used) {
-                (void)parsec_atomic_fetch_dec_int32(&arena->used);
-                return NULL;
+    if( NULL != es ) PARSEC_METRICS_ATOMIC_ADD(es, PARSEC_METRICS_ARENA_MISSES, 1);
+
+    if( size < sizeof( parsec_list_item_t ) )
+        size = sizeof( parsec_list_item_t );
+    if( arena->use_slabs ) {
+        parsec_list_item_t *others;
+        int32_t nb = parsec_arena_slab_grow(arena, size, node, &item);
+        if( 0 == nb )
+            return NULL;
+        /* keep the first for the caller, fill the magazine and give the rest to the freelist */
+        others = (parsec_list_item_t*)item->list_next;
+        nb--;
+        if( NULL != mag ) {
+            while( (NULL != others) && (mag->nb_items < arena->magazine_size) ) {
+                parsec_list_item_t *next = (parsec_list_item_t*)others->list_next;
+                others->list_next = mag->items;
+                mag->items = others;
+                mag->nb_items++;
+                others = next;
+                nb--;
             }
         }
-        if( size < sizeof( parsec_list_item_t ) )
-            size = sizeof( parsec_list_item_t );
+        parsec_arena_chain_chunks(arena, parsec_arena_lifo(arena, ((parsec_arena_chunk_t*)item)->numa_node),
+                                  others, nb);
+        goto done;
+    }
+    if(arena->max_used != INT32_MAX) {
+        int32_t current = parsec_atomic_fetch_inc_int32(&arena->used) + 1;
+        if(current > arena->max_used) {
+            (void)parsec_atomic_fetch_dec_int32(&arena->used);
+            return NULL;
+        }
+    }
+    if( node >= 0 ) {
+        item = (parsec_list_item_t *)parsec_arena_chunk_alloc(arena, size, &node);
+    } else {
         item = (parsec_list_item_t *)alloc( size );
-        TRACE_MALLOC(arena_memory_alloc_key, size, item);
-        PARSEC_OBJ_CONSTRUCT(item, parsec_list_item_t);
-        assert(NULL != item);
     }
+    TRACE_MALLOC(arena_memory_alloc_key, size, item);
+    PARSEC_OBJ_CONSTRUCT(item, parsec_list_item_t);
+    assert(NULL != item);
+    ((parsec_arena_chunk_t*)item)->numa_node = node;
+  done:
     PARSEC_DEBUG_VERBOSE(10, parsec_debug_output, "Arena:\tpop a data of size %zu from arena %p, aligned by %zu, base ptr %p, data ptr %p, sizeof prefix %zu(%zd)",
                 arena->elem_size, arena, arena->alignment, item, ((parsec_arena_chunk_t*)item)->data, sizeof(parsec_arena_chunk_t),
                 PARSEC_ARENA_MIN_ALIGNMENT(arena->alignment));
@@ -155,25 +592,46 @@ static void
 parsec_arena_release_chunk(parsec_arena_t* arena,
                           parsec_arena_chunk_t *chunk)
 {
+    parsec_execution_stream_t *es;
+    parsec_arena_magazine_t *mag;
+    int node;
+
     TRACE_FREE(arena_memory_unused_key, -arena->elem_size*chunk->count, chunk);
 
-    if( (chunk->count == 1) && (arena->released < arena->max_released) ) {
-        PARSEC_DEBUG_VERBOSE(10, parsec_debug_output, "Arena:\tpush a data of size %zu from arena %p, aligned by %zu, base ptr %p, data ptr %p, sizeof prefix %zu(%zd)",
-                arena->elem_size, arena, arena->alignment, chunk, chunk->data, sizeof(parsec_arena_chunk_t),
-                PARSEC_ARENA_MIN_ALIGNMENT(arena->alignment));
-        if(arena->max_released != INT32_MAX) {
-            (void)parsec_atomic_fetch_inc_int32(&arena->released);
+    if( chunk->count == 1 ) {
+        es = parsec_my_execution_stream();
+        node = parsec_arena_numa_node(arena, es);
+        /* chunks bound to another NUMA node go back to their own freelist */
+        if( (NULL != (mag = parsec_arena_my_magazine(arena, es))) &&
+            ((chunk->numa_node < 0) || (chunk->numa_node == node)) ) {
+            if( mag->nb_items < arena->magazine_size ) {
+                mag->hits++;
+            } else {
+                mag->misses++;
+                parsec_arena_magazine_drain(arena, mag, node);
+            }
+            chunk->item.list_next = mag->items;
+            mag->items = &chunk->item;
+            mag->nb_items++;
+            return;
+        }
+        if( arena->use_slabs || (arena->released < arena->max_released) ) {
+            PARSEC_DEBUG_VERBOSE(10, parsec_debug_output, "Arena:\tpush a data of size %zu from arena %p, aligned by %zu, base ptr %p, data ptr %p, sizeof prefix %zu(%zd)",
+                    arena->elem_size, arena, arena->alignment, chunk, chunk->data, sizeof(parsec_arena_chunk_t),
+                    PARSEC_ARENA_MIN_ALIGNMENT(arena->alignment));
+            if(arena->max_released != INT32_MAX) {
+                (void)parsec_atomic_fetch_inc_int32(&arena->released);
+            }
+            parsec_lifo_push(parsec_arena_lifo(arena, chunk->numa_node), &chunk->item);
+            return;
         }
-        parsec_lifo_push(&arena->area_lifo, &chunk->item);
-        return;
     }
     PARSEC_DEBUG_VERBOSE(10, parsec_debug_output, "Arena:\tdeallocate a tile of size %zu x %zu from arena %p, aligned by %zu, base ptr %p, data ptr %p, sizeof prefix %zu(%zd)",
             arena->elem_size, chunk->count, arena, arena->alignment, chunk, chunk->data, sizeof(parsec_arena_chunk_t),
             PARSEC_ARENA_MIN_ALIGNMENT(arena->alignment));
-    TRACE_FREE(arena_memory_free_key, -arena->elem_size*chunk->count, chunk);
     if(arena->max_used != 0 && arena->max_used != INT32_MAX)
         (void)parsec_atomic_fetch_sub_int32(&arena->used, chunk->count);
-    arena->data_free(chunk);
+    parsec_arena_chunk_free(arena, chunk, chunk->count);
 }
 
 int  parsec_arena_allocate_device_private(parsec_data_copy_t *copy,
@@ -188,11 +646,11 @@ int  parsec_arena_allocate_device_private(parsec_data_copy_t *copy,
     assert(device == copy->device_index);
     (void)device;
 
+    size = parsec_arena_chunk_size(arena, count);
     if( count == 1 ) {
-        size = PARSEC_ALIGN(arena->elem_size + arena->alignment + sizeof(parsec_arena_chunk_t),
-                            arena->alignment, size_t);
         chunk = (parsec_arena_chunk_t *)parsec_arena_get_chunk( arena, size, arena->data_malloc );
     } else {
+        int node = parsec_arena_numa_node(arena, parsec_my_execution_stream());
         assert(count > 1);
         if(arena->max_used != INT32_MAX) {
             int32_t current = parsec_atomic_fetch_add_int32(&arena->used, count) + count;
@@ -201,10 +659,9 @@ int  parsec_arena_allocate_device_private(parsec_data_copy_t *copy,
                 return PARSEC_ERR_OUT_OF_RESOURCE;
             }
         }
-        size = PARSEC_ALIGN(arena->elem_size * count + arena->alignment + sizeof(parsec_arena_chunk_t),
-                            arena->alignment, size_t);
-        chunk = (parsec_arena_chunk_t*)arena->data_malloc(size);
+        chunk = (parsec_arena_chunk_t*)parsec_arena_chunk_alloc(arena, size, &node);
         PARSEC_OBJ_CONSTRUCT(&chunk->item, parsec_list_item_t);
+        chunk->numa_node = node;
 
         TRACE_MALLOC(arena_memory_alloc_key, size, chunk);
     }
@@ -231,6 +688,8 @@ int  parsec_arena_allocate_device_private(parsec_data_copy_t *copy,
     copy->dtt = dtt;
     copy->device_private = chunk->data;
     copy->arena_chunk = chunk;
+    if( chunk->numa_node >= 0 )
+        copy->numa_node = (int8_t)chunk->numa_node;
 
     return PARSEC_SUCCESS;
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2009-2022 The University of Tennessee and The University
+ * Copyright (c) 2009-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  */
@@ -35,16 +35,79 @@ extern size_t parsec_arena_max_allocated_memory;
  */
 extern size_t parsec_arena_max_cached_memory;
 
+/**
+ * Number of single element chunks each execution stream can keep in its
+ * private magazine, for each arena (0 disables the magazines).
+ */
+extern int parsec_arena_magazine_size;
+
+/**
+ * When set, the single element chunks of the arenas using the default
+ * allocator are carved out of slabs backed by huge pages.
+ */
+extern int parsec_arena_hugepages;
+
+/**
+ * Number of magazines allocated by each arena, aka. the maximum number of
+ * execution streams that can use the magazines. Set by parsec_init.
+ */
+extern int parsec_arena_nb_magazines;
+
+/**
+ * Process-wide counters of the operations served by the arena magazines
+ * (hits) and of those that had to go to the shared freelist (misses).
+ */
+extern volatile int64_t parsec_arena_magazine_hits;
+extern volatile int64_t parsec_arena_magazine_misses;
+extern volatile int64_t parsec_arena_slab_memory;
+
+/**
+ * When set, the arenas keep one freelist per NUMA node, and allocate the
+ * memory on the NUMA node of the requesting execution stream.
+ */
+extern int parsec_arena_numa;
+
+/**
+ * Number of NUMA nodes handled by the arenas, 0 if the NUMA support is
+ * disabled. Set by parsec_init.
+ */
+extern int parsec_arena_nb_numa_nodes;
+
+#define PARSEC_ARENA_MAX_NUMA_NODES 64
+
+/**
+ * Per NUMA node allocation counters, for all the arenas.
+ */
+typedef struct parsec_arena_numa_counters_s {
+    volatile int64_t nb_allocs;  /**< chunks allocated on the node */
+    volatile int64_t nb_reuses;  /**< chunks taken back from the freelist of the node */
+    volatile int64_t bytes;      /**< memory currently allocated on the node */
+} parsec_arena_numa_counters_t;
+
+extern parsec_arena_numa_counters_t parsec_arena_numa_counters[PARSEC_ARENA_MAX_NUMA_NODES];
+
 #define PARSEC_ALIGN(x,a,t) (((x)+((t)(a)-1)) & ~(((t)(a)-1)))
 #define PARSEC_ALIGN_PTR(x,a,t) ((t)PARSEC_ALIGN((uintptr_t)x, a, uintptr_t))
 #define PARSEC_ALIGN_PAD_AMOUNT(x,s) ((~((uintptr_t)(x))+1) & ((uintptr_t)(s)-1))
 
+typedef struct parsec_arena_magazine_s parsec_arena_magazine_t;
+typedef struct parsec_arena_slab_s     parsec_arena_slab_t;
+
 /**
  * A parsec_arena_s is a structure that manages temporary memory
  * areas passed to the user code by the runtime engine.
  *
  * Typically, network messages and data generated by tasks
  * are stored into arenas.
+ *
+ * Single element chunks are first cached in a small magazine private
+ * to each execution stream, that is accessed without atomic operations.
+ * The magazines are refilled from, and drained into, the shared LIFO by
+ * batches of half their capacity.
+ *
+ * When the NUMA support is enabled, the chunks are allocated on the NUMA
+ * node of the requesting execution stream, and go back to the freelist
+ * of their node when released.
  */
 struct parsec_arena_s {
     parsec_object_t       super;
@@ -62,6 +125,13 @@ struct parsec_arena_s {
      */
     parsec_data_allocate_t data_malloc;
     parsec_data_free_t     data_free;
+    int32_t                magazine_size; /**< capacity of the per execution stream magazines, 0 if disabled */
+    int32_t                nb_magazines;  /**< number of elements in magazines */
+    parsec_arena_magazine_t * volatile magazines; /**< per execution stream caches, allocated on first use */
+    parsec_arena_slab_t * volatile slabs; /**< huge page slabs the chunks are carved from, if enabled */
+    int32_t                use_slabs;     /**< single element chunks are allocated from slabs */
+    int32_t                nb_numa_nodes; /**< number of elements in numa_lifos */
+    parsec_lifo_t         *numa_lifos;    /**< per NUMA node freelists, NULL if the NUMA support is disabled */
 };
 PARSEC_DECLSPEC PARSEC_OBJ_CLASS_DECLARATION(parsec_arena_t);
 
@@ -72,6 +142,7 @@ struct parsec_arena_chunk_s {
      *  It is SINGLETON when ( (not in a free list) and (in debug mode) ) */
     parsec_list_item_t item;
     uint32_t           count;    /**< Number of basic elements pointed by param in this chunck */
+    int32_t            numa_node; /**< NUMA node the chunk is bound to, -1 if allocated with data_malloc */
     parsec_arena_t    *origin;   /**< Arena in which this chunck should be released */
     void              *data;     /**< Actual data pointed by this chunck */
 };
@@ -11,6 +11,7 @@
 #include "parsec/utils/mca_param.h"
 #include "parsec/utils/debug.h"
 #include <stdio.h>
+#include <string.h>
 
 #undef HELPFIRST
 
@@ -35,6 +36,8 @@ static int      parsec_hash_table_mca_param_mnb_index = -1;
 static int32_t  parsec_hash_table_max_table_nb_bits   = 24; /* We will never create a sub-table with more than 1<<parsec_hash_table_max_table_nb_bits buckets
                                                              * NB: if the user calls parsec_hash_table_init with nb_bits > parsec_hash_table_max_table_nb_bits,
                                                              *     we *will* create the first-level table with 1<<nb_bits buckets, despite this value. */
+static int      parsec_hash_table_mca_param_lf_index  = -1;
+static int32_t  parsec_hash_table_lockfree            = 0;  /* Use the lock-free implementation (if the 128 bits CAS is available) */
 
 void *parsec_hash_table_item_lookup(parsec_hash_table_t *ht, parsec_hash_table_item_t *item)
 {
@@ -56,6 +59,351 @@ PARSEC_OBJ_CLASS_INSTANCE(parsec_hash_table_t, parsec_object_t, NULL, parsec_has
        (_HT)->key_functions.key_equal((_ITEM)->key,                     \
                                       (_KEY), (_HT)->hash_data)) )
 
+static uint64_t parsec_hash_table_universal_rehash(parsec_key_t key, int nb_bits);
+
+/*
+ * Lock-free implementation.
+ *
+ * The table is an open addressing array of 128 bits slots (key, item),
+ * probed linearly from the rehashed key. Items are pointers to the
+ * parsec_hash_table_item_t of the user structures, so they are at least
+ * 8 bytes aligned, and the low values / low bit of the item field are used
+ * to encode the state of a slot:
+ *   - LF_EMPTY: never used. Ends all probe sequences.
+ *   - LF_TOMB: an item was removed from this slot. Probes continue, and
+ *     insertions may reuse it.
+ *   - LF_MOVED / LF_MOVED_EMPTY: the slot was migrated into the next table.
+ *     LF_MOVED_EMPTY replaces an LF_EMPTY slot, and thus still ends probe
+ *     sequences in this table, LF_MOVED replaces a used or tombstone slot.
+ *   - an item with LF_FROZEN set: the item is being copied into the next
+ *     table. It can still be found, but not removed from this slot.
+ *
+ * Keys are unique in the table (this is a requirement of the API), an insertion
+ * takes the first empty or tombstone slot of its probe sequence, and empty slots
+ * are never created after initialization: an item is thus always before the first
+ * empty slot of its probe sequence.
+ *
+ * Resizing allocates a new table and links it as next of the current one.
+ * From then on, insertions go into the newest table, while find and remove
+ * look in the old table first, then in the next one. Each operation that sees
+ * a migration in progress migrates a chunk of slots before proceeding; when all
+ * chunks of a table are migrated, ht->lf_table moves to the next table. Old
+ * tables are kept until the hash table is destroyed, as concurrent threads may
+ * still be probing them.
+ */
+#if defined(PARSEC_ATOMIC_HAS_ATOMIC_CAS_INT128)
+#define PARSEC_HASH_TABLE_LF_AVAILABLE 1
+
+#define LF_EMPTY       ((uintptr_t)0x0)
+#define LF_FROZEN      ((uintptr_t)0x1)
+#define LF_TOMB        ((uintptr_t)0x2)
+#define LF_MOVED       ((uintptr_t)0x4)
+#define LF_MOVED_EMPTY ((uintptr_t)0x6)
+#define LF_IS_ITEM(_i) ((_i) > LF_MOVED_EMPTY)
+#define LF_MIGRATION_CHUNK 256
+#define LF_MIN_LOCKS_NB_BITS 8
+
+typedef union {
+    struct {
+        parsec_key_t key;
+        uintptr_t    item;
+    } s;
+    __int128_t       v;
+} parsec_hash_table_lf_slot_t;
+
+struct parsec_hash_table_lf_s {
+    parsec_hash_table_lf_t * volatile      next;          /**< The table this one is migrating into */
+    uint32_t                               nb_bits;       /**< This table has 1<<nb_bits slots */
+    volatile int64_t                       migrate_next;  /**< Index of the next chunk of slots to migrate */
+    volatile int64_t                       migrate_done;  /**< Number of slots already migrated */
+    volatile parsec_hash_table_lf_slot_t  *slots;
+};
+
+static parsec_hash_table_lf_t *parsec_hash_table_lf_new(uint32_t nb_bits)
+{
+    parsec_hash_table_lf_t *t = malloc(sizeof(parsec_hash_table_lf_t));
+    void *slots;
+    if( 0 != posix_memalign(&slots, sizeof(parsec_hash_table_lf_slot_t), (1ULL<<nb_bits) * sizeof(parsec_hash_table_lf_slot_t)) ) {
+        free(t);
+        return NULL;
+    }
+    memset(slots, 0, (1ULL<<nb_bits) * sizeof(parsec_hash_table_lf_slot_t));
+    t->next         = NULL;
+    t->nb_bits      = nb_bits;
+    t->migrate_next = 0;
+    t->migrate_done = 0;
+    t->slots        = (volatile parsec_hash_table_lf_slot_t*)slots;
+    return t;
+}
+
+/* Reads a slot so that key and item belong to the same state, i.e. the item
+ * did not change while the key was read. */
+static inline void parsec_hash_table_lf_read(volatile parsec_hash_table_lf_slot_t *slot,
+                                             parsec_hash_table_lf_slot_t *out)
+{
+    uintptr_t i1;
+    do {
+        i1 = slot->s.item;
+        parsec_atomic_rmb();
+        out->s.key = slot->s.key;
+        parsec_atomic_rmb();
+        out->s.item = slot->s.item;
+    } while( i1 != out->s.item );
+}
+
+static inline int parsec_hash_table_lf_cas(volatile parsec_hash_table_lf_slot_t *slot,
+                                           const parsec_hash_table_lf_slot_t *old,
+                                           parsec_key_t key, uintptr_t item)
+{
+    parsec_hash_table_lf_slot_t nv;
+    nv.s.key = key;
+    nv.s.item = item;
+    return parsec_atomic_cas_int128(&slot->v, old->v, nv.v);
+}
+
+/* Same as OPTIMIZED_EQUAL_TEST, but on the key stored in the slot */
+#define LF_EQUAL_TEST(_SLOT, _KEY, _HASH64, _HT)                        \
+    ( (_SLOT).s.key == (_KEY) ||                                        \
+      (((parsec_hash_table_item_t*)((_SLOT).s.item & ~LF_FROZEN))->hash64 == (_HASH64) && \
+       (_HT)->key_functions.key_equal((_SLOT).s.key,                    \
+                                      (_KEY), (_HT)->hash_data)) )
+
+static void parsec_hash_table_lf_insert_in(parsec_hash_table_t *ht, parsec_hash_table_lf_t *t,
+                                           parsec_hash_table_item_t *item);
+
+static void parsec_hash_table_lf_advance(parsec_hash_table_t *ht)
+{
+    parsec_hash_table_lf_t *t = ht->lf_table;
+    while( NULL != t->next && t->migrate_done == (int64_t)(1ULL<<t->nb_bits) ) {
+        parsec_atomic_cas_ptr(&ht->lf_table, t, t->next);
+        t = ht->lf_table;
+    }
+}
+
+static void parsec_hash_table_lf_migrate_slot(parsec_hash_table_t *ht, parsec_hash_table_lf_t *t, int64_t idx)
+{
+    volatile parsec_hash_table_lf_slot_t *slot = &t->slots[idx];
+    parsec_hash_table_lf_slot_t cur;
+    parsec_hash_table_item_t *item;
+
+    while( 1 ) {
+        parsec_hash_table_lf_read(slot, &cur);
+        if( LF_EMPTY == cur.s.item ) {
+            if( parsec_hash_table_lf_cas(slot, &cur, 0, LF_MOVED_EMPTY) ) return;
+            continue;
+        }
+        if( LF_TOMB == cur.s.item ) {
+            if( parsec_hash_table_lf_cas(slot, &cur, 0, LF_MOVED) ) return;
+            continue;
+        }
+        /* Slots are migrated by a single thread (the owner of the chunk) */
+        assert( LF_IS_ITEM(cur.s.item) && !(cur.s.item & LF_FROZEN) );
+        if( !parsec_hash_table_lf_cas(slot, &cur, cur.s.key, cur.s.item | LF_FROZEN) )
+            continue;
+        item = (parsec_hash_table_item_t*)cur.s.item;
+        parsec_hash_table_lf_insert_in(ht, t->next, item);
+        cur.s.item |= LF_FROZEN;
+        if( !parsec_hash_table_lf_cas(slot, &cur, 0, LF_MOVED) ) {
+            assert(0);  /* nobody else is allowed to modify a frozen slot */
+        }
+        return;
+    }
+}
+
+/* Migrates one chunk of t into t->next, if any chunk remains.
+ * Returns 1 if some work was done, 0 otherwise. */
+static int parsec_hash_table_lf_help(parsec_hash_table_t *ht, parsec_hash_table_lf_t *t)
+{
+    int64_t size = (int64_t)(1ULL<<t->nb_bits), start, end, idx;
+
+    if( t->migrate_next >= size ) return 0;
+    start = parsec_atomic_fetch_add_int64(&t->migrate_next, LF_MIGRATION_CHUNK);
+    if( start >= size ) return 0;
+    end = start + LF_MIGRATION_CHUNK < size ? start + LF_MIGRATION_CHUNK : size;
+    for( idx = start; idx < end; idx++ ) {
+        parsec_hash_table_lf_migrate_slot(ht, t, idx);
+    }
+    if( parsec_atomic_fetch_add_int64(&t->migrate_done, end - start) + (end - start) == size ) {
+        parsec_hash_table_lf_advance(ht);
+    }
+    return 1;
+}
+
+static void parsec_hash_table_lf_resize(parsec_hash_table_t *ht, parsec_hash_table_lf_t *t)
+{
+    int64_t size = (int64_t)(1ULL<<t->nb_bits), live = 0, tombs = 0;
+    parsec_hash_table_lf_t *nt;
+    uint32_t nb_bits = t->nb_bits;
+
+    if( NULL != t->next ) return;
+    for( int64_t i = 0; i < size; i++ ) {
+        uintptr_t it = t->slots[i].s.item;
+        if( LF_IS_ITEM(it) ) live++;
+        else if( LF_TOMB == it ) tombs++;
+    }
+    /* Grow if the load is high, or if the probe sequences are long
+     * without being caused by tombstones; otherwise rehash at the same
+     * size, which purges the tombstones. */
+    if( live * 4 > size || tombs < live ) {
+        do {
+            nb_bits++;
+        } while( live * 4 > (int64_t)(1ULL<<nb_bits) );
+    }
+    if( (int)nb_bits > ht->max_table_nb_bits && live * 2 < size ) {
+        /* Cannot grow, but there is still room: only purge the tombstones
+         * when they fill a good part of the table, otherwise every long
+         * probe sequence would rehash the whole table again */
+        if( !ht->warning_issued ) {
+            parsec_warning("Lock-free hash table %p would need %lu slots, but it is limited to %lu. Performance might get very bad if more elements are added. Consider allowing larger resize with the MCA parameter parsec_hash_table_max_table_nb_bits",
+                           ht, (1UL<<nb_bits), (1UL<<t->nb_bits));
+            ht->warning_issued = 1;
+        }
+        if( tombs * 4 < size )
+            return;
+        nb_bits = t->nb_bits;
+    }
+    assert(nb_bits < 32);
+    nt = parsec_hash_table_lf_new(nb_bits);
+    if( NULL == nt ) return;
+    if( !parsec_atomic_cas_ptr(&t->next, NULL, nt) ) {
+        /* Somebody else started the migration */
+        free((void*)nt->slots);
+        free(nt);
+    }
+    PARSEC_DEBUG_VERBOSE(20, parsec_debug_output, "Lock-free hash table %p: migrating %lu slots (%"PRId64" items, %"PRId64" tombstones) into %lu slots",
+                         ht, (1UL<<t->nb_bits), live, tombs, (1UL<<nb_bits));
+    parsec_hash_table_lf_help(ht, t);
+}
+
+static void parsec_hash_table_lf_insert_in(parsec_hash_table_t *ht, parsec_hash_table_lf_t *t,
+                                           parsec_hash_table_item_t *item)
+{
+    volatile parsec_hash_table_lf_slot_t *slot;
+    parsec_hash_table_lf_slot_t cur;
+    int64_t size, idx, probe;
+
+    while( 1 ) {
+        if( NULL != t->next ) {
+            parsec_hash_table_lf_help(ht, t);
+            t = t->next;
+            continue;
+        }
+        size = (int64_t)(1ULL<<t->nb_bits);
+        idx = parsec_hash_table_universal_rehash(item->hash64, t->nb_bits);
+        for( probe = 0; probe < size; ) {
+            slot = &t->slots[idx];
+            parsec_hash_table_lf_read(slot, &cur);
+            if( LF_EMPTY == cur.s.item || LF_TOMB == cur.s.item ) {
+                if( !parsec_hash_table_lf_cas(slot, &cur, item->key, (uintptr_t)item) )
+                    continue;  /* retry the same slot */
+#if defined(PARSEC_DEBUG_NOISIER)
+                char estr[64];
+                PARSEC_DEBUG_VERBOSE(20, parsec_debug_output, "Added item %p/%s into lock-free hash table %p/%p in slot %"PRId64,
+                                     item, ht->key_functions.key_print(estr, 64, item->key, ht->hash_data), ht, t, idx);
+#endif
+                if( probe > ht->max_collisions_hint ) {
+                    parsec_hash_table_lf_resize(ht, t);
+                }
+                return;
+            }
+            if( LF_MOVED == cur.s.item || LF_MOVED_EMPTY == cur.s.item )
+                break;  /* t->next is set, go insert there */
+            probe++;
+            idx = (idx + 1) & (size - 1);
+        }
+        if( probe == size ) {
+            /* The table is full */
+            parsec_hash_table_lf_resize(ht, t);
+        }
+    }
+}
+
+static void *parsec_hash_table_lf_find(parsec_hash_table_t *ht, parsec_key_t key, uint64_t hash64)
+{
+    parsec_hash_table_lf_t *t = ht->lf_table, *next;
+    parsec_hash_table_lf_slot_t cur;
+    int64_t size, idx, probe;
+
+    while( 1 ) {
+        size = (int64_t)(1ULL<<t->nb_bits);
+        idx = parsec_hash_table_universal_rehash(hash64, t->nb_bits);
+        for( probe = 0; probe < size; probe++, idx = (idx + 1) & (size - 1) ) {
+            parsec_hash_table_lf_read(&t->slots[idx], &cur);
+            if( LF_EMPTY == cur.s.item || LF_MOVED_EMPTY == cur.s.item )
+                break;
+            if( !LF_IS_ITEM(cur.s.item) )
+                continue;
+            if( LF_EQUAL_TEST(cur, key, hash64, ht) ) {
+#if defined(PARSEC_DEBUG_NOISIER)
+                char estr[64];
+                PARSEC_DEBUG_VERBOSE(20, parsec_debug_output, "Found item %p/%s into lock-free hash table %p/%p in slot %"PRId64,
+                                     BASEADDROF(cur.s.item & ~LF_FROZEN, ht),
+                                     ht->key_functions.key_print(estr, 64, key, ht->hash_data), ht, t, idx);
+#endif
+                return BASEADDROF(cur.s.item & ~LF_FROZEN, ht);
+            }
+        }
+        if( NULL == (next = t->next) )
+            return NULL;
+        parsec_hash_table_lf_help(ht, t);
+        t = next;
+    }
+}
+
+static void *parsec_hash_table_lf_remove(parsec_hash_table_t *ht, parsec_key_t key, uint64_t hash64)
+{
+    parsec_hash_table_lf_t *t = ht->lf_table, *next;
+    volatile parsec_hash_table_lf_slot_t *slot;
+    parsec_hash_table_lf_slot_t cur;
+    int64_t size, idx, probe;
+
+    while( 1 ) {
+        size = (int64_t)(1ULL<<t->nb_bits);
+        idx = parsec_hash_table_universal_rehash(hash64, t->nb_bits);
+        for( probe = 0; probe < size; ) {
+            slot = &t->slots[idx];
+            parsec_hash_table_lf_read(slot, &cur);
+            if( LF_EMPTY == cur.s.item || LF_MOVED_EMPTY == cur.s.item )
+                break;
+            if( LF_IS_ITEM(cur.s.item) && LF_EQUAL_TEST(cur, key, hash64, ht) ) {
+                if( cur.s.item & LF_FROZEN )
+                    continue;  /* being copied into t->next: wait until it is moved */
+                if( !parsec_hash_table_lf_cas(slot, &cur, 0, LF_TOMB) )
+                    continue;
+#if defined(PARSEC_DEBUG_NOISIER)
+                char estr[64];
+                PARSEC_DEBUG_VERBOSE(20, parsec_debug_output, "Removed item %p/%s from lock-free hash table %p/%p in slot %"PRId64,
+                                     BASEADDROF(cur.s.item, ht),
+                                     ht->key_functions.key_print(estr, 64, key, ht->hash_data), ht, t, idx);
+#endif
+                return BASEADDROF(cur.s.item, ht);
+            }
+            probe++;
+            idx = (idx + 1) & (size - 1);
+        }
+        if( NULL == (next = t->next) )
+            return NULL;
+        parsec_hash_table_lf_help(ht, t);
+        t = next;
+    }
+}
+
+/* Not thread safe: completes any pending migration */
+static parsec_hash_table_lf_t *parsec_hash_table_lf_quiesce(parsec_hash_table_t *ht)
+{
+    while( NULL != ht->lf_table->next ) {
+        while( parsec_hash_table_lf_help(ht, ht->lf_table) );
+        parsec_hash_table_lf_advance(ht);
+    }
+    return ht->lf_table;
+}
+
+static inline uint64_t parsec_hash_table_lf_lock_index(parsec_hash_table_t *ht, uint64_t hash64)
+{
+    return parsec_hash_table_universal_rehash(hash64, ht->lf_locks_nb_bits);
+}
+#endif  /* defined(PARSEC_ATOMIC_HAS_ATOMIC_CAS_INT128) */
+
 
 int parsec_hash_tables_init(void)
 {
@@ -84,6 +432,19 @@ int parsec_hash_tables_init(void)
         return PARSEC_ERROR;
     }
 
+    v = parsec_hash_table_lockfree;
+    parsec_hash_table_mca_param_lf_index =
+        parsec_mca_param_reg_int_name("parsec", "hash_table_lockfree",
+                                      "Use the lock-free implementation of the hash tables: open addressing "
+                                      "with 128 bits CAS and incremental resize, instead of per-bucket locks "
+                                      "and a global readers-writer lock (ignored if the architecture does not "
+                                      "provide a 128 bits CAS).\n",
+                                      false, false, v, &v);
+    parsec_hash_table_lockfree = v;
+    if( PARSEC_ERROR == parsec_hash_table_mca_param_lf_index ) {
+        return PARSEC_ERROR;
+    }
+
     return PARSEC_SUCCESS;
 }
 
@@ -106,12 +467,41 @@ void parsec_hash_table_init(parsec_hash_table_t *ht, int64_t offset, int nb_bits
         }
     }
 
+    ht->lockfree = 0;
+#if defined(PARSEC_HASH_TABLE_LF_AVAILABLE)
+    ht->lockfree = parsec_hash_table_lockfree;
+    if( parsec_hash_table_mca_param_lf_index != PARSEC_ERROR ) {
+        if( parsec_mca_param_lookup_int(parsec_hash_table_mca_param_lf_index, &v) != PARSEC_ERROR ) {
+            ht->lockfree = v;
+        }
+    }
+#endif  /* defined(PARSEC_HASH_TABLE_LF_AVAILABLE) */
+
     assert( nb_bits >= 1 && nb_bits <= 16);
 
     ht->key_functions = key_functions;
     ht->hash_data = data;
     ht->elt_hashitem_offset = offset;
     ht->warning_issued = 0;
+    ht->lf_locks = NULL;
+    ht->lf_table = NULL;
+    ht->lf_first = NULL;
+
+#if defined(PARSEC_HASH_TABLE_LF_AVAILABLE)
+    if( ht->lockfree ) {
+        parsec_atomic_lock_t unlocked = PARSEC_ATOMIC_UNLOCKED;
+        ht->rw_hash = NULL;
+        ht->rw_lock = unlock;
+        /* Start with more slots than buckets, as the slots hold a single element */
+        ht->lf_first = ht->lf_table = parsec_hash_table_lf_new(nb_bits + 1);
+        ht->lf_locks_nb_bits = nb_bits > LF_MIN_LOCKS_NB_BITS ? nb_bits : LF_MIN_LOCKS_NB_BITS;
+        ht->lf_locks = malloc( (1ULL<<ht->lf_locks_nb_bits) * sizeof(parsec_atomic_lock_t) );
+        for( i = 0; i < (1ULL<<ht->lf_locks_nb_bits); i++ ) {
+            ht->lf_locks[i] = unlocked;
+        }
+        return;
+    }
+#endif  /* defined(PARSEC_HASH_TABLE_LF_AVAILABLE) */
 
     head = malloc(sizeof(parsec_hash_table_head_t));
     head->buckets      = malloc( (1ULL<<nb_bits) * sizeof(parsec_hash_table_bucket_t));
@@ -161,6 +551,13 @@ void parsec_hash_table_lock_bucket(parsec_hash_table_t *ht, parsec_key_t key )
 {
     uint64_t hash;
 
+#if defined(PARSEC_HASH_TABLE_LF_AVAILABLE)
+    if( ht->lockfree ) {
+        hash = parsec_hash_table_lf_lock_index(ht, ht->key_functions.key_hash(key, ht->hash_data));
+        parsec_atomic_lock(&ht->lf_locks[hash]);
+        return;
+    }
+#endif  /* defined(PARSEC_HASH_TABLE_LF_AVAILABLE) */
     parsec_atomic_rwlock_rdlock(&ht->rw_lock);
     hash = parsec_hash_table_universal_rehash(ht->key_functions.key_hash(key, ht->hash_data), ht->rw_hash->nb_bits);
     assert( hash < (1ULL<<ht->rw_hash->nb_bits) );
@@ -173,6 +570,18 @@ void parsec_hash_table_lock_bucket_handle(parsec_hash_table_t *ht,
 {
     uint64_t hash64, hash;
 
+#if defined(PARSEC_HASH_TABLE_LF_AVAILABLE)
+    if( ht->lockfree ) {
+        hash64 = ht->key_functions.key_hash(key, ht->hash_data);
+        hash = parsec_hash_table_lf_lock_index(ht, hash64);
+        parsec_atomic_lock(&ht->lf_locks[hash]);
+        handle->key = key;
+        handle->hash64 = hash64;
+        handle->hash = hash;
+        return;
+    }
+#endif  /* defined(PARSEC_HASH_TABLE_LF_AVAILABLE) */
+
     parsec_atomic_rwlock_rdlock(&ht->rw_lock);
     hash64 = ht->key_functions.key_hash(key, ht->hash_data);
     hash = parsec_hash_table_universal_rehash(hash64, ht->rw_hash->nb_bits);
@@ -218,7 +627,13 @@ static void parsec_hash_table_resize(parsec_hash_table_t *ht)
 void parsec_hash_table_unlock_bucket_impl(parsec_hash_table_t *ht, parsec_key_t key, const char *file, int line)
 {
     uint64_t hash64 = ht->key_functions.key_hash(key, ht->hash_data);
-    uint64_t hash = parsec_hash_table_universal_rehash(hash64, ht->rw_hash->nb_bits);
+    uint64_t hash;
+#if defined(PARSEC_HASH_TABLE_LF_AVAILABLE)
+    if( ht->lockfree )
+        hash = parsec_hash_table_lf_lock_index(ht, hash64);
+    else
+#endif  /* defined(PARSEC_HASH_TABLE_LF_AVAILABLE) */
+        hash = parsec_hash_table_universal_rehash(hash64, ht->rw_hash->nb_bits);
     parsec_key_handle_t handle = {.key = key, .hash64 = hash64, .hash = hash};
     parsec_hash_table_unlock_bucket_handle_impl(ht, &handle, file, line);
 }
@@ -232,6 +647,16 @@ void parsec_hash_table_unlock_bucket_handle_impl(parsec_hash_table_t *ht,
     parsec_hash_table_head_t *cur_head;
     uint64_t hash = handle->hash;
 
+#if defined(PARSEC_HASH_TABLE_LF_AVAILABLE)
+    if( ht->lockfree ) {
+        /* Resizes are triggered by the insertions themselves */
+        (void)file; (void)line;
+        assert( hash < (1ULL<<ht->lf_locks_nb_bits) );
+        parsec_atomic_unlock(&ht->lf_locks[hash]);
+        return;
+    }
+#endif  /* defined(PARSEC_HASH_TABLE_LF_AVAILABLE) */
+
     assert( hash < (1ULL<<ht->rw_hash->nb_bits) );
     if( ht->rw_hash->buckets[hash].cur_len > ht->max_collisions_hint ) {
         if( (int)ht->rw_hash->nb_bits + 1 < ht->max_table_nb_bits )
@@ -264,6 +689,26 @@ void parsec_hash_table_unlock_bucket_handle_impl(parsec_hash_table_t *ht,
 void parsec_hash_table_fini(parsec_hash_table_t *ht)
 {
     parsec_hash_table_head_t *head, *next;
+#if defined(PARSEC_HASH_TABLE_LF_AVAILABLE)
+    if( ht->lockfree ) {
+        parsec_hash_table_lf_t *t, *tnext;
+        for( t = ht->lf_first; NULL != t; t = tnext ) {
+#if defined(PARSEC_DEBUG_PARANOID)
+            /* Only the last table may have items, all the others were migrated */
+            for(size_t i = 0; i < (1ULL<<t->nb_bits); i++) {
+                assert(!LF_IS_ITEM(t->slots[i].s.item));
+            }
+#endif
+            tnext = t->next;
+            free((void*)t->slots);
+            free(t);
+        }
+        ht->lf_first = ht->lf_table = NULL;
+        free((void*)ht->lf_locks);
+        ht->lf_locks = NULL;
+        return;
+    }
+#endif  /* defined(PARSEC_HASH_TABLE_LF_AVAILABLE) */
     head = ht->rw_hash;
     while( NULL != head ) {
         if(NULL != head->buckets) {
@@ -286,6 +731,13 @@ void parsec_hash_table_nolock_insert(parsec_hash_table_t *ht, parsec_hash_table_
     uint64_t hash, hash64;
     parsec_key_t key = item->key;
     hash64 = ht->key_functions.key_hash(key, ht->hash_data);
+#if defined(PARSEC_HASH_TABLE_LF_AVAILABLE)
+    if( ht->lockfree ) {
+        item->hash64 = hash64;
+        parsec_hash_table_lf_insert_in(ht, ht->lf_table, item);
+        return;
+    }
+#endif  /* defined(PARSEC_HASH_TABLE_LF_AVAILABLE) */
     hash = parsec_hash_table_universal_rehash(hash64, ht->rw_hash->nb_bits);
     parsec_key_handle_t handle = {.key = key, .hash64 = hash64, .hash = hash};
     parsec_hash_table_nolock_insert_handle(ht, &handle, item);
@@ -297,6 +749,13 @@ void parsec_hash_table_nolock_insert_handle(parsec_hash_table_t *ht,
                                             parsec_hash_table_item_t *item)
 {
     uint64_t hash;
+#if defined(PARSEC_HASH_TABLE_LF_AVAILABLE)
+    if( ht->lockfree ) {
+        item->hash64 = handle->hash64;
+        parsec_hash_table_lf_insert_in(ht, ht->lf_table, item);
+        return;
+    }
+#endif  /* defined(PARSEC_HASH_TABLE_LF_AVAILABLE) */
     hash = handle->hash;
     item->next_item = ht->rw_hash->buckets[hash].first_item;
     item->hash64 = handle->hash64;
@@ -442,6 +901,10 @@ void *parsec_hash_table_nolock_find(parsec_hash_table_t *ht, parsec_key_t key)
 {
     uint64_t hash;
     uint64_t hash64 = ht->key_functions.key_hash(key, ht->hash_data);
+#if defined(PARSEC_HASH_TABLE_LF_AVAILABLE)
+    if( ht->lockfree )
+        return parsec_hash_table_lf_find(ht, key, hash64);
+#endif  /* defined(PARSEC_HASH_TABLE_LF_AVAILABLE) */
     hash = parsec_hash_table_universal_rehash(hash64, ht->rw_hash->nb_bits);
     parsec_key_handle_t handle = {.key = key, .hash64 = hash64, .hash = hash};
     return parsec_hash_table_nolock_find_handle(ht, &handle);
@@ -455,6 +918,10 @@ void *parsec_hash_table_nolock_find_handle(parsec_hash_table_t *ht,
     uint64_t hash;
     void *item;
     uint64_t hash64 = handle->hash64;
+#if defined(PARSEC_HASH_TABLE_LF_AVAILABLE)
+    if( ht->lockfree )
+        return parsec_hash_table_lf_find(ht, handle->key, hash64);
+#endif  /* defined(PARSEC_HASH_TABLE_LF_AVAILABLE) */
     hash = handle->hash;
     for(current_item = ht->rw_hash->buckets[hash].first_item;
         NULL != current_item;
@@ -484,6 +951,10 @@ void *parsec_hash_table_nolock_find_handle(parsec_hash_table_t *ht,
 void *parsec_hash_table_nolock_remove(parsec_hash_table_t *ht, parsec_key_t key)
 {
     uint64_t hash64 = ht->key_functions.key_hash(key, ht->hash_data);
+#if defined(PARSEC_HASH_TABLE_LF_AVAILABLE)
+    if( ht->lockfree )
+        return parsec_hash_table_lf_remove(ht, key, hash64);
+#endif  /* defined(PARSEC_HASH_TABLE_LF_AVAILABLE) */
     uint64_t hash = parsec_hash_table_universal_rehash(hash64, ht->rw_hash->nb_bits);
     parsec_key_handle_t handle = {.key = key, .hash64 = hash64, .hash = hash};
     return parsec_hash_table_nolock_remove_handle(ht, &handle);
@@ -496,6 +967,10 @@ void *parsec_hash_table_nolock_remove_handle(parsec_hash_table_t *ht,
     parsec_hash_table_item_t *current_item, *prev_item;
     uint64_t hash64 = handle->hash64;
     uint64_t hash = handle->hash;
+#if defined(PARSEC_HASH_TABLE_LF_AVAILABLE)
+    if( ht->lockfree )
+        return parsec_hash_table_lf_remove(ht, handle->key, hash64);
+#endif  /* defined(PARSEC_HASH_TABLE_LF_AVAILABLE) */
     prev_item = NULL;
     for(current_item = ht->rw_hash->buckets[hash].first_item;
         NULL != current_item;
@@ -526,6 +1001,20 @@ void parsec_hash_table_insert_impl(parsec_hash_table_t *ht, parsec_hash_table_it
     uint64_t hash;
     parsec_hash_table_head_t *cur_head;
     int resize = 0;
+#if defined(PARSEC_HASH_TABLE_LF_AVAILABLE)
+    if( ht->lockfree ) {
+        /* Resizes are decided by the insertion itself, according to the
+         * number of probes: there is no bucket length to report on.
+         * The stripe of the key is locked, as lock_bucket does, so that
+         * the find-then-insert sections of other threads stay atomic */
+        parsec_key_handle_t handle;
+        (void)file; (void)line;
+        parsec_hash_table_lock_bucket_handle(ht, item->key, &handle);
+        parsec_hash_table_nolock_insert_handle(ht, &handle, item);
+        parsec_atomic_unlock(&ht->lf_locks[handle.hash]);
+        return;
+    }
+#endif  /* defined(PARSEC_HASH_TABLE_LF_AVAILABLE) */
     parsec_atomic_rwlock_rdlock(&ht->rw_lock);
     cur_head = ht->rw_hash;
     hash = parsec_hash_table_universal_rehash(ht->key_functions.key_hash(item->key, ht->hash_data), ht->rw_hash->nb_bits);
@@ -562,6 +1051,10 @@ void *parsec_hash_table_find(parsec_hash_table_t *ht, parsec_key_t key)
 {
     uint64_t hash;
     void *ret;
+#if defined(PARSEC_HASH_TABLE_LF_AVAILABLE)
+    if( ht->lockfree )
+        return parsec_hash_table_nolock_find(ht, key);
+#endif  /* defined(PARSEC_HASH_TABLE_LF_AVAILABLE) */
     parsec_atomic_rwlock_rdlock(&ht->rw_lock);
     hash = parsec_hash_table_universal_rehash(ht->key_functions.key_hash(key, ht->hash_data), ht->rw_hash->nb_bits);
     assert( hash < (1ULL<<ht->rw_hash->nb_bits) );
@@ -576,6 +1069,16 @@ void *parsec_hash_table_remove(parsec_hash_table_t *ht, parsec_key_t key)
 {
     uint64_t hash;
     void *ret;
+#if defined(PARSEC_HASH_TABLE_LF_AVAILABLE)
+    if( ht->lockfree ) {
+        /* Same as the insertion: serialized with the lock_bucket sections */
+        parsec_key_handle_t handle;
+        parsec_hash_table_lock_bucket_handle(ht, key, &handle);
+        ret = parsec_hash_table_nolock_remove_handle(ht, &handle);
+        parsec_atomic_unlock(&ht->lf_locks[handle.hash]);
+        return ret;
+    }
+#endif  /* defined(PARSEC_HASH_TABLE_LF_AVAILABLE) */
     parsec_atomic_rwlock_rdlock(&ht->rw_lock);
     hash = parsec_hash_table_universal_rehash(ht->key_functions.key_hash(key, ht->hash_data), ht->rw_hash->nb_bits);
     assert( hash < (1ULL<<ht->rw_hash->nb_bits) );
@@ -595,6 +1098,31 @@ void parsec_hash_table_stat(parsec_hash_table_t *ht)
     uint32_t i, j;
     parsec_hash_table_item_t *current_item;
 
+#if defined(PARSEC_HASH_TABLE_LF_AVAILABLE)
+    if( ht->lockfree ) {
+        parsec_hash_table_lf_t *t;
+        parsec_hash_table_lf_slot_t slot;
+        for(t = ht->lf_table, j = 0; NULL != t; t = t->next, j++) {
+            int64_t live = 0, tombs = 0, moved = 0, probes = 0, maxprobe = 0, p;
+            for(i = 0; i < (1ULL<<t->nb_bits); i++) {
+                parsec_hash_table_lf_read(&t->slots[i], &slot);
+                if( LF_TOMB == slot.s.item ) tombs++;
+                else if( LF_MOVED == slot.s.item || LF_MOVED_EMPTY == slot.s.item ) moved++;
+                else if( LF_IS_ITEM(slot.s.item) ) {
+                    live++;
+                    /* distance from the home slot of this key */
+                    p = ((int64_t)i - (int64_t)parsec_hash_table_universal_rehash(((parsec_hash_table_item_t*)(slot.s.item & ~LF_FROZEN))->hash64, t->nb_bits))
+                        & ((1LL<<t->nb_bits) - 1);
+                    probes += p;
+                    if( p > maxprobe ) maxprobe = p;
+                }
+            }
+            printf("lock-free table %p level %d: %lu slots, %"PRId64" items, %"PRId64" tombstones, %"PRId64" migrated, probe length average %g max %"PRId64"\n",
+                   ht, j, (1UL<<t->nb_bits), live, tombs, moved, live > 0 ? (double)probes/live : 0.0, maxprobe);
+        }
+        return;
+    }
+#endif  /* defined(PARSEC_HASH_TABLE_LF_AVAILABLE) */
     for(head = ht->rw_hash, j=0; NULL != head; head = head->next, j++) {
         n = 0;
         min = -1;
@@ -631,6 +1159,21 @@ void parsec_hash_table_for_all(parsec_hash_table_t* ht, parsec_hash_elem_fct_t f
     parsec_hash_table_item_t *current_item;
     void* user_item;
 
+#if defined(PARSEC_HASH_TABLE_LF_AVAILABLE)
+    if( ht->lockfree ) {
+        /* Like the locked version, this is not safe with concurrent updates:
+         * finish any pending migration, then everything is in a single table */
+        parsec_hash_table_lf_t *t = parsec_hash_table_lf_quiesce(ht);
+        for( size_t i = 0; i < (1ULL<<t->nb_bits); i++ ) {
+            uintptr_t it = t->slots[i].s.item;
+            if( LF_IS_ITEM(it) ) {
+                user_item = parsec_hash_table_item_lookup(ht, (parsec_hash_table_item_t*)it);
+                fct( user_item, cb_data );
+            }
+        }
+        return;
+    }
+#endif  /* defined(PARSEC_HASH_TABLE_LF_AVAILABLE) */
     for( head = ht->rw_hash; NULL != head; head = head->next ) {
         for( size_t i = 0; i < (1ULL<<head->nb_bits); i++ ) {
             current_item = head->buckets[i].first_item;
@@ -31,6 +31,23 @@
  *
  *    Keys are uintptr integers, but users may pass a pointer and provide a user-defined
  *    comparison function to use arbitrary length keys.
+ *
+ *    Two implementations are available behind the same API, selected at
+ *    @ref parsec_hash_table_init time by the MCA parameter parsec_hash_table_lockfree:
+ *     - the default one uses chained buckets protected by per-bucket locks, and
+ *       a global rwlock to resize (keeping older generations of the table alive
+ *       until they are empty);
+ *     - the lock-free one uses open addressing with linear probing over 128 bits
+ *       (key, item) slots updated with CAS, and grows by migrating incrementally
+ *       into a new table: every thread that touches a table being migrated moves
+ *       a chunk of slots before proceeding. In this mode, lock_bucket / unlock_bucket
+ *       lock a fixed set of striped locks, and insert and remove lock the
+ *       stripe of their key too, so that the find-then-insert critical sections
+ *       of the callers stay serialized with the insertions and removals of
+ *       other threads. find and the nolock_* functions never lock. When the
+ *       table reaches parsec_hash_table_max_table_nb_bits, it stops growing
+ *       and is only rehashed to purge a large number of removed slots.
+ *       This mode requires a 128 bits CAS; it is silently disabled otherwise.
  */
 
 BEGIN_C_DECLS
@@ -74,6 +91,7 @@ typedef struct parsec_key_handle_s parsec_key_handle_t;
 typedef struct parsec_hash_table_s        parsec_hash_table_t;       /**< A Hash Table */
 typedef struct parsec_hash_table_item_s   parsec_hash_table_item_t;  /**< Items stored in a Hash Table */
 typedef struct parsec_hash_table_bucket_s parsec_hash_table_bucket_t;/**< Buckets of a Hash Table */
+typedef struct parsec_hash_table_lf_s     parsec_hash_table_lf_t;    /**< Lock-free open addressing table */
 
 
 /**
@@ -105,6 +123,14 @@ struct parsec_hash_table_s {
                                                      *   in the same buckets. */
     int                       warning_issued;       /**< Number of times the warning mentionned above has been issued */
     parsec_hash_table_head_t *rw_hash;              /**< Added elements go in this hash table */
+    int                       lockfree;             /**< If true, the elements are stored in lf_table, and rw_hash,
+                                                     *   rw_lock and the buckets are unused */
+    int                       lf_locks_nb_bits;     /**< lf_locks holds 1<<lf_locks_nb_bits locks */
+    parsec_atomic_lock_t     *lf_locks;             /**< In lock-free mode, lock_bucket locks one of these stripes
+                                                     *   to keep the find-then-insert critical sections of the callers */
+    parsec_hash_table_lf_t * volatile lf_table;     /**< Lock-free mode: current table (may be migrating into lf_table->next) */
+    parsec_hash_table_lf_t   *lf_first;             /**< Lock-free mode: first table allocated, all successors are
+                                                     *   reachable through next and released at fini */
 };
 PARSEC_DECLSPEC PARSEC_OBJ_CLASS_DECLARATION(parsec_hash_table_t);
 
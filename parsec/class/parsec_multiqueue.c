@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+#include "parsec/parsec_config.h"
+#include "parsec/class/parsec_multiqueue.h"
+#include "parsec/utils/debug.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#define PARSEC_MULTIQUEUE_CACHE_LINE  64
+#define PARSEC_MULTIQUEUE_INIT_SIZE   64
+
+/* Each heap is on its own cache lines, so that the threads working on
+ * different heaps do not compete for their cache lines. */
+struct parsec_multiqueue_heap_s {
+    parsec_atomic_lock_t  lock;
+    volatile int32_t      size;      /**< read without the lock to choose a heap */
+    volatile int32_t      top;       /**< priority of items[0], meaningful if size > 0 */
+    int32_t               capacity;
+    parsec_list_item_t  **items;
+    char                  pad[PARSEC_MULTIQUEUE_CACHE_LINE - sizeof(parsec_atomic_lock_t)
+                              - 3 * sizeof(int32_t) - sizeof(parsec_list_item_t**)];
+};
+
+static void parsec_multiqueue_construct(parsec_multiqueue_t *mq)
+{
+    mq->priority_offset = 0;
+    mq->nb_heaps = 0;
+    mq->heaps = NULL;
+}
+
+PARSEC_OBJ_CLASS_INSTANCE(parsec_multiqueue_t, parsec_object_t,
+                          parsec_multiqueue_construct, parsec_multiqueue_fini);
+
+#define MQ_PRIORITY(mq, it) COMPARISON_VAL((it), (mq)->priority_offset)
+
+static inline int
+parsec_multiqueue_higher(int32_t a, int32_t b)
+{
+#if defined(HIGHER_IS_BETTER)
+    return a > b;
+#else
+    return a < b;
+#endif
+}
+
+void parsec_multiqueue_init(parsec_multiqueue_t *mq, off_t priority_offset, int nb_heaps)
+{
+    int h;
+
+    assert(nb_heaps > 0);
+    if( 0 != posix_memalign((void**)&mq->heaps, PARSEC_MULTIQUEUE_CACHE_LINE,
+                            nb_heaps * sizeof(parsec_multiqueue_heap_t)) ) {
+        parsec_fatal("Could not allocate the %d heaps of a MultiQueue", nb_heaps);
+    }
+    mq->priority_offset = priority_offset;
+    mq->nb_heaps = nb_heaps;
+    for( h = 0; h < nb_heaps; h++ ) {
+        parsec_atomic_lock_init(&mq->heaps[h].lock);
+        mq->heaps[h].size = 0;
+        mq->heaps[h].top = 0;
+        mq->heaps[h].capacity = PARSEC_MULTIQUEUE_INIT_SIZE;
+        mq->heaps[h].items = (parsec_list_item_t**)malloc(PARSEC_MULTIQUEUE_INIT_SIZE * sizeof(parsec_list_item_t*));
+    }
+}
+
+void parsec_multiqueue_fini(parsec_multiqueue_t *mq)
+{
+    int h;
+
+    for( h = 0; h < mq->nb_heaps; h++ ) {
+        free(mq->heaps[h].items);
+    }
+    free(mq->heaps);
+    mq->heaps = NULL;
+    mq->nb_heaps = 0;
+}
+
+/* Called with the heap locked */
+static void
+parsec_multiqueue_heap_push(parsec_multiqueue_t *mq, parsec_multiqueue_heap_t *heap,
+                            parsec_list_item_t *item)
+{
+    int32_t i = heap->size, parent;
+    int32_t priority = MQ_PRIORITY(mq, item);
+
+    if( i == heap->capacity ) {
+        heap->capacity *= 2;
+        heap->items = (parsec_list_item_t**)realloc(heap->items, heap->capacity * sizeof(parsec_list_item_t*));
+    }
+    /* sift up */
+    while( i > 0 ) {
+        parent = (i - 1) / 2;
+        if( !parsec_multiqueue_higher(priority, MQ_PRIORITY(mq, heap->items[parent])) )
+            break;
+        heap->items[i] = heap->items[parent];
+        i = parent;
+    }
+    heap->items[i] = item;
+    heap->top = MQ_PRIORITY(mq, heap->items[0]);
+    heap->size = heap->size + 1;
+}
+
+/* Called with the heap locked, and not empty */
+static parsec_list_item_t *
+parsec_multiqueue_heap_pop(parsec_multiqueue_t *mq, parsec_multiqueue_heap_t *heap)
+{
+    parsec_list_item_t *top = heap->items[0], *last;
+    int32_t size = heap->size - 1, i = 0, child;
+    int32_t priority;
+
+    assert(size >= 0);
+    if( size > 0 ) {
+        /* sift the last element down from the root */
+        last = heap->items[size];
+        priority = MQ_PRIORITY(mq, last);
+        while( (child = 2 * i + 1) < size ) {
+            if( (child + 1 < size) &&
+                parsec_multiqueue_higher(MQ_PRIORITY(mq, heap->items[child + 1]), MQ_PRIORITY(mq, heap->items[child])) )
+                child++;
+            if( !parsec_multiqueue_higher(MQ_PRIORITY(mq, heap->items[child]), priority) )
+                break;
+            heap->items[i] = heap->items[child];
+            i = child;
+        }
+        heap->items[i] = last;
+        heap->top = MQ_PRIORITY(mq, heap->items[0]);
+    }
+    heap->size = size;
+    return top;
+}
+
+void parsec_multiqueue_push_all(parsec_multiqueue_t *mq, parsec_list_item_t *ring, unsigned int *seed)
+{
+    parsec_multiqueue_heap_t *heap;
+    parsec_list_item_t *item;
+
+    while( NULL != ring ) {
+        item = ring;
+        ring = parsec_list_item_ring_chop(item);
+        PARSEC_LIST_ITEM_SINGLETON(item);
+        /* do not wait for a busy heap, any other one will do */
+        do {
+            heap = &mq->heaps[rand_r(seed) % mq->nb_heaps];
+        } while( !parsec_atomic_trylock(&heap->lock) );
+        parsec_multiqueue_heap_push(mq, heap, item);
+        parsec_atomic_unlock(&heap->lock);
+    }
+}
+
+parsec_list_item_t *parsec_multiqueue_pop(parsec_multiqueue_t *mq, unsigned int *seed)
+{
+    parsec_multiqueue_heap_t *heap, *other;
+    parsec_list_item_t *item;
+    int h, first, attempts;
+
+    /* Two random choices: take the best top of two heaps */
+    for( attempts = 0; attempts < mq->nb_heaps; attempts++ ) {
+        heap = &mq->heaps[rand_r(seed) % mq->nb_heaps];
+        other = &mq->heaps[rand_r(seed) % mq->nb_heaps];
+        if( 0 == heap->size || (0 != other->size && parsec_multiqueue_higher(other->top, heap->top)) )
+            heap = other;
+        if( 0 == heap->size )
+            break;
+        if( !parsec_atomic_trylock(&heap->lock) )
+            continue;
+        if( 0 != heap->size ) {
+            item = parsec_multiqueue_heap_pop(mq, heap);
+            parsec_atomic_unlock(&heap->lock);
+            return item;
+        }
+        parsec_atomic_unlock(&heap->lock);
+    }
+
+    /* The random heaps were empty or busy: look for any non-empty heap
+     * before reporting the MultiQueue as empty */
+    first = rand_r(seed) % mq->nb_heaps;
+    for( h = 0; h < mq->nb_heaps; h++ ) {
+        heap = &mq->heaps[(first + h) % mq->nb_heaps];
+        if( 0 == heap->size )
+            continue;
+        parsec_atomic_lock(&heap->lock);
+        if( 0 != heap->size ) {
+            item = parsec_multiqueue_heap_pop(mq, heap);
+            parsec_atomic_unlock(&heap->lock);
+            return item;
+        }
+        parsec_atomic_unlock(&heap->lock);
+    }
+    return NULL;
+}
+
+long long int parsec_multiqueue_approx_length(parsec_multiqueue_t *mq)
+{
+    long long int length = 0;
+    int h;
+
+    for( h = 0; h < mq->nb_heaps; h++ ) {
+        length += mq->heaps[h].size;
+    }
+    return length;
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+#ifndef PARSEC_MULTIQUEUE_H_HAS_BEEN_INCLUDED
+#define PARSEC_MULTIQUEUE_H_HAS_BEEN_INCLUDED
+
+#include "parsec/parsec_config.h"
+#include "parsec/class/parsec_object.h"
+#include "parsec/class/list_item.h"
+#include "parsec/sys/atomic.h"
+
+/**
+ * @defgroup parsec_internal_classes_multiqueue Relaxed Priority Queue
+ * @ingroup parsec_internal_classes
+ * @{
+ *
+ *  @brief Concurrent relaxed priority queue of list items
+ *
+ *  @details
+ *    A MultiQueue (Rihani, Sanders, Dementiev, SPAA 2015): the elements are
+ *    spread over nb_heaps binary heaps, each protected by its own lock.
+ *    An element is pushed in a random heap, and pop removes the top of the
+ *    best of two random heaps. Both are O(log n), and threads rarely
+ *    compete for the same heap when there are a few heaps per thread. The
+ *    order is relaxed: pop returns an element among the highest priority
+ *    ones, not always the highest one.
+ *
+ *    The priority of an element is the int32_t at priority_offset in the
+ *    element, compared with A_HIGHER_PRIORITY_THAN_B. The random choices
+ *    are drawn from a seed owned by the calling thread.
+ */
+
+BEGIN_C_DECLS
+
+typedef struct parsec_multiqueue_heap_s parsec_multiqueue_heap_t;  /**< One heap of a MultiQueue */
+typedef struct parsec_multiqueue_s      parsec_multiqueue_t;       /**< A MultiQueue */
+
+struct parsec_multiqueue_s {
+    parsec_object_t           super;            /**< A MultiQueue is a PaRSEC object */
+    off_t                     priority_offset;  /**< Offset of the priority in the elements */
+    int                       nb_heaps;         /**< Number of heaps */
+    parsec_multiqueue_heap_t *heaps;            /**< The heaps */
+};
+PARSEC_DECLSPEC PARSEC_OBJ_CLASS_DECLARATION(parsec_multiqueue_t);
+
+/**
+ * @brief Initialize an empty MultiQueue
+ *
+ * @arg[inout] mq              the MultiQueue
+ * @arg[in]    priority_offset the offset of the int32_t priority in the elements
+ * @arg[in]    nb_heaps        the number of heaps, typically a small multiple
+ *                             of the number of threads using the MultiQueue
+ */
+void parsec_multiqueue_init(parsec_multiqueue_t *mq, off_t priority_offset, int nb_heaps);
+
+/**
+ * @brief Release the heaps of a MultiQueue. The elements still in the
+ *  MultiQueue are not released.
+ */
+void parsec_multiqueue_fini(parsec_multiqueue_t *mq);
+
+/**
+ * @brief Push a ring of elements, each in a random heap
+ *
+ * @arg[inout] mq    the MultiQueue
+ * @arg[in]    ring  the ring of elements to push
+ * @arg[inout] seed  the random seed of the calling thread
+ */
+void parsec_multiqueue_push_all(parsec_multiqueue_t *mq, parsec_list_item_t *ring, unsigned int *seed);
+
+/**
+ * @brief Pop one of the highest priority elements
+ *
+ * @arg[inout] mq    the MultiQueue
+ * @arg[inout] seed  the random seed of the calling thread
+ * @return an element, or NULL if all the heaps were found empty
+ */
+parsec_list_item_t *parsec_multiqueue_pop(parsec_multiqueue_t *mq, unsigned int *seed);
+
+/**
+ * @brief Returns (approximately) how many elements are in the MultiQueue
+ *
+ * @details The sizes of the heaps are read without locking them.
+ */
+long long int parsec_multiqueue_approx_length(parsec_multiqueue_t *mq);
+
+END_C_DECLS
+
+/** @} */
+
+#endif  /* PARSEC_MULTIQUEUE_H_HAS_BEEN_INCLUDED */
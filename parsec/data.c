@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2012-2024 The University of Tennessee and The University
+ * Copyright (c) 2012-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  */
@@ -25,6 +25,7 @@ static void parsec_data_copy_construct(parsec_data_copy_t* obj)
     obj->device_index         = 0;
     obj->flags                = 0;
     obj->coherency_state      = PARSEC_DATA_COHERENCY_INVALID;
+    obj->numa_node            = PARSEC_DATA_COPY_NUMA_UNPROBED;
     obj->readers              = 0;
     obj->version              = 0;
     obj->older                = NULL;
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010-2024 The University of Tennessee and The University
+ * Copyright (c) 2010-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  */
@@ -248,7 +248,8 @@ static int  tiled_matrix_key_to_string(struct parsec_data_collection_s *desc, pa
 
 /*
  * Writes the data into the file filename
- * Sequential function per node
+ * Sequential function per node, see parsec_tiled_matrix_file_write for a
+ * parallel version producing a single file for all the nodes
  */
 int parsec_tiled_matrix_data_write(parsec_tiled_matrix_t *tdesc, char *filename)
 {
@@ -296,7 +297,8 @@ int parsec_tiled_matrix_data_write(parsec_tiled_matrix_t *tdesc, char *filename)
 
 /*
  * Read the data from the file filename
- * Sequential function per node
+ * Sequential function per node, see parsec_tiled_matrix_file_read for a
+ * parallel version
  */
 int parsec_tiled_matrix_data_read(parsec_tiled_matrix_t *tdesc, char *filename)
 {
@@ -309,7 +311,7 @@ int parsec_tiled_matrix_data_read(parsec_tiled_matrix_t *tdesc, char *filename)
     uint32_t myrank = tdesc->super.myrank;
     int eltsize =  parsec_datadist_getsizeoftype( tdesc->mtype );
 
-    tmpf = fopen(filename, "w");
+    tmpf = fopen(filename, "r");
     if(NULL == tmpf) {
         parsec_warning("The file %s cannot be open", filename);
         return -1;
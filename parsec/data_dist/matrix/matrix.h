@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010-2024 The University of Tennessee and The University
+ * Copyright (c) 2010-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  */
@@ -134,6 +134,53 @@ int  parsec_tiled_matrix_data_write(parsec_tiled_matrix_t *tdesc, char *filename
 
 int  parsec_tiled_matrix_data_read(parsec_tiled_matrix_t *tdesc, char *filename);
 
+/**
+ * Header of the files written by parsec_tiled_matrix_file_write. The header
+ * is followed by the mt x nt tiles of the matrix, in column major order of the
+ * tiles, each stored as a full mb x nb column major tile (the parts of the
+ * tiles on the border outside of the matrix are left undefined).
+ */
+#define PARSEC_MATRIX_FILE_MAGIC      "PaRSECmx"
+#define PARSEC_MATRIX_FILE_VERSION    1
+#define PARSEC_MATRIX_FILE_ENDIANNESS 0x01020304
+
+typedef struct parsec_matrix_file_header_s {
+    char     magic[8];      /**< PARSEC_MATRIX_FILE_MAGIC, not NULL terminated */
+    uint32_t version;       /**< PARSEC_MATRIX_FILE_VERSION */
+    uint32_t endianness;    /**< PARSEC_MATRIX_FILE_ENDIANNESS in the byte order of the writer */
+    uint64_t header_size;   /**< offset of the first tile in the file */
+    int32_t  mtype;         /**< parsec_matrix_type_t of the elements */
+    int32_t  eltsize;       /**< size of each element in bytes */
+    int32_t  mb, nb;        /**< size of the tiles */
+    int32_t  m, n;          /**< size of the matrix */
+    int32_t  mt, nt;        /**< number of tiles */
+    int32_t  dtype;         /**< distribution type of the matrix that was written */
+    int32_t  nodes;         /**< number of processes that wrote the file */
+    int32_t  reserved[16];
+} parsec_matrix_file_header_t;
+
+/**
+ * Read and check the header of a matrix file, to create a matrix able to
+ * hold its content.
+ */
+int  parsec_tiled_matrix_file_header(const char *filename, parsec_matrix_file_header_t *header);
+
+/**
+ * Write the matrix in a file shared by all the processes, each process
+ * writing its local tiles in parallel from the tasks of a taskpool. Must be
+ * called by all the processes owning tiles of the matrix, on a file system
+ * they all share. The file is complete once all of them returned.
+ */
+int  parsec_tiled_matrix_file_write(parsec_context_t *parsec, parsec_tiled_matrix_t *tdesc, const char *filename);
+
+/**
+ * Read the matrix from a file written by parsec_tiled_matrix_file_write, each
+ * process reading its local tiles in parallel from the tasks of a taskpool.
+ * The matrix must have the same type as the file, and it can be smaller,
+ * but its distribution, its number of processes and its tiling are free.
+ */
+int  parsec_tiled_matrix_file_read(parsec_context_t *parsec, parsec_tiled_matrix_t *tdesc, const char *filename);
+
 typedef int (*parsec_operator_t)( struct parsec_execution_stream_s *es,
                                   const void* src,
                                   void* dst,
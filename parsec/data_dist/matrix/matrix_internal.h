@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2009-2022 The University of Tennessee and The University
+ * Copyright (c) 2009-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  */
@@ -17,6 +17,52 @@ void parsec_matrix_block_cyclic_key2coords(parsec_data_collection_t *desc,
                                            parsec_data_key_t key, int *m, int *n);
 
 
+/*
+ * Define the variadic accessor NAME of a 2D distribution on top of its index
+ * accessor NAME_idx: it only unpacks the two coordinates.
+ */
+#define PARSEC_MATRIX_VARIADIC_ACCESSOR(RTYPE, NAME)               \
+    static RTYPE NAME(parsec_data_collection_t *desc, ...)         \
+    {                                                              \
+        int idx[2];                                                \
+        va_list ap;                                                \
+        va_start(ap, desc);                                        \
+        idx[0] = (int)va_arg(ap, unsigned int);                    \
+        idx[1] = (int)va_arg(ap, unsigned int);                    \
+        va_end(ap);                                                \
+        return NAME##_idx(desc, idx);                              \
+    }
+
+/*
+ * Accessors used by the band distributions on their band and off-band
+ * collections: the index accessor when the collection provides one, its
+ * variadic accessor otherwise (user collections may not provide the key
+ * accessors).
+ */
+static inline uint32_t
+parsec_matrix_band_part_rank_of(parsec_data_collection_t *dc, int m, int n)
+{
+    if( NULL != dc->rank_of_idx )
+        return dc->rank_of_idx(dc, (const int[]){ m, n });
+    return dc->rank_of(dc, m, n);
+}
+
+static inline int32_t
+parsec_matrix_band_part_vpid_of(parsec_data_collection_t *dc, int m, int n)
+{
+    if( NULL != dc->vpid_of_idx )
+        return dc->vpid_of_idx(dc, (const int[]){ m, n });
+    return dc->vpid_of(dc, m, n);
+}
+
+static inline parsec_data_t*
+parsec_matrix_band_part_data_of(parsec_data_collection_t *dc, int m, int n)
+{
+    if( NULL != dc->data_of_idx )
+        return dc->data_of_idx(dc, (const int[]){ m, n });
+    return dc->data_of(dc, m, n);
+}
+
 size_t parsec_matrix_sym_block_cyclic_coord2pos(
     parsec_matrix_sym_block_cyclic_t *dc,
     int m,
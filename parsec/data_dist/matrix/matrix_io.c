@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+/************************************************************
+ * parallel I/O of tiled matrices in a shared file
+ ************************************************************/
+
+#include "parsec/parsec_config.h"
+#include "parsec/parsec_internal.h"
+#include "parsec/utils/debug.h"
+#include "parsec/data_dist/matrix/matrix.h"
+
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+
+/* What each task needs to locate its tile in the file */
+typedef struct matrix_io_args_s {
+    int              fd;
+    parsec_matrix_file_header_t header;  /* of the file */
+    int              eltsize;
+    int              ld;                 /* leading dimension of the local tiles */
+    volatile int32_t errors;
+} matrix_io_args_t;
+
+/* Offset of the element (gm, gn) of the matrix in the file */
+static inline off_t
+matrix_io_offset(const parsec_matrix_file_header_t *header, int gm, int gn)
+{
+    size_t tile = (size_t)(gn / header->nb) * (size_t)header->mt + (size_t)(gm / header->mb);
+    size_t elt  = (size_t)(gn % header->nb) * (size_t)header->mb + (size_t)(gm % header->mb);
+    return (off_t)(header->header_size +
+                   (tile * (size_t)header->mb * (size_t)header->nb + elt) * (size_t)header->eltsize);
+}
+
+/* Complete pwrite/pread, resuming after interruptions and partial transfers */
+static int
+matrix_io_pwrite(int fd, const char *buf, size_t len, off_t offset)
+{
+    while( len > 0 ) {
+        ssize_t rc = pwrite(fd, buf, len, offset);
+        if( rc < 0 ) {
+            if( EINTR == errno ) continue;
+            return PARSEC_ERROR;
+        }
+        buf += rc; len -= (size_t)rc; offset += rc;
+    }
+    return PARSEC_SUCCESS;
+}
+
+static int
+matrix_io_pread(int fd, char *buf, size_t len, off_t offset)
+{
+    while( len > 0 ) {
+        ssize_t rc = pread(fd, buf, len, offset);
+        if( rc < 0 ) {
+            if( EINTR == errno ) continue;
+            return PARSEC_ERROR;
+        }
+        if( 0 == rc ) return PARSEC_ERR_TRUNCATE;
+        buf += rc; len -= (size_t)rc; offset += rc;
+    }
+    return PARSEC_SUCCESS;
+}
+
+/* Number of rows and columns of the tile (m, n) inside the matrix */
+static inline void
+matrix_io_tile_size(const parsec_tiled_matrix_t *desc, int m, int n, int *rows, int *cols)
+{
+    *rows = (m == desc->mt-1) ? desc->m - m * desc->mb : desc->mb;
+    *cols = (n == desc->nt-1) ? desc->n - n * desc->nb : desc->nb;
+}
+
+/*
+ * The file has the tiling of the matrix, a tile is a single write unless
+ * it has a leading dimension larger than its number of rows.
+ */
+static int
+matrix_io_write_tile(parsec_execution_stream_t *es,
+                     const parsec_tiled_matrix_t *desc,
+                     void *tile, int uplo, int m, int n, void *op_args)
+{
+    matrix_io_args_t *args = (matrix_io_args_t*)op_args;
+    const char *buf = (const char*)tile;
+    int rows, cols, rc = PARSEC_SUCCESS;
+    (void)es; (void)uplo;
+
+    matrix_io_tile_size(desc, m, n, &rows, &cols);
+    if( (args->ld == desc->mb) && (rows == desc->mb) ) {
+        rc = matrix_io_pwrite(args->fd, buf, (size_t)rows * cols * args->eltsize,
+                              matrix_io_offset(&args->header, m * desc->mb, n * desc->nb));
+    } else {
+        for( int c = 0; (c < cols) && (PARSEC_SUCCESS == rc); c++ ) {
+            rc = matrix_io_pwrite(args->fd, buf + (size_t)c * args->ld * args->eltsize,
+                                  (size_t)rows * args->eltsize,
+                                  matrix_io_offset(&args->header, m * desc->mb, n * desc->nb + c));
+        }
+    }
+    if( PARSEC_SUCCESS != rc ) {
+        parsec_warning("Writing the tile (%d, %d) failed: %s", m, n, strerror(errno));
+        parsec_atomic_fetch_inc_int32(&args->errors);
+    }
+    return rc;
+}
+
+/*
+ * The tiling of the file can differ from the tiling of the matrix, each
+ * column of the tile is read by pieces, one per tile of the file it crosses.
+ * With the same tiling this is a single read per tile.
+ */
+static int
+matrix_io_read_tile(parsec_execution_stream_t *es,
+                    const parsec_tiled_matrix_t *desc,
+                    void *tile, int uplo, int m, int n, void *op_args)
+{
+    matrix_io_args_t *args = (matrix_io_args_t*)op_args;
+    const parsec_matrix_file_header_t *header = &args->header;
+    char *buf = (char*)tile;
+    int rows, cols, gm, gn, r, len, rc = PARSEC_SUCCESS;
+    (void)es; (void)uplo;
+
+    matrix_io_tile_size(desc, m, n, &rows, &cols);
+    gm = m * desc->mb;
+    gn = n * desc->nb;
+    if( (args->ld == header->mb) && (rows == header->mb) && (cols <= header->nb) &&
+        (0 == gm % header->mb) && (0 == gn % header->nb) ) {
+        rc = matrix_io_pread(args->fd, buf, (size_t)rows * cols * args->eltsize,
+                             matrix_io_offset(header, gm, gn));
+    } else {
+        for( int c = 0; (c < cols) && (PARSEC_SUCCESS == rc); c++ ) {
+            for( r = 0; (r < rows) && (PARSEC_SUCCESS == rc); r += len ) {
+                len = header->mb - ((gm + r) % header->mb);
+                if( len > rows - r ) len = rows - r;
+                rc = matrix_io_pread(args->fd, buf + ((size_t)c * args->ld + r) * args->eltsize,
+                                     (size_t)len * args->eltsize,
+                                     matrix_io_offset(header, gm + r, gn + c));
+            }
+        }
+    }
+    if( PARSEC_SUCCESS != rc ) {
+        parsec_warning("Reading the tile (%d, %d) failed: %s", m, n,
+                       (PARSEC_ERR_TRUNCATE == rc) ? "file truncated" : strerror(errno));
+        parsec_atomic_fetch_inc_int32(&args->errors);
+    }
+    return rc;
+}
+
+static int
+matrix_io_check_header(const parsec_matrix_file_header_t *header, const char *filename)
+{
+    if( 0 != memcmp(header->magic, PARSEC_MATRIX_FILE_MAGIC, sizeof(header->magic)) ) {
+        parsec_warning("The file %s is not a PaRSEC matrix file", filename);
+        return PARSEC_ERR_BAD_PARAM;
+    }
+    if( PARSEC_MATRIX_FILE_ENDIANNESS != header->endianness ) {
+        parsec_warning("The file %s was written with a different byte order", filename);
+        return PARSEC_ERR_NOT_SUPPORTED;
+    }
+    if( PARSEC_MATRIX_FILE_VERSION != header->version ) {
+        parsec_warning("The file %s has version %u, only version %d is supported",
+                       filename, header->version, PARSEC_MATRIX_FILE_VERSION);
+        return PARSEC_ERR_NOT_SUPPORTED;
+    }
+    return PARSEC_SUCCESS;
+}
+
+int parsec_tiled_matrix_file_header(const char *filename, parsec_matrix_file_header_t *header)
+{
+    int fd, rc;
+
+    fd = open(filename, O_RDONLY);
+    if( -1 == fd ) {
+        parsec_warning("The file %s cannot be open: %s", filename, strerror(errno));
+        return PARSEC_ERR_NOT_FOUND;
+    }
+    rc = matrix_io_pread(fd, (char*)header, sizeof(parsec_matrix_file_header_t), 0);
+    close(fd);
+    if( PARSEC_SUCCESS != rc ) {
+        parsec_warning("The header of %s cannot be read", filename);
+        return rc;
+    }
+    return matrix_io_check_header(header, filename);
+}
+
+/* Leading dimension of the local tiles, as given by data_of */
+static inline int
+matrix_io_local_ld(const parsec_tiled_matrix_t *tdesc)
+{
+    return (PARSEC_MATRIX_LAPACK == tdesc->storage) ? tdesc->llm : tdesc->mb;
+}
+
+int parsec_tiled_matrix_file_write(parsec_context_t *parsec, parsec_tiled_matrix_t *tdesc, const char *filename)
+{
+    matrix_io_args_t args;
+    parsec_matrix_file_header_t *header = &args.header;
+    int rc;
+
+    memset(&args, 0, sizeof(matrix_io_args_t));
+    memcpy(header->magic, PARSEC_MATRIX_FILE_MAGIC, sizeof(header->magic));
+    header->version     = PARSEC_MATRIX_FILE_VERSION;
+    header->endianness  = PARSEC_MATRIX_FILE_ENDIANNESS;
+    header->header_size = sizeof(parsec_matrix_file_header_t);
+    header->mtype       = tdesc->mtype;
+    header->eltsize     = parsec_datadist_getsizeoftype(tdesc->mtype);
+    header->mb          = tdesc->mb;
+    header->nb          = tdesc->nb;
+    header->m           = tdesc->m;
+    header->n           = tdesc->n;
+    header->mt          = tdesc->mt;
+    header->nt          = tdesc->nt;
+    header->dtype       = tdesc->dtype;
+    header->nodes       = tdesc->super.nodes;
+    args.eltsize = header->eltsize;
+    args.ld      = matrix_io_local_ld(tdesc);
+
+    /* Nobody truncates the file while the others write into it, the first
+     * process sets its final size instead */
+    args.fd = open(filename, O_WRONLY | O_CREAT, 0644);
+    if( -1 == args.fd ) {
+        parsec_warning("The file %s cannot be open: %s", filename, strerror(errno));
+        return PARSEC_ERR_NOT_FOUND;
+    }
+    if( 0 == tdesc->super.myrank ) {
+        off_t size = matrix_io_offset(header, 0, header->nt * header->nb);
+        if( (0 != ftruncate(args.fd, size)) ||
+            (PARSEC_SUCCESS != matrix_io_pwrite(args.fd, (char*)header, sizeof(parsec_matrix_file_header_t), 0)) ) {
+            parsec_warning("The header of %s cannot be written: %s", filename, strerror(errno));
+            close(args.fd);
+            return PARSEC_ERROR;
+        }
+    }
+
+    rc = parsec_apply(parsec, PARSEC_MATRIX_FULL, tdesc, matrix_io_write_tile, &args);
+    if( (PARSEC_SUCCESS == rc) && (0 != args.errors) )
+        rc = PARSEC_ERROR;
+    if( 0 != close(args.fd) ) {
+        parsec_warning("Closing %s failed: %s", filename, strerror(errno));
+        rc = PARSEC_ERROR;
+    }
+    return rc;
+}
+
+int parsec_tiled_matrix_file_read(parsec_context_t *parsec, parsec_tiled_matrix_t *tdesc, const char *filename)
+{
+    matrix_io_args_t args;
+    int rc;
+
+    memset(&args, 0, sizeof(matrix_io_args_t));
+    rc = parsec_tiled_matrix_file_header(filename, &args.header);
+    if( PARSEC_SUCCESS != rc )
+        return rc;
+    if( (args.header.mtype != (int32_t)tdesc->mtype) ||
+        (args.header.eltsize != parsec_datadist_getsizeoftype(tdesc->mtype)) ) {
+        parsec_warning("The file %s holds a matrix of type %d, not %d", filename,
+                       args.header.mtype, tdesc->mtype);
+        return PARSEC_ERR_BAD_PARAM;
+    }
+    if( (tdesc->m > args.header.m) || (tdesc->n > args.header.n) ) {
+        parsec_warning("The file %s holds a %dx%d matrix, too small for %dx%d", filename,
+                       args.header.m, args.header.n, tdesc->m, tdesc->n);
+        return PARSEC_ERR_BAD_PARAM;
+    }
+    args.eltsize = args.header.eltsize;
+    args.ld      = matrix_io_local_ld(tdesc);
+
+    args.fd = open(filename, O_RDONLY);
+    if( -1 == args.fd ) {
+        parsec_warning("The file %s cannot be open: %s", filename, strerror(errno));
+        return PARSEC_ERR_NOT_FOUND;
+    }
+    rc = parsec_apply(parsec, PARSEC_MATRIX_FULL, tdesc, matrix_io_read_tile, &args);
+    if( (PARSEC_SUCCESS == rc) && (0 != args.errors) )
+        rc = PARSEC_ERR_TRUNCATE;
+    close(args.fd);
+    return rc;
+}
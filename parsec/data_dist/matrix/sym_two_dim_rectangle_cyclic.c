@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2009-2023 The University of Tennessee and The University
+ * Copyright (c) 2009-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  */
@@ -60,20 +60,17 @@ static int sym_twoDBC_memory_unregister(parsec_data_collection_t* desc, parsec_d
     return device->memory_unregister(device, desc, sym_twodbc->mat);
 }
 
-static uint32_t sym_twoDBC_rank_of(parsec_data_collection_t * desc, ...)
+static uint32_t sym_twoDBC_rank_of_idx(parsec_data_collection_t *desc, const int *idx)
 {
     int cr, m, n;
     int rr;
     int res;
-    va_list ap;
     parsec_matrix_sym_block_cyclic_t * dc;
     dc = (parsec_matrix_sym_block_cyclic_t *)desc;
 
     /* Get coordinates */
-    va_start(ap, desc);
-    m = va_arg(ap, unsigned int);
-    n = va_arg(ap, unsigned int);
-    va_end(ap);
+    m = idx[0];
+    n = idx[1];
 
     /* Offset by (i,j) to translate (m,n) in the global matrix */
     m += dc->super.i / dc->super.mb;
@@ -101,6 +98,8 @@ static uint32_t sym_twoDBC_rank_of(parsec_data_collection_t * desc, ...)
     return res;
 }
 
+PARSEC_MATRIX_VARIADIC_ACCESSOR(uint32_t, sym_twoDBC_rank_of)
+
 static void sym_twoDBC_key_to_coordinates(parsec_data_collection_t *desc, parsec_data_key_t key, int *m, int *n)
 {
     int _m, _n;
@@ -116,25 +115,22 @@ static void sym_twoDBC_key_to_coordinates(parsec_data_collection_t *desc, parsec
 
 static uint32_t sym_twoDBC_rank_of_key(parsec_data_collection_t *desc, parsec_data_key_t key)
 {
-    int m, n;
-    sym_twoDBC_key_to_coordinates(desc, key, &m, &n);
-    return sym_twoDBC_rank_of(desc, m, n);
+    int idx[2];
+    sym_twoDBC_key_to_coordinates(desc, key, &idx[0], &idx[1]);
+    return sym_twoDBC_rank_of_idx(desc, idx);
 }
 
-static parsec_data_t* sym_twoDBC_data_of(parsec_data_collection_t *desc, ...)
+static parsec_data_t* sym_twoDBC_data_of_idx(parsec_data_collection_t *desc, const int *idx)
 {
     int m, n, position;
     parsec_matrix_sym_block_cyclic_t * dc;
     size_t pos = 0;
-    va_list ap;
 
     dc = (parsec_matrix_sym_block_cyclic_t *)desc;
 
     /* Get coordinates */
-    va_start(ap, desc);
-    m = (int)va_arg(ap, unsigned int);
-    n = (int)va_arg(ap, unsigned int);
-    va_end(ap);
+    m = idx[0];
+    n = idx[1];
 
     /* Offset by (i,j) to translate (m,n) in the global matrix */
     m += dc->super.i / dc->super.mb;
@@ -161,19 +157,20 @@ static parsec_data_t* sym_twoDBC_data_of(parsec_data_collection_t *desc, ...)
                                      position, (n * dc->super.lmt) + m );
 }
 
+PARSEC_MATRIX_VARIADIC_ACCESSOR(parsec_data_t*, sym_twoDBC_data_of)
+
 static parsec_data_t* sym_twoDBC_data_of_key(parsec_data_collection_t *desc, parsec_data_key_t key)
 {
-    int m, n;
-    sym_twoDBC_key_to_coordinates(desc, key, &m, &n);
-    return sym_twoDBC_data_of(desc, m, n);
+    int idx[2];
+    sym_twoDBC_key_to_coordinates(desc, key, &idx[0], &idx[1]);
+    return sym_twoDBC_data_of_idx(desc, idx);
 }
 
-static int32_t sym_twoDBC_vpid_of(parsec_data_collection_t *desc, ...)
+static int32_t sym_twoDBC_vpid_of_idx(parsec_data_collection_t *desc, const int *idx)
 {
     int m, n, p, q, pq;
     int local_m, local_n;
     parsec_matrix_sym_block_cyclic_t * dc;
-    va_list ap;
     int32_t vpid;
     dc = (parsec_matrix_sym_block_cyclic_t *)desc;
 
@@ -187,10 +184,8 @@ static int32_t sym_twoDBC_vpid_of(parsec_data_collection_t *desc, ...)
 
 
     /* Get coordinates */
-    va_start(ap, desc);
-    m = (int)va_arg(ap, unsigned int);
-    n = (int)va_arg(ap, unsigned int);
-    va_end(ap);
+    m = idx[0];
+    n = idx[1];
 
     /* Offset by (i,j) to translate (m,n) in the global matrix */
     m += dc->super.i / dc->super.mb;
@@ -218,11 +213,13 @@ static int32_t sym_twoDBC_vpid_of(parsec_data_collection_t *desc, ...)
     return vpid;
 }
 
+PARSEC_MATRIX_VARIADIC_ACCESSOR(int32_t, sym_twoDBC_vpid_of)
+
 static int32_t sym_twoDBC_vpid_of_key(parsec_data_collection_t *desc, parsec_data_key_t key)
 {
-    int m, n;
-    sym_twoDBC_key_to_coordinates(desc, key, &m, &n);
-    return sym_twoDBC_vpid_of(desc, m, n);
+    int idx[2];
+    sym_twoDBC_key_to_coordinates(desc, key, &idx[0], &idx[1]);
+    return sym_twoDBC_vpid_of_idx(desc, idx);
 }
 
 void parsec_matrix_sym_block_cyclic_init(parsec_matrix_sym_block_cyclic_t * dc,
@@ -252,6 +249,9 @@ void parsec_matrix_sym_block_cyclic_init(parsec_matrix_sym_block_cyclic_t * dc,
     o->vpid_of_key = sym_twoDBC_vpid_of_key;
     o->data_of     = sym_twoDBC_data_of;
     o->data_of_key = sym_twoDBC_data_of_key;
+    o->rank_of_idx = sym_twoDBC_rank_of_idx;
+    o->vpid_of_idx = sym_twoDBC_vpid_of_idx;
+    o->data_of_idx = sym_twoDBC_data_of_idx;
 
     o->register_memory   = sym_twoDBC_memory_register;
     o->unregister_memory = sym_twoDBC_memory_unregister;
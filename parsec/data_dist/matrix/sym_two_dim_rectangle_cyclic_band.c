@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2023 The University of Tennessee and The University
+ * Copyright (c) 2017-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  */
@@ -8,64 +8,59 @@
 #include "parsec/data_dist/matrix/matrix_internal.h"
 
 /* New rank_of for sym two dim block cyclic band */
-static uint32_t sym_twoDBC_band_rank_of(parsec_data_collection_t * desc, ...)
+static uint32_t sym_twoDBC_band_rank_of_idx(parsec_data_collection_t *desc, const int *idx)
 {
     unsigned int m, n;
-    va_list ap;
     parsec_matrix_sym_block_cyclic_band_t * dc = (parsec_matrix_sym_block_cyclic_band_t *)desc;
 
     /* Get coordinates */
-    va_start(ap, desc);
-    m = va_arg(ap, unsigned int);
-    n = va_arg(ap, unsigned int);
-    va_end(ap);
+    m = idx[0];
+    n = idx[1];
 
     /* Check tile location within band_size */
     if( (unsigned int)abs((int)m-(int)n) < dc->band_size ) {
         /* New index */
         m = (unsigned int)abs((int)m - (int)n);
-        return dc->band.super.super.rank_of(&dc->band.super.super, m, n);
+        return parsec_matrix_band_part_rank_of(&dc->band.super.super, (int)m, (int)n);
     }
 
-    return dc->off_band.super.super.rank_of(&dc->off_band.super.super, m, n);
+    return parsec_matrix_band_part_rank_of(&dc->off_band.super.super, (int)m, (int)n);
 }
 
+PARSEC_MATRIX_VARIADIC_ACCESSOR(uint32_t, sym_twoDBC_band_rank_of)
+
 /* New vpid_of for sym two dim block cyclic band */
-static int32_t sym_twoDBC_band_vpid_of(parsec_data_collection_t * desc, ...)
+static int32_t sym_twoDBC_band_vpid_of_idx(parsec_data_collection_t *desc, const int *idx)
 {
     unsigned int m, n;
-    va_list ap;
     parsec_matrix_sym_block_cyclic_band_t * dc = (parsec_matrix_sym_block_cyclic_band_t *)desc;
 
     /* Get coordinates */
-    va_start(ap, desc);
-    m = va_arg(ap, unsigned int);
-    n = va_arg(ap, unsigned int);
-    va_end(ap);
+    m = idx[0];
+    n = idx[1];
 
     /* Check tile location within band_size */
     if( (unsigned int)abs((int)m - (int)n) < dc->band_size ) {
         /* The new m in band */
         m = (unsigned int)abs((int)m - (int)n);
-        return dc->band.super.super.vpid_of(&dc->band.super.super, m, n);
+        return parsec_matrix_band_part_vpid_of(&dc->band.super.super, (int)m, (int)n);
     }
 
-    return dc->off_band.super.super.vpid_of(&dc->off_band.super.super, m, n);
+    return parsec_matrix_band_part_vpid_of(&dc->off_band.super.super, (int)m, (int)n);
 }
 
+PARSEC_MATRIX_VARIADIC_ACCESSOR(int32_t, sym_twoDBC_band_vpid_of)
+
 /* New data_of for sym two dim block cyclic band */
-static parsec_data_t* sym_twoDBC_band_data_of(parsec_data_collection_t *desc, ...)
+static parsec_data_t* sym_twoDBC_band_data_of_idx(parsec_data_collection_t *desc, const int *idx)
 {
     unsigned int m, n;
-    va_list ap;
     parsec_matrix_sym_block_cyclic_band_t * dc;
     dc = (parsec_matrix_sym_block_cyclic_band_t *)desc;
 
     /* Get coordinates */
-    va_start(ap, desc);
-    m = va_arg(ap, unsigned int);
-    n = va_arg(ap, unsigned int);
-    va_end(ap);
+    m = idx[0];
+    n = idx[1];
 
 #if defined(DISTRIBUTED)
     assert(desc->myrank == desc->rank_of(desc, m, n));
@@ -75,34 +70,36 @@ static parsec_data_t* sym_twoDBC_band_data_of(parsec_data_collection_t *desc, ..
     if( (unsigned int)abs((int)m - (int)n) < dc->band_size ) {
         /* The new m in band */
         m = (unsigned int)abs((int)m - (int)n);
-        return dc->band.super.super.data_of(&dc->band.super.super, m, n);
+        return parsec_matrix_band_part_data_of(&dc->band.super.super, (int)m, (int)n);
     }
 
-    return dc->off_band.super.super.data_of(&dc->off_band.super.super, m, n);
+    return parsec_matrix_band_part_data_of(&dc->off_band.super.super, (int)m, (int)n);
 }
 
+PARSEC_MATRIX_VARIADIC_ACCESSOR(parsec_data_t*, sym_twoDBC_band_data_of)
+
 /* New rank_of_key for sym two dim block cyclic band */
 static uint32_t sym_twoDBC_band_rank_of_key(parsec_data_collection_t *desc, parsec_data_key_t key)
 {
-    int m, n;
-    parsec_matrix_block_cyclic_key2coords(desc, key, &m, &n);
-    return sym_twoDBC_band_rank_of(desc, m, n);
+    int idx[2];
+    parsec_matrix_block_cyclic_key2coords(desc, key, &idx[0], &idx[1]);
+    return sym_twoDBC_band_rank_of_idx(desc, idx);
 }
 
 /* New vpid_of_key for two dim block cyclic band */
 static int32_t sym_twoDBC_band_vpid_of_key(parsec_data_collection_t *desc, parsec_data_key_t key)
 {
-    int m, n;
-    parsec_matrix_block_cyclic_key2coords(desc, key, &m, &n);
-    return sym_twoDBC_band_vpid_of(desc, m, n);
+    int idx[2];
+    parsec_matrix_block_cyclic_key2coords(desc, key, &idx[0], &idx[1]);
+    return sym_twoDBC_band_vpid_of_idx(desc, idx);
 }
 
 /* New data_of_key for sym two dim block cyclic band */
 static parsec_data_t* sym_twoDBC_band_data_of_key(parsec_data_collection_t *desc, parsec_data_key_t key)
 {
-    int m, n;
-    parsec_matrix_block_cyclic_key2coords(desc, key, &m, &n);
-    return sym_twoDBC_band_data_of(desc, m, n);
+    int idx[2];
+    parsec_matrix_block_cyclic_key2coords(desc, key, &idx[0], &idx[1]);
+    return sym_twoDBC_band_data_of_idx(desc, idx);
 }
 
 /*
@@ -125,4 +122,7 @@ void parsec_matrix_sym_block_cyclic_band_init( parsec_matrix_sym_block_cyclic_ba
     dc->rank_of_key  = sym_twoDBC_band_rank_of_key;
     dc->vpid_of_key  = sym_twoDBC_band_vpid_of_key;
     dc->data_of_key  = sym_twoDBC_band_data_of_key;
+    dc->rank_of_idx  = sym_twoDBC_band_rank_of_idx;
+    dc->vpid_of_idx  = sym_twoDBC_band_vpid_of_idx;
+    dc->data_of_idx  = sym_twoDBC_band_data_of_idx;
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2009-2023 The University of Tennessee and The University
+ * Copyright (c) 2009-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  */
@@ -19,6 +19,9 @@ static parsec_data_t* twoDBC_data_of(parsec_data_collection_t* dc, ...);
 static uint32_t twoDBC_rank_of_key(parsec_data_collection_t* dc, parsec_data_key_t key);
 static int32_t twoDBC_vpid_of_key(parsec_data_collection_t* dc, parsec_data_key_t key);
 static parsec_data_t* twoDBC_data_of_key(parsec_data_collection_t* dc, parsec_data_key_t key);
+static uint32_t twoDBC_rank_of_idx(parsec_data_collection_t* dc, const int *idx);
+static int32_t twoDBC_vpid_of_idx(parsec_data_collection_t* dc, const int *idx);
+static parsec_data_t* twoDBC_data_of_idx(parsec_data_collection_t* dc, const int *idx);
 
 static uint32_t twoDBC_kview_rank_of(parsec_data_collection_t* dc, ...);
 static int32_t twoDBC_kview_vpid_of(parsec_data_collection_t* dc, ...);
@@ -26,6 +29,9 @@ static parsec_data_t* twoDBC_kview_data_of(parsec_data_collection_t* dc, ...);
 static uint32_t twoDBC_kview_rank_of_key(parsec_data_collection_t* dc, parsec_data_key_t key);
 static int32_t twoDBC_kview_vpid_of_key(parsec_data_collection_t* dc, parsec_data_key_t key);
 static parsec_data_t* twoDBC_kview_data_of_key(parsec_data_collection_t* dc, parsec_data_key_t key);
+static uint32_t twoDBC_kview_rank_of_idx(parsec_data_collection_t* dc, const int *idx);
+static int32_t twoDBC_kview_vpid_of_idx(parsec_data_collection_t* dc, const int *idx);
+static parsec_data_t* twoDBC_kview_data_of_idx(parsec_data_collection_t* dc, const int *idx);
 
 #if !PARSEC_KCYCLIC_WITH_VIEW
 static uint32_t twoDBC_kcyclic_rank_of(parsec_data_collection_t* dc, ...);
@@ -34,6 +40,9 @@ static parsec_data_t* twoDBC_kcyclic_data_of(parsec_data_collection_t* dc, ...);
 static uint32_t twoDBC_kcyclic_rank_of_key(parsec_data_collection_t* dc, parsec_data_key_t key);
 static int32_t twoDBC_kcyclic_vpid_of_key(parsec_data_collection_t* dc, parsec_data_key_t key);
 static parsec_data_t* twoDBC_kcyclic_data_of_key(parsec_data_collection_t* dc, parsec_data_key_t key);
+static uint32_t twoDBC_kcyclic_rank_of_idx(parsec_data_collection_t* dc, const int *idx);
+static int32_t twoDBC_kcyclic_vpid_of_idx(parsec_data_collection_t* dc, const int *idx);
+static parsec_data_t* twoDBC_kcyclic_data_of_idx(parsec_data_collection_t* dc, const int *idx);
 #endif
 
 static int twoDBC_memory_register(parsec_data_collection_t* desc, parsec_device_module_t* device)
@@ -198,6 +207,9 @@ void parsec_matrix_block_cyclic_init(parsec_matrix_block_cyclic_t * dc,
         o->rank_of_key  = twoDBC_rank_of_key;
         o->vpid_of_key  = twoDBC_vpid_of_key;
         o->data_of_key  = twoDBC_data_of_key;
+        o->rank_of_idx  = twoDBC_rank_of_idx;
+        o->vpid_of_idx  = twoDBC_vpid_of_idx;
+        o->data_of_idx  = twoDBC_data_of_idx;
     } else {
 #if !PARSEC_KCYCLIC_WITH_VIEW
         o->rank_of      = twoDBC_kcyclic_rank_of;
@@ -206,6 +218,9 @@ void parsec_matrix_block_cyclic_init(parsec_matrix_block_cyclic_t * dc,
         o->rank_of_key  = twoDBC_kcyclic_rank_of_key;
         o->vpid_of_key  = twoDBC_kcyclic_vpid_of_key;
         o->data_of_key  = twoDBC_kcyclic_data_of_key;
+        o->rank_of_idx  = twoDBC_kcyclic_rank_of_idx;
+        o->vpid_of_idx  = twoDBC_kcyclic_vpid_of_idx;
+        o->data_of_idx  = twoDBC_kcyclic_data_of_idx;
 #else
         parsec_matrix_block_cyclic_kview(dc, dc, kp, kq);
 #endif /* PARSEC_KCYCLIC_WITH_VIEW */
@@ -255,19 +270,16 @@ void parsec_matrix_block_cyclic_key2coords(parsec_data_collection_t *desc,
  * Set of functions with no k-cyclicity support
  *
  */
-static uint32_t twoDBC_rank_of(parsec_data_collection_t * desc, ...)
+static uint32_t twoDBC_rank_of_idx(parsec_data_collection_t *desc, const int *idx)
 {
     int cr, m, n;
     int rr;
     int res;
-    va_list ap;
     parsec_matrix_block_cyclic_t * dc = (parsec_matrix_block_cyclic_t *)desc;
 
     /* Get coordinates */
-    va_start(ap, desc);
-    m = va_arg(ap, unsigned int);
-    n = va_arg(ap, unsigned int);
-    va_end(ap);
+    m = idx[0];
+    n = idx[1];
 
     /* Assert using local info */
     assert( m < dc->super.mt );
@@ -285,19 +297,20 @@ static uint32_t twoDBC_rank_of(parsec_data_collection_t * desc, ...)
     return res;
 }
 
+PARSEC_MATRIX_VARIADIC_ACCESSOR(uint32_t, twoDBC_rank_of)
+
 static uint32_t twoDBC_rank_of_key(parsec_data_collection_t *desc, parsec_data_key_t key)
 {
-    int m, n;
-    parsec_matrix_block_cyclic_key2coords(desc, key, &m, &n);
-    return twoDBC_rank_of(desc, m, n);
+    int idx[2];
+    parsec_matrix_block_cyclic_key2coords(desc, key, &idx[0], &idx[1]);
+    return twoDBC_rank_of_idx(desc, idx);
 }
 
-static int32_t twoDBC_vpid_of(parsec_data_collection_t *desc, ...)
+static int32_t twoDBC_vpid_of_idx(parsec_data_collection_t *desc, const int *idx)
 {
     int m, n, p, q, pq;
     int local_m, local_n;
     parsec_matrix_block_cyclic_t * dc;
-    va_list ap;
     int32_t vpid;
     dc = (parsec_matrix_block_cyclic_t *)desc;
 
@@ -311,10 +324,8 @@ static int32_t twoDBC_vpid_of(parsec_data_collection_t *desc, ...)
     assert(p*q == pq);
 
     /* Get coordinates */
-    va_start(ap, desc);
-    m = (int)va_arg(ap, unsigned int);
-    n = (int)va_arg(ap, unsigned int);
-    va_end(ap);
+    m = idx[0];
+    n = idx[1];
 
     /* Assert using local info */
     assert( m < dc->super.mt );
@@ -341,11 +352,13 @@ static int32_t twoDBC_vpid_of(parsec_data_collection_t *desc, ...)
     return vpid;
 }
 
+PARSEC_MATRIX_VARIADIC_ACCESSOR(int32_t, twoDBC_vpid_of)
+
 static int32_t twoDBC_vpid_of_key(parsec_data_collection_t *desc, parsec_data_key_t key)
 {
-    int m, n;
-    parsec_matrix_block_cyclic_key2coords(desc, key, &m, &n);
-    return twoDBC_vpid_of(desc, m, n);
+    int idx[2];
+    parsec_matrix_block_cyclic_key2coords(desc, key, &idx[0], &idx[1]);
+    return twoDBC_vpid_of_idx(desc, idx);
 }
 
 static inline int twoDBC_coordinates_to_position(parsec_matrix_block_cyclic_t *dc, int m, int n){
@@ -365,19 +378,16 @@ static inline int twoDBC_coordinates_to_position(parsec_matrix_block_cyclic_t *d
     return position;
 }
 
-static parsec_data_t* twoDBC_data_of(parsec_data_collection_t *desc, ...)
+static parsec_data_t* twoDBC_data_of_idx(parsec_data_collection_t *desc, const int *idx)
 {
     int m, n, position;
     size_t pos = 0;
-    va_list ap;
     parsec_matrix_block_cyclic_t * dc;
     dc = (parsec_matrix_block_cyclic_t *)desc;
 
     /* Get coordinates */
-    va_start(ap, desc);
-    m = (int)va_arg(ap, unsigned int);
-    n = (int)va_arg(ap, unsigned int);
-    va_end(ap);
+    m = idx[0];
+    n = idx[1];
 
     /* Assert using local info */
     assert( m < dc->super.mt );
@@ -411,11 +421,13 @@ static parsec_data_t* twoDBC_data_of(parsec_data_collection_t *desc, ...)
                                      position, (n * dc->super.lmt) + m );
 }
 
+PARSEC_MATRIX_VARIADIC_ACCESSOR(parsec_data_t*, twoDBC_data_of)
+
 static parsec_data_t* twoDBC_data_of_key(parsec_data_collection_t *desc, parsec_data_key_t key)
 {
-    int m, n;
-    parsec_matrix_block_cyclic_key2coords(desc, key, &m, &n);
-    return twoDBC_data_of(desc, m, n);
+    int idx[2];
+    parsec_matrix_block_cyclic_key2coords(desc, key, &idx[0], &idx[1]);
+    return twoDBC_data_of_idx(desc, idx);
 }
 
 /****
@@ -436,6 +448,9 @@ void parsec_matrix_block_cyclic_kview( parsec_matrix_block_cyclic_t* target,
     target->super.super.rank_of_key = twoDBC_kview_rank_of_key;
     target->super.super.data_of_key = twoDBC_kview_data_of_key;
     target->super.super.vpid_of_key = twoDBC_kview_vpid_of_key;
+    target->super.super.rank_of_idx = twoDBC_kview_rank_of_idx;
+    target->super.super.data_of_idx = twoDBC_kview_data_of_idx;
+    target->super.super.vpid_of_idx = twoDBC_kview_vpid_of_idx;
 }
 
 static inline unsigned int kview_compute_m(parsec_matrix_block_cyclic_t* desc, unsigned int m)
@@ -462,67 +477,58 @@ static inline unsigned int kview_compute_n(parsec_matrix_block_cyclic_t* desc, u
     return n;
 }
 
-static uint32_t twoDBC_kview_rank_of(parsec_data_collection_t* dc, ...)
+static uint32_t twoDBC_kview_rank_of_idx(parsec_data_collection_t *dc, const int *idx)
 {
-    unsigned int m, n, sm, sn;
     parsec_matrix_block_cyclic_t* desc = (parsec_matrix_block_cyclic_t*)dc;
-    va_list ap;
-    va_start(ap, dc);
-    m = va_arg(ap, unsigned int);
-    n = va_arg(ap, unsigned int);
-    va_end(ap);
-    sm = kview_compute_m(desc, m);
-    sn = kview_compute_n(desc, n);
-    return twoDBC_rank_of(dc, sm, sn);
+    int sidx[2];
+    sidx[0] = kview_compute_m(desc, idx[0]);
+    sidx[1] = kview_compute_n(desc, idx[1]);
+    return twoDBC_rank_of_idx(dc, sidx);
 }
 
+PARSEC_MATRIX_VARIADIC_ACCESSOR(uint32_t, twoDBC_kview_rank_of)
+
 static uint32_t twoDBC_kview_rank_of_key(parsec_data_collection_t *desc, parsec_data_key_t key)
 {
-    int m, n;
-    parsec_matrix_block_cyclic_key2coords(desc, key, &m, &n);
-    return twoDBC_kview_rank_of(desc, m, n);
+    int idx[2];
+    parsec_matrix_block_cyclic_key2coords(desc, key, &idx[0], &idx[1]);
+    return twoDBC_kview_rank_of_idx(desc, idx);
 }
 
-static int32_t twoDBC_kview_vpid_of(parsec_data_collection_t* dc, ...)
+static int32_t twoDBC_kview_vpid_of_idx(parsec_data_collection_t *dc, const int *idx)
 {
-    unsigned int m, n;
     parsec_matrix_block_cyclic_t* desc = (parsec_matrix_block_cyclic_t*)dc;
-    va_list ap;
-    va_start(ap, dc);
-    m = va_arg(ap, unsigned int);
-    n = va_arg(ap, unsigned int);
-    va_end(ap);
-    m = kview_compute_m(desc, m);
-    n = kview_compute_n(desc, n);
-    return twoDBC_vpid_of(dc, m, n);
+    int sidx[2];
+    sidx[0] = kview_compute_m(desc, idx[0]);
+    sidx[1] = kview_compute_n(desc, idx[1]);
+    return twoDBC_vpid_of_idx(dc, sidx);
 }
 
+PARSEC_MATRIX_VARIADIC_ACCESSOR(int32_t, twoDBC_kview_vpid_of)
+
 static int32_t twoDBC_kview_vpid_of_key(parsec_data_collection_t *desc, parsec_data_key_t key)
 {
-    int m, n;
-    parsec_matrix_block_cyclic_key2coords(desc, key, &m, &n);
-    return twoDBC_kview_vpid_of(desc, m, n);
+    int idx[2];
+    parsec_matrix_block_cyclic_key2coords(desc, key, &idx[0], &idx[1]);
+    return twoDBC_kview_vpid_of_idx(desc, idx);
 }
 
-static parsec_data_t* twoDBC_kview_data_of(parsec_data_collection_t* dc, ...)
+static parsec_data_t* twoDBC_kview_data_of_idx(parsec_data_collection_t *dc, const int *idx)
 {
-    unsigned int m, n;
     parsec_matrix_block_cyclic_t* desc = (parsec_matrix_block_cyclic_t*)dc;
-    va_list ap;
-    va_start(ap, dc);
-    m = va_arg(ap, unsigned int);
-    n = va_arg(ap, unsigned int);
-    va_end(ap);
-    m = kview_compute_m(desc, m);
-    n = kview_compute_n(desc, n);
-    return twoDBC_data_of(dc, m, n);
+    int sidx[2];
+    sidx[0] = kview_compute_m(desc, idx[0]);
+    sidx[1] = kview_compute_n(desc, idx[1]);
+    return twoDBC_data_of_idx(dc, sidx);
 }
 
+PARSEC_MATRIX_VARIADIC_ACCESSOR(parsec_data_t*, twoDBC_kview_data_of)
+
 static parsec_data_t* twoDBC_kview_data_of_key(parsec_data_collection_t *desc, parsec_data_key_t key)
 {
-    int m, n;
-    parsec_matrix_block_cyclic_key2coords(desc, key, &m, &n);
-    return twoDBC_kview_data_of(desc, m, n);
+    int idx[2];
+    parsec_matrix_block_cyclic_key2coords(desc, key, &idx[0], &idx[1]);
+    return twoDBC_kview_data_of_idx(desc, idx);
 }
 
 #if !PARSEC_KCYCLIC_WITH_VIEW
@@ -531,20 +537,17 @@ static parsec_data_t* twoDBC_kview_data_of_key(parsec_data_collection_t *desc, p
  * Set of functions with k-cyclicity support
  *
  */
-static uint32_t twoDBC_kcyclic_rank_of(parsec_data_collection_t * desc, ...)
+static uint32_t twoDBC_kcyclic_rank_of_idx(parsec_data_collection_t *desc, const int *idx)
 {
     unsigned int stc, cr, m, n;
     unsigned int str, rr;
     unsigned int res;
-    va_list ap;
     parsec_matrix_block_cyclic_t * dc;
     dc = (parsec_matrix_block_cyclic_t *)desc;
 
     /* Get coordinates */
-    va_start(ap, desc);
-    m = va_arg(ap, unsigned int);
-    n = va_arg(ap, unsigned int);
-    va_end(ap);
+    m = idx[0];
+    n = idx[1];
 
     /* Offset by (i,j) to translate (m,n) in the global matrix */
     m += dc->super.i / dc->super.mb;
@@ -566,19 +569,20 @@ static uint32_t twoDBC_kcyclic_rank_of(parsec_data_collection_t * desc, ...)
     return res;
 }
 
+PARSEC_MATRIX_VARIADIC_ACCESSOR(uint32_t, twoDBC_kcyclic_rank_of)
+
 static uint32_t twoDBC_kcyclic_rank_of_key(parsec_data_collection_t *desc, parsec_data_key_t key)
 {
-    int m, n;
-    parsec_matrix_block_cyclic_key2coords(desc, key, &m, &n);
-    return twoDBC_kcyclic_rank_of(desc, m, n);
+    int idx[2];
+    parsec_matrix_block_cyclic_key2coords(desc, key, &idx[0], &idx[1]);
+    return twoDBC_kcyclic_rank_of_idx(desc, idx);
 }
 
-static int32_t twoDBC_kcyclic_vpid_of(parsec_data_collection_t *desc, ...)
+static int32_t twoDBC_kcyclic_vpid_of_idx(parsec_data_collection_t *desc, const int *idx)
 {
     int m, n, p, q, pq;
     int local_m, local_n;
     parsec_matrix_block_cyclic_t * dc;
-    va_list ap;
     int32_t vpid;
     dc = (parsec_matrix_block_cyclic_t *)desc;
 
@@ -592,10 +596,8 @@ static int32_t twoDBC_kcyclic_vpid_of(parsec_data_collection_t *desc, ...)
     assert(p*q == pq);
 
     /* Get coordinates */
-    va_start(ap, desc);
-    m = (int)va_arg(ap, unsigned int);
-    n = (int)va_arg(ap, unsigned int);
-    va_end(ap);
+    m = idx[0];
+    n = idx[1];
 
     /* Assert using local info */
 #if defined(DISTRIBUTED)
@@ -623,26 +625,25 @@ static int32_t twoDBC_kcyclic_vpid_of(parsec_data_collection_t *desc, ...)
     return vpid;
 }
 
+PARSEC_MATRIX_VARIADIC_ACCESSOR(int32_t, twoDBC_kcyclic_vpid_of)
+
 static int32_t twoDBC_kcyclic_vpid_of_key(parsec_data_collection_t *desc, parsec_data_key_t key)
 {
-    int m, n;
-    parsec_matrix_block_cyclic_key2coords(desc, key, &m, &n);
-    return twoDBC_kcyclic_vpid_of(desc, m, n);
+    int idx[2];
+    parsec_matrix_block_cyclic_key2coords(desc, key, &idx[0], &idx[1]);
+    return twoDBC_kcyclic_vpid_of_idx(desc, idx);
 }
 
-static parsec_data_t* twoDBC_kcyclic_data_of(parsec_data_collection_t *desc, ...)
+static parsec_data_t* twoDBC_kcyclic_data_of_idx(parsec_data_collection_t *desc, const int *idx)
 {
     size_t pos = 0;
     int m, n, local_m, local_n, position;
-    va_list ap;
     parsec_matrix_block_cyclic_t * dc;
     dc = (parsec_matrix_block_cyclic_t *)desc;
 
     /* Get coordinates */
-    va_start(ap, desc);
-    m = (int)va_arg(ap, unsigned int);
-    n = (int)va_arg(ap, unsigned int);
-    va_end(ap);
+    m = idx[0];
+    n = idx[1];
 
     /* Assert using local info */
 #if defined(DISTRIBUTED)
@@ -683,11 +684,13 @@ static parsec_data_t* twoDBC_kcyclic_data_of(parsec_data_collection_t *desc, ...
                                      position, (n * dc->super.lmt) + m );
 }
 
+PARSEC_MATRIX_VARIADIC_ACCESSOR(parsec_data_t*, twoDBC_kcyclic_data_of)
+
 static parsec_data_t* twoDBC_kcyclic_data_of_key(parsec_data_collection_t *desc, parsec_data_key_t key)
 {
-    int m, n;
-    parsec_matrix_block_cyclic_key2coords(desc, key, &m, &n);
-    return twoDBC_kcyclic_data_of(desc, m, n);
+    int idx[2];
+    parsec_matrix_block_cyclic_key2coords(desc, key, &idx[0], &idx[1]);
+    return twoDBC_kcyclic_data_of_idx(desc, idx);
 }
 
 #endif /* PARSEC_KCYCLIC_WITH_VIEW */
@@ -1,6 +1,6 @@
 
 /*
- * Copyright (c) 2009-2022 The University of Tennessee and The University
+ * Copyright (c) 2009-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  */
@@ -10,6 +10,7 @@
 #include "parsec/utils/debug.h"
 #include "parsec/data_dist/matrix/matrix.h"
 #include "parsec/data_dist/matrix/two_dim_tabular.h"
+#include "parsec/data_dist/matrix/matrix_internal.h"
 #include "parsec/vpmap.h"
 #include "parsec/runtime.h"
 #include "parsec/data.h"
@@ -25,22 +26,22 @@ static int32_t       twoDTD_vpid_of(    parsec_data_collection_t* dc, ... );
 static int32_t       twoDTD_vpid_of_key(parsec_data_collection_t* dc, parsec_data_key_t key);
 static parsec_data_t* twoDTD_data_of(    parsec_data_collection_t* dc, ... );
 static parsec_data_t* twoDTD_data_of_key(parsec_data_collection_t* dc, parsec_data_key_t key);
+static uint32_t      twoDTD_rank_of_idx(parsec_data_collection_t* dc, const int *idx);
+static int32_t       twoDTD_vpid_of_idx(parsec_data_collection_t* dc, const int *idx);
+static parsec_data_t* twoDTD_data_of_idx(parsec_data_collection_t* dc, const int *idx);
 
 /*
  * Tiles are stored in column major order
  */
-static uint32_t twoDTD_rank_of(parsec_data_collection_t * desc, ...)
+static uint32_t twoDTD_rank_of_idx(parsec_data_collection_t *desc, const int *idx)
 {
     int m, n, res;
-    va_list ap;
     parsec_matrix_tabular_t   * dc;
 
     dc = (parsec_matrix_tabular_t*)desc;
 
-    va_start(ap, desc);
-    m = va_arg(ap, int);
-    n = va_arg(ap, int);
-    va_end(ap);
+    m = idx[0];
+    n = idx[1];
 
     /* Offset by (i,j) to translate (m,n) in the global matrix */
     m += dc->super.i / dc->super.mb;
@@ -51,6 +52,8 @@ static uint32_t twoDTD_rank_of(parsec_data_collection_t * desc, ...)
     return dc->tiles_table->elems[res].rank;
 }
 
+PARSEC_MATRIX_VARIADIC_ACCESSOR(uint32_t, twoDTD_rank_of)
+
 static uint32_t twoDTD_rank_of_key(parsec_data_collection_t *dc, parsec_data_key_t key)
 {
     assert( key < (parsec_data_key_t)(((parsec_matrix_tabular_t*)dc)->tiles_table->nbelem) );
@@ -58,18 +61,15 @@ static uint32_t twoDTD_rank_of_key(parsec_data_collection_t *dc, parsec_data_key
     return ((parsec_matrix_tabular_t*)dc)->tiles_table->elems[key].rank;
 }
 
-static int32_t twoDTD_vpid_of(parsec_data_collection_t * desc, ...)
+static int32_t twoDTD_vpid_of_idx(parsec_data_collection_t *desc, const int *idx)
 {
     int m, n, res;
-    va_list ap;
     parsec_matrix_tabular_t   * dc;
 
     dc = (parsec_matrix_tabular_t*)desc;
 
-    va_start(ap, desc);
-    m = va_arg(ap, int);
-    n = va_arg(ap, int);
-    va_end(ap);
+    m = idx[0];
+    n = idx[1];
 
     /* Offset by (i,j) to translate (m,n) in the global matrix */
     m += dc->super.i / dc->super.mb;
@@ -80,6 +80,8 @@ static int32_t twoDTD_vpid_of(parsec_data_collection_t * desc, ...)
     return dc->tiles_table->elems[res].vpid;
 }
 
+PARSEC_MATRIX_VARIADIC_ACCESSOR(int32_t, twoDTD_vpid_of)
+
 static int32_t twoDTD_vpid_of_key(parsec_data_collection_t *dc, parsec_data_key_t key)
 {
     assert( key < (parsec_data_key_t)(((parsec_matrix_tabular_t*)dc)->tiles_table->nbelem) );
@@ -88,18 +90,15 @@ static int32_t twoDTD_vpid_of_key(parsec_data_collection_t *dc, parsec_data_key_
 }
 
 
-static parsec_data_t* twoDTD_data_of(parsec_data_collection_t* dc, ...)
+static parsec_data_t* twoDTD_data_of_idx(parsec_data_collection_t *dc, const int *idx)
 {
     int m, n, res;
-    va_list ap;
     parsec_matrix_tabular_t * tdc;
     parsec_two_dim_td_table_elem_t *elem;
     tdc = (parsec_matrix_tabular_t *)dc;
 
-    va_start(ap, dc);
-    m = va_arg(ap, int);
-    n = va_arg(ap, int);
-    va_end(ap);
+    m = idx[0];
+    n = idx[1];
 
     /* asking for tile (m,n) in submatrix, compute which tile it corresponds in full matrix */
     m += tdc->super.i / tdc->super.mb;
@@ -113,6 +112,8 @@ static parsec_data_t* twoDTD_data_of(parsec_data_collection_t* dc, ...)
     return parsec_tiled_matrix_create_data( &tdc->super, elem->data, elem->pos, res );
 }
 
+PARSEC_MATRIX_VARIADIC_ACCESSOR(parsec_data_t*, twoDTD_data_of)
+
 static parsec_data_t* twoDTD_data_of_key(parsec_data_collection_t *dc, parsec_data_key_t key)
 {
     parsec_matrix_tabular_t       *tdc = (parsec_matrix_tabular_t*)dc;
@@ -146,6 +147,9 @@ void parsec_matrix_tabular_init(parsec_matrix_tabular_t * dc,
     dc->super.super.vpid_of_key = twoDTD_vpid_of_key;
     dc->super.super.data_of     = twoDTD_data_of;
     dc->super.super.data_of_key = twoDTD_data_of_key;
+    dc->super.super.rank_of_idx = twoDTD_rank_of_idx;
+    dc->super.super.vpid_of_idx = twoDTD_vpid_of_idx;
+    dc->super.super.data_of_idx = twoDTD_data_of_idx;
 
     if( NULL != table ) {
         parsec_matrix_tabular_set_table( dc, table );
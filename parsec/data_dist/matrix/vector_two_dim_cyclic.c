@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2009-2024 The University of Tennessee and The University
+ * Copyright (c) 2009-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * Copyright (c) 2024      NVIDIA Corporation.  All rights reserved.
@@ -15,6 +15,9 @@
 static uint32_t vector_twoDBC_rank_of(parsec_data_collection_t* dc, ...);
 static int32_t  vector_twoDBC_vpid_of(parsec_data_collection_t* dc, ...);
 static parsec_data_t* vector_twoDBC_data_of(parsec_data_collection_t* dc, ...);
+static uint32_t vector_twoDBC_rank_of_idx(parsec_data_collection_t* dc, const int *idx);
+static int32_t  vector_twoDBC_vpid_of_idx(parsec_data_collection_t* dc, const int *idx);
+static parsec_data_t* vector_twoDBC_data_of_idx(parsec_data_collection_t* dc, const int *idx);
 
 #if defined(PARSEC_PROF_TRACE) || defined(PARSEC_HAVE_DEV_CUDA_SUPPORT) || defined(PARSEC_HAVE_DEV_HIP_SUPPORT)
 static parsec_data_key_t vector_twoDBC_data_key(struct parsec_data_collection_s *desc, ...);
@@ -125,6 +128,9 @@ void parsec_vector_two_dim_cyclic_init( parsec_vector_two_dim_cyclic_t * dc,
     o->rank_of = vector_twoDBC_rank_of;
     o->vpid_of = vector_twoDBC_vpid_of;
     o->data_of = vector_twoDBC_data_of;
+    o->rank_of_idx = vector_twoDBC_rank_of_idx;
+    o->vpid_of_idx = vector_twoDBC_vpid_of_idx;
+    o->data_of_idx = vector_twoDBC_data_of_idx;
 
 #if defined(PARSEC_PROF_TRACE) || defined(PARSEC_HAVE_DEV_CUDA_SUPPORT) || defined(PARSEC_HAVE_DEV_HIP_SUPPORT)
     o->data_key      = vector_twoDBC_data_key;
@@ -156,20 +162,17 @@ void parsec_vector_two_dim_cyclic_init( parsec_vector_two_dim_cyclic_t * dc,
  * Set of functions do not support k-cycling
  *
  */
-static uint32_t vector_twoDBC_rank_of(parsec_data_collection_t * desc, ...)
+static uint32_t vector_twoDBC_rank_of_idx(parsec_data_collection_t *desc, const int *idx)
 {
     unsigned int m;
     unsigned int rr = 0;
     unsigned int cr = 0;
     unsigned int res;
-    va_list ap;
     parsec_vector_two_dim_cyclic_t * dc;
     dc = (parsec_vector_two_dim_cyclic_t *)desc;
 
     /* Get coordinates */
-    va_start(ap, desc);
-    m = va_arg(ap, unsigned int);
-    va_end(ap);
+    m = idx[0];
 
     /* Offset by (i,j) to translate (m,n) in the global matrix */
     m += dc->super.i / dc->super.mb;
@@ -186,13 +189,12 @@ static uint32_t vector_twoDBC_rank_of(parsec_data_collection_t * desc, ...)
     return res;
 }
 
-static int32_t vector_twoDBC_vpid_of(parsec_data_collection_t *desc, ...)
+static int32_t vector_twoDBC_vpid_of_idx(parsec_data_collection_t *desc, const int *idx)
 {
     int m, p, q, pq;
     int local_m = 0;
     int local_n = 0;
     parsec_vector_two_dim_cyclic_t * dc;
-    va_list ap;
     int32_t vpid;
     dc = (parsec_vector_two_dim_cyclic_t *)desc;
 
@@ -206,9 +208,7 @@ static int32_t vector_twoDBC_vpid_of(parsec_data_collection_t *desc, ...)
     assert(p*q == pq);
 
     /* Get coordinates */
-    va_start(ap, desc);
-    m = (int)va_arg(ap, unsigned int);
-    va_end(ap);
+    m = idx[0];
 
     /* Offset by (i,j) to translate (m,n) in the global matrix */
     m += dc->super.i / dc->super.mb;
@@ -230,19 +230,16 @@ static int32_t vector_twoDBC_vpid_of(parsec_data_collection_t *desc, ...)
     return vpid;
 }
 
-static parsec_data_t* vector_twoDBC_data_of(parsec_data_collection_t *desc, ...)
+static parsec_data_t* vector_twoDBC_data_of_idx(parsec_data_collection_t *desc, const int *idx)
 {
     int m;
     size_t pos = 0;
     int local_m;
-    va_list ap;
     parsec_vector_two_dim_cyclic_t * dc;
     dc = (parsec_vector_two_dim_cyclic_t *)desc;
 
     /* Get coordinates */
-    va_start(ap, desc);
-    m = (int)va_arg(ap, unsigned int);
-    va_end(ap);
+    m = idx[0];
 
     /* Offset by (i,j) to translate (m,n) in the global matrix */
     m += dc->super.i / dc->super.mb;
@@ -267,6 +264,42 @@ static parsec_data_t* vector_twoDBC_data_of(parsec_data_collection_t *desc, ...)
                                     local_m, m);
 }
 
+/*
+ * Variadic accessors, forwarding the coordinate to the index ones
+ */
+static uint32_t vector_twoDBC_rank_of(parsec_data_collection_t *desc, ...)
+{
+    int m;
+    va_list ap;
+
+    va_start(ap, desc);
+    m = (int)va_arg(ap, unsigned int);
+    va_end(ap);
+    return vector_twoDBC_rank_of_idx(desc, &m);
+}
+
+static int32_t vector_twoDBC_vpid_of(parsec_data_collection_t *desc, ...)
+{
+    int m;
+    va_list ap;
+
+    va_start(ap, desc);
+    m = (int)va_arg(ap, unsigned int);
+    va_end(ap);
+    return vector_twoDBC_vpid_of_idx(desc, &m);
+}
+
+static parsec_data_t* vector_twoDBC_data_of(parsec_data_collection_t *desc, ...)
+{
+    int m;
+    va_list ap;
+
+    va_start(ap, desc);
+    m = (int)va_arg(ap, unsigned int);
+    va_end(ap);
+    return vector_twoDBC_data_of_idx(desc, &m);
+}
+
 /*
  * Common functions
  */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2024 The University of Tennessee and The University
+ * Copyright (c) 2015-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  */
@@ -44,6 +44,12 @@ struct parsec_data_s {
 };
 PARSEC_DECLSPEC PARSEC_OBJ_CLASS_DECLARATION(parsec_data_t);
 
+/**
+ * Value of parsec_data_copy_t::numa_node until the location of the copy is
+ * known (either set by the arena or lazily probed by the scheduler).
+ */
+#define PARSEC_DATA_COPY_NUMA_UNPROBED (-2)
+
 /**
  * This structure represent a device copy of a parsec_data_t.
  */
@@ -53,7 +59,8 @@ struct parsec_data_copy_s {
     int8_t                      device_index;         /**< Index in the original->device_copies array */
     parsec_data_flag_t          flags;
     parsec_data_coherency_t     coherency_state;
-    /* int8_t */
+    int8_t                      numa_node;            /**< NUMA node holding the data (-1 if unknown),
+                                                       *   or PARSEC_DATA_COPY_NUMA_UNPROBED */
 
     int32_t                     readers;
 
@@ -219,6 +219,43 @@ parsec_hbbuffer_push_all_by_priority(parsec_hbbuffer_t *b,
 #undef CTX
 }
 
+void
+parsec_hbbuffer_push_all_sorted_by_priority(parsec_hbbuffer_t *b,
+                                            parsec_list_item_t *list,
+                                            int32_t distance)
+{
+    parsec_list_item_t *topush;
+    size_t i;
+
+    if( (0 != distance) && (NULL != b->parent_push_fct) ) {
+        b->parent_push_fct(b->parent_store, list, distance - 1);
+        return;
+    }
+
+    /* The list is sorted, so the first elements are the ones that would win
+     * any slot: give them the empty slots first, in one scan of the buffer. */
+    for(i = 0; (NULL != list) && (i < b->size); i++) {
+        if( NULL != b->items[i] )
+            continue;
+        topush = list;
+        list = parsec_list_item_ring_chop(topush);
+        PARSEC_LIST_ITEM_SINGLETON(topush);
+        if( 0 == parsec_atomic_cas_ptr(&b->items[i], NULL, topush) ) {
+            /* Somebody took this slot, put topush back in front of the list */
+            if( NULL != list )
+                parsec_list_item_ring_push(list, topush);
+            list = topush;
+            continue;
+        }
+        PARSEC_DEBUG_VERBOSE(20, parsec_debug_output, "HBB:	Push elem %p in local queue %p at position %d", topush, b, (int)i );
+    }
+
+    /* The buffer is full: the remaining (lowest priority) elements may still
+     * evict lower priority elements from the buffer */
+    if( NULL != list )
+        parsec_hbbuffer_push_all_by_priority(b, list, distance);
+}
+
 parsec_list_item_t*
 parsec_hbbuffer_pop_best(parsec_hbbuffer_t *b, off_t priority_offset)
 {
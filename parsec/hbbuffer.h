@@ -62,6 +62,16 @@ parsec_hbbuffer_push_all_by_priority(parsec_hbbuffer_t *b,
                                      parsec_list_item_t *list,
                                      int32_t distance);
 
+/* Same as parsec_hbbuffer_push_all_by_priority, for a list sorted by
+ * decreasing priority: the empty slots of the buffer are filled in a
+ * single pass, and only the elements that do not fit compete for the
+ * slots of lower priority elements.
+ */
+void
+parsec_hbbuffer_push_all_sorted_by_priority(parsec_hbbuffer_t *b,
+                                            parsec_list_item_t *list,
+                                            int32_t distance);
+
 /* This code is unsafe, since another thread may be inserting new elements.
  * Use is_empty in safe-checking only
  */
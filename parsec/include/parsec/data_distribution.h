@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010-2021 The University of Tennessee and The University
+ * Copyright (c) 2010-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  */
@@ -36,17 +36,28 @@ struct parsec_data_collection_s {
     /* return a unique key (unique only for the specified parsec_dc) associated to a data */
     parsec_data_key_t (*data_key)(parsec_data_collection_t *d, ...);
 
+    /* The accessors below come in three flavors: variadic, taking one int per
+     * dimension of the collection; by key; and by index, taking the same
+     * coordinates packed in an array. The index flavor is optional (NULL if
+     * the collection does not provide it) and is preferred by the generated
+     * code as it does not pay for the va_list handling. A collection that
+     * overrides a variadic accessor must override or reset the index one.
+     */
+
     /* return the rank of the process owning the data  */
     uint32_t (*rank_of)(parsec_data_collection_t *d, ...);
     uint32_t (*rank_of_key)(parsec_data_collection_t *d, parsec_data_key_t key);
+    uint32_t (*rank_of_idx)(parsec_data_collection_t *d, const int *idx);
 
     /* return the pointer to the data possessed locally */
     parsec_data_t* (*data_of)(parsec_data_collection_t *d, ...);
     parsec_data_t* (*data_of_key)(parsec_data_collection_t *d, parsec_data_key_t key);
+    parsec_data_t* (*data_of_idx)(parsec_data_collection_t *d, const int *idx);
 
     /* return the virtual process ID of data possessed locally */
     int32_t  (*vpid_of)(parsec_data_collection_t *d, ...);
     int32_t  (*vpid_of_key)(parsec_data_collection_t *d, parsec_data_key_t key);
+    int32_t  (*vpid_of_idx)(parsec_data_collection_t *d, const int *idx);
 
     /* Memory management function. They are used to register/unregister the data description
      * with the active devices.
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2009-2023 The University of Tennessee and The University
+ * Copyright (c) 2009-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  */
@@ -37,6 +37,8 @@ struct parsec_execution_stream_s {
     int32_t   th_id;        /**< Internal thread identifier. A thread belongs to a vp */
     int core_id;            /**< Core on which the thread is bound (hwloc in order numbering) */
     int socket_id;          /**< Socket on which the thread is bound (hwloc in order numerotation) */
+    int numa_id;            /**< NUMA node on which the thread is bound (hwloc logical index), -1 if unknown */
+    int32_t arena_magazine_id; /**< Index of the magazines of this stream in the arenas, -1 if none */
 
     pthread_t pthread_id;     /**< POSIX thread identifier. */
 
@@ -48,6 +50,8 @@ struct parsec_execution_stream_s {
 
     void *scheduler_object;
 
+    struct parsec_metrics_stream_s *metrics; /**< Runtime metrics of this stream, NULL if disabled */
+
     /* The task to be executed next by this execution_stream. Beware as this bypasses
      * the scheduler decision.
      */
@@ -93,6 +97,15 @@ struct parsec_vp_s {
     parsec_mempool_t         dependencies_mempool; /**< If using hashtables to store dependencies
                                                     *   those are allocated using this mempool */
 
+    /* The execution streams of this vp grouped by NUMA node, for the
+     * locality-aware scheduling (only set when it is enabled and the streams
+     * span more than one node). The streams of node n are
+     * numa_streams[numa_first[n]] to numa_streams[numa_first[n+1]-1].
+     */
+    int32_t                     nb_numa_nodes;
+    int32_t                    *numa_first;
+    parsec_execution_stream_t **numa_streams;
+
     /* This field should always be the last one in the structure. Even if the
      * declared number of execution units is 1, when we allocate the memory
      * we will allocate more (as many as we need), so everything after this
@@ -30,6 +30,7 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include <sys/time.h>
 
 #include "parsec/parsec_config.h"
@@ -69,6 +70,9 @@ int32_t __parsec_dtd_is_initialized = 0; /**< Indicates init of dtd environment
 
 int parsec_dtd_window_size             = 8000;   /**< Default window size */
 int parsec_dtd_threshold_size          = 4000;   /**< Default threshold size of tasks for master thread to wait on */
+int parsec_dtd_window_adaptive         = 0;      /**< The window is adjusted at runtime */
+static int parsec_dtd_window_min_size  = 256;    /**< Lower bound of the adaptive window */
+static int parsec_dtd_window_max_memory = 0;     /**< Memory (MB) held by pending tasks above which the adaptive window shrinks */
 static int parsec_dtd_task_hash_table_size = 1<<16; /**< Default task hash table size */
 static int parsec_dtd_tile_hash_table_size = 1<<16; /**< Default tile hash table size */
 
@@ -461,6 +465,13 @@ PARSEC_OBJ_CLASS_INSTANCE(parsec_dtd_taskpool_t, parsec_taskpool_t,
  *                                          thread will wait before going
  *                                          back and inserting task into the
  *                                          engine.
+ *  - dtd_window_mode (default=static):    static, or adaptive to adjust
+ *                                          the window from the load (see
+ *                                          parsec_dtd_adapt_window).
+ *  - dtd_window_min_size (default=256):    Lower bound of the adaptive window.
+ *  - dtd_window_max_memory (default=0):    Memory (MB) of the pending tasks
+ *                                          above which the adaptive window
+ *                                          shrinks, 0 for no limit.
  * @ingroup DTD_INTERFACE
  */
 static void
@@ -496,6 +507,32 @@ parsec_dtd_lazy_init(void)
                                         "Registers the supplied size overriding the default size of threshold size",
                                         false, false, parsec_dtd_threshold_size, &parsec_dtd_threshold_size);
 
+    char *window_mode = NULL;
+    (void)parsec_mca_param_reg_string_name("dtd", "window_mode",
+                                           "How the window of task insertion is sized: static (doubled up to dtd_window_size, "
+                                           "then drained down to dtd_threshold_size) or adaptive (adjusted between "
+                                           "dtd_window_min_size and dtd_window_size from the ready tasks and the memory in use)",
+                                           false, false, parsec_dtd_window_adaptive ? "adaptive" : "static", &window_mode);
+    if( NULL != window_mode ) {
+        if( 0 == strcmp(window_mode, "adaptive") ) {
+            parsec_dtd_window_adaptive = 1;
+        } else if( 0 == strcmp(window_mode, "static") ) {
+            parsec_dtd_window_adaptive = 0;
+        } else {
+            parsec_warning("DTD window mode '%s' is unknown, using static", window_mode);
+            parsec_dtd_window_adaptive = 0;
+        }
+    }
+
+    (void)parsec_mca_param_reg_int_name("dtd", "window_min_size",
+                                        "Lower bound of the adaptive window of task insertion",
+                                        false, false, parsec_dtd_window_min_size, &parsec_dtd_window_min_size);
+
+    (void)parsec_mca_param_reg_int_name("dtd", "window_max_memory",
+                                        "Memory (in MB) held by the pending tasks and the bounded arenas above which "
+                                        "the adaptive window shrinks, 0 for no limit",
+                                        false, false, parsec_dtd_window_max_memory, &parsec_dtd_window_max_memory);
+
     /* Registering mca param for threshold size */
     (void)parsec_mca_param_reg_int_name("dtd", "profile_verbose",
                                         "This param turns events that profiles task insertion and other dtd overheads",
@@ -564,14 +601,16 @@ extern int __parsec_task_progress(parsec_execution_stream_t *es,
  *
  * @param[in]   tp
  *                  PaRSEC dtd taskpool
+ * @return          The number of times no ready task was found
  *
  * @ingroup     DTD_INTERFACE_INTERNAL
  */
-void
+int
 parsec_execute_and_come_back(parsec_taskpool_t *tp,
                              int task_threshold_count)
 {
     uint64_t misses_in_a_row;
+    int empty_selects = 0;
     parsec_execution_stream_t *es = parsec_my_execution_stream();
     parsec_task_t *task;
     int rc, distance;
@@ -614,8 +653,11 @@ parsec_execute_and_come_back(parsec_taskpool_t *tp,
 
             rc = __parsec_task_progress(es, task, distance);
             (void)rc;
+        } else {
+            empty_selects++;
         }
     }
+    return empty_selects;
 }
 
 /* **************************************************************************** */
@@ -1262,6 +1304,15 @@ parsec_dtd_tile_of(parsec_data_collection_t *dc, parsec_data_key_t key)
 {
     parsec_dtd_tile_t *tile = parsec_dtd_tile_find(dc, (uint64_t)key);
     if( NULL == tile ) {
+        parsec_hash_table_t *hash_table = (parsec_hash_table_t *)dc->tile_h_table;
+        /* Another inserting thread might be creating the same tile: check again
+         * with the bucket locked, and insert the tile before releasing it */
+        parsec_hash_table_lock_bucket(hash_table, (parsec_key_t)key);
+        tile = (parsec_dtd_tile_t *)parsec_hash_table_nolock_find(hash_table, (parsec_key_t)key);
+        if( NULL != tile ) {
+            parsec_hash_table_unlock_bucket(hash_table, (parsec_key_t)key);
+            goto tile_found;
+        }
         /* Creating Tile object */
         tile = (parsec_dtd_tile_t *)parsec_thread_mempool_allocate(parsec_dtd_tile_mempool->thread_mempools);
         tile->dc = dc;
@@ -1278,8 +1329,11 @@ parsec_dtd_tile_of(parsec_data_collection_t *dc, parsec_data_key_t key)
         }
 
         SET_LAST_ACCESSOR(tile);
-        parsec_dtd_tile_insert(tile->key, tile, dc);
+        tile->ht_item.key = (parsec_key_t)tile->key;
+        parsec_hash_table_nolock_insert(hash_table, &tile->ht_item);
+        parsec_hash_table_unlock_bucket(hash_table, (parsec_key_t)key);
     }
+  tile_found:
     assert(tile->flushed == NOT_FLUSHED);
 #if defined(PARSEC_DEBUG_PARANOID)
     assert(tile->super.super.obj_reference_count > 0);
@@ -1414,6 +1468,17 @@ parsec_dtd_taskpool_new(void)
     __tp->local_task_inserted = 0;
     __tp->enqueue_flag = 0;
     __tp->new_tile_keys = 0;
+    __tp->window_adaptive = parsec_dtd_window_adaptive;
+    if( __tp->window_adaptive ) {
+        /* start small, the window grows if the workers starve */
+        __tp->task_window_size = (parsec_dtd_window_min_size < parsec_dtd_window_size) ?
+                                 parsec_dtd_window_min_size : parsec_dtd_window_size;
+        if( __tp->task_window_size < 2 ) __tp->task_window_size = 2;
+    }
+    __tp->window_next_check = 0;
+    __tp->task_size = 0;
+    __tp->recording = NULL;
+    parsec_atomic_lock_init(&__tp->task_class_lock);
 
     (void)parsec_taskpool_reserve_id((parsec_taskpool_t *)__tp);
     if( 0 > asprintf(&__tp->super.taskpool_name, "DTD Taskpool %d",
@@ -1629,6 +1694,7 @@ dtd_release_dep_fct(parsec_execution_stream_t *es,
                     parsec_list_item_ring_push_sorted((parsec_list_item_t *)arg->ready_lists[dst_vpid],
                                                       &current_task->super.super,
                                                       parsec_execution_context_priority_comparator);
+            arg->ready_counts[dst_vpid]++;
             return PARSEC_ITERATE_CONTINUE; /* Returns the status of the task being activated */
         } else {
             return PARSEC_ITERATE_STOP;
@@ -1709,9 +1775,12 @@ parsec_dtd_release_deps(parsec_execution_stream_t *es,
     arg.output_usage = 0;
     arg.output_entry = NULL;
     arg.ready_lists = alloca(sizeof(parsec_task_t *) * es->virtual_process->parsec_context->nb_vp);
+    arg.ready_counts = alloca(sizeof(int32_t) * es->virtual_process->parsec_context->nb_vp);
 
-    for( __vp_id = 0; __vp_id < es->virtual_process->parsec_context->nb_vp; __vp_id++ )
+    for( __vp_id = 0; __vp_id < es->virtual_process->parsec_context->nb_vp; __vp_id++ ) {
         arg.ready_lists[__vp_id] = NULL;
+        arg.ready_counts[__vp_id] = 0;
+    }
 
     parsec_dtd_task_t *this_dtd_task = NULL;
     const parsec_task_class_t *tc = this_task->task_class;
@@ -1774,7 +1843,7 @@ parsec_dtd_release_deps(parsec_execution_stream_t *es,
 
     /* Scheduling tasks */
     if( action_mask & PARSEC_ACTION_RELEASE_LOCAL_DEPS ) {
-        __parsec_schedule_vp(es, arg.ready_lists, 0);
+        __parsec_schedule_vp_chains(es, arg.ready_lists, arg.ready_counts, 0);
     }
 
     PARSEC_PINS(es, RELEASE_DEPS_END, this_task);
@@ -2488,9 +2557,16 @@ parsec_dtd_set_flow_in_function(parsec_dtd_taskpool_t *dtd_tp,
         flow->flow_flags = PARSEC_FLOW_ACCESS_RW;
     }
 
+    /* The first tasks of a class can be inserted concurrently: only one flow is kept */
     parsec_flow_t **in = (parsec_flow_t **)&(this_task->super.task_class->in[flow_index]);
-    *in = flow;
-    parsec_flow_t **out = (parsec_flow_t **)&(this_task->super.task_class->out[flow_index]);
+    parsec_flow_t * volatile *out = (parsec_flow_t * volatile *)&(this_task->super.task_class->out[flow_index]);
+    if( !parsec_atomic_cas_ptr(in, NULL, flow) ) {
+        free(flow);
+        /* The dependencies of our task use both in and out: wait for the
+         * winner to publish out, which it does right after in */
+        while( NULL == *out ) ;
+        return;
+    }
     *out = flow;
 }
 
@@ -2630,13 +2706,15 @@ parsec_dtd_create_and_initialize_task(parsec_dtd_taskpool_t *dtd_tp,
     }
     this_task = (parsec_dtd_task_t *)parsec_thread_mempool_allocate(
             dtd_task_mempool->thread_mempools + parsec_my_execution_stream()->core_id);
+    dtd_tp->task_size = dtd_task_mempool->elt_size;
 
     assert(this_task->super.super.super.obj_reference_count == 1);
 
     PARSEC_OBJ_CONSTRUCT(&this_task->super, parsec_task_t);
     this_task->orig_task = NULL;
     this_task->super.taskpool = (parsec_taskpool_t *)dtd_tp;
-    this_task->ht_item.key = (parsec_key_t)(uintptr_t)(dtd_tp->task_id++);
+    /* Tasks can be inserted concurrently by several threads */
+    this_task->ht_item.key = (parsec_key_t)(uintptr_t)parsec_atomic_fetch_inc_int32(&dtd_tp->task_id);
     /* this is needed for grapher to work properly */
     this_task->super.locals[0].value = (int)(uintptr_t)this_task->ht_item.key;
     assert((uintptr_t)this_task->super.locals[0].value == (uintptr_t)this_task->ht_item.key);
@@ -2765,9 +2843,82 @@ parsec_dtd_schedule_task_if_ready(int satisfied_flow, parsec_dtd_task_t *this_ta
     return 0;
 }
 
+static void
+parsec_dtd_arena_bytes_used(void *item, void *cb_data)
+{
+    parsec_arena_t *arena = ((parsec_arena_datatype_t *)item)->arena;
+    /* Only the bounded arenas account for the chunks in use */
+    if( NULL != arena && 0 != arena->max_used && INT32_MAX != arena->max_used ) {
+        *(size_t *)cb_data += (size_t)arena->used * arena->elem_size;
+    }
+}
+
+/* **************************************************************************** */
+/**
+ * Adaptive control of the window of task insertion
+ *
+ * Every quarter of a window, the pending local tasks are compared to the
+ * window: while they fit, the inserting thread goes on. Otherwise it executes
+ * tasks until half of the window has drained, and the window is resized from
+ * what it saw meanwhile: if the scheduler had no ready task for it at some
+ * point, the pending tasks are mostly waiting on their predecessors and the
+ * window doubles to expose more parallelism; if a ready task was always
+ * available, the window shrinks by a quarter to hold less memory. The window
+ * is also halved when the memory held by the pending tasks and the bounded
+ * arenas exceeds dtd_window_max_memory.
+ *
+ * @return          1 if the inserting thread blocked, 0 otherwise
+ *
+ * @ingroup         DTD_INTERFACE_INTERNAL
+ */
+static int
+parsec_dtd_adapt_window(parsec_dtd_taskpool_t *dtd_tp)
+{
+    int window = dtd_tp->task_window_size, nb_tasks, empty_selects;
+    int min_window = (parsec_dtd_window_min_size < parsec_dtd_window_size) ?
+                     parsec_dtd_window_min_size : parsec_dtd_window_size;
+
+    if( (int32_t)(dtd_tp->local_task_inserted - dtd_tp->window_next_check) < 0 )
+        return 0;
+    dtd_tp->window_next_check = dtd_tp->local_task_inserted + (window / 4 > 1 ? window / 4 : 1);
+
+    nb_tasks = dtd_tp->super.nb_tasks;
+    if( 0 != parsec_dtd_window_max_memory ) {
+        size_t bytes = (size_t)nb_tasks * dtd_tp->task_size;
+        parsec_hash_table_for_all(&dtd_tp->super.context->dtd_arena_datatypes_hash_table,
+                                  parsec_dtd_arena_bytes_used, &bytes);
+        if( bytes > ((size_t)parsec_dtd_window_max_memory << 20) ) {
+            window /= 2;
+            if( window < min_window ) window = min_window;
+            if( window < 2 ) window = 2;
+            dtd_tp->task_window_size = window;
+        }
+    }
+    if( nb_tasks < window )
+        return 0;
+
+    empty_selects = parsec_execute_and_come_back(&dtd_tp->super, window / 2);
+    if( 0 != empty_selects ) {
+        window *= 2;
+    } else {
+        window -= window / 4;
+    }
+    if( window > parsec_dtd_window_size ) window = parsec_dtd_window_size;
+    if( window < min_window ) window = min_window;
+    if( window < 2 ) window = 2;
+    PARSEC_DEBUG_VERBOSE(parsec_dtd_dump_traversal_info, parsec_dtd_debug_output,
+                         "DTD window of taskpool %d: %d -> %d tasks (%d empty selects)",
+                         dtd_tp->super.taskpool_id, dtd_tp->task_window_size, window, empty_selects);
+    dtd_tp->task_window_size = window;
+    return 1; /* Indicating we blocked */
+}
+
 int
 parsec_dtd_block_if_threshold_reached(parsec_dtd_taskpool_t *dtd_tp, int task_threshold)
 {
+    if( dtd_tp->window_adaptive ) {
+        return parsec_dtd_adapt_window(dtd_tp);
+    }
     if((dtd_tp->local_task_inserted % dtd_tp->task_window_size) == 0 ) {
         if( dtd_tp->task_window_size < parsec_dtd_window_size ) {
             dtd_tp->task_window_size *= 2;
@@ -2780,26 +2931,26 @@ parsec_dtd_block_if_threshold_reached(parsec_dtd_taskpool_t *dtd_tp, int task_th
     return 0;
 }
 
+static void
+parsec_dtd_insert_one_task(parsec_dtd_task_t *this_task, int may_block);
+
 /* **************************************************************************** */
 /**
- * Function to insert dtd task in PaRSEC
+ * Function to resolve the dependencies of a dtd task
  *
- * In this function we track all the dependencies and create the DAG
+ * Links the task with the previous users of its data, and returns the number
+ * of flows already satisfied. The task is neither accounted for in the
+ * taskpool, nor scheduled. The tasks inserted on its behalf to read the data
+ * from memory only throttle the inserting thread if may_block is set.
  *
  */
-void
-parsec_insert_dtd_task(parsec_task_t *__this_task)
+static int
+parsec_dtd_link_task(parsec_dtd_task_t *this_task, int may_block)
 {
-    if( PARSEC_TASKPOOL_TYPE_DTD != __this_task->taskpool->taskpool_type ) {
-        parsec_fatal("Error! Taskpool is of incorrect type\n");
-    }
-
-    parsec_dtd_task_t *this_task = (parsec_dtd_task_t *)__this_task;
     const parsec_task_class_t *tc = this_task->super.task_class;
     parsec_dtd_taskpool_t *dtd_tp = (parsec_dtd_taskpool_t *)this_task->super.taskpool;
 
     int flow_index, satisfied_flow = 0, tile_op_type = 0, put_in_chain = 1;
-    static int vpid = 0;
     parsec_dtd_tile_t *tile = NULL;
 
     /* Retaining every remote_task */
@@ -2848,11 +2999,13 @@ parsec_insert_dtd_task(parsec_task_t *__this_task)
 
             /* parentless */
             /* Create Fake output_task */
-            parsec_dtd_insert_task(this_task->super.taskpool,
-                                   &fake_first_out_body, 0, PARSEC_DEV_CPU,"Fake_FIRST_OUT",
-                                   PASSED_BY_REF, tile,
-                                            PARSEC_INOUT | (tile_op_type & PARSEC_GET_REGION_INFO) | PARSEC_AFFINITY,
-                                   PARSEC_DTD_ARG_END);
+            parsec_dtd_insert_one_task((parsec_dtd_task_t *)
+                                       parsec_dtd_create_task(this_task->super.taskpool,
+                                                              &fake_first_out_body, 0, PARSEC_DEV_CPU, "Fake_FIRST_OUT",
+                                                              PASSED_BY_REF, tile,
+                                                                       PARSEC_INOUT | (tile_op_type & PARSEC_GET_REGION_INFO) | PARSEC_AFFINITY,
+                                                              PARSEC_DTD_ARG_END),
+                                       may_block);
 
             parsec_dtd_last_user_lock(&(tile->last_user));
 
@@ -3096,7 +3249,33 @@ parsec_insert_dtd_task(parsec_task_t *__this_task)
 
     dtd_tp->flow_set_flag[tc->task_class_id] = 1;
 
-    if( parsec_dtd_task_is_local(this_task) ) {/* Task is local */
+    /* Releasing every remote_task */
+    if( parsec_dtd_task_is_remote(this_task)) {
+        parsec_dtd_remote_task_release(this_task);
+    }
+
+    return satisfied_flow;
+}
+
+/* **************************************************************************** */
+/**
+ * Function to insert one dtd task
+ *
+ * The dependencies of the task are resolved, the task is accounted for in
+ * the taskpool and scheduled if it is ready. The inserting thread is then
+ * throttled, if may_block is set.
+ *
+ */
+static void
+parsec_dtd_insert_one_task(parsec_dtd_task_t *this_task, int may_block)
+{
+    parsec_dtd_taskpool_t *dtd_tp = (parsec_dtd_taskpool_t *)this_task->super.taskpool;
+    int satisfied_flow, is_local = parsec_dtd_task_is_local(this_task);
+    static int vpid = 0;
+
+    satisfied_flow = parsec_dtd_link_task(this_task, may_block);
+
+    if( is_local ) {/* Task is local */
         dtd_tp->super.tdm.module->taskpool_addto_nb_tasks(&dtd_tp->super, 1);
         dtd_tp->local_task_inserted++;
         PARSEC_DEBUG_VERBOSE(parsec_dtd_dump_traversal_info, parsec_dtd_debug_output,
@@ -3104,11 +3283,6 @@ parsec_insert_dtd_task(parsec_task_t *__this_task)
                              this_task->ht_item.key, this_task->rank);
     }
 
-    /* Releasing every remote_task */
-    if( parsec_dtd_task_is_remote(this_task)) {
-        parsec_dtd_remote_task_release(this_task);
-    }
-
     /* Increase the count of satisfied flows to counter-balance the increase in the
      * number of expected flows done during the task creation.  */
     satisfied_flow++;
@@ -3118,27 +3292,550 @@ parsec_insert_dtd_task(parsec_task_t *__this_task)
         parsec_profiling_ts_trace_flags_info_fn(insert_task_trace_keyout, 0, dtd_tp->super.taskpool_id, NULL, NULL, 0);
 #endif
 
-    if( parsec_dtd_task_is_local(this_task)) {
+    if( is_local ) {
         parsec_dtd_schedule_task_if_ready(satisfied_flow, this_task,
                                           dtd_tp, &vpid);
     }
 
-    parsec_dtd_block_if_threshold_reached(dtd_tp, parsec_dtd_threshold_size);
+    if( may_block ) {
+        parsec_dtd_block_if_threshold_reached(dtd_tp, parsec_dtd_threshold_size);
+    }
+}
+
+/* **************************************************************************** */
+/**
+ * Function to insert dtd task in PaRSEC
+ *
+ * In this function we track all the dependencies and create the DAG
+ *
+ */
+void
+parsec_insert_dtd_task(parsec_task_t *__this_task)
+{
+    if( PARSEC_TASKPOOL_TYPE_DTD != __this_task->taskpool->taskpool_type ) {
+        parsec_fatal("Error! Taskpool is of incorrect type\n");
+    }
+    parsec_dtd_insert_one_task((parsec_dtd_task_t *)__this_task, 1);
+}
+
+/* **************************************************************************** */
+/**
+ * Function to find the rank a dtd task is placed on, from its parameters
+ *
+ * The values are the tiles of the data parameters, and the addresses of the
+ * others. Also returns the number of tracked data the task writes, plus one.
+ *
+ */
+static int
+parsec_dtd_rank_of_params(parsec_dtd_taskpool_t *dtd_tp, int nb_params,
+                          const parsec_dtd_param_t *params, void * const *values,
+                          int *write_flow_count)
+{
+    int p, tile_op_type, rank = -1;
+
+    *write_flow_count = 1;
+    for( p = 0; p < nb_params; p++ ) {
+        tile_op_type = (int)params[p].op;
+
+        /* Check for affinity to get rank */
+        if((tile_op_type & PARSEC_AFFINITY)) {
+            if( rank == -1 ) {
+                if((tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_INPUT ||
+                   (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_INOUT ||
+                   (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_OUTPUT ) {
+                    rank = ((parsec_dtd_tile_t *)values[p])->rank;
+                } else if((tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_VALUE ) {
+                    rank = *(int *)values[p];
+                    /* Warn user if rank passed is negative or
+                     * more than total no of mpi process.
+                     */
+                    if( rank < 0 || rank >= dtd_tp->super.context->nb_nodes ) {
+                        parsec_warning("/!\\ Rank information passed to task is invalid,"
+                                       " placing task in rank 0 /!\\\n");
+                    }
+                }
+            } else {
+                parsec_warning("/!\\ Task is already placed, only the first use of AFFINITY flag is effective, others "
+                               "are ignored /!\\\n");
+            }
+        }
+
+        if( NULL != values[p] && !(tile_op_type & PARSEC_DONT_TRACK) &&
+            (PARSEC_INOUT == (tile_op_type & PARSEC_GET_OP_TYPE) ||
+             PARSEC_OUTPUT == (tile_op_type & PARSEC_GET_OP_TYPE)) ) {
+            (*write_flow_count)++;
+        }
+    }
+
+#if defined(DISTRIBUTED)
+    /* Safeguard: check that the rank has been set by affinity if it is needed */
+    if( dtd_tp->super.context->nb_nodes > 1 ) {
+        if((-1 == rank) && (*write_flow_count > 1)) {
+            parsec_fatal("You inserted a task without indicating where the task should be executed (using\n"
+                         "PARSEC_AFFINITY flag). This will result in executing this task on all nodes and the outcome\n"
+                         "might be not be what you want. So we are exiting for now. Please see the usage of\n"
+                         "PARSEC_AFFINITY flag.\n");
+        } else if( rank == -1 && *write_flow_count == 1 ) {
+            /* we have tasks with no real data as parameter so we are safe to execute it in each process */
+            rank = dtd_tp->super.context->my_rank;
+        }
+    } else {
+        rank = 0;
+    }
+#else
+    rank = 0;
+#endif
+
+    return rank;
+}
+
+/* **************************************************************************** */
+/**
+ * Function to select the chores of a task class allowed on device_type
+ *
+ */
+static inline uint8_t
+parsec_dtd_chore_mask_of(const parsec_task_class_t *tc, int device_type)
+{
+    uint8_t chore_mask = 0;
+    /* We take only the chores that are defined and that allowed by the user */
+    for( int i = 0; NULL != tc->incarnations[i].hook; i++ ) {
+        if( tc->incarnations[i].type & device_type ) {
+            chore_mask |= (1<<i);
+        }
+    }
+    return chore_mask;
+}
+
+/* **************************************************************************** */
+/**
+ * Function to create a dtd task of a known task class from its parameters
+ *
+ * The values are the tiles of the data parameters, and the addresses of the
+ * others. The task is created on the rank computed by parsec_dtd_rank_of_params.
+ *
+ */
+static parsec_dtd_task_t *
+parsec_dtd_create_task_from_params(parsec_dtd_taskpool_t *dtd_tp, parsec_task_class_t *tc,
+                                   int rank, int32_t priority, uint8_t chore_mask,
+                                   int write_flow_count, int nb_params,
+                                   const parsec_dtd_param_t *params, void * const *values)
+{
+    parsec_dtd_task_t *this_task = parsec_dtd_create_and_initialize_task(dtd_tp, tc, rank);
+    int p, tile_op_type, flow_index = 0;
+
+    this_task->super.priority = priority;
+    this_task->super.chore_mask = chore_mask;
+    assert(0 != this_task->super.chore_mask);
+
+    /* Set the parameters in the newly created task */
+    if( parsec_dtd_task_is_local(this_task)) {
+        parsec_object_t *object = (parsec_object_t *)this_task;
+        /* retaining the local task as many write flows as
+         * it has and one to indicate when we have executed the task */
+        (void)parsec_atomic_fetch_add_int32(&object->obj_reference_count, write_flow_count);
+
+        parsec_dtd_task_param_t *head_of_param_list = GET_HEAD_OF_PARAM_LIST(this_task);
+        parsec_dtd_task_param_t *current_param = head_of_param_list;
+        /* Getting the pointer to allocated memory by mempool */
+        void *current_val =
+                GET_VALUE_BLOCK(head_of_param_list, ((parsec_dtd_task_class_t *)tc)->count_of_params);
+
+        for( p = 0; p < nb_params; p++ ) {
+            parsec_dtd_set_params_of_task(this_task, values[p], (int)params[p].op,
+                                          &flow_index, &current_val,
+                                          current_param, (int)params[p].size);
+
+            current_param->arg_size = (int)params[p].size;
+            current_param->op_type = params[p].op;
+            current_param = current_param + 1;
+        }
+    } else {
+        for( p = 0; p < nb_params; p++ ) {
+            tile_op_type = (int)params[p].op;
+            if((tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_INPUT ||
+               (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_INOUT ||
+               (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_OUTPUT ) {
+                parsec_dtd_set_params_of_task(this_task, values[p], tile_op_type,
+                                              &flow_index, NULL,
+                                              NULL, (int)params[p].size);
+            }
+        }
+    }
+
+#if defined(DISTRIBUTED)
+    assert(this_task->rank != -1);
+#endif
+
+    return this_task;
+}
+
+/* **************************************************************************** */
+/**
+ * Recorded DTD graphs
+ *
+ * A graph keeps, for each task inserted while it is recorded, its task
+ * class (retained until the graph is freed), priority, chores and
+ * parameters: the collection and key of the data, a copy of the values, and
+ * the addresses of the scratches and references. It also keeps the edges
+ * between the tasks: for each data, the previous access to the same data in
+ * the graph, if any.
+ *
+ * Replaying the graph inserts the same tasks again without parsing their
+ * arguments or looking their task class up. Only the first access of the
+ * graph to each data looks its tile up, the other accesses take the tile of
+ * their predecessor in this replay (a recorded tile may have been flushed
+ * since, and its memory returned to the tile mempool). The tasks are still
+ * linked through the last user of their tiles: this is the handshake with
+ * the predecessors that complete meanwhile.
+ *
+ */
+typedef struct parsec_dtd_graph_task_s {
+    parsec_task_class_t *tc;
+    int32_t              priority;
+    uint8_t              chore_mask;
+    int                  nb_params;
+    int                  first_param;  /* index of the first parameter in the graph */
+} parsec_dtd_graph_task_t;
+
+typedef struct parsec_dtd_graph_value_s {
+    void                     *ptr;     /* the address of a scratch or a reference (the tile of
+                                        * a data while the graph is recorded) */
+    parsec_data_collection_t *dc;      /* the collection and key of a data */
+    parsec_data_key_t         key;
+    int                       pred;    /* the previous access to the data in the graph (the
+                                        * index of its parameter, in the same task or in a
+                                        * previous one), or -1 */
+    size_t                    offset;  /* the copy of a value in values_storage */
+} parsec_dtd_graph_value_t;
+
+struct parsec_dtd_graph_s {
+    parsec_dtd_taskpool_t    *tp;      /* the taskpool the graph was recorded in */
+    int                       nb_tasks;
+    int                       max_tasks;
+    parsec_dtd_graph_task_t  *tasks;
+    int                       nb_params;
+    int                       max_params;
+    parsec_dtd_param_t       *params;
+    parsec_dtd_graph_value_t *values;
+    parsec_dtd_tile_t       **tiles;   /* the tile of each data during a replay */
+    size_t                    values_size;
+    size_t                    max_values_size;
+    char                     *values_storage;
+    int                       nb_tcs;  /* the task classes retained by the graph */
+    int                       max_tcs;
+    parsec_task_class_t     **tcs;
+    int                       last_access_mask;  /* while recording: open addressing table of */
+    int                       nb_last_accesses;  /* the last access to each tile, -1 if empty */
+    int                      *last_access;
+};
+
+static inline int
+parsec_dtd_op_is_data(int tile_op_type)
+{
+    return (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_INPUT ||
+           (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_OUTPUT ||
+           (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_INOUT ||
+           (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_ATOMIC_WRITE;
+}
+
+/**
+ * Take a reference on a task class the graph uses, once per graph
+ */
+static void
+parsec_dtd_graph_retain_task_class(parsec_dtd_graph_t *graph, parsec_task_class_t *tc)
+{
+    int i;
+
+    /* the tasks of a class are often recorded in a row */
+    for( i = graph->nb_tcs - 1; i >= 0; i-- ) {
+        if( graph->tcs[i] == tc )
+            return;
+    }
+    if( graph->nb_tcs == graph->max_tcs ) {
+        graph->max_tcs = (0 == graph->max_tcs) ? 8 : 2 * graph->max_tcs;
+        graph->tcs = (parsec_task_class_t **)realloc(graph->tcs, graph->max_tcs * sizeof(parsec_task_class_t *));
+    }
+    graph->tcs[graph->nb_tcs++] = tc;
+    (void)parsec_atomic_fetch_inc_int32(&((parsec_dtd_task_class_t *)tc)->ref_count);
+}
+
+static void
+parsec_dtd_graph_release_task_classes(parsec_dtd_graph_t *graph)
+{
+    int i;
+
+    for( i = 0; i < graph->nb_tcs; i++ ) {
+        parsec_dtd_task_class_release(&graph->tp->super, graph->tcs[i]);
+    }
+    graph->nb_tcs = 0;
+}
+
+static inline int
+parsec_dtd_graph_access_slot(const parsec_dtd_graph_t *graph, const void *tile)
+{
+    return (int)(((uint64_t)(uintptr_t)tile * 0x9E3779B97F4A7C15ULL) >> 40) & graph->last_access_mask;
+}
+
+/**
+ * Record the access of the parameter idx to its tile, and return the index of
+ * the previous access of the graph to the same tile, or -1. The tiles are only
+ * compared, a tile flushed and reused for another data is told apart by its
+ * collection and key.
+ */
+static int
+parsec_dtd_graph_record_access(parsec_dtd_graph_t *graph, int idx)
+{
+    const parsec_dtd_graph_value_t *value = &graph->values[idx], *last;
+    int slot, pred;
+
+    if( 2 * (graph->nb_last_accesses + 1) > graph->last_access_mask + 1 ) {
+        /* keep the table at most half full */
+        int *old = graph->last_access, old_size = graph->last_access_mask + 1, i;
+        int size = (NULL == old) ? 256 : 2 * old_size;
+        graph->last_access = (int *)malloc(size * sizeof(int));
+        graph->last_access_mask = size - 1;
+        for( i = 0; i < size; i++ ) graph->last_access[i] = -1;
+        for( i = 0; (NULL != old) && (i < old_size); i++ ) {
+            if( -1 == old[i] ) continue;
+            slot = parsec_dtd_graph_access_slot(graph, graph->values[old[i]].ptr);
+            while( -1 != graph->last_access[slot] ) slot = (slot + 1) & graph->last_access_mask;
+            graph->last_access[slot] = old[i];
+        }
+        free(old);
+    }
+
+    for( slot = parsec_dtd_graph_access_slot(graph, value->ptr);
+         -1 != (pred = graph->last_access[slot]);
+         slot = (slot + 1) & graph->last_access_mask ) {
+        last = &graph->values[pred];
+        if( last->ptr != value->ptr )
+            continue;
+        graph->last_access[slot] = idx;
+        return (last->dc == value->dc && last->key == value->key) ? pred : -1;
+    }
+    graph->last_access[slot] = idx;
+    graph->nb_last_accesses++;
+    return -1;
+}
+
+/**
+ * Append a task, about to be inserted, to the graph being recorded
+ */
+static void
+parsec_dtd_graph_record_task(parsec_dtd_graph_t *graph, parsec_task_class_t *tc,
+                             int32_t priority, uint8_t chore_mask, int nb_params,
+                             const parsec_dtd_param_t *params, void * const *values)
+{
+    parsec_dtd_graph_task_t *task;
+    parsec_dtd_graph_value_t *value;
+    int p, tile_op_type;
+
+    if( graph->nb_tasks == graph->max_tasks ) {
+        graph->max_tasks = (0 == graph->max_tasks) ? 64 : 2 * graph->max_tasks;
+        graph->tasks = (parsec_dtd_graph_task_t *)realloc(graph->tasks,
+                                                          graph->max_tasks * sizeof(parsec_dtd_graph_task_t));
+    }
+    if( graph->nb_params + nb_params > graph->max_params ) {
+        while( graph->nb_params + nb_params > graph->max_params )
+            graph->max_params = (0 == graph->max_params) ? 256 : 2 * graph->max_params;
+        graph->params = (parsec_dtd_param_t *)realloc(graph->params,
+                                                      graph->max_params * sizeof(parsec_dtd_param_t));
+        graph->values = (parsec_dtd_graph_value_t *)realloc(graph->values,
+                                                            graph->max_params * sizeof(parsec_dtd_graph_value_t));
+        graph->tiles = (parsec_dtd_tile_t **)realloc(graph->tiles,
+                                                     graph->max_params * sizeof(parsec_dtd_tile_t *));
+    }
+
+    parsec_dtd_graph_retain_task_class(graph, tc);
+    task = &graph->tasks[graph->nb_tasks++];
+    task->tc = tc;
+    task->priority = priority;
+    task->chore_mask = chore_mask;
+    task->nb_params = nb_params;
+    task->first_param = graph->nb_params;
+
+    for( p = 0; p < nb_params; p++ ) {
+        tile_op_type = (int)params[p].op;
+        graph->params[graph->nb_params] = params[p];
+        value = &graph->values[graph->nb_params++];
+        value->ptr = values[p];
+        value->dc = NULL;
+        value->key = 0;
+        value->pred = -1;
+        value->offset = 0;
+        if( parsec_dtd_op_is_data(tile_op_type) ) {
+            if( NULL != values[p] ) {
+                /* the tile is only kept until the end of the recording, it
+                 * may be released once flushed */
+                value->dc = ((parsec_dtd_tile_t *)values[p])->dc;
+                value->key = ((parsec_dtd_tile_t *)values[p])->key;
+                value->pred = parsec_dtd_graph_record_access(graph, graph->nb_params - 1);
+            }
+        } else if( (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_VALUE ) {
+            /* the value may change once the task is inserted: keep a copy */
+            size_t size = (size_t)params[p].size;
+            if( graph->values_size + size > graph->max_values_size ) {
+                while( graph->values_size + size > graph->max_values_size )
+                    graph->max_values_size = (0 == graph->max_values_size) ? 1024 : 2 * graph->max_values_size;
+                graph->values_storage = (char *)realloc(graph->values_storage, graph->max_values_size);
+            }
+            value->offset = graph->values_size;
+            memcpy(graph->values_storage + value->offset, values[p], size);
+            graph->values_size += size;
+        }
+    }
+}
+
+parsec_dtd_graph_t *
+parsec_dtd_graph_new(void)
+{
+    parsec_dtd_graph_t *graph = (parsec_dtd_graph_t *)calloc(1, sizeof(parsec_dtd_graph_t));
+    graph->last_access_mask = -1;
+    return graph;
+}
+
+void
+parsec_dtd_graph_free(parsec_dtd_graph_t *graph)
+{
+    if( NULL == graph )
+        return;
+    parsec_dtd_graph_release_task_classes(graph);
+    free(graph->tasks);
+    free(graph->params);
+    free(graph->values);
+    free(graph->tiles);
+    free(graph->values_storage);
+    free(graph->tcs);
+    free(graph->last_access);
+    free(graph);
+}
+
+int
+parsec_dtd_graph_nb_tasks(const parsec_dtd_graph_t *graph)
+{
+    return graph->nb_tasks;
+}
+
+int
+parsec_dtd_graph_record_start(parsec_taskpool_t *tp, parsec_dtd_graph_t *graph)
+{
+    parsec_dtd_taskpool_t *dtd_tp = (parsec_dtd_taskpool_t *)tp;
+
+    if( PARSEC_TASKPOOL_TYPE_DTD != tp->taskpool_type ) {
+        parsec_warning("Called parsec_dtd_graph_record_start on a non-DTD taskpool '%s'\n",
+                       tp->taskpool_name);
+        return PARSEC_ERR_BAD_PARAM;
+    }
+    if( NULL != dtd_tp->recording ) {
+        parsec_warning("A graph is already being recorded in taskpool '%s'\n", tp->taskpool_name);
+        return PARSEC_ERROR;
+    }
+    /* a graph records the tasks of a single taskpool, from scratch */
+    if( NULL != graph->tp )
+        parsec_dtd_graph_release_task_classes(graph);
+    graph->tp = dtd_tp;
+    graph->nb_tasks = 0;
+    graph->nb_params = 0;
+    graph->values_size = 0;
+    dtd_tp->recording = graph;
+    return PARSEC_SUCCESS;
+}
+
+int
+parsec_dtd_graph_record_stop(parsec_taskpool_t *tp)
+{
+    parsec_dtd_taskpool_t *dtd_tp = (parsec_dtd_taskpool_t *)tp;
+    parsec_dtd_graph_t *graph;
+    int p;
+
+    if( PARSEC_TASKPOOL_TYPE_DTD != tp->taskpool_type || NULL == dtd_tp->recording ) {
+        parsec_warning("No graph is being recorded in taskpool '%s'\n", tp->taskpool_name);
+        return PARSEC_ERR_BAD_PARAM;
+    }
+    graph = dtd_tp->recording;
+    dtd_tp->recording = NULL;
+    /* Only the edges are kept: a recorded tile may be released once flushed */
+    for( p = 0; p < graph->nb_params; p++ ) {
+        if( NULL != graph->values[p].dc )
+            graph->values[p].ptr = NULL;
+    }
+    free(graph->last_access);
+    graph->last_access = NULL;
+    graph->last_access_mask = -1;
+    graph->nb_last_accesses = 0;
+    return PARSEC_SUCCESS;
+}
+
+int
+parsec_dtd_graph_replay(parsec_taskpool_t *tp, parsec_dtd_graph_t *graph,
+                        parsec_dtd_graph_update_t *update, void *cb_data)
+{
+    parsec_dtd_taskpool_t *dtd_tp = (parsec_dtd_taskpool_t *)tp;
+    void *values[PARSEC_DTD_MAX_PARAMS];
+    parsec_dtd_graph_task_t *task;
+    parsec_dtd_graph_value_t *value;
+    const parsec_dtd_param_t *params;
+    int t, p, rank, write_flow_count;
+
+    if( graph->tp != dtd_tp ) {
+        parsec_warning("The graph was not recorded in taskpool '%s'\n", tp->taskpool_name);
+        return PARSEC_ERR_BAD_PARAM;
+    }
+    if( dtd_tp->recording == graph ) {
+        parsec_warning("The graph is still being recorded in taskpool '%s'\n", tp->taskpool_name);
+        return PARSEC_ERROR;
+    }
+
+    for( t = 0; t < graph->nb_tasks; t++ ) {
+        task = &graph->tasks[t];
+        params = &graph->params[task->first_param];
+
+#if defined(PARSEC_PROF_TRACE)
+        if( parsec_dtd_profile_verbose )
+            parsec_profiling_ts_trace_flags_info_fn(insert_task_trace_keyin, 0, dtd_tp->super.taskpool_id, NULL, NULL, 0);
+#endif
+        for( p = 0; p < task->nb_params; p++ ) {
+            value = &graph->values[task->first_param + p];
+            if( (params[p].op & PARSEC_GET_OP_TYPE) == PARSEC_VALUE ) {
+                values[p] = graph->values_storage + value->offset;
+                continue;
+            }
+            if( NULL == value->dc ) {
+                values[p] = value->ptr;
+                continue;
+            }
+            /* Follow the edge to the previous access, replayed before this one */
+            graph->tiles[task->first_param + p] = (-1 == value->pred) ?
+                parsec_dtd_tile_of(value->dc, value->key) : graph->tiles[value->pred];
+            values[p] = graph->tiles[task->first_param + p];
+        }
+        if( NULL != update ) {
+            update(t, task->nb_params, values, cb_data);
+        }
+
+        rank = parsec_dtd_rank_of_params(dtd_tp, task->nb_params, params, values, &write_flow_count);
+        parsec_dtd_insert_one_task(parsec_dtd_create_task_from_params(dtd_tp, task->tc, rank, task->priority,
+                                                                      task->chore_mask, write_flow_count,
+                                                                      task->nb_params, params, values), 1);
+    }
+    return PARSEC_SUCCESS;
 }
 
 static inline parsec_task_t *
 __parsec_dtd_taskpool_create_task(parsec_taskpool_t *tp,
                                   void *fpointer, int32_t priority, uint8_t device_type,
-                                  const char *name_of_kernel, parsec_task_class_t *tc, va_list args)
+                                  const char *name_of_kernel, parsec_task_class_t *tc, int record,
+                                  va_list args)
 {
     parsec_dtd_taskpool_t *dtd_tp = (parsec_dtd_taskpool_t *)tp;
-    int rank = -1;
-    int write_flow_count = 1;
+    int rank, write_flow_count;
     int flow_count_of_tc = 0;
-    int flow_index = 0;
     parsec_dtd_task_class_t *dtd_tc = (parsec_dtd_task_class_t*)tc;
     int nb_params = 0;
     parsec_dtd_param_t params[PARSEC_DTD_MAX_PARAMS];
+    void *values[PARSEC_DTD_MAX_PARAMS];
+    uint8_t chore_mask;
 
     if( dtd_tp == NULL) {
         parsec_fatal("You need to pass a correct parsec taskpool in order to insert task. "
@@ -3157,17 +3854,14 @@ __parsec_dtd_taskpool_create_task(parsec_taskpool_t *tp,
         parsec_profiling_ts_trace_flags_info_fn(insert_task_trace_keyin, 0, dtd_tp->super.taskpool_id, NULL, NULL, 0);
 #endif
 
-    /* We parse arguments a first time (mostly skipping the tile),
-     * to compute how the task needs to be created */
+    /* We parse the arguments once, to collect the parameters of the task */
     int first_arg, tile_op_type, arg_size;
     void *tile;
-    va_list arg_chk;
-    va_copy(arg_chk, args);
-    while( PARSEC_DTD_ARG_END != (first_arg = va_arg(arg_chk, int))) {
-        tile = va_arg(arg_chk, void *);
+    while( PARSEC_DTD_ARG_END != (first_arg = va_arg(args, int))) {
+        tile = va_arg(args, void *);
         if(NULL != fpointer) {
             assert(NULL == tc);
-            tile_op_type = va_arg(arg_chk, int);
+            tile_op_type = va_arg(args, int);
             arg_size = first_arg;
             if( (NULL == tc) && (tile_op_type & PARSEC_PROFILE_INFO) ) {
                 parsec_fatal("Argument %d of DTD task '%s' tries to define a PROFILE_INFO without providing a task class.\n",
@@ -3179,41 +3873,10 @@ __parsec_dtd_taskpool_create_task(parsec_taskpool_t *tp,
             arg_size = (int)dtd_tc->params[nb_params].size;
         }
 
-        /* Check for affinity to get rank */
-        if((tile_op_type & PARSEC_AFFINITY)) {
-            if( rank == -1 ) {
-                if((tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_INPUT ||
-                   (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_INOUT ||
-                   (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_OUTPUT ) {
-                    rank = ((parsec_dtd_tile_t *)tile)->rank;
-                } else if((tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_VALUE ) {
-                    rank = *(int *)tile;
-                    /* Warn user if rank passed is negative or
-                     * more than total no of mpi process.
-                     */
-                    if( rank < 0 || rank >= dtd_tp->super.context->nb_nodes ) {
-                        parsec_warning("/!\\ Rank information passed to task is invalid,"
-                                       " placing task in rank 0 /!\\\n");
-                    }
-                }
-            } else {
-                parsec_warning("/!\\ Task is already placed, only the first use of AFFINITY flag is effective, others "
-                               "are ignored /!\\\n");
-            }
-        }
-
         if((tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_INPUT ||
            (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_INOUT ||
            (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_OUTPUT ) {
             flow_count_of_tc++;
-            if( NULL != tile ) {
-                if( !(tile_op_type & PARSEC_DONT_TRACK)) {
-                    if( PARSEC_INOUT == (tile_op_type & PARSEC_GET_OP_TYPE) ||
-                        PARSEC_OUTPUT == (tile_op_type & PARSEC_GET_OP_TYPE)) {
-                        write_flow_count++;
-                    }
-                }
-            }
         }
 
         params[nb_params].op = tile_op_type;
@@ -3227,28 +3890,11 @@ __parsec_dtd_taskpool_create_task(parsec_taskpool_t *tp,
             params[nb_params].profile_info = dtd_tc->params[nb_params].profile_info;
         }
         params[nb_params].size = arg_size;
+        values[nb_params] = tile;
         nb_params++;
     }
-    va_end(arg_chk);
 
-#if defined(DISTRIBUTED)
-    /* Safeguard: check that the rank has been set by affinity if it is needed */
-    if( tp->context->nb_nodes > 1 ) {
-        if((-1 == rank) && (write_flow_count > 1)) {
-            parsec_fatal("You inserted a task without indicating where the task should be executed (using\n"
-                         "PARSEC_AFFINITY flag). This will result in executing this task on all nodes and the outcome\n"
-                         "might be not be what you want. So we are exiting for now. Please see the usage of\n"
-                         "PARSEC_AFFINITY flag.\n");
-        } else if( rank == -1 && write_flow_count == 1 ) {
-            /* we have tasks with no real data as parameter so we are safe to execute it in each process */
-            rank = tp->context->my_rank;
-        }
-    } else {
-        rank = 0;
-    }
-#else
-    rank = 0;
-#endif
+    rank = parsec_dtd_rank_of_params(dtd_tp, nb_params, params, values, &write_flow_count);
 
     if(NULL != fpointer) {
         uint64_t fkey = (uint64_t)(uintptr_t)fpointer + flow_count_of_tc;
@@ -3256,6 +3902,14 @@ __parsec_dtd_taskpool_create_task(parsec_taskpool_t *tp,
         /* Hash table lookup to check if the function structure exists or not */
         tc = (parsec_task_class_t *)parsec_dtd_find_task_class(dtd_tp, fkey);
 
+        if( NULL == tc ) {
+            /* Another inserting thread might be creating the same task class */
+            parsec_atomic_lock(&dtd_tp->task_class_lock);
+            tc = (parsec_task_class_t *)parsec_dtd_find_task_class(dtd_tp, fkey);
+            if( NULL != tc ) {
+                parsec_atomic_unlock(&dtd_tp->task_class_lock);
+            }
+        }
         if( NULL == tc ) {
             dtd_tc = parsec_dtd_create_task_classv(name_of_kernel, nb_params, params);
             tc = &dtd_tc->super;
@@ -3275,92 +3929,23 @@ __parsec_dtd_taskpool_create_task(parsec_taskpool_t *tp,
             (*incarnations)[1].type = PARSEC_DEV_NONE;
 
             /* Bookkeeping of the task class */
-            parsec_dtd_register_task_class(&dtd_tp->super, fkey, tc);
             parsec_dtd_insert_task_class(dtd_tp, dtd_tc);
+            parsec_dtd_register_task_class(&dtd_tp->super, fkey, tc);
+            parsec_atomic_unlock(&dtd_tp->task_class_lock);
         }
-    }
-
-    parsec_dtd_task_t *this_task = parsec_dtd_create_and_initialize_task(dtd_tp, tc, rank);
-
-    this_task->super.priority = priority;
-
-    if( NULL == fpointer ) {
-        this_task->super.chore_mask = 0;
-        /* We take only the chores that are defined and that allowed by the user */
-        for( int i = 0; NULL != tc->incarnations[i].hook; i++ ) {
-            if( tc->incarnations[i].type & device_type ) {
-                this_task->super.chore_mask |= (1<<i);
-            }
-        }
-    } else {
         /* the task class has a single incarnation */
-        this_task->super.chore_mask = 1;
-    }
-    assert(0 != this_task->super.chore_mask);
-
-    /* We now re-iterate over the arguments, this time to set them in
-     * the newly created task */
-    if( parsec_dtd_task_is_local(this_task)) {
-        parsec_object_t *object = (parsec_object_t *)this_task;
-        /* retaining the local task as many write flows as
-         * it has and one to indicate when we have executed the task */
-        (void)parsec_atomic_fetch_add_int32(&object->obj_reference_count, write_flow_count);
-
-        parsec_dtd_task_param_t *head_of_param_list = GET_HEAD_OF_PARAM_LIST(this_task);
-        parsec_dtd_task_param_t *current_param = head_of_param_list;
-        /* Getting the pointer to allocated memory by mempool */
-        void *current_val =
-                GET_VALUE_BLOCK(head_of_param_list, ((parsec_dtd_task_class_t *)tc)->count_of_params);
-
-        nb_params = 0;
-        while( PARSEC_DTD_ARG_END != (first_arg = va_arg(args, int))) {
-            tile = va_arg(args, void *);
-            if(NULL != fpointer) {
-                tile_op_type = va_arg(args, int);
-                arg_size = first_arg;
-            } else {
-                tile_op_type = first_arg | (int)dtd_tc->params[nb_params].op;
-                arg_size = (int)dtd_tc->params[nb_params].size;
-            }
-
-            parsec_dtd_set_params_of_task(this_task, tile, tile_op_type,
-                                          &flow_index, &current_val,
-                                          current_param, arg_size);
-
-            current_param->arg_size = arg_size;
-            current_param->op_type = (parsec_dtd_op_t)tile_op_type;
-            current_param = current_param + 1;
-
-            nb_params++;
-        }
+        chore_mask = 1;
     } else {
-        nb_params = 0;
-        while( PARSEC_DTD_ARG_END != (first_arg = va_arg(args, int))) {
-            tile = va_arg(args, void *);
-            if( NULL != fpointer ) {
-                tile_op_type = va_arg(args, int);
-                arg_size = first_arg;
-            } else {
-                tile_op_type = first_arg | (int)dtd_tc->params[nb_params].op;
-                arg_size = (int)dtd_tc->params[nb_params].size;
-            }
-
-            if((tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_INPUT ||
-               (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_INOUT ||
-               (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_OUTPUT ) {
-                parsec_dtd_set_params_of_task(this_task, tile, tile_op_type,
-                                              &flow_index, NULL,
-                                              NULL, arg_size);
-            }
-            nb_params++;
-        }
+        chore_mask = parsec_dtd_chore_mask_of(tc, device_type);
     }
 
-#if defined(DISTRIBUTED)
-    assert(this_task->rank != -1);
-#endif
+    if( record && NULL != dtd_tp->recording ) {
+        parsec_dtd_graph_record_task(dtd_tp->recording, tc, priority, chore_mask,
+                                     nb_params, params, values);
+    }
 
-    return (parsec_task_t *)this_task;
+    return (parsec_task_t *)parsec_dtd_create_task_from_params(dtd_tp, tc, rank, priority, chore_mask,
+                                                               write_flow_count, nb_params, params, values);
 }
 
 /* **************************************************************************** */
@@ -3401,7 +3986,7 @@ parsec_dtd_insert_task(parsec_taskpool_t *tp,
     va_start(args, name_of_kernel);
 
     parsec_task_t *this_task = __parsec_dtd_taskpool_create_task(tp, fpointer, priority, device_type,
-                                                                 name_of_kernel, NULL, args);
+                                                                 name_of_kernel, NULL, 1, args);
     va_end(args);
 
     if( NULL != this_task ) {
@@ -3421,7 +4006,7 @@ parsec_dtd_insert_task_with_task_class(parsec_taskpool_t *tp,
     va_start(args, device_type);
 
     parsec_task_t *this_task = __parsec_dtd_taskpool_create_task(tp, NULL, priority, device_type,
-                                                                 tc->name, tc, args);
+                                                                 tc->name, tc, 1, args);
     va_end(args);
 
     if( NULL != this_task ) {
@@ -3431,6 +4016,140 @@ parsec_dtd_insert_task_with_task_class(parsec_taskpool_t *tp,
     }
 }
 
+/* **************************************************************************** */
+/**
+ * Function to insert an array of tasks of the same task class in PaRSEC
+ *
+ * The parameters of the tasks are taken from the task class, instead of
+ * being parsed for each task: the tasks are created, linked with their
+ * predecessors, accounted for in the taskpool and scheduled by chunks that
+ * end with the current insertion window, and the inserting thread is only
+ * throttled between two chunks.
+ *
+ * @param[in,out]   tp
+ *                      DTD taskpool
+ * @param[in]       tc
+ *                      The task class of all the tasks
+ * @param[in]       device_type
+ *                      The devices the tasks can be executed on
+ * @param[in]       nb_tasks
+ *                      The number of tasks to insert
+ * @param[in]       priorities
+ *                      The priority of each task, NULL for 0
+ * @param[in]       flags
+ *                      Flags (e.g. PARSEC_AFFINITY) added to the access mode of
+ *                      each parameter of the task class for all the tasks, NULL for none
+ * @param[in]       args
+ *                      The parameters of the tasks, parameter p of task t at
+ *                      args[t * nb_params + p]: the tile of a data, the address
+ *                      of a value, a scratch or a reference
+ *
+ * @ingroup         DTD_INTERFACE
+ */
+void
+parsec_dtd_insert_tasks_with_task_class(parsec_taskpool_t *tp,
+                                        parsec_task_class_t *tc,
+                                        int device_type,
+                                        int nb_tasks,
+                                        const int *priorities,
+                                        const int *flags,
+                                        void * const *args)
+{
+    parsec_dtd_taskpool_t *dtd_tp = (parsec_dtd_taskpool_t *)tp;
+    parsec_dtd_task_class_t *dtd_tc = (parsec_dtd_task_class_t *)tc;
+    parsec_dtd_param_t params[PARSEC_DTD_MAX_PARAMS];
+    int nb_params = dtd_tc->count_of_params;
+    int t, c, p, nb_chunk, max_chunk, nb_local, rank, write_flow_count, satisfied_flow;
+    parsec_dtd_task_t **chunk, *this_task;
+    parsec_list_item_t *ready;
+    uint8_t chore_mask;
+
+    if( PARSEC_TASKPOOL_TYPE_DTD != tp->taskpool_type ) {
+        parsec_fatal("Error! Taskpool is of incorrect type\n");
+    }
+    if( tp->context == NULL) {
+        parsec_fatal("Sorry! You can not insert task without enqueuing the taskpool to parsec_context"
+                     " first. Please make sure you call parsec_context_add_taskpool(parsec_context, taskpool) before"
+                     " you try inserting task in PaRSEC\n");
+    }
+    if( nb_tasks <= 0 )
+        return;
+
+    /* The parameters are the same for all the tasks */
+    for( p = 0; p < nb_params; p++ ) {
+        params[p].op = (parsec_dtd_op_t)(dtd_tc->params[p].op | (NULL != flags ? flags[p] : 0));
+        params[p].size = dtd_tc->params[p].size;
+        params[p].profile_info = dtd_tc->params[p].profile_info;
+    }
+    chore_mask = parsec_dtd_chore_mask_of(tc, device_type);
+
+    max_chunk = (parsec_dtd_window_size > 1) ? parsec_dtd_window_size : 1;
+    if( max_chunk > nb_tasks ) max_chunk = nb_tasks;
+    chunk = (parsec_dtd_task_t **)malloc(max_chunk * sizeof(parsec_dtd_task_t *));
+
+    for( t = 0; t < nb_tasks; t += nb_chunk ) {
+        /* A chunk ends with the current window, where a single task insertion
+         * would throttle the inserting thread */
+        nb_chunk = dtd_tp->task_window_size - (int)(dtd_tp->local_task_inserted % dtd_tp->task_window_size);
+        if( nb_chunk > nb_tasks - t ) nb_chunk = nb_tasks - t;
+        if( nb_chunk > max_chunk ) nb_chunk = max_chunk;
+
+#if defined(PARSEC_PROF_TRACE)
+        if( parsec_dtd_profile_verbose )
+            parsec_profiling_ts_trace_flags_info_fn(insert_task_trace_keyin, 0, dtd_tp->super.taskpool_id, NULL, NULL, 0);
+#endif
+        for( c = 0, nb_local = 0; c < nb_chunk; c++ ) {
+            void * const *values = args + (size_t)(t + c) * nb_params;
+            rank = parsec_dtd_rank_of_params(dtd_tp, nb_params, params, values, &write_flow_count);
+            if( NULL != dtd_tp->recording ) {
+                parsec_dtd_graph_record_task(dtd_tp->recording, tc,
+                                             NULL != priorities ? priorities[t + c] : 0,
+                                             chore_mask, nb_params, params, values);
+            }
+            chunk[c] = parsec_dtd_create_task_from_params(dtd_tp, tc, rank,
+                                                          NULL != priorities ? priorities[t + c] : 0,
+                                                          chore_mask, write_flow_count,
+                                                          nb_params, params, values);
+            nb_local += parsec_dtd_task_is_local(chunk[c]);
+        }
+
+        /* Account for the local tasks of the chunk at once, before any of them
+         * can be scheduled */
+        if( 0 != nb_local ) {
+            dtd_tp->super.tdm.module->taskpool_addto_nb_tasks(&dtd_tp->super, nb_local);
+            dtd_tp->local_task_inserted += nb_local;
+        }
+
+        /* Link the tasks in order, and gather those that are ready: nothing in
+         * the chunk can block, so holding them until the end cannot deadlock */
+        for( c = 0, ready = NULL; c < nb_chunk; c++ ) {
+            this_task = chunk[c];
+            if( parsec_dtd_task_is_remote(this_task) ) {
+                (void)parsec_dtd_link_task(this_task, 0);
+                continue;
+            }
+            /* +1 to counter-balance the expected flow added at the task creation */
+            satisfied_flow = parsec_dtd_link_task(this_task, 0) + 1;
+            if( satisfied_flow == parsec_atomic_fetch_sub_int32(&this_task->flow_count, satisfied_flow) ) {
+                PARSEC_LIST_ITEM_SINGLETON(this_task);
+                if( NULL == ready ) ready = &this_task->super.super;
+                else parsec_list_item_ring_push(ready, &this_task->super.super);
+            }
+        }
+        if( NULL != ready ) {
+            __parsec_schedule(parsec_my_execution_stream(), (parsec_task_t *)ready, 0);
+        }
+
+#if defined(PARSEC_PROF_TRACE)
+        if( parsec_dtd_profile_verbose )
+            parsec_profiling_ts_trace_flags_info_fn(insert_task_trace_keyout, 0, dtd_tp->super.taskpool_id, NULL, NULL, 0);
+#endif
+        parsec_dtd_block_if_threshold_reached(dtd_tp, parsec_dtd_threshold_size);
+    }
+
+    free(chunk);
+}
+
 parsec_task_t *
 parsec_dtd_create_task(parsec_taskpool_t *tp,
                        parsec_dtd_funcptr_t *fpointer, int priority,
@@ -3441,7 +4160,7 @@ parsec_dtd_create_task(parsec_taskpool_t *tp,
     va_start(args, name_of_kernel);
 
     parsec_task_t *this_task = __parsec_dtd_taskpool_create_task(tp, fpointer, priority, device_type,
-                                                                 name_of_kernel, NULL, args);
+                                                                 name_of_kernel, NULL, 0, args);
     va_end(args);
 
     return this_task;
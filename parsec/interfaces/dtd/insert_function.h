@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2015-2023 The University of Tennessee and The University
+ * Copyright (c) 2015-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  **/
@@ -134,14 +134,25 @@ int parsec_dtd_destroy_arena_datatype(parsec_context_t *ctx, int id);
  * The parsec_dtd_threshold_size indicates the number of tasks, reaching which
  * the main thread will resume inserting tasks again.
  * The threshold should always be smaller than the window size.
+ *
+ * With "--mca dtd_window_mode adaptive" (parsec_dtd_window_adaptive set to 1
+ * before the taskpool is created), the window is instead adjusted at runtime
+ * between dtd_window_min_size and parsec_dtd_window_size: it grows when the
+ * inserting thread, while waiting, finds no ready task (the workers starve),
+ * shrinks while the ready tasks are plentiful, and is halved when the memory
+ * held by the pending tasks and the bounded arenas exceeds dtd_window_max_memory
+ * (in MB, 0 for no limit). The main thread then resumes inserting once half
+ * of the window has drained.
  */
 extern int parsec_dtd_window_size;
 extern int parsec_dtd_threshold_size;
+extern int parsec_dtd_window_adaptive;
 
 
 typedef struct parsec_dtd_tile_s         parsec_dtd_tile_t;
 typedef struct parsec_dtd_task_s         parsec_dtd_task_t;
 typedef struct parsec_dtd_taskpool_s     parsec_dtd_taskpool_t;
+typedef struct parsec_dtd_graph_s        parsec_dtd_graph_t;
 
 /**
  * Hard limit on the number of parameters a task inserted with DTD
@@ -276,6 +287,14 @@ parsec_dtd_tile_t * parsec_dtd_tile_new(parsec_taskpool_t *dtd_tp, int rank);
  *      *******  THIS PARAMETER MUST BE PROVIDED *******
  *      4. "0" indicates the end of parameter list. This should always be the last parameter.
  *
+ * Several threads can insert tasks in the same taskpool concurrently, if they
+ * all are PaRSEC threads (the main thread, or tasks inserting tasks). The
+ * accesses to a data are ordered as they are inserted by each thread; accesses
+ * to the same data from different threads are ordered as their insertions
+ * reach the runtime, so threads that need a specific order between them must
+ * synchronize their insertions (e.g. by epochs, each waited for before the
+ * next one starts). The tasks are matched across processes by their insertion
+ * order, so concurrent insertion is only supported in a single process.
  */
 void
 parsec_dtd_insert_task(parsec_taskpool_t  *tp,
@@ -397,6 +416,79 @@ parsec_dtd_insert_task_with_task_class(parsec_taskpool_t *tp,
                                        int device_type,
                                        ...);
 
+/**
+ * Insert nb_tasks tasks of the task class tc in a single call. The
+ * parameters of the task t are read from args[t * nb_params + p], where
+ * nb_params is the number of parameters of the task class: the tile
+ * (resolved once by the caller with PARSEC_DTD_TILE_OF) of a data, or the
+ * address of a value, a scratch or a reference. flags (NULL for none) are
+ * added to the access mode of each parameter for all the tasks (e.g.
+ * PARSEC_AFFINITY), and priorities (NULL for 0) gives the priority of each
+ * task. The tasks are linked with their predecessors in the order of the
+ * array, exactly as if they were inserted one at a time.
+ */
+void
+parsec_dtd_insert_tasks_with_task_class(parsec_taskpool_t *tp,
+                                        parsec_task_class_t *tc,
+                                        int device_type,
+                                        int nb_tasks,
+                                        const int *priorities,
+                                        const int *flags,
+                                        void * const *args);
+
+/**
+ * Recording and replaying the tasks of an iterative algorithm
+ *
+ * When the same tasks are inserted at each iteration, with different values
+ * only, the tasks inserted between parsec_dtd_graph_record_start and
+ * parsec_dtd_graph_record_stop (by parsec_dtd_insert_task,
+ * parsec_dtd_insert_task_with_task_class and
+ * parsec_dtd_insert_tasks_with_task_class) are kept in a graph, and
+ * parsec_dtd_graph_replay inserts them again, in the same order, without
+ * parsing their arguments or looking their task class up. The graph keeps,
+ * for each data, the previous access to it in the graph: only the first
+ * access of a replay to each data looks its tile up. The replayed tasks are
+ * still linked to the last user of their tiles, so a graph can be replayed
+ * while the previous iteration is still running.
+ *
+ * A graph is replayed in the taskpool it was recorded in. It retains its
+ * task classes, and must be freed before the taskpool. It records the
+ * tasks of a single inserting thread. The values of the tasks are copied
+ * when they are recorded; before each task is replayed, update (if not
+ * NULL) is called with the index of the task in the graph and the values
+ * of its parameters: the tiles of the data, and the addresses of the other
+ * parameters. update can change the recorded values in place, or replace
+ * the tile or the address of a parameter of this task for this replay only:
+ * the next accesses to the data in the graph keep the recorded tile.
+ */
+typedef void (parsec_dtd_graph_update_t)(int task_index, int nb_params, void **values, void *cb_data);
+
+parsec_dtd_graph_t *
+parsec_dtd_graph_new(void);
+
+/**
+ * Release a graph, that is not being recorded.
+ */
+void
+parsec_dtd_graph_free(parsec_dtd_graph_t *graph);
+
+int
+parsec_dtd_graph_nb_tasks(const parsec_dtd_graph_t *graph);
+
+/**
+ * Start recording the tasks inserted in tp in graph, discarding the tasks
+ * the graph held.
+ */
+int
+parsec_dtd_graph_record_start(parsec_taskpool_t *tp, parsec_dtd_graph_t *graph);
+
+int
+parsec_dtd_graph_record_stop(parsec_taskpool_t *tp);
+
+int
+parsec_dtd_graph_replay(parsec_taskpool_t *tp, parsec_dtd_graph_t *graph,
+                        parsec_dtd_graph_update_t *update, void *cb_data);
+
 void
 parsec_dtd_register_task_class(parsec_taskpool_t *tp,
                                uint64_t key,
@@ -231,7 +231,17 @@ struct parsec_dtd_taskpool_s {
     uint32_t                     local_task_inserted;  /* don't waste an atomic operation
                                                           on this, it can be loosely connected
                                                           to the number of locally inserted
-                                                          tasks. */
+                                                          tasks, even with concurrent inserters. */
+    int                          window_adaptive;      /* the window follows the load, see
+                                                          parsec_dtd_adapt_window */
+    uint32_t                     window_next_check;    /* local_task_inserted at which the
+                                                          adaptive window is checked next */
+    size_t                       task_size;            /* size of the last local task created */
+    parsec_atomic_lock_t         task_class_lock;      /* serializes the creation of the task
+                                                          classes discovered from a function
+                                                          pointer */
+    parsec_dtd_graph_t          *recording;            /* the graph the inserted tasks are
+                                                          recorded in, if any */
     uint8_t                      flow_set_flag[PARSEC_DTD_NB_TASK_CLASSES];
     int64_t                      new_tile_keys;
     parsec_data_collection_t     new_tile_dc;
@@ -328,7 +338,7 @@ void
 parsec_dtd_task_release( parsec_dtd_taskpool_t  *tp,
                          uint32_t             key );
 
-void
+int
 parsec_execute_and_come_back( parsec_taskpool_t  *tp,
                               int task_threshold_count );
 
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2009-2023 The University of Tennessee and The University
+ * Copyright (c) 2009-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation. All rights
  *                         reserved.
  */
@@ -108,6 +108,9 @@ typedef struct jdf_compiler_global_args {
     int   noline;  /**< Don't dump the jdf line number in the generate .c file */
     struct jdf_name_list *ignore_properties; /**< Properties to ignore */
     int   termdet; /**< What termination detection to use (one of TERMDET_*) */
+    int   auto_priority; /**< Generate the bottom level of the task classes without
+                          *   priority, to be used as their default priority */
+    int   count_deps;    /**< Track the dependencies of all the task classes with a counter */
 } jdf_compiler_global_args_t;
 extern jdf_compiler_global_args_t JDF_COMPILER_GLOBAL_ARGS;
 
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2009-2024 The University of Tennessee and The University
+ * Copyright (c) 2009-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * Copyright (c) 2024      NVIDIA Corporation.  All rights reserved.
@@ -51,6 +51,10 @@ static void
 jdf_generate_code_find_deps(const jdf_t *jdf,
                             const jdf_function_entry_t *f,
                             const char *name);
+static int
+jdf_generate_code_count_deps(const jdf_t *jdf,
+                             const jdf_function_entry_t *f,
+                             const char *name);
 static void jdf_generate_inline_c_functions(jdf_t* jdf);
 
 /* local constants */
@@ -325,14 +329,15 @@ static char* dump_globals(void** elem, void *arg)
 }
 
 /**
- * dump_data:
- *   Dump a global symbol like
- *     #define data_of_ABC(A0, A1) (__parsec_tp->super.ABC->data_of(__parsec_tp->super.ABC, A0, A1))
+ * dump_accessor:
+ *   Dump the definition of a data collection accessor macro. The index
+ *   flavor of the accessor avoids the va_list handling of the variadic one,
+ *   and it is used when the collection provides it.
+ *     ABC(A0, A1) ((NULL != ABC->data_of_idx) ? ABC->data_of_idx(ABC, (const int[]){ (int)(A0), (int)(A1) })
+ *                                             : ABC->data_of(ABC, (A0), (A1)))
  */
-static char* dump_data(void** elem, void *arg)
+static char* dump_accessor(jdf_data_entry_t* data, string_arena_t *sa, const char *accessor)
 {
-    jdf_data_entry_t* data = (jdf_data_entry_t*)elem;
-    string_arena_t *sa = (string_arena_t*)arg;
     int i;
 
     string_arena_init(sa);
@@ -340,8 +345,15 @@ static char* dump_data(void** elem, void *arg)
     for( i = 1; i < data->nbparams; i++ ) {
         string_arena_add_string(sa, ", %s_d%d", data->dname, i );
     }
-    string_arena_add_string(sa, ")  (((parsec_data_collection_t*)"TASKPOOL_GLOBAL_PREFIX"_g_%s)->data_of((parsec_data_collection_t*)"TASKPOOL_GLOBAL_PREFIX"_g_%s",
-                            data->dname, data->dname);
+    string_arena_add_string(sa, ")  ((NULL != ((parsec_data_collection_t*)"TASKPOOL_GLOBAL_PREFIX"_g_%s)->%s_idx) ? \\\n"
+                            "    ((parsec_data_collection_t*)"TASKPOOL_GLOBAL_PREFIX"_g_%s)->%s_idx((parsec_data_collection_t*)"TASKPOOL_GLOBAL_PREFIX"_g_%s, (const int[]){ (int)(%s_d0)",
+                            data->dname, accessor, data->dname, accessor, data->dname, data->dname);
+    for( i = 1; i < data->nbparams; i++ ) {
+        string_arena_add_string(sa, ", (int)(%s_d%d)", data->dname, i );
+    }
+    string_arena_add_string(sa, " }) : \\\n"
+                            "    ((parsec_data_collection_t*)"TASKPOOL_GLOBAL_PREFIX"_g_%s)->%s((parsec_data_collection_t*)"TASKPOOL_GLOBAL_PREFIX"_g_%s",
+                            data->dname, accessor, data->dname);
     for( i = 0; i < data->nbparams; i++ ) {
         string_arena_add_string(sa, ", (%s_d%d)", data->dname, i );
     }
@@ -349,6 +361,15 @@ static char* dump_data(void** elem, void *arg)
     return string_arena_get_string(sa);
 }
 
+/**
+ * dump_data:
+ *   Dump the global symbol #define data_of_ABC(A0, A1), see dump_accessor
+ */
+static char* dump_data(void** elem, void *arg)
+{
+    return dump_accessor((jdf_data_entry_t*)elem, (string_arena_t*)arg, "data_of");
+}
+
 static int expr_requires_assignment(const jdf_expr_t *expr, int inc_locals)
 {
     if( inc_locals && NULL != expr->local_variables ) {
@@ -377,27 +398,20 @@ static int expr_requires_assignment(const jdf_expr_t *expr, int inc_locals)
 
 /**
  * dump_rank:
- *   Dump a global symbol like
- *     #define rank_of_ABC(A0, A1) (__parsec_tp->super.ABC->rank_of(__parsec_tp->super.ABC, A0, A1))
+ *   Dump the global symbol #define rank_of_ABC(A0, A1), see dump_accessor
  */
 static char* dump_rank(void** elem, void *arg)
 {
-    jdf_data_entry_t* data = (jdf_data_entry_t*)elem;
-    string_arena_t *sa = (string_arena_t*)arg;
-    int i;
+    return dump_accessor((jdf_data_entry_t*)elem, (string_arena_t*)arg, "rank_of");
+}
 
-    string_arena_init(sa);
-    string_arena_add_string(sa, "%s(%s_d%d", data->dname, data->dname, 0 );
-    for( i = 1; i < data->nbparams; i++ ) {
-        string_arena_add_string(sa, ", %s_d%d", data->dname, i );
-    }
-    string_arena_add_string(sa, ")  (((parsec_data_collection_t*)"TASKPOOL_GLOBAL_PREFIX"_g_%s)->rank_of((parsec_data_collection_t*)"TASKPOOL_GLOBAL_PREFIX"_g_%s",
-                            data->dname, data->dname);
-    for( i = 0; i < data->nbparams; i++ ) {
-        string_arena_add_string(sa, ", (%s_d%d)", data->dname, i );
-    }
-    string_arena_add_string(sa, "))" );
-    return string_arena_get_string(sa);
+/**
+ * dump_vpid:
+ *   Dump the global symbol #define vpid_of_ABC(A0, A1), see dump_accessor
+ */
+static char* dump_vpid(void** elem, void *arg)
+{
+    return dump_accessor((jdf_data_entry_t*)elem, (string_arena_t*)arg, "vpid_of");
 }
 
 /**
@@ -1152,6 +1166,29 @@ static int jdf_expr_depends_on_symbol(const char *name, const jdf_expr_t *e)
     return 2;  /* by default assume we might need all of them */
 }
 
+/**
+ * Whether the value of e may change with the variable name: unlike
+ * jdf_expr_depends_on_symbol, the other variables are known not to depend
+ * on it, and only the inline C code and the ranges are assumed to.
+ */
+static int jdf_expr_may_vary_with(const char *name, const jdf_expr_t *e)
+{
+    if( JDF_OP_IS_CST(e->op) || JDF_OP_IS_STRING(e->op) )
+        return 0;
+    if( JDF_OP_IS_VAR(e->op) )
+        return 0 == strcmp(e->jdf_var, name);
+    if( JDF_OP_IS_UNARY(e->op) )
+        return jdf_expr_may_vary_with(name, e->jdf_ua);
+    if( JDF_OP_IS_TERNARY(e->op) )
+        return jdf_expr_may_vary_with(name, e->jdf_tat) ||
+            jdf_expr_may_vary_with(name, e->jdf_ta1) ||
+            jdf_expr_may_vary_with(name, e->jdf_ta2);
+    if( JDF_OP_IS_BINARY(e->op) && (JDF_RANGE != e->op) )
+        return jdf_expr_may_vary_with(name, e->jdf_ba1) ||
+            jdf_expr_may_vary_with(name, e->jdf_ba2);
+    return 1;
+}
+
 /**
  * Helpers to manipulate object properties (i.e. typed attributed associated with
  * different concepts such as tasks, flows, dependencies and functions). The
@@ -1613,6 +1650,13 @@ static void jdf_generate_structure(jdf_t *jdf)
                 jdf_basename, jdf_basename,
                 jdf_basename, jdf_basename);
 
+    /* Before the globals, which are macros that may hide the fields of the collection */
+    coutput("/* All the tasks with an affinity to a collection on a single node are local */\n"
+            "static inline int parsec_dc_all_local(const parsec_data_collection_t *dc)\n"
+            "{\n"
+            "  return (1 == dc->nodes) && (0 == dc->myrank);\n"
+            "};\n\n");
+
     UTIL_DUMP_LIST(sa1, jdf->globals, next,
                    dump_globals, sa2, "", "#define ", "\n", "\n");
     if( 1 < strlen(string_arena_get_string(sa1)) ) {
@@ -1620,7 +1664,14 @@ static void jdf_generate_structure(jdf_t *jdf)
     }
 
     coutput("static inline int parsec_imin(int a, int b) { return (a <= b) ? a : b; };\n\n"
-            "static inline int parsec_imax(int a, int b) { return (a >= b) ? a : b; };\n\n");
+            "static inline int parsec_imax(int a, int b) { return (a >= b) ? a : b; };\n\n"
+            "/* Number of values taken by a loop from start to end (included) by inc */\n"
+            "static inline int parsec_range_nb_values(int start, int end, int inc)\n"
+            "{\n"
+            "  if( inc > 0 ) return (end >= start) ? (end - start) / inc + 1 : 0;\n"
+            "  if( inc < 0 ) return (start >= end) ? (start - end) / -inc + 1 : 0;\n"
+            "  return (start <= end) ? 1 : 0;\n"
+            "};\n\n");
 
     /**
      * Generate the inline_c functions as soon as possible, or they will not be usable
@@ -1634,6 +1685,9 @@ static void jdf_generate_structure(jdf_t *jdf)
     coutput("%s\n",
             UTIL_DUMP_LIST(sa1, jdf->data, next,
                            dump_rank, sa2, "", "#define rank_of_", "\n", "\n"));
+    coutput("%s\n",
+            UTIL_DUMP_LIST(sa1, jdf->data, next,
+                           dump_vpid, sa2, "", "#define vpid_of_", "\n", "\n"));
 
     coutput("/* Functions Predicates */\n%s\n",
             UTIL_DUMP_LIST(sa1, jdf->functions, next,
@@ -2508,41 +2562,47 @@ static void jdf_generate_direct_data_function(const jdf_t *jdf, const char *mem,
     (void)jdf;
 }
 
+/**
+ * Returns the first range of an input call, NULL if the call has none. An
+ * input call with a range is a control gather.
+ */
+static const jdf_expr_t *jdf_input_call_range(const jdf_call_t *call, const jdf_dep_t *dep)
+{
+    const jdf_expr_t *le;
+
+    /* First: do we have a control gather because of the parameters? */
+    for( le = call->parameters; le != NULL; le = le->next ) {
+        if( le->op == JDF_RANGE ) {
+            return le;
+        }
+    }
+    /* If not, do we have one because the call has a ranged local definition ? */
+    for(le = call->local_defs; le != NULL; le = le->next) {
+        if( le->op == JDF_RANGE ) {
+            return le;
+        }
+    }
+    /* Last, do we have one because the dep has a ranged local definition ? */
+    for(le = dep->local_defs; le != NULL; le = le->next) {
+        if( le->op == JDF_RANGE ) {
+            return le;
+        }
+    }
+    return NULL;
+}
+
 static int jdf_generate_dependency( const jdf_t *jdf, jdf_dataflow_t *flow, jdf_dep_t *dep,
                                     jdf_call_t *call, const char *depname,
                                     const char *condname, const jdf_function_entry_t* f )
 {
     string_arena_t *sa = string_arena_new(64), *sa2 = string_arena_new(64), *sa3 = string_arena_new(64);
-    jdf_expr_t *le;
     int ret = 1;
     string_arena_t *tmp_fct_name;
 
     JDF_OBJECT_ONAME(call) = strdup(depname);
 
     if( dep->dep_flags & JDF_DEP_FLOW_IN ) {
-        /* First: do we have a control gather because of the parameters? */
-        for( le = call->parameters; le != NULL; le = le->next ) {
-            if( le->op == JDF_RANGE ) {
-                break;
-            }
-        }
-        if( NULL == le ) {
-            /* If not, do we have one because the call has a ranged local definition ? */
-            for(le = call->local_defs; le != NULL; le = le->next) {
-                if( le->op == JDF_RANGE ) {
-                    break;
-                }
-            }
-            if( NULL == le ) {
-                /* Last, do we have one because the dep has a ranged local definition ? */
-                for(le = dep->local_defs; le != NULL; le = le->next) {
-                    if( le->op == JDF_RANGE ) {
-                        break;
-                    }
-                }
-            }
-        }
-        if( NULL != le ) {
+        if( NULL != jdf_input_call_range(call, dep) ) {
             /* At least one range in input: must be a control gather */
             if( !(flow->flow_flags & JDF_FLOW_TYPE_CTL) ) {
                 jdf_fatal(JDF_OBJECT_LINENO(dep), "This dependency features a range as input but is not a Control dependency\n");
@@ -3022,7 +3082,9 @@ force_continue_generation:
  * The initialization of the structures (dependency tracking and data flow
  * repositories) are executed in the %s_internal_init functions, bound to the
  * prepare_input hook, and the creation of the initial tasks executed in the
- * %s_startup_tasks functions bound to the incarnation hook.
+ * %s_startup_tasks functions bound to the incarnation hook. The index arrays
+ * of the dependency tracking are the exception: find_deps allocates them on
+ * the first access to each sub-range of the execution space.
  *
  * internal_init is supposed to return ASYNC until the last prepare_input has
  * been executed, so that the hook is not triggered before everything is prepared.
@@ -3152,7 +3214,7 @@ static void jdf_generate_startup_tasks(const jdf_t *jdf, const jdf_function_entr
     jdf_generate_direct_input_conditions(jdf, f, f->dataflow);
 
     coutput("%s  if( NULL != ((parsec_data_collection_t*)"TASKPOOL_GLOBAL_PREFIX"_g_%s)->vpid_of ) {\n"
-            "%s    vpid = ((parsec_data_collection_t*)"TASKPOOL_GLOBAL_PREFIX"_g_%s)->vpid_of((parsec_data_collection_t*)"TASKPOOL_GLOBAL_PREFIX"_g_%s, %s);\n"
+            "%s    vpid = vpid_of_%s(%s);\n"
             "%s    assert(context->nb_vp >= vpid);\n"
             "%s  } else {\n"
             "%s    vpid = (vpid + 1) %% context->nb_vp;  /* spread the initial joy */\n"
@@ -3160,7 +3222,7 @@ static void jdf_generate_startup_tasks(const jdf_t *jdf, const jdf_function_entr
             "%s  new_task = (%s*)parsec_thread_mempool_allocate( context->virtual_processes[vpid]->execution_streams[0]->context_mempool );\n"
             "%s  PARSEC_OBJ_CONSTRUCT(new_task, parsec_task_t); /* construct called only when new, force-construct it again */\n",
             indent(nesting), f->predicate->func_or_mem,
-            indent(nesting), f->predicate->func_or_mem, f->predicate->func_or_mem,
+            indent(nesting), f->predicate->func_or_mem,
             UTIL_DUMP_LIST(sa2, f->predicate->parameters, next,
                            dump_expr, (void*)&info1,
                            "", "", ", ", ""),
@@ -3188,6 +3250,10 @@ static void jdf_generate_startup_tasks(const jdf_t *jdf, const jdf_function_entr
     if( NULL != f->priority ) {
         coutput("%s  new_task->priority = __parsec_tp->super.super.priority + priority_of_%s_%s_as_expr_fct((__parsec_%s_internal_taskpool_t*)new_task->taskpool, &new_task->locals);\n",
                 indent(nesting), jdf_basename, f->fname, jdf_basename);
+    } else if( JDF_COMPILER_GLOBAL_ARGS.auto_priority ) {
+        coutput("%s  new_task->priority = __parsec_tp->super.super.priority +\n"
+                "%s    (parsec_runtime_auto_priority ? bottom_level_of_%s_%s(__parsec_tp, new_task) : 0);\n",
+                indent(nesting), indent(nesting), jdf_basename, f->fname);
     } else {
         coutput("%s  new_task->priority = __parsec_tp->super.super.priority;\n", indent(nesting));
     }
@@ -3436,7 +3502,7 @@ static void jdf_generate_internal_init(const jdf_t *jdf, const jdf_function_entr
     jdf_expr_t *ld;
     const jdf_param_list_t *pl;
     expr_info_t info = EMPTY_EXPR_INFO;
-    int need_to_iterate, need_min_max, need_to_count_tasks;
+    int need_to_iterate, need_min_max, need_to_count_tasks, closed_form_count, invariant_pred = 0;
     int nesting = 0, idx;
     jdf_l2p_t *l2p = build_l2p(f), *l2p_item;
     char *dep_key_fn_name = NULL;
@@ -3451,6 +3517,20 @@ static void jdf_generate_internal_init(const jdf_t *jdf, const jdf_function_entr
             (0 == (f->user_defines & JDF_HAS_DYNAMIC_TERMDET)) &&
             (0 == (f->user_defines & JDF_HAS_USER_TRIGGERED_TERMDET));
     need_to_iterate = need_min_max || need_to_count_tasks;
+    /* When the innermost local is a range, and either all the tasks are local
+     * or the affinity does not depend on that local, the tasks of the
+     * innermost range are counted without iterating over it */
+    for(vl = f->locals; (NULL != vl) && (NULL != vl->next); vl = vl->next) /* nothing */;
+    closed_form_count = need_to_count_tasks && (NULL != vl) && (JDF_RANGE == vl->expr->op);
+    if( closed_form_count && (NULL == f->predicate->local_defs) ) {
+        invariant_pred = 1;
+        for(ld = f->predicate->parameters; NULL != ld; ld = ld->next) {
+            if( jdf_expr_may_vary_with(vl->name, ld) ) {
+                invariant_pred = 0;
+                break;
+            }
+        }
+    }
 
     if( 0 != (f->user_defines & JDF_FUNCTION_HAS_UD_HASH_STRUCT) ) {
         dep_key_fn_name = strdup( jdf_property_get_string(f->properties, JDF_PROP_UD_HASH_STRUCT_NAME, NULL) );
@@ -3475,9 +3555,11 @@ static void jdf_generate_internal_init(const jdf_t *jdf, const jdf_function_entr
             jdf_basename, jdf_basename);
 
     if(need_to_count_tasks) {
-        coutput("  int32_t nb_tasks = 0, saved_nb_tasks = 0;\n");
-        /* prepare the epilog output to prevent compiler from complaining about initialized but unused data */
-        string_arena_add_string(sa_end, "(void)saved_nb_tasks;\n");
+        coutput("  int32_t nb_tasks = 0;\n");
+    }
+    if( closed_form_count && !invariant_pred ) {
+        coutput("  const int %sall_local = parsec_dc_all_local((parsec_data_collection_t*)("TASKPOOL_GLOBAL_PREFIX"_g_%s));\n",
+                JDF2C_NAMESPACE, f->predicate->func_or_mem);
     }
     if( need_min_max ) {
         for(l2p_item = l2p; NULL != l2p_item; l2p_item = l2p_item->next) {
@@ -3500,9 +3582,6 @@ static void jdf_generate_internal_init(const jdf_t *jdf, const jdf_function_entr
             parsec_get_name(jdf, f, "parsec_assignment_t"),
             UTIL_DUMP_LIST_FIELD(sa1, f->locals, next, name, dump_string, NULL,
                                      "  ", ".", ".value = 0, ", ".value = 0 "));
-        if( JDF_COMPILER_GLOBAL_ARGS.dep_management == DEP_MANAGEMENT_INDEX_ARRAY ) {
-            coutput("  parsec_dependencies_t *dep = NULL;\n");
-        }
         coutput("%s",
                 UTIL_DUMP_LIST_FIELD(sa1, f->locals, next, name, dump_string, NULL,
                                      "  int32_t ", " ", ", ", ";\n"));
@@ -3558,6 +3637,51 @@ static void jdf_generate_internal_init(const jdf_t *jdf, const jdf_function_entr
                             indent(nesting), JDF2C_NAMESPACE, vl->name, JDF2C_NAMESPACE, vl->name, vl->name);
                 }
 
+                if( closed_form_count && (NULL == vl->next) ) {
+                    /* Every point of the innermost range is a local task, or the
+                     * predicate has the same value on all of them: count them in
+                     * closed form, and iterate over the range only otherwise. */
+                    if( invariant_pred ) {
+                        coutput("%s    if( 1 /* the affinity does not depend on %s */ ) {\n",
+                                indent(nesting), vl->name);
+                    } else {
+                        coutput("%s    if( %sall_local ) {\n",
+                                indent(nesting), JDF2C_NAMESPACE);
+                    }
+                    coutput("%s      int32_t %snb_%s = parsec_range_nb_values(%s%s_start, %s%s_end, %s%s_inc);\n"
+                            "%s      if( 0 < %snb_%s ) {\n",
+                            indent(nesting), JDF2C_NAMESPACE, vl->name, JDF2C_NAMESPACE, vl->name,
+                            JDF2C_NAMESPACE, vl->name, JDF2C_NAMESPACE, vl->name,
+                            indent(nesting), JDF2C_NAMESPACE, vl->name);
+                    if( need_min_max ) {
+                        for(const jdf_variable_list_t *vl2 = f->locals; vl2 != NULL; vl2 = vl2->next) {
+                            if ( NULL != vl2->expr->local_variables) {
+                                coutput("%s        %s%s_min = parsec_imin(%s%s_min, %s);\n",
+                                        indent(nesting), JDF2C_NAMESPACE, vl2->name, JDF2C_NAMESPACE, vl2->name, vl2->name);
+                                coutput("%s        %s%s_max = parsec_imax(%s%s_max, %s);\n",
+                                        indent(nesting), JDF2C_NAMESPACE, vl2->name, JDF2C_NAMESPACE, vl2->name, vl2->name);
+                            }
+                        }
+                    }
+                    if( invariant_pred ) {
+                        string_arena_init(sa2);
+                        coutput("%s        %s = %s%s_start;\n"
+                                "%s        assignments.%s.value = %s;\n"
+                                "%s        if( %s_pred(%s) )\n"
+                                "%s          nb_tasks += %snb_%s;\n",
+                                indent(nesting), vl->name, JDF2C_NAMESPACE, vl->name,
+                                indent(nesting), vl->name, vl->name,
+                                indent(nesting), f->fname, UTIL_DUMP_LIST_FIELD(sa2, f->locals, next, name,
+                                                                                dump_string, NULL, "", "", ", ", ""),
+                                indent(nesting), JDF2C_NAMESPACE, vl->name);
+                    } else {
+                        coutput("%s        nb_tasks += %snb_%s;\n",
+                                indent(nesting), JDF2C_NAMESPACE, vl->name);
+                    }
+                    coutput("%s      }\n"
+                            "%s    } else\n",
+                            indent(nesting), indent(nesting));
+                }
                 /* Adapt the loop condition depending on the value of the increment. We can
                  * now handle both increasing and decreasing execution spaces. */
                 coutput("%s    for(%s =  %s%s_start;\n",
@@ -3666,46 +3790,6 @@ static void jdf_generate_internal_init(const jdf_t *jdf, const jdf_function_entr
             inner_vl = vl;
         }
 
-        if( JDF_COMPILER_GLOBAL_ARGS.dep_management == DEP_MANAGEMENT_INDEX_ARRAY ) {
-            /* If no tasks have been generated during the last loop, there is no need
-             * to have any dependencies.
-             */
-            if( need_to_count_tasks ) {
-                coutput("%s  if( saved_nb_tasks != nb_tasks ) {\n", indent(nesting));
-                coutput("%s    PARSEC_DEBUG_VERBOSE(20, parsec_debug_output, \"Allocating dependencies array for %s (partial nb_tasks = %%d)\", nb_tasks);\n",
-                        indent(nesting), f->fname);
-            }
-
-            string_arena_add_string(sa1, "dep");
-            for(l2p_item = l2p; NULL != l2p_item; l2p_item = l2p_item->next) {
-                vl = l2p_item->vl;
-                coutput("%s    if( %s == NULL ) {\n",
-                        indent(nesting), string_arena_get_string(sa1));
-                if(vl->expr->op == JDF_RANGE) {
-                    coutput("%s      ALLOCATE_DEP_TRACKING(%s, __%s_min, __%s_max,\n",
-                            indent(nesting), string_arena_get_string(sa1), vl->name, vl->name);
-                } else {
-                    coutput("%s      ALLOCATE_DEP_TRACKING(%s, %s, %s,\n",
-                            indent(nesting), string_arena_get_string(sa1), vl->name, vl->name);
-                }
-                coutput("%s                            \"%s\", %s);\n"
-                        "%s    }\n",
-                        indent(nesting), vl->name,
-                        NULL == l2p_item->next ? "PARSEC_DEPENDENCIES_FLAG_FINAL" : "PARSEC_DEPENDENCIES_FLAG_NEXT",  /* last item */
-                        indent(nesting));
-                string_arena_init(sa2);
-                string_arena_add_string(sa2, "%s", string_arena_get_string(sa1));
-                string_arena_add_string(sa1, "->u.next[%s-__%s_min]", vl->name, vl->name);
-            }
-            /* Save the current number of tasks for the optimization of the next iteration */
-            if( need_to_count_tasks ) {
-                coutput("%s    saved_nb_tasks = nb_tasks;\n"
-                        "%s }\n",
-                        indent(nesting),
-                        indent(nesting));
-            }
-        }
-
         while( NULL != inner_vl ) {
             /* We close all the other loops in reverse order */
             if( inner_vl->expr->local_variables == NULL ) {
@@ -3792,10 +3876,9 @@ static void jdf_generate_internal_init(const jdf_t *jdf, const jdf_function_entr
         coutput("  __parsec_tp->super.super.dependencies_array[%d] = %s(__parsec_tp);\n",
                 f->task_class_id, jdf_property_get_function(f->properties, JDF_PROP_UD_ALLOC_DEPS_FN_NAME, NULL));
     } else {
-        if( JDF_COMPILER_GLOBAL_ARGS.dep_management == DEP_MANAGEMENT_INDEX_ARRAY ) {
-            coutput("  __parsec_tp->super.super.dependencies_array[%d] = dep;\n",
-                    f->task_class_id);
-        } else if( JDF_COMPILER_GLOBAL_ARGS.dep_management == DEP_MANAGEMENT_DYNAMIC_HASH_TABLE ||
+        /* With the index arrays, the dependencies are allocated by find_deps on the
+         * first access to each sub-range of the execution space */
+        if( JDF_COMPILER_GLOBAL_ARGS.dep_management == DEP_MANAGEMENT_DYNAMIC_HASH_TABLE ||
                    0 != (f->user_defines & JDF_FUNCTION_HAS_UD_HASH_STRUCT)) {
             coutput("  __parsec_tp->super.super.dependencies_array[%d] = PARSEC_OBJ_NEW(parsec_hash_table_t);\n"
                     "  parsec_hash_table_init(__parsec_tp->super.super.dependencies_array[%d], offsetof(parsec_hashable_dependency_t, ht_item), 10, %s, this_task->taskpool);\n",
@@ -3870,7 +3953,12 @@ static void jdf_generate_internal_init(const jdf_t *jdf, const jdf_function_entr
                 "                           this_task->taskpool->taskpool_id, NULL);\n"
                 "#endif /* defined(PARSEC_PROF_TRACE) && defined(PARSEC_PROF_TRACE_PTG_INTERNAL_INIT) */\n");
     }
-    if( f->flags & JDF_FUNCTION_FLAG_CAN_BE_STARTUP ) {
+    /* With a dynamic termination detection only the startup hook can discover
+     * the local tasks, and the pending actions also account for the taskpool
+     * registration with the communication engine, which completes asynchronously:
+     * the startup hook must always run. */
+    if( (f->flags & JDF_FUNCTION_FLAG_CAN_BE_STARTUP) &&
+        (0 == (f->user_defines & JDF_HAS_DYNAMIC_TERMDET)) ) {
         coutput("    if( 1 >= __parsec_tp->super.super.nb_pending_actions ) {\n"
                 "        /* if no tasks will be generated let's prevent the runtime from calling the hook and instead go directly to complete the task */\n"
                 "        this_task->status = PARSEC_TASK_STATUS_COMPLETE;\n"
@@ -4215,7 +4303,7 @@ static void jdf_generate_one_function( const jdf_t *jdf, jdf_function_entry_t *f
 #else
     use_mask = 0;
 #endif
-    if( jdf_property_get_int(f->properties, "count_deps", 0) )
+    if( jdf_property_get_int(f->properties, "count_deps", 0) || JDF_COMPILER_GLOBAL_ARGS.count_deps )
         use_mask = 0;
     if( jdf_property_get_int(f->properties, "mask_deps", 0) )
         use_mask = 1;
@@ -4309,6 +4397,12 @@ static void jdf_generate_one_function( const jdf_t *jdf, jdf_function_entry_t *f
         string_arena_add_string(sa, "  .update_deps = parsec_update_deps_with_mask,\n");
     } else {
         string_arena_add_string(sa, "  .update_deps = parsec_update_deps_with_counter,\n");
+        if( has_in_in_dep || has_control_gather ) {
+            /* The number of inputs depends on the task */
+            sprintf(prefix, "count_deps_of_%s_%s", jdf_basename, f->fname);
+            if( jdf_generate_code_count_deps(jdf, f, prefix) )
+                string_arena_add_string(sa, "  .count_deps = %s,\n", prefix);
+        }
     }
 
     if( !(f->flags & JDF_FUNCTION_FLAG_NO_SUCCESSORS) ) {
@@ -4432,6 +4526,202 @@ static void jdf_generate_functions_statics( const jdf_t *jdf )
     string_arena_free(sa);
 }
 
+/**
+ * Automatic priorities (--auto-priority).
+ *
+ * The bottom level of a task is the length of the longest path from this task
+ * to the end of the DAG. It is estimated from the symbolic dependencies: the
+ * task classes form a graph through their output dependencies, and a class
+ * that calls itself with one of its parameters shifted by a constant (such as
+ * F(k) -> F(k+1) with k = 0 .. NT-1) defines a chain whose remaining length
+ * can be computed from the range of that parameter. The bottom level of a
+ * task is the remaining length of its chain, weighted by the time_estimate of
+ * the task, plus the length of the longest path through the other classes,
+ * each counted with its static chain length (1 when it cannot be computed).
+ * Cycles between different classes are broken arbitrarily.
+ */
+typedef struct jdf_bottom_level {
+    const jdf_function_entry_t *f;
+    const jdf_variable_list_t  *chain_var;  /**< parameter shifted along the self calls, or NULL */
+    int                         chain_step; /**< positive or negative shift of chain_var */
+    int                         max_chain;  /**< static bound on the chain length, 1 if unknown */
+    int                         tail;       /**< longest path through the other classes, -1 if not computed */
+    int                         visiting;
+} jdf_bottom_level_t;
+
+static int jdf_expr_is_int_cst(const jdf_expr_t *e)
+{
+    return (NULL != e) && (JDF_CST == e->op) && (EXPR_TYPE_INT32 == e->jdf_type);
+}
+
+static int jdf_expr_contains_c_code(const jdf_expr_t *e)
+{
+    if( NULL == e ) return 0;
+    if( JDF_OP_IS_C_CODE(e->op) ) return 1;
+    if( JDF_OP_IS_UNARY(e->op) ) return jdf_expr_contains_c_code(e->jdf_ua);
+    if( JDF_OP_IS_TERNARY(e->op) || (JDF_RANGE == e->op) )
+        return jdf_expr_contains_c_code(e->jdf_ta1) || jdf_expr_contains_c_code(e->jdf_ta2) ||
+            jdf_expr_contains_c_code(e->jdf_ta3);
+    if( JDF_OP_IS_BINARY(e->op) )
+        return jdf_expr_contains_c_code(e->jdf_ba1) || jdf_expr_contains_c_code(e->jdf_ba2);
+    return 0;
+}
+
+/**
+ * Return the shift of the parameter name in the expression e, if e is of the
+ * form name + cst, cst + name or name - cst, and 0 otherwise.
+ */
+static int jdf_expr_shift_of(const char *name, const jdf_expr_t *e)
+{
+    const jdf_expr_t *v, *c;
+    if( (JDF_PLUS != e->op) && (JDF_MINUS != e->op) ) return 0;
+    v = e->jdf_ba1; c = e->jdf_ba2;
+    if( (JDF_PLUS == e->op) && JDF_OP_IS_VAR(c->op) ) { v = e->jdf_ba2; c = e->jdf_ba1; }
+    if( !JDF_OP_IS_VAR(v->op) || (0 != strcmp(v->jdf_var, name)) || !jdf_expr_is_int_cst(c) )
+        return 0;
+    return (JDF_PLUS == e->op) ? c->jdf_cst : -c->jdf_cst;
+}
+
+static void jdf_bottom_level_find_chain(jdf_bottom_level_t *bl, const jdf_call_t *call)
+{
+    const jdf_param_list_t *p;
+    const jdf_expr_t *e;
+    int shift;
+
+    for( p = bl->f->parameters, e = call->parameters;
+         (NULL != p) && (NULL != e); p = p->next, e = e->next ) {
+        if( (NULL == p->local) || (NULL == p->local->expr) ||
+            (JDF_RANGE != p->local->expr->op) || (NULL != p->local->expr->local_variables) ||
+            jdf_expr_contains_c_code(p->local->expr->jdf_ta1) ||
+            jdf_expr_contains_c_code(p->local->expr->jdf_ta2) )
+            continue;
+        if( 0 == (shift = jdf_expr_shift_of(p->name, e)) )
+            continue;
+        bl->chain_var = p->local;
+        bl->chain_step = shift;
+        if( jdf_expr_is_int_cst(p->local->expr->jdf_ta1) && jdf_expr_is_int_cst(p->local->expr->jdf_ta2) )
+            bl->max_chain = 1 + (p->local->expr->jdf_ta2->jdf_cst - p->local->expr->jdf_ta1->jdf_cst) /
+                (shift < 0 ? -shift : shift);
+        if( bl->max_chain < 1 ) bl->max_chain = 1;
+        return;
+    }
+}
+
+static jdf_bottom_level_t *jdf_bottom_level_of(jdf_bottom_level_t *bls, int nb, const char *fname)
+{
+    for( int i = 0; i < nb; i++ )
+        if( 0 == strcmp(bls[i].f->fname, fname) ) return &bls[i];
+    return NULL;
+}
+
+static int jdf_bottom_level_tail(jdf_bottom_level_t *bls, int nb, jdf_bottom_level_t *bl)
+{
+    const jdf_dataflow_t *fl;
+    const jdf_dep_t *dep;
+    const jdf_call_t *calls[2];
+    jdf_bottom_level_t *succ;
+    int i, length;
+
+    if( bl->tail >= 0 ) return bl->tail;
+    bl->visiting = 1;
+    bl->tail = 0;
+    for( fl = bl->f->dataflow; NULL != fl; fl = fl->next ) {
+        for( dep = fl->deps; NULL != dep; dep = dep->next ) {
+            if( !(dep->dep_flags & JDF_DEP_FLOW_OUT) ) continue;
+            calls[0] = dep->guard->calltrue;
+            calls[1] = dep->guard->callfalse;
+            for( i = 0; i < 2; i++ ) {
+                if( (NULL == calls[i]) || (NULL == calls[i]->var) ) continue;  /* data collection */
+                if( NULL == (succ = jdf_bottom_level_of(bls, nb, calls[i]->func_or_mem)) ) continue;
+                if( succ == bl ) continue;
+                if( succ->visiting ) continue;  /* break the cycle */
+                length = succ->max_chain + jdf_bottom_level_tail(bls, nb, succ);
+                if( length > bl->tail ) bl->tail = length;
+            }
+        }
+    }
+    bl->visiting = 0;
+    return bl->tail;
+}
+
+static void jdf_generate_bottom_levels( const jdf_t *jdf )
+{
+    const jdf_function_entry_t *f;
+    const jdf_dataflow_t *fl;
+    const jdf_dep_t *dep;
+    jdf_bottom_level_t *bls, *bl;
+    string_arena_t *sa, *sa2;
+    assignment_info_t ai;
+    expr_info_t info = EMPTY_EXPR_INFO;
+    int nb = 0, i;
+
+    if( !JDF_COMPILER_GLOBAL_ARGS.auto_priority ) return;
+
+    for(f = jdf->functions; f != NULL; f = f->next) nb++;
+    bls = (jdf_bottom_level_t*)calloc(nb, sizeof(jdf_bottom_level_t));
+    for(f = jdf->functions, i = 0; f != NULL; f = f->next, i++) {
+        bl = &bls[i];
+        bl->f = f;
+        bl->max_chain = 1;
+        bl->tail = -1;
+        for( fl = f->dataflow; (NULL != fl) && (NULL == bl->chain_var); fl = fl->next ) {
+            for( dep = fl->deps; (NULL != dep) && (NULL == bl->chain_var); dep = dep->next ) {
+                if( !(dep->dep_flags & JDF_DEP_FLOW_OUT) ) continue;
+                if( (NULL != dep->guard->calltrue) && (NULL != dep->guard->calltrue->var) &&
+                    (0 == strcmp(dep->guard->calltrue->func_or_mem, f->fname)) )
+                    jdf_bottom_level_find_chain(bl, dep->guard->calltrue);
+                if( (NULL == bl->chain_var) && (NULL != dep->guard->callfalse) &&
+                    (NULL != dep->guard->callfalse->var) &&
+                    (0 == strcmp(dep->guard->callfalse->func_or_mem, f->fname)) )
+                    jdf_bottom_level_find_chain(bl, dep->guard->callfalse);
+            }
+        }
+    }
+
+    sa = string_arena_new(64);
+    sa2 = string_arena_new(64);
+    info.sa = sa;
+    info.prefix = "";
+    info.suffix = "";
+    info.assignments = "locals";
+    for( i = 0; i < nb; i++ ) {
+        bl = &bls[i];
+        f = bl->f;
+        if( NULL != f->priority ) continue;
+        jdf_bottom_level_tail(bls, nb, bl);
+
+        ai.sa = sa;
+        ai.holder = "locals->";
+        ai.expr = NULL;
+        coutput("static inline int bottom_level_of_%s_%s(const __parsec_%s_internal_taskpool_t *__parsec_tp, const %s *this_task)\n"
+                "{\n"
+                "  const %s *locals = &this_task->locals;\n"
+                "%s\n"
+                "  int64_t length = 1, bl;\n"
+                "  (void)__parsec_tp; (void)locals;\n",
+                jdf_basename, f->fname, jdf_basename, parsec_get_name(jdf, f, "task_t"),
+                parsec_get_name(jdf, f, "parsec_assignment_t"),
+                UTIL_DUMP_LIST(sa2, f->locals, next, dump_local_assignments, &ai,
+                               "", "  ", "\n", "\n"));
+        if( NULL != bl->chain_var ) {
+            const jdf_expr_t *bound = (bl->chain_step > 0) ? bl->chain_var->expr->jdf_ta2 : bl->chain_var->expr->jdf_ta1;
+            coutput("  /* remaining length of the chain along %s */\n"
+                    "  length = 1 + ((int64_t)(%s) - (int64_t)%s) / %d;\n"
+                    "  if( length < 1 ) length = 1;\n",
+                    bl->chain_var->name,
+                    dump_expr((void**)bound, &info), bl->chain_var->name,
+                    bl->chain_step);
+        }
+        coutput("  bl = length * parsec_mca_device_task_weight((const parsec_task_t*)this_task) + %d;\n"
+                "  return (int)((bl < (INT32_MAX / 2)) ? bl : (INT32_MAX / 2));\n"
+                "}\n\n",
+                bl->tail);
+    }
+    string_arena_free(sa);
+    string_arena_free(sa2);
+    free(bls);
+}
+
 static void jdf_generate_priority_prototypes( const jdf_t *jdf )
 {
     jdf_function_entry_t *f;
@@ -7207,11 +7497,17 @@ static void jdf_generate_code_release_deps(const jdf_t *jdf, const jdf_function_
             "  arg.remote_deps = deps;\n"
             "#endif  /* defined(DISTRIBUTED) */\n"
             "  assert(NULL != es);\n"
-            "  if( action_mask & PARSEC_ACTION_RELEASE_LOCAL_DEPS )"
+            "  if( action_mask & PARSEC_ACTION_RELEASE_LOCAL_DEPS ) {\n"
             "    arg.ready_lists = alloca(sizeof(parsec_task_t *) * es->virtual_process->parsec_context->nb_vp);\n"
-            "  else\n"
+            "    arg.ready_counts = alloca(sizeof(int32_t) * es->virtual_process->parsec_context->nb_vp);\n"
+            "  } else {\n"
             "    arg.ready_lists = NULL;\n"
-            "  for( __vp_id = 0; __vp_id < es->virtual_process->parsec_context->nb_vp; arg.ready_lists[__vp_id++] = NULL );\n"
+            "    arg.ready_counts = NULL;\n"
+            "  }\n"
+            "  for( __vp_id = 0; __vp_id < es->virtual_process->parsec_context->nb_vp; __vp_id++ ) {\n"
+            "    arg.ready_lists[__vp_id] = NULL;\n"
+            "    arg.ready_counts[__vp_id] = 0;\n"
+            "  }\n"
             "  (void)__parsec_tp; (void)deps;\n",
             name, parsec_get_name(jdf, f, "task_t"),
             jdf_basename, jdf_basename);
@@ -7263,13 +7559,12 @@ static void jdf_generate_code_release_deps(const jdf_t *jdf, const jdf_function_
                     "      /* Using Dynamic Termination Detection, the DSL is reponsible of counting the number of tasks scheduled before scheduling them */\n"
                     "      int __nb_tasks = 0;\n"
                     "      for(__vp_id = 0; __vp_id < es->virtual_process->parsec_context->nb_vp; __vp_id++) {\n"
-                    "        if( NULL == arg.ready_lists[__vp_id] ) continue;\n"
-                    "        _LIST_ITEM_ITERATOR(arg.ready_lists[__vp_id], &arg.ready_lists[__vp_id]->super, __item, __nb_tasks++);"
+                    "        __nb_tasks += arg.ready_counts[__vp_id];\n"
                     "      }\n"
                     "      __parsec_tp->super.super.tdm.module->taskpool_addto_nb_tasks((parsec_taskpool_t*)__parsec_tp, __nb_tasks);\n"
                     "    }\n");
         }
-        coutput("    __parsec_schedule_vp(es, arg.ready_lists, 0);\n"
+        coutput("    __parsec_schedule_vp_chains(es, arg.ready_lists, arg.ready_counts, 0);\n"
                 "  }\n");
     } else {
         coutput("  /* No successors, don't call iterate_successors and don't release any local deps */\n");
@@ -7543,9 +7838,9 @@ static char *jdf_dump_context_assignment(string_arena_t *sa_open,
     string_arena_add_string(sa_open,
                             "%s%s  if( (NULL != es) && (rank_dst == es->virtual_process->parsec_context->my_rank) )\n"
                             "#endif /* DISTRIBUTED */\n"
-                            "%s%s    vpid_dst = ((parsec_data_collection_t*)"TASKPOOL_GLOBAL_PREFIX"_g_%s)->vpid_of((parsec_data_collection_t*)"TASKPOOL_GLOBAL_PREFIX"_g_%s, %s);\n",
+                            "%s%s    vpid_dst = vpid_of_%s(%s);\n",
                             prefix, indent(nbopen),
-                            prefix, indent(nbopen), targetf->predicate->func_or_mem, targetf->predicate->func_or_mem,
+                            prefix, indent(nbopen), targetf->predicate->func_or_mem,
                             UTIL_DUMP_LIST(sa2, targetf->predicate->parameters, next,
                                            dump_expr, (void*)&dest_info,
                                            "", "", ", ", ""));
@@ -7554,6 +7849,11 @@ static char *jdf_dump_context_assignment(string_arena_t *sa_open,
         string_arena_add_string(sa_open,
                                 "%s%s  %s.priority = __parsec_tp->super.super.priority + priority_of_%s_%s_as_expr_fct(__parsec_tp, &ncc->locals);\n",
                                 prefix, indent(nbopen), var, jdf_basename, targetf->fname);
+    } else if( JDF_COMPILER_GLOBAL_ARGS.auto_priority ) {
+        string_arena_add_string(sa_open,
+                                "%s%s  %s.priority = __parsec_tp->super.super.priority +\n"
+                                "%s%s    (parsec_runtime_auto_priority ? bottom_level_of_%s_%s(__parsec_tp, ncc) : 0);\n",
+                                prefix, indent(nbopen), var, prefix, indent(nbopen), jdf_basename, targetf->fname);
     } else {
         string_arena_add_string(sa_open, "%s%s  %s.priority = __parsec_tp->super.super.priority;\n",
                                 prefix, indent(nbopen), var);
@@ -8310,41 +8610,180 @@ static void jdf_check_user_defined_internals(jdf_t *jdf)
     }
 }
 
+/**
+ * The index arrays of the dependencies are allocated on the first access to
+ * each sub-range of the execution space, instead of for the whole space at
+ * the taskpool startup: only the sub-ranges holding tasks released on this
+ * rank are allocated. The bounds of a sub-range are the bounds of the range
+ * of the parameter, computed from the outer parameters of the task.
+ */
 static void
 jdf_generate_code_find_deps(const jdf_t *jdf,
                             const jdf_function_entry_t *f,
                             const char *name)
 {
     jdf_l2p_t *l2p = NULL, *l2p_item;
+    string_arena_t *sa1 = string_arena_new(64), *sa2 = string_arena_new(64);
+    string_arena_t *sa3 = string_arena_new(64), *sa4 = string_arena_new(64);
+    expr_info_t info = EMPTY_EXPR_INFO;
+    assignment_info_t ai;
+
+    info.sa = sa4;
+    info.prefix = "";
+    info.suffix = "";
+    info.assignments = "&task->locals";
+
+    ai.sa = sa2;
+    ai.holder = "task->locals.";
+    ai.expr = NULL;
+
     coutput("parsec_dependency_t*\n"
             "%s(const parsec_taskpool_t*__tp,\n"
             "   parsec_execution_stream_t *es,\n"
             "   const parsec_task_t* PARSEC_RESTRICT __task)\n"
             "{\n"
-            "  parsec_dependencies_t *deps;\n"
+            "  parsec_dependencies_t *deps, *new_deps, **deps_ptr;\n"
             "  (void)es;\n"
-            "  const parsec_%s_taskpool_t *__parsec_tp = (parsec_%s_taskpool_t*)__tp;\n"
+            "  const __parsec_%s_internal_taskpool_t *__parsec_tp = (const __parsec_%s_internal_taskpool_t*)__tp;\n"
             "  const __parsec_%s_%s_task_t* task = (__parsec_%s_%s_task_t*)__task;\n"
-            "  deps = %sdependencies_array[task->task_class->task_class_id];\n",
+            "  (void)__parsec_tp;\n"
+            "%s"
+            "  deps_ptr = (parsec_dependencies_t**)&__tp->dependencies_array[task->task_class->task_class_id];\n",
             name,
             jdf_basename, jdf_basename,
             jdf_basename, f->fname, jdf_basename, f->fname,
-            TASKPOOL_GLOBAL_PREFIX);
+            UTIL_DUMP_LIST(sa1, f->locals, next,
+                           dump_local_assignments, &ai, "", "  ", "\n", "\n"));
 
     l2p = build_l2p(f);
-    for(l2p_item = l2p; NULL != l2p_item->next; l2p_item = l2p_item->next) {
-        coutput("  assert( (deps->flags & PARSEC_DEPENDENCIES_FLAG_NEXT) != 0 );\n");
-        coutput("  deps = deps->u.next[task->locals.%s.value - deps->min];\n"
-                "  assert( NULL != deps );\n",
-                l2p_item->pl->name);
-    }
-    coutput("  return &(deps->u.dependencies[task->locals.%s.value - deps->min]);\n",
-            l2p_item->pl->name);
+    for(l2p_item = l2p; NULL != l2p_item; l2p_item = l2p_item->next) {
+        coutput("  if( NULL == (deps = *deps_ptr) ) {\n");
+        if( JDF_RANGE == l2p_item->vl->expr->op ) {
+            string_arena_init(sa1);
+            string_arena_add_string(sa1, "%s", dump_expr((void**)l2p_item->vl->expr->jdf_ta1, &info));
+            string_arena_init(sa3);
+            string_arena_add_string(sa3, "%s", dump_expr((void**)l2p_item->vl->expr->jdf_ta2, &info));
+            coutput("    ALLOCATE_DEP_TRACKING(new_deps, parsec_imin(%s, %s), parsec_imax(%s, %s), \"%s\", %s);\n",
+                    string_arena_get_string(sa1), string_arena_get_string(sa3),
+                    string_arena_get_string(sa1), string_arena_get_string(sa3),
+                    l2p_item->pl->name,
+                    NULL == l2p_item->next ? "PARSEC_DEPENDENCIES_FLAG_FINAL" : "PARSEC_DEPENDENCIES_FLAG_NEXT");
+        } else {
+            coutput("    ALLOCATE_DEP_TRACKING(new_deps, %s, %s, \"%s\", %s);\n",
+                    l2p_item->pl->name, l2p_item->pl->name, l2p_item->pl->name,
+                    NULL == l2p_item->next ? "PARSEC_DEPENDENCIES_FLAG_FINAL" : "PARSEC_DEPENDENCIES_FLAG_NEXT");
+        }
+        coutput("    if( parsec_atomic_cas_ptr(deps_ptr, NULL, new_deps) ) {\n"
+                "      deps = new_deps;\n"
+                "    } else {  /* allocated concurrently by another thread */\n"
+                "      free(new_deps);\n"
+                "      deps = *deps_ptr;\n"
+                "    }\n"
+                "  }\n");
+        if( NULL != l2p_item->next ) {
+            coutput("  assert( (deps->flags & PARSEC_DEPENDENCIES_FLAG_NEXT) != 0 );\n"
+                    "  deps_ptr = &deps->u.next[%s - deps->min];\n",
+                    l2p_item->pl->name);
+        } else {
+            coutput("  return &(deps->u.dependencies[%s - deps->min]);\n",
+                    l2p_item->pl->name);
+        }
+    }
     free_l2p(l2p);
     coutput("}\n\n");
+    string_arena_free(sa1);
+    string_arena_free(sa2);
+    string_arena_free(sa3);
+    string_arena_free(sa4);
     (void)jdf;
 }
 
+/**
+ * The number of input dependencies of a task, for the task classes that track
+ * their dependencies with a counter and whose number of inputs depends on the
+ * task. It is parsec_check_IN_dependencies_with_counter specialized for the
+ * task class: the flows and the dependencies are unrolled, and the guards and
+ * the control gathers are direct calls to their (inline) functions.
+ * Returns 0 if the task class uses guards with ranges, which are counted by
+ * iterating over the predecessors: the generic code is then used.
+ */
+static int
+jdf_generate_code_count_deps(const jdf_t *jdf,
+                             const jdf_function_entry_t *f,
+                             const char *name)
+{
+    const jdf_dataflow_t *fl;
+    const jdf_dep_t *dl;
+    const jdf_call_t *call;
+    const char *sep;
+    int nb_calls, c;
+
+    for( fl = f->dataflow; NULL != fl; fl = fl->next ) {
+        for( dl = fl->deps; NULL != dl; dl = dl->next ) {
+            if( (dl->dep_flags & JDF_DEP_FLOW_IN) && (NULL != dl->guard->guard) &&
+                jdf_expr_is_range(dl->guard->guard) )
+                return 0;
+        }
+    }
+
+    coutput("static parsec_dependency_t %s(const parsec_taskpool_t *__tp, const parsec_task_t *__task)\n"
+            "{\n"
+            "  const __parsec_%s_internal_taskpool_t *__parsec_tp = (const __parsec_%s_internal_taskpool_t*)__tp;\n"
+            "  const %s *locals = (const %s*)__task->locals;\n"
+            "  parsec_dependency_t nb = 0;\n"
+            "  (void)__parsec_tp; (void)locals;\n",
+            name, jdf_basename, jdf_basename,
+            parsec_get_name(jdf, f, "parsec_assignment_t"), parsec_get_name(jdf, f, "parsec_assignment_t"));
+
+    for( fl = f->dataflow; NULL != fl; fl = fl->next ) {
+        sep = "  ";
+        for( dl = fl->deps; NULL != dl; dl = dl->next ) {
+            if( !(dl->dep_flags & JDF_DEP_FLOW_IN) || JDF_IS_DEP_WRITE_ONLY_INPUT_TYPE(dl) )
+                continue;
+            if( 0 == strcmp(sep, "  ") )
+                coutput("  /* Flow %s */\n", fl->varname);
+            nb_calls = (JDF_GUARD_TERNARY == dl->guard->guard_type) ? 2 : 1;
+            if( fl->flow_flags & JDF_FLOW_TYPE_CTL ) {
+                /* All the controls with a true guard must be resolved */
+                if( JDF_GUARD_BINARY == dl->guard->guard_type )
+                    coutput("  if( %s_fct(__parsec_tp, locals) )", JDF_OBJECT_ONAME(dl->guard->guard));
+                coutput("  nb += ");
+                if( JDF_GUARD_TERNARY == dl->guard->guard_type )
+                    coutput("%s_fct(__parsec_tp, locals) ? ", JDF_OBJECT_ONAME(dl->guard->guard));
+                for( c = 0; c < nb_calls; c++ ) {
+                    call = (0 == c) ? dl->guard->calltrue : dl->guard->callfalse;
+                    if( NULL != jdf_input_call_range(call, dl) )
+                        coutput("ctl_gather_compute_for_dep_%s_fct(__parsec_tp, locals)", JDF_OBJECT_ONAME(call));
+                    else
+                        coutput("1");
+                    coutput("%s", (c + 1 < nb_calls) ? " : " : ";\n");
+                }
+                sep = "";
+            } else {
+                /* The first input with a true guard provides the data. It must be
+                 * waited for if it comes from a task, not from the memory. */
+                if( JDF_GUARD_BINARY == dl->guard->guard_type ) {
+                    coutput("%sif( %s_fct(__parsec_tp, locals) ) nb += %d;\n",
+                            sep, JDF_OBJECT_ONAME(dl->guard->guard), NULL != dl->guard->calltrue->var);
+                    sep = "  else ";
+                    continue;
+                }
+                if( (JDF_GUARD_TERNARY == dl->guard->guard_type) &&
+                    ((NULL != dl->guard->calltrue->var) != (NULL != dl->guard->callfalse->var)) )
+                    coutput("%snb += %s_fct(__parsec_tp, locals) ? %d : %d;\n",
+                            sep, JDF_OBJECT_ONAME(dl->guard->guard),
+                            NULL != dl->guard->calltrue->var, NULL != dl->guard->callfalse->var);
+                else
+                    coutput("%snb += %d;\n", sep, NULL != dl->guard->calltrue->var);
+                break;  /* the next inputs are never used */
+            }
+        }
+    }
+    coutput("  return nb;\n"
+            "}\n\n");
+    return 1;
+}
+
 /**
  * Analyze the code to optimize the output
  */
@@ -8566,6 +9005,7 @@ int jdf2c(const char *output_c, const char *output_h, const char *_jdf_basename,
     jdf_generate_inline_c_functions(jdf);
     jdf_generate_makekey_and_hashstruct(jdf);
     jdf_generate_priority_prototypes(jdf);
+    jdf_generate_bottom_levels(jdf);
     jdf_generate_functions_statics(jdf); // PETER generates startup tasks
     jdf_generate_startup_hook(jdf);
 
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2009-2022 The University of Tennessee and The University
+ * Copyright (c) 2009-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  */
@@ -92,6 +92,11 @@ static void usage(void)
             "                     in the source code (default don't)\n"
             "  --ignore-property  List (comma separated) of properties to ignore in the JDF\n"
             "                     (default none)\n"
+            "  --auto-priority    Estimate the bottom level (longest path to the end of the DAG)\n"
+            "                     of the tasks without a priority expression, and use it as their\n"
+            "                     priority (see the runtime_auto_priority MCA parameter)\n"
+            "  --count-deps       Track the dependencies of all the tasks with a counter, as\n"
+            "                     with the count_deps property, instead of a mask\n"
             "\n",
             DEFAULTS.input,
             DEFAULTS.output_c,
@@ -195,6 +200,8 @@ static void parse_args(int argc, char *argv[])
         { "force-profile", no_argument,             NULL,   2  },
         { "ignore-properties", required_argument,   NULL,  'I' },
         { "dynamic-termdet", no_argument,           NULL,  'D' },
+        { "auto-priority", no_argument,             NULL,   3  },
+        { "count-deps",    no_argument,             NULL,   4  },
         { NULL,            0,                       NULL,   0  }
     };
 
@@ -251,6 +258,12 @@ static void parse_args(int argc, char *argv[])
         case 2:
             add_to_ignore_properties("profile");
             break;
+        case 3:
+            JDF_COMPILER_GLOBAL_ARGS.auto_priority = 1;
+            break;
+        case 4:
+            JDF_COMPILER_GLOBAL_ARGS.count_deps = 1;
+            break;
         case 'E':
             /* Don't compile the preprocessed file, instead stop after the preprocessing stage */
             JDF_COMPILER_GLOBAL_ARGS.compile = 0;
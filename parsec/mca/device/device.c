@@ -78,6 +78,19 @@ static int64_t time_estimate(const parsec_task_t *this_task, parsec_device_modul
     return dev->time_estimate_default;
 }
 
+int64_t parsec_mca_device_task_weight(const parsec_task_t *this_task)
+{
+    parsec_device_module_t *dev = parsec_device_cpus;
+    int64_t estimate;
+
+    if( (NULL == dev) || (NULL == this_task->task_class->time_estimate) )
+        return 1;
+    estimate = time_estimate(this_task, dev);
+    if( dev->time_estimate_default > 1 )
+        estimate /= dev->time_estimate_default;
+    return (estimate > 1) ? estimate : 1;
+}
+
 /**
  * Find the best device to execute the kernel based on the compute
  * capability of the device.
@@ -205,6 +205,13 @@ extern int parsec_device_output;
  */
 PARSEC_DECLSPEC extern int parsec_select_best_device( parsec_task_t* this_task);
 
+/**
+ * Weight of this_task relative to a task of the default cost, computed from
+ * the time_estimate of its task class on the first CPU device. Tasks without
+ * a time_estimate, or with an estimate below the default, weight 1.
+ */
+PARSEC_DECLSPEC extern int64_t parsec_mca_device_task_weight(const parsec_task_t *this_task);
+
 /**
  * Initialize the internal structures for managing external devices such as
  * accelerators and GPU. Memory nodes can as well be managed using the same
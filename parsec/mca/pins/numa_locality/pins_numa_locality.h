@@ -0,0 +1,26 @@
+#ifndef PINS_NUMA_LOCALITY_H
+#define PINS_NUMA_LOCALITY_H
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+#include "parsec/parsec_config.h"
+#include "parsec/runtime.h"
+#include "parsec/mca/mca.h"
+#include "parsec/mca/pins/pins.h"
+
+BEGIN_C_DECLS
+
+/**
+ * Globally exported variable
+ */
+PARSEC_DECLSPEC extern const parsec_pins_base_component_t parsec_pins_numa_locality_component;
+PARSEC_DECLSPEC extern const parsec_pins_module_t parsec_pins_numa_locality_module;
+/* static accessor */
+mca_base_component_t * pins_numa_locality_static_component(void);
+
+END_C_DECLS
+
+#endif
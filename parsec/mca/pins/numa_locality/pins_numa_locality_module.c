@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+/*
+ * Count, for each execution stream, the tasks executed on the NUMA node
+ * holding most of their input data (local), on another node (remote), or
+ * whose input data location is unknown. The counters are printed when the
+ * execution streams terminate, and the totals for the process at the end.
+ */
+
+#include "pins_numa_locality.h"
+#include "parsec/mca/pins/pins.h"
+#include "parsec/utils/debug.h"
+#include "parsec/execution_stream.h"
+#include "parsec/scheduling.h"
+#include "parsec/sys/atomic.h"
+
+static void pins_init_numa_locality(parsec_context_t* master_context);
+static void pins_fini_numa_locality(parsec_context_t* master_context);
+static void pins_thread_init_numa_locality(parsec_execution_stream_t* es);
+static void pins_thread_fini_numa_locality(parsec_execution_stream_t* es);
+
+const parsec_pins_module_t parsec_pins_numa_locality_module = {
+    &parsec_pins_numa_locality_component,
+    {
+        pins_init_numa_locality,
+        pins_fini_numa_locality,
+        NULL,
+        NULL,
+        pins_thread_init_numa_locality,
+        pins_thread_fini_numa_locality
+    },
+    { NULL }
+};
+
+typedef struct parsec_pins_numa_locality_data_s {
+    parsec_pins_next_callback_t cb_data;
+    int64_t local;
+    int64_t remote;
+    int64_t unknown;
+} parsec_pins_numa_locality_data_t;
+
+static volatile int64_t total_local, total_remote, total_unknown;
+
+static void numa_locality_exec_begin(parsec_execution_stream_t* es,
+                                     parsec_task_t* task,
+                                     parsec_pins_next_callback_t* data);
+
+static void pins_init_numa_locality(parsec_context_t* master)
+{
+    (void)master;
+    total_local = total_remote = total_unknown = 0;
+}
+
+static void pins_fini_numa_locality(parsec_context_t* master)
+{
+    parsec_inform("NUMA locality on rank %d: %lld local, %lld remote, %lld unknown task executions",
+                  master->my_rank, (long long)total_local, (long long)total_remote, (long long)total_unknown);
+}
+
+static void pins_thread_init_numa_locality(parsec_execution_stream_t* es)
+{
+    parsec_pins_numa_locality_data_t* event_cb =
+        (parsec_pins_numa_locality_data_t*)calloc(1, sizeof(parsec_pins_numa_locality_data_t));
+    PARSEC_PINS_REGISTER(es, EXEC_BEGIN, numa_locality_exec_begin,
+                         (parsec_pins_next_callback_t*)event_cb);
+}
+
+static void pins_thread_fini_numa_locality(parsec_execution_stream_t* es)
+{
+    parsec_pins_numa_locality_data_t* event_cb;
+    PARSEC_PINS_UNREGISTER(es, EXEC_BEGIN, numa_locality_exec_begin,
+                           (parsec_pins_next_callback_t**)&event_cb);
+    if( NULL == event_cb )
+        return;
+
+    parsec_debug_verbose(3, parsec_debug_output,
+                         "NUMA locality of thread %d of VP %d (NUMA node %d): %lld local, %lld remote, %lld unknown",
+                         es->th_id, es->virtual_process->vp_id, es->numa_id,
+                         (long long)event_cb->local, (long long)event_cb->remote, (long long)event_cb->unknown);
+    parsec_atomic_fetch_add_int64(&total_local, event_cb->local);
+    parsec_atomic_fetch_add_int64(&total_remote, event_cb->remote);
+    parsec_atomic_fetch_add_int64(&total_unknown, event_cb->unknown);
+    free(event_cb);
+}
+
+static void numa_locality_exec_begin(parsec_execution_stream_t* es,
+                                     parsec_task_t* task,
+                                     parsec_pins_next_callback_t* data)
+{
+    parsec_pins_numa_locality_data_t* event_cb = (parsec_pins_numa_locality_data_t*)data;
+    int node = parsec_task_locality_hint(task);
+
+    if( node < 0 || es->numa_id < 0 )
+        event_cb->unknown++;
+    else if( node == es->numa_id )
+        event_cb->local++;
+    else
+        event_cb->remote++;
+}
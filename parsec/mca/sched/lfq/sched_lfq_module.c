@@ -45,7 +45,8 @@ const parsec_sched_module_t parsec_sched_lfq_module = {
         sched_lfq_schedule,
         sched_lfq_select,
         NULL,
-        sched_lfq_remove
+        sched_lfq_remove,
+        NULL
     }
 };
 
@@ -45,7 +45,8 @@ const parsec_sched_module_t parsec_sched_lhq_module = {
         sched_lhq_schedule,
         sched_lhq_select,
         NULL,
-        sched_lhq_remove
+        sched_lhq_remove,
+        NULL
     }
 };
 
@@ -43,7 +43,8 @@ const parsec_sched_module_t parsec_sched_ll_module = {
         sched_ll_schedule,
         sched_ll_select,
         NULL,
-        sched_ll_remove
+        sched_ll_remove,
+        NULL
     }
 };
 
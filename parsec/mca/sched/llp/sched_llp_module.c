@@ -75,7 +75,8 @@ const parsec_sched_module_t parsec_sched_llp_module = {
         sched_llp_schedule,
         sched_llp_select,
         NULL,
-        sched_llp_remove
+        sched_llp_remove,
+        NULL
     }
 };
 
@@ -47,7 +47,8 @@ const parsec_sched_module_t parsec_sched_ltq_module = {
         sched_ltq_schedule,
         sched_ltq_select,
         NULL,
-        sched_ltq_remove
+        sched_ltq_remove,
+        NULL
     }
 };
 
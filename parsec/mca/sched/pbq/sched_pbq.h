@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2017 The University of Tennessee and The University
+ * Copyright (c) 2013-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * $COPYRIGHT$
@@ -35,6 +35,9 @@ PARSEC_DECLSPEC extern const parsec_sched_module_t parsec_sched_pbq_module;
 /* static accessor */
 mca_base_component_t *sched_pbq_static_component(void);
 
+/* MCA tunables, registered by the component */
+extern int parsec_sched_pbq_multiqueue;
+
 
 END_C_DECLS
 #endif /* MCA_SCHED_PBQ_H */
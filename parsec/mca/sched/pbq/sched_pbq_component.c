@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2022 The University of Tennessee and The University
+ * Copyright (c) 2013-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * $COPYRIGHT$
@@ -21,6 +21,7 @@
 #include "parsec/mca/sched/sched.h"
 #include "parsec/mca/sched/pbq/sched_pbq.h"
 #include "parsec/papi_sde.h"
+#include "parsec/utils/mca_param.h"
 
 /*
  * Local function
@@ -76,6 +77,11 @@ static int sched_pbq_component_query(mca_base_module_t **module, int *priority)
 
 static int sched_pbq_component_register(void)
 {
+    parsec_mca_param_reg_int_name("sched_pbq", "multiqueue",
+                                  "Number of heaps per stream of a relaxed concurrent priority queue (MultiQueue) "
+                                  "shared by the streams of a virtual process, used instead of the per-stream "
+                                  "bounded buffers (0: use the bounded buffers)",
+                                  false, false, parsec_sched_pbq_multiqueue, &parsec_sched_pbq_multiqueue);
     PARSEC_PAPI_SDE_DESCRIBE_COUNTER("SCHEDULER::PENDING_TASKS::SCHED=PBQ",
                               "the number of pending tasks for the PBQ scheduler");
     PARSEC_PAPI_SDE_DESCRIBE_COUNTER("SCHEDULER::PENDING_TASKS::QUEUE=<VPID>/<QID>::SCHED=PBQ",
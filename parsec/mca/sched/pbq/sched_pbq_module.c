@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2013-2022 The University of Tennessee and The University
+ * Copyright (c) 2013-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * Copyright (c) 2024      NVIDIA Corporation.  All rights reserved.
@@ -24,6 +24,8 @@
 #include "parsec/parsec_hwloc.h"
 #include "parsec/papi_sde.h"
 
+int parsec_sched_pbq_multiqueue = 0;
+
 /**
  * Module functions
  */
@@ -31,6 +33,10 @@ static int sched_pbq_install(parsec_context_t* master);
 static int sched_pbq_schedule(parsec_execution_stream_t* es,
                               parsec_task_t* new_context,
                               int32_t distance);
+static int sched_pbq_schedule_chain(parsec_execution_stream_t* es,
+                                    parsec_task_t* new_context,
+                                    int32_t nb_tasks,
+                                    int32_t distance);
 static parsec_task_t *sched_pbq_select(parsec_execution_stream_t *es,
                                                     int32_t* distance);
 static int flow_pbq_init(parsec_execution_stream_t* es, struct parsec_barrier_t* barrier);
@@ -44,7 +50,8 @@ const parsec_sched_module_t parsec_sched_pbq_module = {
         sched_pbq_schedule,
         sched_pbq_select,
         NULL,
-        sched_pbq_remove
+        sched_pbq_remove,
+        sched_pbq_schedule_chain
     }
 };
 
@@ -66,6 +73,11 @@ static int flow_pbq_init(parsec_execution_stream_t* es, struct parsec_barrier_t*
     es->scheduler_object = sched_obj;
     if( es->th_id == 0 ) { /* And flow 0 creates the system_queue */
         sched_obj->system_queue = PARSEC_OBJ_NEW(parsec_dequeue_t);
+        if( parsec_sched_pbq_multiqueue > 0 ) {
+            sched_obj->multiqueue = PARSEC_OBJ_NEW(parsec_multiqueue_t);
+            parsec_multiqueue_init(sched_obj->multiqueue, parsec_execution_context_priority_comparator,
+                                   parsec_sched_pbq_multiqueue * vp->nb_cores);
+        }
     }
 
     sched_obj->nb_hierarch_queues = vp->nb_cores;
@@ -78,6 +90,7 @@ static int flow_pbq_init(parsec_execution_stream_t* es, struct parsec_barrier_t*
 
     /* Get the flow 0 system queue and store it locally */
     sched_obj->system_queue = PARSEC_MCA_SCHED_LOCAL_QUEUES_OBJECT(vp->execution_streams[0])->system_queue;
+    sched_obj->multiqueue = PARSEC_MCA_SCHED_LOCAL_QUEUES_OBJECT(vp->execution_streams[0])->multiqueue;
 
     /* Each thread creates its own "local" queue, connected to the shared dequeue */
     sched_obj->task_queue = parsec_hbbuffer_new( queue_size, 1, parsec_mca_sched_push_in_system_queue_wrapper,
@@ -162,6 +175,13 @@ sched_pbq_select( parsec_execution_stream_t *es,
 {
     parsec_task_t *task = NULL;
     int i;
+
+    if( NULL != PARSEC_MCA_SCHED_LOCAL_QUEUES_OBJECT(es)->multiqueue ) {
+        /* the MultiQueue balances the load by itself */
+        *distance = 0;
+        return (parsec_task_t*)parsec_multiqueue_pop(PARSEC_MCA_SCHED_LOCAL_QUEUES_OBJECT(es)->multiqueue,
+                                                     &es->rand_seed);
+    }
     task = (parsec_task_t*)parsec_hbbuffer_pop_best(PARSEC_MCA_SCHED_LOCAL_QUEUES_OBJECT(es)->task_queue,
                                                     parsec_execution_context_priority_comparator);
     if( NULL != task ) {
@@ -191,12 +211,34 @@ static int sched_pbq_schedule(parsec_execution_stream_t* es,
                               parsec_task_t* new_context,
                               int32_t distance)
 {
+    if( NULL != PARSEC_MCA_SCHED_LOCAL_QUEUES_OBJECT(es)->multiqueue ) {
+        parsec_multiqueue_push_all(PARSEC_MCA_SCHED_LOCAL_QUEUES_OBJECT(es)->multiqueue,
+                                   (parsec_list_item_t*)new_context, &es->rand_seed);
+        return PARSEC_SUCCESS;
+    }
     parsec_hbbuffer_push_all_by_priority( PARSEC_MCA_SCHED_LOCAL_QUEUES_OBJECT(es)->task_queue,
                                           (parsec_list_item_t*)new_context,
                                           distance);
     return PARSEC_SUCCESS;
 }
 
+static int sched_pbq_schedule_chain(parsec_execution_stream_t* es,
+                                    parsec_task_t* new_context,
+                                    int32_t nb_tasks,
+                                    int32_t distance)
+{
+    (void)nb_tasks;
+    if( NULL != PARSEC_MCA_SCHED_LOCAL_QUEUES_OBJECT(es)->multiqueue ) {
+        parsec_multiqueue_push_all(PARSEC_MCA_SCHED_LOCAL_QUEUES_OBJECT(es)->multiqueue,
+                                   (parsec_list_item_t*)new_context, &es->rand_seed);
+        return PARSEC_SUCCESS;
+    }
+    parsec_hbbuffer_push_all_sorted_by_priority( PARSEC_MCA_SCHED_LOCAL_QUEUES_OBJECT(es)->task_queue,
+                                                 (parsec_list_item_t*)new_context,
+                                                 distance);
+    return PARSEC_SUCCESS;
+}
+
 static void sched_pbq_remove( parsec_context_t *master )
 {
     int p, t;
@@ -213,8 +255,12 @@ static void sched_pbq_remove( parsec_context_t *master )
             if( es->th_id == 0 ) {
                 PARSEC_OBJ_DESTRUCT( sched_obj->system_queue );
                 free( sched_obj->system_queue );
+                if( NULL != sched_obj->multiqueue ) {
+                    PARSEC_OBJ_RELEASE( sched_obj->multiqueue );
+                }
             }
             sched_obj->system_queue = NULL;
+            sched_obj->multiqueue = NULL;
 
             parsec_hbbuffer_destruct( sched_obj->task_queue );
             sched_obj->task_queue = NULL;
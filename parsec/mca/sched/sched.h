@@ -266,6 +266,40 @@ typedef int  (*parsec_sched_base_module_schedule_fn_t)
                  (parsec_execution_stream_t* es,
                   parsec_task_t* new_context,
                   int32_t distance);
+/**
+ * @brief Bulk scheduling function (optional)
+ *
+ * @details
+ * Same as the scheduling function, but the runtime guarantees that
+ * new_context is a ring of exactly nb_tasks tasks, sorted by decreasing
+ * priority (this is how the release of the dependencies of a task builds
+ * the set of its ready successors). The scheduler can thus insert the whole
+ * ring at once, e.g. by splicing it in its structures with a single atomic
+ * operation, without walking the ring to count the tasks or sorting it
+ * again.
+ *
+ * This function may be NULL, in which case the runtime uses the scheduling
+ * function. Only ws (a single store of the bottom of the deque) and pbq (one
+ * pass over the empty slots of its bounded buffer, without sorting again)
+ * provide it. The other schedulers insert the ring through their scheduling
+ * function. lfq (the default) and lhq already place the ring with one pass
+ * over their bounded buffer, one atomic per filled slot, and push the
+ * overflow to the system queue as one chain; ltq has to walk the ring anyway
+ * to group the tasks in heaps. The count gives them nothing more.
+ *
+ * @param[inout] eu_context the current execution stream
+ * @param[inout] new_context a double-linked ring of ready tasks, sorted by
+ *               decreasing priority.
+ * @param[in]    nb_tasks the number of tasks in new_context
+ * @param[in]    distance a (mandatory) hint for the scheduler that enables
+ *               fairness, see @ref parsec_sched_base_module_schedule_fn_t
+ * @return PARSEC_SUCCESS on success; an error code in case of error (which is fatal).
+ */
+typedef int  (*parsec_sched_base_module_schedule_chain_fn_t)
+                 (parsec_execution_stream_t* es,
+                  parsec_task_t* new_context,
+                  int32_t nb_tasks,
+                  int32_t distance);
 /**
  * @brief Selecting Function
  *
@@ -329,6 +363,7 @@ struct parsec_sched_base_module_1_0_0_t {
     parsec_sched_base_module_select_fn_t       select;
     parsec_sched_base_module_stats_fn_t        display_stats;
     parsec_sched_base_module_remove_fn_t       remove;
+    parsec_sched_base_module_schedule_chain_fn_t schedule_chain;  /**< optional, may be NULL */
 };
 
 typedef struct parsec_sched_base_module_1_0_0_t parsec_sched_base_module_1_0_0_t;
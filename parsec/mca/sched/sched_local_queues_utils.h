@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2022 The University of Tennessee and The University
+ * Copyright (c) 2013-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * $COPYRIGHT$
@@ -20,6 +20,7 @@
 
 #include "parsec/parsec_config.h"
 #include "parsec/hbbuffer.h"
+#include "parsec/class/parsec_multiqueue.h"
 
 typedef struct {
     parsec_dequeue_t   *system_queue;               /* The overflow queue itself. */
@@ -31,6 +32,9 @@ typedef struct {
     parsec_hbbuffer_t  *task_queue;                 /* The lowest level bounded buffer, local to this thread only */
     int                 nb_hierarch_queues;         /* The number of bounded buffers -- algorithm dependent */
     parsec_hbbuffer_t **hierarch_queues;            /* The entire set of bounded buffers */
+    parsec_multiqueue_t *multiqueue;                /* If not NULL, the relaxed priority queue shared by the
+                                                     * streams of the virtual process, used instead of the
+                                                     * bounded buffers -- algorithm dependent */
 } parsec_mca_sched_local_queues_scheduler_object_t;
 
 #define PARSEC_MCA_SCHED_LOCAL_QUEUES_OBJECT(eu_context) ((parsec_mca_sched_local_queues_scheduler_object_t*)(eu_context)->scheduler_object)
@@ -91,7 +91,8 @@ const parsec_sched_module_t parsec_sched_spq_module = {
         sched_spq_schedule,
         sched_spq_select,
         NULL,
-        sched_spq_remove
+        sched_spq_remove,
+        NULL
     }
 };
 
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ * 
+ * Additional copyrights may follow
+ * 
+ * $HEADER$
+ */
+
+/**
+ * @file
+ *
+ * Work Stealing Scheduler (Chase-Lev deques)
+ *
+ */
+
+
+#ifndef MCA_SCHED_WS_H
+#define MCA_SCHED_WS_H
+
+#include "parsec/parsec_config.h"
+#include "parsec/mca/mca.h"
+#include "parsec/mca/sched/sched.h"
+
+
+BEGIN_C_DECLS
+
+/**
+ * Globally exported variable
+ */
+PARSEC_DECLSPEC extern const parsec_sched_base_component_t parsec_sched_ws_component;
+PARSEC_DECLSPEC extern const parsec_sched_module_t parsec_sched_ws_module;
+/* static accessor */
+mca_base_component_t *sched_ws_static_component(void);
+
+/* MCA tunables, registered by the component */
+extern int parsec_sched_ws_deque_size;
+extern int parsec_sched_ws_steal_half;
+
+
+END_C_DECLS
+#endif /* MCA_SCHED_WS_H */
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ * 
+ * Additional copyrights may follow
+ * 
+ * $HEADER$
+ *
+ * These symbols are in a file by themselves to provide nice linker
+ * semantics.  Since linkers generally pull in symbols by object
+ * files, keeping these symbols as the only symbols in this file
+ * prevents utility programs such as "ompi_info" from having to import
+ * entire components just to query their version and parameters.
+ */
+
+#include "parsec/parsec_config.h"
+#include "parsec/runtime.h"
+
+#include "parsec/mca/sched/sched.h"
+#include "parsec/mca/sched/ws/sched_ws.h"
+#include "parsec/papi_sde.h"
+#include "parsec/utils/mca_param.h"
+
+/*
+ * Local function
+ */
+static int sched_ws_component_query(mca_base_module_t **module, int *priority);
+static int sched_ws_component_register(void);
+
+/*
+ * Instantiate the public struct with all of our public information
+ * and pointers to our public functions in it
+ */
+const parsec_sched_base_component_t parsec_sched_ws_component = {
+
+    /* First, the mca_component_t struct containing meta information
+       about the component itself */
+
+    {
+        PARSEC_SCHED_BASE_VERSION_2_0_0,
+
+        /* Component name and version */
+        "ws",
+        "", /* options */
+        PARSEC_VERSION_MAJOR,
+        PARSEC_VERSION_MINOR,
+
+        /* Component open and close functions */
+        NULL, /*< No open: sched_ws is always available, no need to check at runtime */
+        NULL, /*< No close: open did not allocate any resource, no need to release them */
+        sched_ws_component_query, 
+        /*< specific query to return the module and add it to the list of available modules */
+        sched_ws_component_register,
+        "", /*< no reserve */
+    },
+    {
+        /* The component has no metada */
+        MCA_BASE_METADATA_PARAM_NONE,
+        "", /*< no reserve */
+    }
+};
+
+mca_base_component_t *sched_ws_static_component(void)
+{
+    return (mca_base_component_t *)&parsec_sched_ws_component;
+}
+
+static int sched_ws_component_query(mca_base_module_t **module, int *priority)
+{
+    /* module type should be: const mca_base_module_t ** */
+    void *ptr = (void*)&parsec_sched_ws_module;
+    *priority = 14;
+    *module = (mca_base_module_t *)ptr;
+    return MCA_SUCCESS;
+}
+
+static int sched_ws_component_register(void)
+{
+    parsec_mca_param_reg_int_name("sched_ws", "deque_size",
+                                  "Initial number of slots (rounded up to a power of 2) of the per-stream work stealing "
+                                  "deques. The deques grow as needed, this only sets the starting capacity",
+                                  false, false, parsec_sched_ws_deque_size, &parsec_sched_ws_deque_size);
+    parsec_mca_param_reg_int_name("sched_ws", "steal_half",
+                                  "When stealing, take up to half of the victim's deque in a single "
+                                  "attempt instead of a single task (0: steal one, 1: steal half)",
+                                  false, false, parsec_sched_ws_steal_half, &parsec_sched_ws_steal_half);
+    return MCA_SUCCESS;
+}
@@ -0,0 +1,438 @@
+/**
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ */
+
+#include "parsec/parsec_config.h"
+#include "parsec/parsec_internal.h"
+#include "parsec/utils/debug.h"
+#include "parsec/class/lifo.h"
+#include "parsec/class/dequeue.h"
+#include "parsec/sys/atomic.h"
+
+#include "parsec/mca/sched/sched.h"
+#include "parsec/mca/sched/ws/sched_ws.h"
+#include "parsec/mca/pins/pins.h"
+#include "parsec/parsec_hwloc.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+int parsec_sched_ws_deque_size = 256;
+int parsec_sched_ws_steal_half = 1;
+
+/**
+ * Module functions
+ */
+static int sched_ws_install(parsec_context_t* master);
+static int sched_ws_schedule(parsec_execution_stream_t* es,
+                             parsec_task_t* new_context,
+                             int32_t distance);
+static int sched_ws_schedule_chain(parsec_execution_stream_t* es,
+                                   parsec_task_t* new_context,
+                                   int32_t nb_tasks,
+                                   int32_t distance);
+static parsec_task_t*
+sched_ws_select(parsec_execution_stream_t *es,
+                int32_t* distance);
+static void sched_ws_remove(parsec_context_t* master);
+static int flow_ws_init(parsec_execution_stream_t* es, struct parsec_barrier_t* barrier);
+
+const parsec_sched_module_t parsec_sched_ws_module = {
+    &parsec_sched_ws_component,
+    {
+        sched_ws_install,
+        flow_ws_init,
+        sched_ws_schedule,
+        sched_ws_select,
+        NULL,
+        sched_ws_remove,
+        sched_ws_schedule_chain
+    }
+};
+
+#define SCHED_WS_CACHE_LINE 64
+
+/**
+ * @brief Circular array backing a Chase-Lev deque.
+ *
+ * @details When the owner needs more room it allocates a buffer twice as
+ *   large, copies the live range and publishes the new buffer. Thieves may
+ *   still be reading from the old one, so retired buffers are chained
+ *   through prev and only released when the scheduler is removed.
+ */
+typedef struct sched_ws_buffer_s {
+    struct sched_ws_buffer_s *prev;
+    int64_t                   mask;
+    parsec_task_t * volatile  tasks[1];
+} sched_ws_buffer_t;
+
+/**
+ * @brief Per execution stream scheduler object.
+ *
+ * @details
+ *   - deque: Chase-Lev work stealing deque. Only the owning stream pushes
+ *     and pops at the bottom, any other stream of the VP steals from the top.
+ *   - inbox: tasks scheduled on this stream by another thread (e.g. the
+ *     communication thread, or a reschedule). They cannot be pushed into the
+ *     deque by a non-owner, so they transit through a lock-free LIFO that is
+ *     drained by the owner and is also visible to thieves.
+ *   - system_queue: shared by the whole VP, holds the tasks scheduled with a
+ *     non zero distance, so that they are only considered once all deques
+ *     are empty.
+ *   - victims: other streams of the VP, sorted by hwloc distance. victims
+ *     with the same distance form a level, described by level_end. Thieves
+ *     visit levels from the closest to the farthest, and pick a random
+ *     starting victim inside each level.
+ */
+typedef struct {
+    volatile int64_t             top;
+    char                         pad0[SCHED_WS_CACHE_LINE - sizeof(int64_t)];
+    volatile int64_t             bottom;
+    sched_ws_buffer_t * volatile buffer;
+    char                         pad1[SCHED_WS_CACHE_LINE - sizeof(int64_t) - sizeof(void*)];
+    parsec_lifo_t               *inbox;
+    parsec_dequeue_t            *system_queue;
+    int                          nb_victims;
+    int                          nb_levels;
+    int                         *victims;
+    int                         *level_end;
+} sched_ws_object_t;
+
+#define SCHED_WS_OBJECT(es) ((sched_ws_object_t*)(es)->scheduler_object)
+
+static sched_ws_buffer_t *sched_ws_buffer_new(int64_t size)
+{
+    sched_ws_buffer_t *b = (sched_ws_buffer_t*)calloc(1, sizeof(sched_ws_buffer_t) + (size-1) * sizeof(parsec_task_t*));
+    b->mask = size - 1;
+    return b;
+}
+
+/**
+ * @brief Owner-only: grow the deque to twice its size.
+ */
+static sched_ws_buffer_t *sched_ws_deque_grow(sched_ws_object_t *obj, int64_t top, int64_t bottom)
+{
+    sched_ws_buffer_t *old = obj->buffer;
+    sched_ws_buffer_t *b = sched_ws_buffer_new(2 * (old->mask + 1));
+    for(int64_t i = top; i < bottom; i++)
+        b->tasks[i & b->mask] = old->tasks[i & old->mask];
+    b->prev = old;
+    parsec_atomic_wmb();
+    obj->buffer = b;
+    PARSEC_DEBUG_VERBOSE(20, parsec_debug_output, "WS\t: deque %p grown to %"PRId64" slots",
+                         obj, b->mask + 1);
+    return b;
+}
+
+/**
+ * @brief Owner-only: push a single task at the bottom of the deque.
+ */
+static inline void sched_ws_deque_push(sched_ws_object_t *obj, parsec_task_t *task)
+{
+    int64_t b = obj->bottom;
+    int64_t t = obj->top;
+    sched_ws_buffer_t *buf = obj->buffer;
+
+    if( (b - t) > buf->mask ) {
+        buf = sched_ws_deque_grow(obj, t, b);
+    }
+    buf->tasks[b & buf->mask] = task;
+    parsec_atomic_wmb();
+    obj->bottom = b + 1;
+}
+
+/**
+ * @brief Owner-only: push a ring of nb tasks at the bottom of the deque.
+ *
+ * @details The deque is grown at most once, the tasks are stored from the
+ *   tail to the head of the ring, so that the head is the next one to be
+ *   popped, and they are all published to the thieves with a single update
+ *   of bottom.
+ */
+static inline void sched_ws_deque_push_chain(sched_ws_object_t *obj, parsec_list_item_t *ring, int32_t nb)
+{
+    int64_t b = obj->bottom;
+    int64_t t = obj->top;
+    sched_ws_buffer_t *buf = obj->buffer;
+    parsec_list_item_t *elt, *prev;
+
+    while( (b - t) + nb > buf->mask + 1 ) {
+        buf = sched_ws_deque_grow(obj, t, b);
+    }
+    elt = (parsec_list_item_t*)ring->list_prev;
+    for(int32_t i = 0; i < nb; i++) {
+        prev = (parsec_list_item_t*)elt->list_prev;
+        parsec_list_item_ring_chop(elt);
+        PARSEC_LIST_ITEM_SINGLETON(elt);
+        buf->tasks[(b + i) & buf->mask] = (parsec_task_t*)elt;
+        elt = prev;
+    }
+    parsec_atomic_wmb();
+    obj->bottom = b + nb;
+}
+
+/**
+ * @brief Owner-only: pop the most recently pushed task.
+ */
+static inline parsec_task_t *sched_ws_deque_pop(sched_ws_object_t *obj)
+{
+    int64_t b = obj->bottom - 1;
+    sched_ws_buffer_t *buf = obj->buffer;
+    parsec_task_t *task;
+    int64_t t;
+
+    obj->bottom = b;
+    parsec_mfence();
+    t = obj->top;
+    if( t > b ) {
+        /* Empty deque */
+        obj->bottom = b + 1;
+        return NULL;
+    }
+    task = buf->tasks[b & buf->mask];
+    if( t == b ) {
+        /* Last element: race against the thieves for it */
+        if( !parsec_atomic_cas_int64(&obj->top, t, t + 1) )
+            task = NULL;
+        obj->bottom = b + 1;
+    }
+    return task;
+}
+
+/**
+ * @brief Thief: steal the oldest task from a victim deque.
+ *
+ * @return the stolen task, or NULL if the deque was empty or if the steal
+ *   lost a race with the owner or another thief. *left is set to the number
+ *   of tasks observed in the deque before the steal.
+ */
+static inline parsec_task_t *sched_ws_deque_steal(sched_ws_object_t *obj, int64_t *left)
+{
+    int64_t t = obj->top;
+    parsec_mfence();
+    int64_t b = obj->bottom;
+    sched_ws_buffer_t *buf;
+    parsec_task_t *task;
+
+    *left = b - t;
+    if( t >= b )
+        return NULL;
+    parsec_atomic_rmb();
+    buf = obj->buffer;
+    task = buf->tasks[t & buf->mask];
+    if( !parsec_atomic_cas_int64(&obj->top, t, t + 1) )
+        return NULL;
+    return task;
+}
+
+static int sched_ws_install( parsec_context_t *master )
+{
+    (void)master;
+    return PARSEC_SUCCESS;
+}
+
+static int flow_ws_init(parsec_execution_stream_t* es, struct parsec_barrier_t* barrier)
+{
+    sched_ws_object_t *sched_obj;
+    parsec_vp_t *vp = es->virtual_process;
+    int64_t size = 2;
+    int *dist, i, j, nv;
+
+    if( 0 != posix_memalign((void**)&sched_obj, SCHED_WS_CACHE_LINE, sizeof(sched_ws_object_t)) ) {
+        return PARSEC_ERR_OUT_OF_RESOURCE;
+    }
+    memset(sched_obj, 0, sizeof(sched_ws_object_t));
+    es->scheduler_object = sched_obj;
+
+    while( size < parsec_sched_ws_deque_size ) size <<= 1;
+    sched_obj->buffer = sched_ws_buffer_new(size);
+    sched_obj->inbox = PARSEC_OBJ_NEW(parsec_lifo_t);
+    if( 0 == es->th_id ) {  /* flow 0 creates the system_queue */
+        sched_obj->system_queue = PARSEC_OBJ_NEW(parsec_dequeue_t);
+    }
+
+    /* Order the potential victims by hwloc distance (insertion sort, the
+     * number of streams per VP is small), and group them in levels of
+     * equal distance. */
+    sched_obj->victims   = (int*)malloc(vp->nb_cores * sizeof(int));
+    sched_obj->level_end = (int*)malloc(vp->nb_cores * sizeof(int));
+    dist = (int*)malloc(vp->nb_cores * sizeof(int));
+    nv = 0;
+    for(int id = (es->th_id + 1) % vp->nb_cores; id != es->th_id; id = (id + 1) % vp->nb_cores) {
+        int d;
+#if defined(PARSEC_HAVE_HWLOC)
+        d = parsec_hwloc_distance(es->th_id, id) / 2;
+#else
+        d = 0;
+#endif
+        for(j = nv; (j > 0) && (dist[j-1] > d); j--) {
+            dist[j] = dist[j-1];
+            sched_obj->victims[j] = sched_obj->victims[j-1];
+        }
+        dist[j] = d;
+        sched_obj->victims[j] = id;
+        nv++;
+    }
+    sched_obj->nb_victims = nv;
+    sched_obj->nb_levels = 0;
+    for(i = 0; i < nv; i++) {
+        if( (i == nv - 1) || (dist[i] != dist[i+1]) )
+            sched_obj->level_end[sched_obj->nb_levels++] = i + 1;
+    }
+    free(dist);
+
+    /* All local allocations are now completed. Synchronize with the other
+     threads before sharing the system queue. */
+    parsec_barrier_wait(barrier);
+
+    sched_obj->system_queue = SCHED_WS_OBJECT(vp->execution_streams[0])->system_queue;
+
+    PARSEC_DEBUG_VERBOSE(20, parsec_debug_output, "WS\t: %d:%d has %d victims in %d distance levels",
+                         vp->vp_id, es->th_id, sched_obj->nb_victims, sched_obj->nb_levels);
+    return PARSEC_SUCCESS;
+}
+
+/**
+ * @brief Steal from a victim stream.
+ *
+ * @details Try the victim deque first, then its inbox. When steal_half is
+ *   enabled, keep stealing from the deque until half of the tasks observed
+ *   in it have been moved to the thief's own deque. The first stolen task is
+ *   returned to be executed immediately.
+ */
+static parsec_task_t *sched_ws_steal_from(sched_ws_object_t *thief, sched_ws_object_t *victim)
+{
+    parsec_task_t *task, *extra;
+    int64_t left, tosteal;
+
+    task = sched_ws_deque_steal(victim, &left);
+    if( NULL == task ) {
+        return (parsec_task_t*)parsec_lifo_pop(victim->inbox);
+    }
+    if( parsec_sched_ws_steal_half ) {
+        for(tosteal = left / 2 - 1; tosteal > 0; tosteal--) {
+            extra = sched_ws_deque_steal(victim, &left);
+            if( NULL == extra ) break;
+            sched_ws_deque_push(thief, extra);
+        }
+    }
+    return task;
+}
+
+static parsec_task_t*
+sched_ws_select(parsec_execution_stream_t *es,
+                int32_t* distance)
+{
+    sched_ws_object_t *sched_obj = SCHED_WS_OBJECT(es);
+    parsec_vp_t *vp = es->virtual_process;
+    parsec_task_t *task;
+    int level, start, end, i, n;
+
+    task = sched_ws_deque_pop(sched_obj);
+    if( NULL != task ) {
+        *distance = 0;
+        return task;
+    }
+    task = (parsec_task_t*)parsec_lifo_pop(sched_obj->inbox);
+    if( NULL != task ) {
+        *distance = 0;
+        return task;
+    }
+
+    for(level = 0, start = 0; level < sched_obj->nb_levels; level++, start = end) {
+        end = sched_obj->level_end[level];
+        n = end - start;
+        i = rand_r(&es->rand_seed) % n;
+        for(int k = 0; k < n; k++, i = (i + 1) % n) {
+            int vid = sched_obj->victims[start + i];
+            task = sched_ws_steal_from(sched_obj, SCHED_WS_OBJECT(vp->execution_streams[vid]));
+            if( NULL != task ) {
+                PARSEC_DEBUG_VERBOSE(20, parsec_debug_output, "WS\t: %d:%d stole task %p from %d (level %d)",
+                                     vp->vp_id, es->th_id, task, vid, level);
+                *distance = start + i + 1;
+                return task;
+            }
+        }
+    }
+
+    task = (parsec_task_t*)parsec_dequeue_try_pop_front(sched_obj->system_queue);
+    if( NULL != task ) {
+        PARSEC_DEBUG_VERBOSE(20, parsec_debug_output, "WS\t: %d:%d found task %p in its system queue %p",
+                             vp->vp_id, es->th_id, task, sched_obj->system_queue);
+        *distance = 1 + sched_obj->nb_victims;
+    }
+    return task;
+}
+
+static int sched_ws_schedule_chain(parsec_execution_stream_t* es,
+                                   parsec_task_t* new_context,
+                                   int32_t nb_tasks,
+                                   int32_t distance)
+{
+    sched_ws_object_t *sched_obj = SCHED_WS_OBJECT(es);
+    parsec_list_item_t *ring = (parsec_list_item_t*)new_context;
+
+    if( 0 != distance ) {
+        parsec_dequeue_chain_back(sched_obj->system_queue, ring);
+        return PARSEC_SUCCESS;
+    }
+    if( es != parsec_my_execution_stream() ) {
+        /* Only the owner can push into the deque */
+        parsec_lifo_chain(sched_obj->inbox, ring);
+        return PARSEC_SUCCESS;
+    }
+    /* The ring is sorted by decreasing priority, and the owner pops from
+     * the bottom: the head of the ring must end up at the bottom. */
+    sched_ws_deque_push_chain(sched_obj, ring, nb_tasks);
+    return PARSEC_SUCCESS;
+}
+
+static int sched_ws_schedule(parsec_execution_stream_t* es,
+                             parsec_task_t* new_context,
+                             int32_t distance)
+{
+    int32_t nb_tasks = 0;
+    _LIST_ITEM_ITERATOR(new_context, &new_context->super, item, {nb_tasks++; });
+    return sched_ws_schedule_chain(es, new_context, nb_tasks, distance);
+}
+
+static void sched_ws_remove( parsec_context_t *master )
+{
+    int p, t;
+    parsec_execution_stream_t *es;
+    parsec_vp_t *vp;
+    sched_ws_object_t *sched_obj;
+    sched_ws_buffer_t *b;
+
+    for(p = 0; p < master->nb_vp; p++) {
+        vp = master->virtual_processes[p];
+        for(t = 0; t < vp->nb_cores; t++) {
+            es = vp->execution_streams[t];
+            if( (NULL == es) || (NULL == es->scheduler_object) )
+                continue;
+            sched_obj = SCHED_WS_OBJECT(es);
+
+            if( es->th_id == 0 ) {
+                PARSEC_OBJ_RELEASE( sched_obj->system_queue );
+            }
+            sched_obj->system_queue = NULL;
+            PARSEC_OBJ_RELEASE(sched_obj->inbox);
+            while( NULL != (b = sched_obj->buffer) ) {
+                sched_obj->buffer = b->prev;
+                free(b);
+            }
+            free(sched_obj->victims);
+            free(sched_obj->level_end);
+            free(sched_obj);
+            es->scheduler_object = NULL;
+        }
+    }
+}
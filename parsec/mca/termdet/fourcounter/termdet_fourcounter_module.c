@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2018-2022 The University of Tennessee and The University
+ * Copyright (c) 2018-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * $COPYRIGHT$
@@ -560,11 +560,13 @@ static int parsec_termdet_fourcounter_incoming_message_start(parsec_taskpool_t *
     assert( tp->tdm.module == &parsec_termdet_fourcounter_module.module );
 
     tpm = tp->tdm.monitor;
-    assert( tpm->state > PARSEC_TERMDET_FOURCOUNTER_NOT_READY);
     assert( tpm->state != PARSEC_TERMDET_FOURCOUNTER_TERMINATED );
 
     parsec_atomic_rwlock_wrlock(&tpm->rw_lock);
-    /* If we were ready or more, we become busy */
+    /* The DSL enables the taskpool before declaring it ready, so a message can
+     * arrive while we are not ready yet: we are then busy until we are ready,
+     * and the message is only counted. Otherwise, if we were idle, we become
+     * busy */
     if( tpm->state == PARSEC_TERMDET_FOURCOUNTER_IDLE_WAITING_FOR_CHILDREN ) {
         tpm->state = PARSEC_TERMDET_FOURCOUNTER_BUSY_WAITING_FOR_CHILDREN;
         tpm->stats_nb_idle_busy++;
@@ -599,7 +601,6 @@ static int parsec_termdet_fourcounter_incoming_message_end(parsec_taskpool_t *tp
     assert( tpm->state != PARSEC_TERMDET_FOURCOUNTER_TERMINATED );
 
     parsec_atomic_rwlock_wrlock(&tpm->rw_lock);
-    assert( tpm->state > PARSEC_TERMDET_FOURCOUNTER_NOT_READY);
     tpm->messages_received++;
     parsec_atomic_rwlock_wrunlock(&tpm->rw_lock);
 
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+
+/**
+ * @file
+ *
+ * Dijkstra/Scholten Termination Detection Algorithm, with piggybacked
+ *   acknowledgments and a single hierarchical wave
+ *   (see https://www.cs.utexas.edu/users/EWD/ewd06xx/EWD687a.PDF)
+ *
+ * Each process counts the application messages it sent that have not
+ * been acknowledged yet (its deficit). The acknowledgments travel, as
+ * counters, on the application messages going back to the sender, and
+ * are only sent as control messages when the receiver becomes idle. A
+ * process that is idle with a null deficit is free, and can only be
+ * engaged again by a message from a process that is not free; the
+ * acknowledgment of that message is held until it is free again.
+ *
+ * The processes report to their parent in a tree once they are free and
+ * all their children reported. The ranks of a node report to their node
+ * leader, and the node leaders form a binary tree rooted at rank 0, so
+ * the node is quiescent before the global wave involves the network.
+ * Because a free process can only be re-engaged by a process that is not
+ * free, one wave is enough: when the root is free and all processes
+ * reported, the computation has terminated.
+ */
+
+#ifndef MCA_TERMDET_HIERARCHICAL_H
+#define MCA_TERMDET_HIERARCHICAL_H
+
+#include "parsec/parsec_config.h"
+#include "parsec/mca/mca.h"
+#include "parsec/mca/termdet/termdet.h"
+#include "parsec/parsec_comm_engine.h"
+
+BEGIN_C_DECLS
+
+/**
+ * Globally exported variable
+ */
+PARSEC_DECLSPEC extern const parsec_termdet_base_component_t parsec_termdet_hierarchical_component;
+PARSEC_DECLSPEC extern const parsec_termdet_module_t parsec_termdet_hierarchical_module;
+
+/* Number of consecutive ranks considered to be on the same node (0: use the nodes
+ * discovered by the communication engine) */
+extern int parsec_termdet_hierarchical_node_size;
+
+int parsec_termdet_hierarchical_msg_dispatch(parsec_comm_engine_t *ce, parsec_ce_tag_t tag,  void *msg,
+                                             size_t size, int src,  void *module);
+
+typedef enum {
+    PARSEC_TERMDET_HIERARCHICAL_MSG_TYPE_ACK,
+    PARSEC_TERMDET_HIERARCHICAL_MSG_TYPE_UP,
+    PARSEC_TERMDET_HIERARCHICAL_MSG_TYPE_TERMINATE
+} parsec_termdet_hierarchical_msg_type_t;
+
+typedef struct {
+    parsec_termdet_hierarchical_msg_type_t msg_type;
+    uint32_t tp_id;
+    uint32_t nb_acks;   /**< For ACK messages: number of application messages acknowledged */
+} parsec_termdet_hierarchical_msg_t;
+
+#define PARSEC_TERMDET_HIERARCHICAL_MAX_MSG_SIZE (sizeof(parsec_termdet_hierarchical_msg_t))
+
+typedef struct {
+    parsec_list_item_t list_item;
+    unsigned char msg[PARSEC_TERMDET_HIERARCHICAL_MAX_MSG_SIZE];
+    parsec_comm_engine_t *ce;
+    void *module;
+    long unsigned int tag;
+    long unsigned int size;
+    int src;
+} parsec_termdet_hierarchical_delayed_msg_t;
+
+extern parsec_list_t parsec_termdet_hierarchical_delayed_messages;
+
+/* static accessor */
+mca_base_component_t *termdet_hierarchical_static_component(void);
+
+END_C_DECLS
+#endif /* MCA_TERMDET_HIERARCHICAL_H */
+
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * These symbols are in a file by themselves to provide nice linker
+ * semantics.  Since linkers generally pull in symbols by object
+ * files, keeping these symbols as the only symbols in this file
+ * prevents utility programs such as "ompi_info" from having to import
+ * entire components just to query their version and parameters.
+ */
+
+#include "parsec/parsec_config.h"
+#include "parsec.h"
+#include "parsec/parsec_internal.h"
+
+#include "parsec/mca/termdet/termdet.h"
+#include "parsec/mca/termdet/hierarchical/termdet_hierarchical.h"
+#include "parsec/remote_dep.h"
+#include "parsec/utils/mca_param.h"
+
+/*
+ * Local function
+ */
+static int termdet_hierarchical_component_query(mca_base_module_t **module, int *priority);
+static int termdet_hierarchical_component_close(void);
+static int termdet_hierarchical_component_register(void);
+
+/*
+ * Instantiate the public struct with all of our public information
+ * and pointers to our public functions in it
+ */
+const parsec_termdet_base_component_t parsec_termdet_hierarchical_component = {
+
+    /* First, the mca_component_t struct containing meta information
+       about the component itself */
+
+    {
+        PARSEC_TERMDET_BASE_VERSION_2_0_0,
+
+        /* Component name, options and version */
+        "hierarchical",
+        "",
+        PARSEC_VERSION_MAJOR,
+        PARSEC_VERSION_MINOR,
+
+        /* Component open and close functions */
+        NULL, /*< No open: termdet_hierarchical is always available, no need to check at runtime */
+        termdet_hierarchical_component_close,
+        termdet_hierarchical_component_query,
+        /*< specific query to return the module and add it to the list of available modules */
+        termdet_hierarchical_component_register,
+        "", /*< no reserve */
+    },
+    {
+        /* The component has no metada */
+        MCA_BASE_METADATA_PARAM_NONE,
+        "", /*< no reserve */
+    }
+};
+
+mca_base_component_t *termdet_hierarchical_static_component(void)
+{
+    return (mca_base_component_t *)&parsec_termdet_hierarchical_component;
+}
+
+int parsec_termdet_hierarchical_node_size = 0;
+
+/* set to 1 when the callback is registered -- workaround current MCA interface limitation */
+static int parsec_termdet_hierarchical_msg_cb_registered = 0;
+
+static int termdet_hierarchical_component_query(mca_base_module_t **module, int *priority)
+{
+    /* module type should be: const mca_base_module_t ** */
+    void *ptr = (void*)&parsec_termdet_hierarchical_module;
+    *priority = 2;
+    *module = (mca_base_module_t *)ptr;
+
+    if( 0 == parsec_termdet_hierarchical_msg_cb_registered ) {
+        int rc = parsec_ce.tag_register(PARSEC_TERMDET_HIERARCHICAL_MSG_TAG, parsec_termdet_hierarchical_msg_dispatch, ptr,
+                                        PARSEC_TERMDET_HIERARCHICAL_MAX_MSG_SIZE);
+        (void)rc;
+        PARSEC_OBJ_CONSTRUCT(&parsec_termdet_hierarchical_delayed_messages, parsec_list_t);
+        parsec_termdet_hierarchical_msg_cb_registered++;
+    }
+
+    return MCA_SUCCESS;
+}
+
+static int termdet_hierarchical_component_close()
+{
+    parsec_termdet_hierarchical_msg_cb_registered--;
+    if( 0 == parsec_termdet_hierarchical_msg_cb_registered ) {
+        parsec_ce.tag_unregister(PARSEC_TERMDET_HIERARCHICAL_MSG_TAG);
+        PARSEC_OBJ_DESTRUCT(&parsec_termdet_hierarchical_delayed_messages);
+    }
+    return MCA_SUCCESS;
+}
+
+static int termdet_hierarchical_component_register(void)
+{
+    parsec_mca_param_reg_int_name("termdet_hierarchical", "node_size",
+                                  "Number of consecutive ranks the termination detection aggregates before the "
+                                  "global wave (0: use the nodes discovered by the communication engine)",
+                                  false, false, parsec_termdet_hierarchical_node_size,
+                                  &parsec_termdet_hierarchical_node_size);
+    return MCA_SUCCESS;
+}
@@ -0,0 +1,722 @@
+/**
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ */
+
+#include "parsec/parsec_config.h"
+#include "parsec/parsec_internal.h"
+#include "parsec/include/parsec/execution_stream.h"
+#include "parsec/utils/debug.h"
+#include "parsec/mca/termdet/termdet.h"
+#include "parsec/mca/termdet/hierarchical/termdet_hierarchical.h"
+#include "parsec/remote_dep.h"
+
+/**
+ * Module functions
+ */
+
+static void parsec_termdet_hierarchical_monitor_taskpool(parsec_taskpool_t *tp,
+                                                         parsec_termdet_termination_detected_function_t cb);
+static void parsec_termdet_hierarchical_unmonitor_taskpool(parsec_taskpool_t *tp);
+static parsec_termdet_taskpool_state_t parsec_termdet_hierarchical_taskpool_state(parsec_taskpool_t *tp);
+static int parsec_termdet_hierarchical_taskpool_ready(parsec_taskpool_t *tp);
+static int parsec_termdet_hierarchical_taskpool_addto_nb_tasks(parsec_taskpool_t *tp, int v);
+static int parsec_termdet_hierarchical_taskpool_addto_runtime_actions(parsec_taskpool_t *tp, int v);
+static int parsec_termdet_hierarchical_taskpool_set_nb_tasks(parsec_taskpool_t *tp, int v);
+static int parsec_termdet_hierarchical_taskpool_set_runtime_actions(parsec_taskpool_t *tp, int v);
+
+static int parsec_termdet_hierarchical_outgoing_message_pack(parsec_taskpool_t *tp,
+                                                             int dst_rank,
+                                                             char *packed_buffer,
+                                                             int *position,
+                                                             int buffer_size);
+static int parsec_termdet_hierarchical_outgoing_message_start(parsec_taskpool_t *tp,
+                                                              int dst_rank,
+                                                              parsec_remote_deps_t *remote_deps);
+static int parsec_termdet_hierarchical_incoming_message_start(parsec_taskpool_t *tp,
+                                                              int src_rank,
+                                                              char *packed_buffer,
+                                                              int *position,
+                                                              int buffer_size,
+                                                              const parsec_remote_deps_t *msg);
+static int parsec_termdet_hierarchical_incoming_message_end(parsec_taskpool_t *tp,
+                                                            const parsec_remote_deps_t *msg);
+static int parsec_termdet_hierarchical_write_stats(parsec_taskpool_t *tp, FILE *fp);
+
+const parsec_termdet_module_t parsec_termdet_hierarchical_module = {
+    &parsec_termdet_hierarchical_component,
+    {
+        parsec_termdet_hierarchical_monitor_taskpool,
+        parsec_termdet_hierarchical_unmonitor_taskpool,
+        parsec_termdet_hierarchical_taskpool_state,
+        parsec_termdet_hierarchical_taskpool_ready,
+        parsec_termdet_hierarchical_taskpool_addto_nb_tasks,
+        parsec_termdet_hierarchical_taskpool_addto_runtime_actions,
+        parsec_termdet_hierarchical_taskpool_set_nb_tasks,
+        parsec_termdet_hierarchical_taskpool_set_runtime_actions,
+        sizeof(uint32_t),  /* the acknowledgments for the destination */
+        parsec_termdet_hierarchical_outgoing_message_start,
+        parsec_termdet_hierarchical_outgoing_message_pack,
+        parsec_termdet_hierarchical_incoming_message_start,
+        parsec_termdet_hierarchical_incoming_message_end,
+        parsec_termdet_hierarchical_write_stats
+    }
+};
+
+typedef enum {
+    PARSEC_TERMDET_HIERARCHICAL_NOT_READY,
+    PARSEC_TERMDET_HIERARCHICAL_BUSY,
+    PARSEC_TERMDET_HIERARCHICAL_IDLE,
+    PARSEC_TERMDET_HIERARCHICAL_TERMINATED
+} parsec_termdet_hierarchical_state_t;
+
+typedef struct parsec_termdet_hierarchical_monitor_s {
+    parsec_atomic_rwlock_t rw_lock;             /**< Operations that change the state take the write lock, operations that
+                                                 *   read the state take the read lock */
+    parsec_termdet_hierarchical_state_t state;  /**< Current status */
+    int32_t deficit;                            /**< Application messages sent and not acknowledged yet */
+    int32_t receiving;                          /**< Application messages started and not completely received */
+    int engager;                                /**< Rank whose message engaged this process while it was free, or -1.
+                                                 *   That message is acknowledged when the process is free again */
+    uint32_t *pending_acks;                     /**< Per rank, application messages received and not acknowledged yet */
+    uint32_t nb_pending_acks;                   /**< Sum of pending_acks */
+    int reported;                               /**< This process took part in the wave */
+    int nb_child_left;                          /**< How many children did not report yet */
+    int parent;                                 /**< Parent in the wave, -1 for the root */
+    int nb_children;
+    int *children;
+
+    uint32_t stats_nb_busy_idle;                /**< Statistics: number of transitions busy -> idle */
+    uint32_t stats_nb_idle_busy;                /**< Statistics: number of transitions idle -> busy */
+    uint32_t stats_nb_piggybacked_acks;         /**< Statistics: number of acknowledgments sent on application messages */
+    uint32_t stats_nb_sent_msg;                 /**< Statistics: number of messages sent */
+    uint32_t stats_nb_recv_msg;                 /**< Statistics: number of messages received */
+    uint32_t stats_nb_sent_bytes;               /**< Statistics: number of bytes sent */
+    uint32_t stats_nb_recv_bytes;               /**< Statistics: number of bytes received */
+    struct timeval stats_time_start;
+    struct timeval stats_time_last_idle;
+    struct timeval stats_time_end;
+} parsec_termdet_hierarchical_monitor_t;
+
+static int parsec_termdet_hierarchical_msg_ack(parsec_termdet_hierarchical_msg_t *msg, int src, parsec_taskpool_t *tp);
+static int parsec_termdet_hierarchical_msg_up(parsec_termdet_hierarchical_msg_t *msg, int src, parsec_taskpool_t *tp);
+static int parsec_termdet_hierarchical_msg_terminate(parsec_termdet_hierarchical_msg_t *msg, int src, parsec_taskpool_t *tp);
+
+parsec_list_t parsec_termdet_hierarchical_delayed_messages;
+
+static int parsec_termdet_hierarchical_msg_dispatch_taskpool(parsec_taskpool_t *tp, parsec_comm_engine_t *ce,
+                                                             long unsigned int tag,  void *msg,
+                                                             long unsigned int size, int src,  void *module)
+{
+    parsec_termdet_hierarchical_msg_t *hmsg = (parsec_termdet_hierarchical_msg_t*)msg;
+    int terminated = 0;
+    (void)size;
+    (void)tag;
+    (void)module;
+    (void)ce;
+
+    assert( size == sizeof(parsec_termdet_hierarchical_msg_t) );
+    PARSEC_DEBUG_VERBOSE(10, parsec_debug_output, "TERMDET-HIER:\tReceived %d bytes from %d relative to taskpool %d",
+                         size, src, tp->taskpool_id);
+
+    switch( hmsg->msg_type ) {
+    case PARSEC_TERMDET_HIERARCHICAL_MSG_TYPE_ACK:
+        terminated = parsec_termdet_hierarchical_msg_ack(hmsg, src, tp);
+        break;
+    case PARSEC_TERMDET_HIERARCHICAL_MSG_TYPE_UP:
+        terminated = parsec_termdet_hierarchical_msg_up(hmsg, src, tp);
+        break;
+    case PARSEC_TERMDET_HIERARCHICAL_MSG_TYPE_TERMINATE:
+        terminated = parsec_termdet_hierarchical_msg_terminate(hmsg, src, tp);
+        break;
+    default:
+        assert(0);
+        return PARSEC_ERROR;
+    }
+    if( terminated )
+        tp->tdm.callback(tp);
+    return PARSEC_SUCCESS;
+}
+
+static int parsec_termdet_hierarchical_must_delay(parsec_taskpool_t *tp)
+{
+    return (NULL == tp) || (NULL == tp->tdm.monitor) ||
+        (((parsec_termdet_hierarchical_monitor_t*)tp->tdm.monitor)->state == PARSEC_TERMDET_HIERARCHICAL_NOT_READY);
+}
+
+int parsec_termdet_hierarchical_msg_dispatch(parsec_comm_engine_t *ce, parsec_ce_tag_t tag,  void *msg,
+                                             size_t size, int src,  void *module)
+{
+    parsec_termdet_hierarchical_delayed_msg_t *delayed_msg;
+    parsec_termdet_hierarchical_msg_t *hmsg = (parsec_termdet_hierarchical_msg_t*)msg;
+    parsec_taskpool_t *tp = parsec_taskpool_lookup(hmsg->tp_id);
+
+    if( parsec_termdet_hierarchical_must_delay(tp) ) {
+        parsec_list_lock(&parsec_termdet_hierarchical_delayed_messages);
+        /* We re-check: somebody may have already inserted the
+         * taskpool when we didn't have the lock */
+        tp = parsec_taskpool_lookup(hmsg->tp_id);
+        if( parsec_termdet_hierarchical_must_delay(tp) ) {
+            delayed_msg = (parsec_termdet_hierarchical_delayed_msg_t *)calloc(1, sizeof(parsec_termdet_hierarchical_delayed_msg_t));
+            PARSEC_LIST_ITEM_SINGLETON(delayed_msg);
+            assert(size <= PARSEC_TERMDET_HIERARCHICAL_MAX_MSG_SIZE);
+            delayed_msg->ce = ce;
+            delayed_msg->module = module;
+            delayed_msg->tag = tag;
+            delayed_msg->size = size;
+            delayed_msg->src = src;
+            memcpy(delayed_msg->msg, msg, size);
+            parsec_list_nolock_push_back(&parsec_termdet_hierarchical_delayed_messages, &delayed_msg->list_item);
+            parsec_list_unlock(&parsec_termdet_hierarchical_delayed_messages);
+            return PARSEC_SUCCESS;
+        }
+        parsec_list_unlock(&parsec_termdet_hierarchical_delayed_messages);
+    }
+
+    return parsec_termdet_hierarchical_msg_dispatch_taskpool(tp, ce, tag, msg, size, src, module);
+}
+
+static inline int parsec_termdet_hierarchical_leader_of(int rank)
+{
+    if( parsec_termdet_hierarchical_node_size > 0 )
+        return rank - (rank % parsec_termdet_hierarchical_node_size);
+    return (NULL != parsec_ce.node_of) ? parsec_ce.node_of[rank] : rank;
+}
+
+/**
+ * The ranks of a node are the children of their leader (the lowest rank of
+ * the node), and the leaders form a binary tree, in the order of their ranks.
+ */
+static void parsec_termdet_hierarchical_topology_init(parsec_termdet_hierarchical_monitor_t *tpm,
+                                                      parsec_taskpool_t *tp)
+{
+    int nb_nodes = tp->context->nb_nodes, me = tp->context->my_rank;
+    int r, j, my_index = -1, nb_leaders = 0, leader = parsec_termdet_hierarchical_leader_of(me);
+    int *leaders;
+
+    tpm->nb_children = 0;
+    tpm->children = NULL;
+    if( leader != me ) {
+        tpm->parent = leader;
+        return;
+    }
+
+    leaders = (int*)malloc(nb_nodes * sizeof(int));
+    tpm->children = (int*)malloc((nb_nodes + 2) * sizeof(int));
+    for( r = 0; r < nb_nodes; r++ ) {
+        int l = parsec_termdet_hierarchical_leader_of(r);
+        if( l == r ) {
+            if( r == me ) my_index = nb_leaders;
+            leaders[nb_leaders++] = r;
+        } else if( l == me ) {
+            tpm->children[tpm->nb_children++] = r;
+        }
+    }
+    assert(my_index >= 0 && leaders[0] == 0);
+    tpm->parent = (my_index <= 0) ? -1 : leaders[(my_index - 1) / 2];
+    for( j = 2 * my_index + 1; (j <= 2 * my_index + 2) && (j < nb_leaders); j++ )
+        tpm->children[tpm->nb_children++] = leaders[j];
+    free(leaders);
+}
+
+/**
+ * The taskpool is attached to its context when it is enabled, and the
+ * application messages may start flowing before it is ready: build the
+ * topology and the acknowledgment counters on first use, with the write lock.
+ */
+static void parsec_termdet_hierarchical_setup(parsec_termdet_hierarchical_monitor_t *tpm,
+                                              parsec_taskpool_t *tp)
+{
+    if( NULL != tpm->pending_acks )
+        return;
+    assert(NULL != tp->context);
+    parsec_termdet_hierarchical_topology_init(tpm, tp);
+    tpm->nb_child_left = tpm->nb_children;
+    tpm->pending_acks = (uint32_t*)calloc(tp->context->nb_nodes, sizeof(uint32_t));
+}
+
+static void parsec_termdet_hierarchical_send(parsec_termdet_hierarchical_monitor_t *tpm,
+                                             parsec_taskpool_t *tp,
+                                             parsec_termdet_hierarchical_msg_type_t type,
+                                             uint32_t nb_acks, int dst)
+{
+    parsec_termdet_hierarchical_msg_t msg;
+    msg.msg_type = type;
+    msg.tp_id = tp->taskpool_id;
+    msg.nb_acks = nb_acks;
+    tpm->stats_nb_sent_msg++;
+    tpm->stats_nb_sent_bytes += sizeof(parsec_termdet_hierarchical_msg_t) + sizeof(int);
+    parsec_ce.send_am(&parsec_ce, PARSEC_TERMDET_HIERARCHICAL_MSG_TAG, dst, &msg, sizeof(parsec_termdet_hierarchical_msg_t));
+}
+
+static void parsec_termdet_hierarchical_monitor_taskpool(parsec_taskpool_t *tp,
+                                                         parsec_termdet_termination_detected_function_t cb)
+{
+    parsec_termdet_hierarchical_monitor_t *tpm;
+    assert(&parsec_termdet_hierarchical_module.module == tp->tdm.module);
+    tpm = (parsec_termdet_hierarchical_monitor_t*)calloc(1, sizeof(parsec_termdet_hierarchical_monitor_t));
+    tp->tdm.callback = cb;
+    tpm->state = PARSEC_TERMDET_HIERARCHICAL_NOT_READY;
+    PARSEC_DEBUG_VERBOSE(10, parsec_debug_output, "TERMDET-HIER:\tProcess initializes state to NOT_READY");
+    tpm->engager = -1;
+    tpm->parent = -1;
+    tp->tdm.monitor = tpm;
+
+    tp->nb_tasks = 0;
+    tp->nb_pending_actions = 0;
+
+    parsec_atomic_rwlock_init(&tpm->rw_lock);
+    gettimeofday(&tpm->stats_time_start, NULL);
+}
+
+static void parsec_termdet_hierarchical_unmonitor_taskpool(parsec_taskpool_t *tp)
+{
+    assert(tp->tdm.module == &parsec_termdet_hierarchical_module.module);
+    parsec_termdet_hierarchical_monitor_t *tpm;
+    tpm = tp->tdm.monitor;
+    assert(NULL != tpm);
+    assert(tpm->state == PARSEC_TERMDET_HIERARCHICAL_TERMINATED);
+    free(tpm->pending_acks);
+    free(tpm->children);
+    free(tpm);
+    tp->tdm.monitor  = NULL;
+    tp->tdm.module   = NULL;
+    tp->tdm.callback = NULL;
+}
+
+static parsec_termdet_taskpool_state_t parsec_termdet_hierarchical_taskpool_state(parsec_taskpool_t *tp)
+{
+    parsec_termdet_hierarchical_monitor_t *tpm;
+    parsec_termdet_hierarchical_state_t state;
+    if( tp->tdm.module == NULL )
+        return PARSEC_TERM_TP_NOT_MONITORED;
+    assert(tp->tdm.module == &parsec_termdet_hierarchical_module.module);
+    tpm = tp->tdm.monitor;
+    parsec_atomic_rwlock_rdlock(&tpm->rw_lock);
+    state = tpm->state;
+    parsec_atomic_rwlock_rdunlock(&tpm->rw_lock);
+    switch(state) {
+    case PARSEC_TERMDET_HIERARCHICAL_NOT_READY:
+        return PARSEC_TERM_TP_NOT_READY;
+    case PARSEC_TERMDET_HIERARCHICAL_BUSY:
+        return PARSEC_TERM_TP_BUSY;
+    case PARSEC_TERMDET_HIERARCHICAL_IDLE:
+        return PARSEC_TERM_TP_IDLE;
+    case PARSEC_TERMDET_HIERARCHICAL_TERMINATED:
+        return PARSEC_TERM_TP_TERMINATED;
+    }
+    assert(0);
+    return (parsec_termdet_taskpool_state_t)-1;
+}
+
+/**
+ * Called with the write lock held after any event that may make the process
+ * idle or free. Sends the pending acknowledgments if the process is idle, and
+ * its report if it is free and all its children reported. Returns 1 if the
+ * termination was detected, the caller must then release the lock and call
+ * the termination callback.
+ */
+static int parsec_termdet_hierarchical_check_state(parsec_termdet_hierarchical_monitor_t *tpm,
+                                                   parsec_taskpool_t *tp)
+{
+    int r, i;
+
+    if( tpm->state == PARSEC_TERMDET_HIERARCHICAL_NOT_READY ||
+        tpm->state == PARSEC_TERMDET_HIERARCHICAL_TERMINATED )
+        return 0;
+    if( tp->nb_tasks != 0 || tp->nb_pending_actions != 0 || tpm->receiving != 0 ) {
+        if( tpm->state == PARSEC_TERMDET_HIERARCHICAL_IDLE ) {
+            PARSEC_DEBUG_VERBOSE(10, parsec_debug_output, "TERMDET-HIER:\tProcess changed state for BUSY");
+            tpm->state = PARSEC_TERMDET_HIERARCHICAL_BUSY;
+            tpm->stats_nb_idle_busy++;
+        }
+        return 0;
+    }
+    if( tpm->state == PARSEC_TERMDET_HIERARCHICAL_BUSY ) {
+        PARSEC_DEBUG_VERBOSE(10, parsec_debug_output, "TERMDET-HIER:\tProcess changed state for IDLE");
+        tpm->state = PARSEC_TERMDET_HIERARCHICAL_IDLE;
+        tpm->stats_nb_busy_idle++;
+        gettimeofday(&tpm->stats_time_last_idle, NULL);
+    }
+
+    /* Free again: release the process that engaged us */
+    if( 0 == tpm->deficit && -1 != tpm->engager ) {
+        tpm->pending_acks[tpm->engager]++;
+        tpm->nb_pending_acks++;
+        tpm->engager = -1;
+    }
+    /* Nothing left to piggyback the acknowledgments on */
+    for( r = 0; (0 != tpm->nb_pending_acks) && (r < tp->context->nb_nodes); r++ ) {
+        if( 0 == tpm->pending_acks[r] ) continue;
+        PARSEC_DEBUG_VERBOSE(10, parsec_debug_output, "TERMDET-HIER:\tSending ACK message for %u messages to rank %d",
+                             tpm->pending_acks[r], r);
+        parsec_termdet_hierarchical_send(tpm, tp, PARSEC_TERMDET_HIERARCHICAL_MSG_TYPE_ACK, tpm->pending_acks[r], r);
+        tpm->nb_pending_acks -= tpm->pending_acks[r];
+        tpm->pending_acks[r] = 0;
+    }
+
+    if( 0 != tpm->deficit || tpm->reported || 0 != tpm->nb_child_left )
+        return 0;
+    tpm->reported = 1;
+    if( -1 != tpm->parent ) {
+        PARSEC_DEBUG_VERBOSE(10, parsec_debug_output, "TERMDET-HIER:\tSending UP message to rank %d", tpm->parent);
+        parsec_termdet_hierarchical_send(tpm, tp, PARSEC_TERMDET_HIERARCHICAL_MSG_TYPE_UP, 0, tpm->parent);
+        return 0;
+    }
+    PARSEC_DEBUG_VERBOSE(10, parsec_debug_output, "TERMDET-HIER:\tTermination detected at the root");
+    for( i = 0; i < tpm->nb_children; i++ )
+        parsec_termdet_hierarchical_send(tpm, tp, PARSEC_TERMDET_HIERARCHICAL_MSG_TYPE_TERMINATE, 0, tpm->children[i]);
+    gettimeofday(&tpm->stats_time_end, NULL);
+    tpm->state = PARSEC_TERMDET_HIERARCHICAL_TERMINATED;
+    return 1;
+}
+
+static int parsec_termdet_hierarchical_taskpool_ready(parsec_taskpool_t *tp)
+{
+    parsec_termdet_hierarchical_monitor_t *tpm;
+    parsec_list_item_t *item, *next;
+    parsec_list_t ready;
+    parsec_termdet_hierarchical_delayed_msg_t *delayed_msg;
+
+    assert( tp->tdm.module != NULL );
+    assert( tp->tdm.module == &parsec_termdet_hierarchical_module.module );
+    tpm = (parsec_termdet_hierarchical_monitor_t*)tp->tdm.monitor;
+    assert( tpm->state == PARSEC_TERMDET_HIERARCHICAL_NOT_READY );
+    parsec_atomic_rwlock_wrlock(&tpm->rw_lock);
+    parsec_termdet_hierarchical_setup(tpm, tp);
+    /* The process stays busy until the next change of its workload, as the
+     * DSL is still holding the taskpool with a runtime action */
+    tpm->state = PARSEC_TERMDET_HIERARCHICAL_BUSY;
+    PARSEC_DEBUG_VERBOSE(10, parsec_debug_output, "TERMDET-HIER:\tProcess changed state for BUSY (taskpool ready)");
+    parsec_atomic_rwlock_wrunlock(&tpm->rw_lock);
+    parsec_mfence();
+
+    PARSEC_OBJ_CONSTRUCT(&ready, parsec_list_t);
+    parsec_list_lock(&parsec_termdet_hierarchical_delayed_messages);
+    for(item = PARSEC_LIST_ITERATOR_FIRST(&parsec_termdet_hierarchical_delayed_messages);
+        item != PARSEC_LIST_ITERATOR_END(&parsec_termdet_hierarchical_delayed_messages);
+        item = next) {
+        next = PARSEC_LIST_ITEM_NEXT(item);
+        delayed_msg = (parsec_termdet_hierarchical_delayed_msg_t*)item;
+        if( ((parsec_termdet_hierarchical_msg_t*)delayed_msg->msg)->tp_id == tp->taskpool_id ) {
+            parsec_list_nolock_remove(&parsec_termdet_hierarchical_delayed_messages, item);
+            parsec_list_nolock_push_back(&ready, item);
+        }
+    }
+    parsec_list_unlock(&parsec_termdet_hierarchical_delayed_messages);
+
+    while( NULL != (item = parsec_list_nolock_pop_front(&ready)) ) {
+        delayed_msg = (parsec_termdet_hierarchical_delayed_msg_t*)item;
+        parsec_termdet_hierarchical_msg_dispatch_taskpool(tp, delayed_msg->ce, delayed_msg->tag,
+                                                          delayed_msg->msg, delayed_msg->size,
+                                                          delayed_msg->src, delayed_msg->module);
+        free(delayed_msg);
+    }
+    PARSEC_OBJ_DESTRUCT(&ready);
+
+    return PARSEC_SUCCESS;
+}
+
+static int parsec_termdet_hierarchical_workload_changed(parsec_taskpool_t *tp)
+{
+    parsec_termdet_hierarchical_monitor_t *tpm = (parsec_termdet_hierarchical_monitor_t *)tp->tdm.monitor;
+    int terminated;
+    parsec_atomic_rwlock_wrlock(&tpm->rw_lock);
+    terminated = parsec_termdet_hierarchical_check_state(tpm, tp);
+    parsec_atomic_rwlock_wrunlock(&tpm->rw_lock);
+    if( terminated )
+        tp->tdm.callback(tp);
+    return terminated;
+}
+
+static int parsec_termdet_hierarchical_taskpool_set_nb_tasks(parsec_taskpool_t *tp, int v)
+{
+    parsec_termdet_hierarchical_monitor_t *tpm;
+    int changed = 0;
+    assert( tp->tdm.module != NULL );
+    assert( tp->tdm.module == &parsec_termdet_hierarchical_module.module );
+    assert( v >= 0 );
+    tpm = (parsec_termdet_hierarchical_monitor_t *)tp->tdm.monitor;
+    assert( tpm->state != PARSEC_TERMDET_HIERARCHICAL_TERMINATED );
+    parsec_atomic_rwlock_wrlock(&tpm->rw_lock);
+    if( (int)tp->nb_tasks != v) {
+        tp->nb_tasks = v;
+        changed = 1;
+    }
+    parsec_atomic_rwlock_wrunlock(&tpm->rw_lock);
+    if( changed )
+        parsec_termdet_hierarchical_workload_changed(tp);
+    return v;
+}
+
+static int parsec_termdet_hierarchical_taskpool_set_runtime_actions(parsec_taskpool_t *tp, int v)
+{
+    parsec_termdet_hierarchical_monitor_t *tpm;
+    int changed = 0;
+    assert( tp->tdm.module != NULL );
+    assert( tp->tdm.module == &parsec_termdet_hierarchical_module.module );
+    assert( v >= 0 );
+    tpm = (parsec_termdet_hierarchical_monitor_t *)tp->tdm.monitor;
+    assert( tpm->state != PARSEC_TERMDET_HIERARCHICAL_TERMINATED );
+    parsec_atomic_rwlock_wrlock(&tpm->rw_lock);
+    if( (int)tp->nb_pending_actions != v) {
+        tp->nb_pending_actions = v;
+        changed = 1;
+    }
+    parsec_atomic_rwlock_wrunlock(&tpm->rw_lock);
+    if( changed )
+        parsec_termdet_hierarchical_workload_changed(tp);
+    return v;
+}
+
+static int parsec_termdet_hierarchical_taskpool_addto_nb_tasks(parsec_taskpool_t *tp, int v)
+{
+    int ret;
+    assert( tp->tdm.module != NULL );
+    assert( tp->tdm.module == &parsec_termdet_hierarchical_module.module );
+    if(v == 0)
+        return tp->nb_tasks;
+    PARSEC_DEBUG_VERBOSE(10, parsec_debug_output, "TERMDET-HIER:\tNB_TASKS %d -> %d", tp->nb_tasks, tp->nb_tasks + v);
+    int tmp = parsec_atomic_fetch_add_int32(&tp->nb_tasks, v);
+    assert( ((parsec_termdet_hierarchical_monitor_t *)tp->tdm.monitor)->state != PARSEC_TERMDET_HIERARCHICAL_TERMINATED );
+    ret = tmp + v;
+    if (tmp == 0 || ret == 0) {
+        /* Slow path: our changes might cause a state change so take a lock and check */
+        parsec_termdet_hierarchical_workload_changed(tp);
+    }
+    return ret;
+}
+
+static int parsec_termdet_hierarchical_taskpool_addto_runtime_actions(parsec_taskpool_t *tp, int v)
+{
+    int ret;
+    assert( tp->tdm.module != NULL );
+    assert( tp->tdm.module == &parsec_termdet_hierarchical_module.module );
+    assert( ((parsec_termdet_hierarchical_monitor_t *)tp->tdm.monitor)->state != PARSEC_TERMDET_HIERARCHICAL_TERMINATED );
+    if(v == 0)
+        return tp->nb_pending_actions;
+    PARSEC_DEBUG_VERBOSE(10, parsec_debug_output, "TERMDET-HIER:\tNB_PA %d -> %d", tp->nb_pending_actions, tp->nb_pending_actions + v);
+    int tmp = parsec_atomic_fetch_add_int32(&tp->nb_pending_actions, v);
+    ret = tmp + v;
+    if (tmp == 0 || ret == 0) {
+        /* Slow path: our changes might cause a state change so take a lock and check */
+        parsec_termdet_hierarchical_workload_changed(tp);
+    }
+    return ret;
+}
+
+static int parsec_termdet_hierarchical_outgoing_message_start(parsec_taskpool_t *tp,
+                                                              int dst_rank,
+                                                              parsec_remote_deps_t *remote_deps)
+{
+    parsec_termdet_hierarchical_monitor_t *tpm;
+    assert( tp->tdm.module != NULL );
+    assert( tp->tdm.module == &parsec_termdet_hierarchical_module.module );
+    (void)dst_rank;
+    (void)remote_deps;
+    tpm = tp->tdm.monitor;
+    assert( tpm->state != PARSEC_TERMDET_HIERARCHICAL_TERMINATED );
+    /* The sender is busy, the deficit cannot make it free. The acknowledgments
+     * decrease the deficit under the write lock, take it as well. */
+    parsec_atomic_rwlock_wrlock(&tpm->rw_lock);
+    tpm->deficit++;
+    parsec_atomic_rwlock_wrunlock(&tpm->rw_lock);
+
+    return 1;
+}
+
+static int parsec_termdet_hierarchical_outgoing_message_pack(parsec_taskpool_t *tp,
+                                                             int dst_rank,
+                                                             char *packed_buffer,
+                                                             int *position,
+                                                             int buffer_size)
+{
+    parsec_termdet_hierarchical_monitor_t *tpm;
+    uint32_t nb_acks;
+    assert( tp->tdm.module != NULL );
+    assert( tp->tdm.module == &parsec_termdet_hierarchical_module.module );
+    assert( *position + (int)sizeof(uint32_t) <= buffer_size );
+    (void)buffer_size;
+    tpm = tp->tdm.monitor;
+
+    /* Acknowledge all the messages received from the destination so far */
+    parsec_atomic_rwlock_wrlock(&tpm->rw_lock);
+    parsec_termdet_hierarchical_setup(tpm, tp);
+    nb_acks = tpm->pending_acks[dst_rank];
+    tpm->pending_acks[dst_rank] = 0;
+    tpm->nb_pending_acks -= nb_acks;
+    tpm->stats_nb_piggybacked_acks += nb_acks;
+    parsec_atomic_rwlock_wrunlock(&tpm->rw_lock);
+
+    memcpy(packed_buffer + *position, &nb_acks, sizeof(uint32_t));
+    *position += sizeof(uint32_t);
+    return PARSEC_SUCCESS;
+}
+
+static int parsec_termdet_hierarchical_incoming_message_start(parsec_taskpool_t *tp,
+                                                              int src_rank,
+                                                              char *packed_buffer,
+                                                              int *position,
+                                                              int buffer_size,
+                                                              const parsec_remote_deps_t *msg)
+{
+    parsec_termdet_hierarchical_monitor_t *tpm;
+    uint32_t nb_acks;
+    int terminated;
+    assert( tp->tdm.module != NULL );
+    assert( tp->tdm.module == &parsec_termdet_hierarchical_module.module );
+    assert( *position + (int)sizeof(uint32_t) <= buffer_size );
+    (void)buffer_size;
+    (void)msg;
+
+    memcpy(&nb_acks, packed_buffer + *position, sizeof(uint32_t));
+    *position += sizeof(uint32_t);
+
+    tpm = tp->tdm.monitor;
+    assert( tpm->state != PARSEC_TERMDET_HIERARCHICAL_TERMINATED );
+
+    parsec_atomic_rwlock_wrlock(&tpm->rw_lock);
+    parsec_termdet_hierarchical_setup(tpm, tp);
+    tpm->deficit -= nb_acks;
+    assert( tpm->deficit >= 0 );
+    if( tpm->state == PARSEC_TERMDET_HIERARCHICAL_IDLE && 0 == tpm->receiving &&
+        0 == tpm->deficit && -1 == tpm->engager ) {
+        /* We were free: this message engages us, its acknowledgment is held until we are free again */
+        tpm->engager = src_rank;
+    } else {
+        tpm->pending_acks[src_rank]++;
+        tpm->nb_pending_acks++;
+    }
+    tpm->receiving++;
+    terminated = parsec_termdet_hierarchical_check_state(tpm, tp);
+    parsec_atomic_rwlock_wrunlock(&tpm->rw_lock);
+    assert(!terminated); (void)terminated;
+
+    return PARSEC_SUCCESS;
+}
+
+static int parsec_termdet_hierarchical_incoming_message_end(parsec_taskpool_t *tp,
+                                                            const parsec_remote_deps_t *msg)
+{
+    parsec_termdet_hierarchical_monitor_t *tpm;
+    int terminated;
+    (void)msg;
+
+    assert( tp->tdm.module != NULL );
+    assert( tp->tdm.module == &parsec_termdet_hierarchical_module.module );
+
+    tpm = tp->tdm.monitor;
+    assert( tpm->state != PARSEC_TERMDET_HIERARCHICAL_TERMINATED );
+
+    parsec_atomic_rwlock_wrlock(&tpm->rw_lock);
+    assert( tpm->receiving > 0 );
+    tpm->receiving--;
+    terminated = parsec_termdet_hierarchical_check_state(tpm, tp);
+    parsec_atomic_rwlock_wrunlock(&tpm->rw_lock);
+    if( terminated )
+        tp->tdm.callback(tp);
+
+    return PARSEC_SUCCESS;
+}
+
+static int parsec_termdet_hierarchical_msg_ack(parsec_termdet_hierarchical_msg_t *msg, int src, parsec_taskpool_t *tp)
+{
+    parsec_termdet_hierarchical_monitor_t *tpm;
+    int terminated;
+    (void)src;
+
+    assert(&parsec_termdet_hierarchical_module.module == tp->tdm.module);
+    tpm = (parsec_termdet_hierarchical_monitor_t *)tp->tdm.monitor;
+    assert( tpm->state != PARSEC_TERMDET_HIERARCHICAL_TERMINATED );
+
+    parsec_atomic_rwlock_wrlock(&tpm->rw_lock);
+    tpm->stats_nb_recv_msg++;
+    tpm->stats_nb_recv_bytes += sizeof(parsec_termdet_hierarchical_msg_t) + sizeof(int);
+    PARSEC_DEBUG_VERBOSE(10, parsec_debug_output, "TERMDET-HIER:\tACK message for %u messages from rank %d (deficit %d)",
+                         msg->nb_acks, src, tpm->deficit);
+    tpm->deficit -= msg->nb_acks;
+    assert( tpm->deficit >= 0 );
+    terminated = parsec_termdet_hierarchical_check_state(tpm, tp);
+    parsec_atomic_rwlock_wrunlock(&tpm->rw_lock);
+    return terminated;
+}
+
+static int parsec_termdet_hierarchical_msg_up(parsec_termdet_hierarchical_msg_t *msg, int src, parsec_taskpool_t *tp)
+{
+    parsec_termdet_hierarchical_monitor_t *tpm;
+    int terminated;
+    (void)src;
+    (void)msg;
+
+    assert(&parsec_termdet_hierarchical_module.module == tp->tdm.module);
+    tpm = (parsec_termdet_hierarchical_monitor_t *)tp->tdm.monitor;
+    assert( tpm->state != PARSEC_TERMDET_HIERARCHICAL_TERMINATED );
+
+    parsec_atomic_rwlock_wrlock(&tpm->rw_lock);
+    tpm->stats_nb_recv_msg++;
+    tpm->stats_nb_recv_bytes += sizeof(parsec_termdet_hierarchical_msg_t) + sizeof(int);
+    PARSEC_DEBUG_VERBOSE(10, parsec_debug_output, "TERMDET-HIER:\tUP message from rank %d", src);
+    assert( tpm->nb_child_left > 0 );
+    tpm->nb_child_left--;
+    terminated = parsec_termdet_hierarchical_check_state(tpm, tp);
+    parsec_atomic_rwlock_wrunlock(&tpm->rw_lock);
+    return terminated;
+}
+
+static int parsec_termdet_hierarchical_msg_terminate(parsec_termdet_hierarchical_msg_t *msg, int src, parsec_taskpool_t *tp)
+{
+    parsec_termdet_hierarchical_monitor_t *tpm;
+    int i;
+    (void)src;
+    (void)msg;
+
+    assert(&parsec_termdet_hierarchical_module.module == tp->tdm.module);
+    tpm = (parsec_termdet_hierarchical_monitor_t *)tp->tdm.monitor;
+
+    parsec_atomic_rwlock_wrlock(&tpm->rw_lock);
+    tpm->stats_nb_recv_msg++;
+    tpm->stats_nb_recv_bytes += sizeof(parsec_termdet_hierarchical_msg_t) + sizeof(int);
+    assert( tpm->state == PARSEC_TERMDET_HIERARCHICAL_IDLE && tpm->reported && 0 == tpm->deficit );
+    for( i = 0; i < tpm->nb_children; i++ )
+        parsec_termdet_hierarchical_send(tpm, tp, PARSEC_TERMDET_HIERARCHICAL_MSG_TYPE_TERMINATE, 0, tpm->children[i]);
+    gettimeofday(&tpm->stats_time_end, NULL);
+    tpm->state = PARSEC_TERMDET_HIERARCHICAL_TERMINATED;
+    PARSEC_DEBUG_VERBOSE(10, parsec_debug_output, "TERMDET-HIER:\tTermination detected on TERMINATE message");
+    parsec_atomic_rwlock_wrunlock(&tpm->rw_lock);
+    return 1;
+}
+
+static int parsec_termdet_hierarchical_write_stats(parsec_taskpool_t *tp, FILE *fp)
+{
+    parsec_termdet_hierarchical_monitor_t *tpm;
+    struct timeval t1, t2;
+    assert(NULL != tp->tdm.module);
+    assert(&parsec_termdet_hierarchical_module.module == tp->tdm.module);
+    tpm = (parsec_termdet_hierarchical_monitor_t *)tp->tdm.monitor;
+
+    timersub(&tpm->stats_time_end, &tpm->stats_time_last_idle, &t1);
+    timersub(&tpm->stats_time_end, &tpm->stats_time_start, &t2);
+
+    fprintf(fp, "NP: %d M: HIER Rank: %d Taskpool#: %d #Transitions_Busy_to_Idle: %u #Transitions_Idle_to_Busy: %u #Piggybacked_Acks: %u #SentCtlMsg: %u #RecvCtlMsg: %u SentCtlBytes: %u RecvCtlBytes: %u WallTime: %u.%06u Idle2End: %u.%06u\n",
+            tp->context->nb_nodes,
+            tp->context->my_rank,
+            tp->taskpool_id,
+            tpm->stats_nb_busy_idle,
+            tpm->stats_nb_idle_busy,
+            tpm->stats_nb_piggybacked_acks,
+            tpm->stats_nb_sent_msg,
+            tpm->stats_nb_recv_msg,
+            tpm->stats_nb_sent_bytes,
+            tpm->stats_nb_recv_bytes,
+            (unsigned int)t2.tv_sec, (unsigned int)t2.tv_usec,
+            (unsigned int)t1.tv_sec, (unsigned int)t1.tv_usec);
+
+    return PARSEC_SUCCESS;
+}
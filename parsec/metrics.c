@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+#include "parsec/parsec_config.h"
+#include "parsec/metrics.h"
+#include "parsec/constants.h"
+#include "parsec/utils/mca_param.h"
+#include "parsec/utils/debug.h"
+#include "parsec/os-spec-timing.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#if defined(PARSEC_HAVE_ERRNO_H)
+#include <errno.h>
+#endif  /* defined(PARSEC_HAVE_ERRNO_H) */
+#include <sys/types.h>
+#if defined(PARSEC_HAVE_SYS_MMAN_H)
+#include <sys/mman.h>
+#endif  /* defined(PARSEC_HAVE_SYS_MMAN_H) */
+#include <sys/stat.h> /* For mode constants */
+#include <fcntl.h> /* For O_* constants */
+
+#define PARSEC_METRICS_ALIGNMENT 64
+#define PARSEC_METRICS_ALIGN(x) (((x) + PARSEC_METRICS_ALIGNMENT - 1) & ~((size_t)PARSEC_METRICS_ALIGNMENT - 1))
+
+int parsec_metrics_enabled = 1;
+
+static parsec_metrics_header_t *metrics_segment = NULL;
+static size_t metrics_segment_size = 0;
+static char *metrics_shm_path = NULL;  /* NULL if the segment is private */
+
+static const char *metrics_counter_names[PARSEC_METRICS_NB_COUNTERS] = {
+    [PARSEC_METRICS_TASKS_EXECUTED]     = "tasks_executed",
+    [PARSEC_METRICS_TASKS_STOLEN]       = "tasks_stolen",
+    [PARSEC_METRICS_SELECT_TIME]        = "select_time",
+    [PARSEC_METRICS_SELECT_MISSES]      = "select_misses",
+    [PARSEC_METRICS_IDLE_TIME]          = "idle_time",
+    [PARSEC_METRICS_REMOTE_ACTIVATIONS] = "remote_activations",
+    [PARSEC_METRICS_BYTES_SENT]         = "bytes_sent",
+    [PARSEC_METRICS_ARENA_HITS]         = "arena_hits",
+    [PARSEC_METRICS_ARENA_MISSES]       = "arena_misses",
+};
+
+static const char *metrics_histogram_names[PARSEC_METRICS_NB_HISTOGRAMS] = {
+    [PARSEC_METRICS_EXEC_LATENCY]   = "exec_latency",
+    [PARSEC_METRICS_SELECT_LATENCY] = "select_latency",
+};
+
+static size_t metrics_header_size(void)
+{
+    size_t size = sizeof(parsec_metrics_header_t) +
+        (PARSEC_METRICS_NB_COUNTERS + PARSEC_METRICS_NB_HISTOGRAMS) * PARSEC_METRICS_NAME_LENGTH;
+    return PARSEC_METRICS_ALIGN(size);
+}
+
+static size_t metrics_stream_size(void)
+{
+    return PARSEC_METRICS_ALIGN(sizeof(parsec_metrics_stream_t));
+}
+
+#if defined(PARSEC_HAVE_SYS_MMAN_H)
+static void *metrics_shm_create(const char *path, size_t size)
+{
+    void *segment;
+    int fd;
+
+    fd = shm_open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if( -1 == fd ) {
+        parsec_warning("Unable to create the metrics segment %s: %s", path, strerror(errno));
+        return NULL;
+    }
+    if( 0 != ftruncate(fd, size) ) {
+        parsec_warning("Unable to size the metrics segment %s: %s", path, strerror(errno));
+        close(fd);
+        shm_unlink(path);
+        return NULL;
+    }
+    segment = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if( MAP_FAILED == segment ) {
+        parsec_warning("Unable to map the metrics segment %s: %s", path, strerror(errno));
+        shm_unlink(path);
+        return NULL;
+    }
+    return segment;
+}
+#endif  /* defined(PARSEC_HAVE_SYS_MMAN_H) */
+
+int parsec_metrics_init(int nb_streams, int rank)
+{
+    parsec_metrics_header_t *header;
+    char *shm_name = NULL;
+    size_t size;
+    int i;
+
+    parsec_mca_param_reg_int_name("metrics", "enable",
+                                  "Maintain the per execution stream runtime metrics (counters and latency histograms)",
+                                  false, false, parsec_metrics_enabled, &parsec_metrics_enabled);
+    parsec_mca_param_reg_string_name("metrics", "shm_name",
+                                     "Publish the runtime metrics in the shared memory segment /<name>-<rank>,"
+                                     " for external samplers (empty to keep them private to the process)",
+                                     false, false, "", &shm_name);
+    if( !parsec_metrics_enabled ) {
+        free(shm_name);
+        return PARSEC_SUCCESS;
+    }
+
+    nb_streams++;  /* the communication stream */
+    size = metrics_header_size() + nb_streams * metrics_stream_size();
+
+#if defined(PARSEC_HAVE_SYS_MMAN_H)
+    if( (NULL != shm_name) && ('\0' != shm_name[0]) ) {
+        if( 0 > asprintf(&metrics_shm_path, "/%s-%d", shm_name, rank) ) {
+            metrics_shm_path = NULL;
+        } else if( NULL == (metrics_segment = metrics_shm_create(metrics_shm_path, size)) ) {
+            free(metrics_shm_path);
+            metrics_shm_path = NULL;
+        }
+    }
+#endif  /* defined(PARSEC_HAVE_SYS_MMAN_H) */
+    free(shm_name);
+    if( NULL == metrics_segment ) {
+        if( 0 != posix_memalign((void**)&metrics_segment, PARSEC_METRICS_ALIGNMENT, size) ) {
+            metrics_segment = NULL;
+            parsec_metrics_enabled = 0;
+            return PARSEC_ERR_OUT_OF_RESOURCE;
+        }
+    }
+    memset(metrics_segment, 0, size);
+    metrics_segment_size = size;
+
+    header = metrics_segment;
+    header->version       = PARSEC_METRICS_VERSION;
+    header->header_size   = (uint32_t)metrics_header_size();
+    header->stream_size   = (uint32_t)metrics_stream_size();
+    header->nb_streams    = (uint32_t)nb_streams;
+    header->nb_counters   = PARSEC_METRICS_NB_COUNTERS;
+    header->nb_histograms = PARSEC_METRICS_NB_HISTOGRAMS;
+    header->nb_buckets    = PARSEC_METRICS_NB_BUCKETS;
+    header->rank          = rank;
+    header->pid           = (int32_t)getpid();
+    header->state         = PARSEC_METRICS_STATE_RUNNING;
+    snprintf(header->timer_unit, sizeof(header->timer_unit), "%s", TIMER_UNIT);
+    for( i = 0; i < PARSEC_METRICS_NB_COUNTERS; i++ )
+        snprintf(header->names[i], PARSEC_METRICS_NAME_LENGTH, "%s", metrics_counter_names[i]);
+    for( i = 0; i < PARSEC_METRICS_NB_HISTOGRAMS; i++ )
+        snprintf(header->names[PARSEC_METRICS_NB_COUNTERS + i], PARSEC_METRICS_NAME_LENGTH,
+                 "%s", metrics_histogram_names[i]);
+    /* the magick validates the rest of the header for the readers */
+    parsec_atomic_wmb();
+    memcpy(header->magick, PARSEC_METRICS_MAGICK, sizeof(PARSEC_METRICS_MAGICK));
+    return PARSEC_SUCCESS;
+}
+
+void parsec_metrics_fini(void)
+{
+    if( NULL == metrics_segment )
+        return;
+    metrics_segment->state = PARSEC_METRICS_STATE_FINISHED;
+#if defined(PARSEC_HAVE_SYS_MMAN_H)
+    if( NULL != metrics_shm_path ) {
+        /* Samplers that already mapped the segment keep their mapping */
+        munmap(metrics_segment, metrics_segment_size);
+        shm_unlink(metrics_shm_path);
+        free(metrics_shm_path);
+        metrics_shm_path = NULL;
+        metrics_segment = NULL;
+    }
+#endif  /* defined(PARSEC_HAVE_SYS_MMAN_H) */
+    free(metrics_segment);
+    metrics_segment = NULL;
+    metrics_segment_size = 0;
+}
+
+parsec_metrics_stream_t *parsec_metrics_stream(int idx)
+{
+    if( NULL == metrics_segment )
+        return NULL;
+    if( idx < 0 )
+        idx = metrics_segment->nb_streams - 1;
+    if( (uint32_t)idx >= metrics_segment->nb_streams )
+        return NULL;
+    return (parsec_metrics_stream_t*)((char*)metrics_segment + metrics_segment->header_size +
+                                      (size_t)idx * metrics_segment->stream_size);
+}
+
+parsec_metrics_header_t *parsec_metrics_attach(const char *name, int rank)
+{
+#if defined(PARSEC_HAVE_SYS_MMAN_H)
+    parsec_metrics_header_t *header;
+    struct stat st;
+    char *path;
+    int fd;
+
+    if( 0 > asprintf(&path, "/%s-%d", name, rank) )
+        return NULL;
+    fd = shm_open(path, O_RDONLY, 0);
+    free(path);
+    if( -1 == fd )
+        return NULL;
+    if( (0 != fstat(fd, &st)) || ((size_t)st.st_size < sizeof(parsec_metrics_header_t)) ) {
+        close(fd);
+        return NULL;
+    }
+    header = (parsec_metrics_header_t*)mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if( MAP_FAILED == header )
+        return NULL;
+    if( (0 != memcmp(header->magick, PARSEC_METRICS_MAGICK, sizeof(PARSEC_METRICS_MAGICK))) ||
+        (PARSEC_METRICS_VERSION != header->version) ||
+        ((size_t)st.st_size < (size_t)header->header_size + (size_t)header->nb_streams * header->stream_size) ) {
+        munmap(header, st.st_size);
+        return NULL;
+    }
+    return header;
+#else
+    (void)name; (void)rank;
+    return NULL;
+#endif  /* defined(PARSEC_HAVE_SYS_MMAN_H) */
+}
+
+void parsec_metrics_detach(parsec_metrics_header_t *header)
+{
+#if defined(PARSEC_HAVE_SYS_MMAN_H)
+    if( NULL != header )
+        munmap(header, (size_t)header->header_size + (size_t)header->nb_streams * header->stream_size);
+#else
+    (void)header;
+#endif  /* defined(PARSEC_HAVE_SYS_MMAN_H) */
+}
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+#ifndef PARSEC_METRICS_H_HAS_BEEN_INCLUDED
+#define PARSEC_METRICS_H_HAS_BEEN_INCLUDED
+
+#include "parsec/parsec_config.h"
+#include <stdint.h>
+#include <stddef.h>
+#include "parsec/sys/atomic.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @defgroup parsec_internal_metrics Runtime metrics
+ * @ingroup parsec_internal_runtime
+ * @{
+ *
+ * @brief Cheap counters and latency histograms, always compiled in, kept per
+ *   execution stream and published in a shared memory segment.
+ *
+ * @details
+ *   Each execution stream owns one slot of the segment, and is the only
+ *   writer of its counters: the updates are plain increments, without
+ *   atomics or locks. The communication stream owns the last slot, and
+ *   as it can be driven by several threads its counters are updated
+ *   atomically. A sampler aggregates the slots, and may observe values
+ *   that are a few updates behind, but never has to stop the runtime.
+ *
+ *   The segment starts with a versioned header that describes its layout
+ *   (number and size of the slots, number of counters, histograms and
+ *   buckets, followed by their names), so that a reader does not need to
+ *   be compiled against the same version of the runtime. The histograms
+ *   use power of two buckets: bucket 0 counts the null durations, and
+ *   bucket b the durations in [2^(b-1), 2^b), the last bucket taking
+ *   everything above.
+ *
+ *   The segment is named /<metrics_shm_name>-<rank>. When the
+ *   metrics_shm_name MCA parameter is empty the metrics are kept in
+ *   private memory, only accessible from within the process.
+ */
+
+#define PARSEC_METRICS_MAGICK       "#PARSEC METRICS"
+#define PARSEC_METRICS_VERSION      1
+#define PARSEC_METRICS_NAME_LENGTH  32
+
+/* Counters */
+#define PARSEC_METRICS_TASKS_EXECUTED     0  /**< Tasks whose body completed on this stream */
+#define PARSEC_METRICS_TASKS_STOLEN       1  /**< Tasks selected from a queue not local to this stream */
+#define PARSEC_METRICS_SELECT_TIME        2  /**< Time spent in the scheduler select */
+#define PARSEC_METRICS_SELECT_MISSES      3  /**< Calls to select that returned no task */
+#define PARSEC_METRICS_IDLE_TIME          4  /**< Time spent sleeping for lack of work */
+#define PARSEC_METRICS_REMOTE_ACTIVATIONS 5  /**< Remote activations received */
+#define PARSEC_METRICS_BYTES_SENT         6  /**< Bytes sent to other processes */
+#define PARSEC_METRICS_ARENA_HITS         7  /**< Arena chunks served from a cache */
+#define PARSEC_METRICS_ARENA_MISSES       8  /**< Arena chunks that had to be allocated */
+#define PARSEC_METRICS_NB_COUNTERS        9
+
+/* Histograms */
+#define PARSEC_METRICS_EXEC_LATENCY       0  /**< Duration of the task bodies */
+#define PARSEC_METRICS_SELECT_LATENCY     1  /**< Duration of the calls to select */
+#define PARSEC_METRICS_NB_HISTOGRAMS      2
+
+#define PARSEC_METRICS_NB_BUCKETS         48
+
+#define PARSEC_METRICS_STATE_RUNNING      1
+#define PARSEC_METRICS_STATE_FINISHED     2
+
+typedef struct parsec_metrics_header_s {
+    char              magick[16];      /**< PARSEC_METRICS_MAGICK, written last */
+    uint32_t          version;         /**< PARSEC_METRICS_VERSION */
+    uint32_t          header_size;     /**< Offset of the first slot, including the names */
+    uint32_t          stream_size;     /**< Distance between two slots */
+    uint32_t          nb_streams;      /**< Number of slots, the last is the communication stream */
+    uint32_t          nb_counters;
+    uint32_t          nb_histograms;
+    uint32_t          nb_buckets;
+    int32_t           rank;
+    int32_t           pid;
+    volatile int32_t  state;           /**< PARSEC_METRICS_STATE_* */
+    char              timer_unit[16];  /**< Unit of the times and durations */
+    char              names[][PARSEC_METRICS_NAME_LENGTH]; /**< Counters, then histograms */
+} parsec_metrics_header_t;
+
+typedef struct parsec_metrics_stream_s {
+    volatile uint64_t counters[PARSEC_METRICS_NB_COUNTERS];
+    volatile uint64_t histograms[PARSEC_METRICS_NB_HISTOGRAMS][PARSEC_METRICS_NB_BUCKETS];
+} parsec_metrics_stream_t;
+
+extern int parsec_metrics_enabled;
+
+/**
+ * Create the metrics segment for nb_streams computation streams (one more
+ * slot is added for the communication stream). Registers the MCA
+ * parameters. Leaves the metrics disabled if they are not wanted.
+ */
+int parsec_metrics_init(int nb_streams, int rank);
+
+/**
+ * Mark the segment as finished and release it.
+ */
+void parsec_metrics_fini(void);
+
+/**
+ * Return the slot of the stream idx, with -1 for the communication stream,
+ * or NULL if the metrics are disabled.
+ */
+parsec_metrics_stream_t *parsec_metrics_stream(int idx);
+
+/**
+ * Reader side: map the segment published by the process of the given rank
+ * under the given name. Returns NULL if the segment does not exist or has
+ * an incompatible version.
+ */
+parsec_metrics_header_t *parsec_metrics_attach(const char *name, int rank);
+void parsec_metrics_detach(parsec_metrics_header_t *header);
+
+static inline int parsec_metrics_bucket(uint64_t duration)
+{
+    int b;
+    if( 0 == duration ) return 0;
+#if defined(__GNUC__)
+    b = 64 - __builtin_clzll(duration);
+#else
+    for( b = 0; 0 != duration; b++ ) duration >>= 1;
+#endif
+    return (b < PARSEC_METRICS_NB_BUCKETS) ? b : PARSEC_METRICS_NB_BUCKETS - 1;
+}
+
+/* Readers must go through the layout described by the header */
+static inline const volatile uint64_t *
+parsec_metrics_slot(const parsec_metrics_header_t *header, uint32_t stream)
+{
+    return (const volatile uint64_t*)((const char*)header + header->header_size +
+                                      (size_t)stream * header->stream_size);
+}
+
+static inline uint64_t
+parsec_metrics_counter(const parsec_metrics_header_t *header, uint32_t stream, uint32_t counter)
+{
+    return parsec_metrics_slot(header, stream)[counter];
+}
+
+static inline uint64_t
+parsec_metrics_histogram(const parsec_metrics_header_t *header, uint32_t stream,
+                         uint32_t histogram, uint32_t bucket)
+{
+    return parsec_metrics_slot(header, stream)[header->nb_counters + histogram * header->nb_buckets + bucket];
+}
+
+/**
+ * Writer side. The execution stream must be the one of the calling thread,
+ * except for the ATOMIC flavors.
+ */
+#define PARSEC_METRICS_ADD(es, counter, value)                          \
+    do {                                                                \
+        parsec_metrics_stream_t *_m = (es)->metrics;                    \
+        if( NULL != _m ) _m->counters[(counter)] += (value);            \
+    } while(0)
+
+#define PARSEC_METRICS_INC(es, counter) PARSEC_METRICS_ADD(es, counter, 1)
+
+#define PARSEC_METRICS_ATOMIC_ADD(es, counter, value)                   \
+    do {                                                                \
+        parsec_metrics_stream_t *_m = (es)->metrics;                    \
+        if( NULL != _m )                                                \
+            (void)parsec_atomic_fetch_add_int64((volatile int64_t*)&_m->counters[(counter)], \
+                                                (int64_t)(value));      \
+    } while(0)
+
+#define PARSEC_METRICS_RECORD(es, histogram, duration)                  \
+    do {                                                                \
+        parsec_metrics_stream_t *_m = (es)->metrics;                    \
+        if( NULL != _m )                                                \
+            _m->histograms[(histogram)][parsec_metrics_bucket(duration)]++; \
+    } while(0)
+
+/** @} */
+
+END_C_DECLS
+
+#endif  /* PARSEC_METRICS_H_HAS_BEEN_INCLUDED */
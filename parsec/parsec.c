@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2009-2024 The University of Tennessee and The University
+ * Copyright (c) 2009-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  */
@@ -50,6 +50,7 @@
 #include "parsec/sys/tls.h"
 #include "parsec/data_distribution.h"
 #include "parsec/papi_sde.h"
+#include "parsec/metrics.h"
 
 #include "parsec/mca/mca_repository.h"
 
@@ -153,6 +154,8 @@ static int parsec_runtime_bind_main_thread = 0;
 static int parsec_runtime_bind_threads     = 0;
 
 int parsec_runtime_keep_highest_priority_task = 1;
+int parsec_runtime_sched_locality = 0;
+int parsec_runtime_auto_priority = 1;
 
 static PARSEC_TLS_DECLARE(parsec_tls_execution_stream);
 
@@ -227,6 +230,7 @@ static void parsec_taskpool_release_resources(void);
 typedef struct __parsec_temporary_thread_initialization_t {
     parsec_vp_t *virtual_process;
     int th_id;
+    int global_id;                    /*< index of the thread among all the VPs */
     int bindto;
     int bindto_ht;
     parsec_barrier_t*  barrier;       /*< the barrier used to synchronize for the
@@ -267,16 +271,21 @@ static void* __parsec_thread_init( __parsec_temporary_thread_initialization_t* s
     PARSEC_TLS_SET_SPECIFIC(parsec_tls_execution_stream, es);
 
     es->th_id            = startup->th_id;
+    es->arena_magazine_id = startup->global_id;
     es->virtual_process  = startup->virtual_process;
     es->rand_seed        = tv_now.tv_usec + startup->th_id;
     es->scheduler_object = NULL;
+    es->metrics          = parsec_metrics_stream(startup->global_id);
     es->next_task        = NULL;
     startup->virtual_process->execution_streams[startup->th_id] = es;
     es->core_id          = startup->bindto;
 #if defined(PARSEC_HAVE_HWLOC)
     es->socket_id        = parsec_hwloc_socket_id(startup->bindto);
+    es->numa_id          = parsec_hwloc_numa_id(startup->bindto);
+    if( es->numa_id < 0 ) es->numa_id = -1;
 #else
     es->socket_id        = 0;
+    es->numa_id          = -1;
 #endif  /* defined(PARSEC_HAVE_HWLOC) */
 
     /*
@@ -348,6 +357,41 @@ static void* __parsec_thread_init( __parsec_temporary_thread_initialization_t* s
     return ret;
 }
 
+/*
+ * Group the execution streams of a virtual process by NUMA node, for the
+ * locality-aware scheduling. Must be called once all the streams are bound.
+ */
+static void parsec_vp_locality_init( parsec_vp_t *vp )
+{
+    int32_t *fill;
+    int t, n, nb_nodes = 0;
+
+    for( t = 0; t < vp->nb_cores; t++ ) {
+        n = vp->execution_streams[t]->numa_id;
+        if( (n < PARSEC_ARENA_MAX_NUMA_NODES) && (n >= nb_nodes) )
+            nb_nodes = n + 1;
+    }
+    if( nb_nodes < 2 )  /* no choice to make */
+        return;
+
+    vp->numa_first = (int32_t*)calloc(nb_nodes + 1, sizeof(int32_t));
+    vp->numa_streams = (parsec_execution_stream_t**)malloc(vp->nb_cores * sizeof(parsec_execution_stream_t*));
+    fill = (int32_t*)calloc(nb_nodes, sizeof(int32_t));
+    for( t = 0; t < vp->nb_cores; t++ ) {
+        n = vp->execution_streams[t]->numa_id;
+        if( (n >= 0) && (n < nb_nodes) ) vp->numa_first[n+1]++;
+    }
+    for( n = 0; n < nb_nodes; n++ )
+        vp->numa_first[n+1] += vp->numa_first[n];
+    for( t = 0; t < vp->nb_cores; t++ ) {
+        n = vp->execution_streams[t]->numa_id;
+        if( (n >= 0) && (n < nb_nodes) )
+            vp->numa_streams[vp->numa_first[n] + fill[n]++] = vp->execution_streams[t];
+    }
+    free(fill);
+    vp->nb_numa_nodes = nb_nodes;
+}
+
 static void parsec_vp_init( parsec_vp_t *vp,
                             int32_t vp_cores,
                            __parsec_temporary_thread_initialization_t *startup)
@@ -357,6 +401,9 @@ static void parsec_vp_init( parsec_vp_t *vp,
 
     assert(vp_cores > 0);
     vp->nb_cores = vp_cores;
+    vp->nb_numa_nodes = 0;
+    vp->numa_first = NULL;
+    vp->numa_streams = NULL;
 
     barrier = (parsec_barrier_t*)malloc(sizeof(parsec_barrier_t));
     parsec_barrier_init(barrier, NULL, vp->nb_cores);
@@ -540,6 +587,14 @@ parsec_context_t* parsec_init( int nb_cores, int* pargc, char** pargv[] )
      */
     parsec_mca_param_reg_int_name("runtime", "keep_highest_priority_task", "Allow a compute thread to retain the highest priority task to be executed locally. This change makes the scheduling decision non-deterministic because some tasks will never be handled to the scheduler.", false, false,
                                   parsec_runtime_keep_highest_priority_task, &parsec_runtime_keep_highest_priority_task);
+    parsec_mca_param_reg_int_name("runtime", "sched_locality", "Hand each ready task to an execution stream on the NUMA node"
+                                  " holding most of its input data, instead of the execution stream releasing it.",
+                                  false, false,
+                                  parsec_runtime_sched_locality, &parsec_runtime_sched_locality);
+    parsec_mca_param_reg_int_name("runtime", "auto_priority", "Use the bottom level estimated by the PTG compiler (--auto-priority)"
+                                  " as the priority of the tasks without a priority expression.",
+                                  false, false,
+                                  parsec_runtime_auto_priority, &parsec_runtime_auto_priority);
 
     /*
      * Initialize the VPMAP, the discrete domains hosting
@@ -649,8 +704,12 @@ parsec_context_t* parsec_init( int nb_cores, int* pargc, char** pargv[] )
          * bound to the allocation context of this thread.
          */
         parsec_vp_init(vp, vpmap_get_nb_threads_in_vp(p), &(startup[t]));
+        for( int i = 0; i < vp->nb_cores; i++ )
+            startup[t + i].global_id = t + i;
         t += vp->nb_cores;
     }
+    if( parsec_arena_nb_magazines < nb_total_comp_threads )
+        parsec_arena_nb_magazines = nb_total_comp_threads;
 
     /*
      * Parameters defining the default ARENA behavior. Handle with care they can lead to
@@ -664,6 +723,26 @@ parsec_context_t* parsec_init( int nb_cores, int* pargc, char** pargv[] )
     parsec_mca_param_reg_sizet_name("arena", "max_cached", "The maximum amount of memory each arena can"
                                    " cache in a freelist (0=no caching)",
                                    false, false, parsec_arena_max_cached_memory, &parsec_arena_max_cached_memory);
+    parsec_mca_param_reg_int_name("arena", "magazine_size", "The number of elements each execution stream can"
+                                  " cache privately in each arena, without synchronization (0=disabled)",
+                                  false, false, parsec_arena_magazine_size, &parsec_arena_magazine_size);
+    parsec_mca_param_reg_int_name("arena", "hugepages", "Allocate the arena elements from slabs backed by huge pages"
+                                  " (only for arenas with caching enabled)",
+                                  false, false, parsec_arena_hugepages, &parsec_arena_hugepages);
+    parsec_mca_param_reg_int_name("arena", "numa", "Keep one freelist per NUMA node in each arena, and allocate the"
+                                  " arena elements on the NUMA node of the requesting execution stream",
+                                  false, false, parsec_arena_numa, &parsec_arena_numa);
+    parsec_arena_nb_numa_nodes = 0;
+    if( parsec_arena_numa ) {
+        int nb_nodes = parsec_hwloc_nb_numa_nodes();
+        if( nb_nodes > PARSEC_ARENA_MAX_NUMA_NODES ) {
+            parsec_warning("The arenas only handle the first %d NUMA nodes out of %d",
+                           PARSEC_ARENA_MAX_NUMA_NODES, nb_nodes);
+            nb_nodes = PARSEC_ARENA_MAX_NUMA_NODES;
+        }
+        if( nb_nodes > 0 )
+            parsec_arena_nb_numa_nodes = nb_nodes;
+    }
 
     parsec_mca_param_reg_sizet_name("task", "startup_iter", "The number of ready tasks to be generated during the startup "
                                    "before allowing the scheduler to distribute them across the entire execution context.",
@@ -771,6 +850,9 @@ parsec_context_t* parsec_init( int nb_cores, int* pargc, char** pargv[] )
     parsec_parse_comm_binding_parameter(comm_binding_parameter, context);
     parsec_parse_binding_parameter(binding_parameter, context, startup);
 
+    /* The metrics must exist before the streams and the communication engine */
+    (void)parsec_metrics_init(nb_total_comp_threads, (parsec_debug_rank < 0) ? 0 : parsec_debug_rank);
+
     /* Introduce communication engine */
     (void)parsec_remote_dep_init(context);
 
@@ -859,6 +941,12 @@ parsec_context_t* parsec_init( int nb_cores, int* pargc, char** pargv[] )
     parsec_barrier_wait( &(context->barrier) );
     context->__parsec_internal_finalization_counter++;
 
+    if( parsec_runtime_sched_locality ) {
+        for( p = 0; p < nb_vp; p++ ) {
+            parsec_vp_locality_init(context->virtual_processes[p]);
+        }
+    }
+
     /* Release the temporary array used for starting up the threads */
     {
         parsec_barrier_t* barrier = startup[0].barrier;
@@ -1069,6 +1157,7 @@ static void parsec_mempool_stats(parsec_context_t *context)
     int i, p;
     unsigned int t;
     size_t m_usage;
+    int64_t hits, misses;
     char meminfo[128];
     parsec_vp_t *vp;
     parsec_mempool_t *mp;
@@ -1104,6 +1193,26 @@ static void parsec_mempool_stats(parsec_context_t *context)
     }
     snprintf(meminfo, 128, "MEMPOOL - Dependencies - %zu bytes", m_usage);
     parsec_profiling_add_information("MEMORY_USAGE", meminfo);
+
+    /* The counters are only updated when the magazines go to the shared
+     * freelist, and when the arenas are destructed. */
+    hits = parsec_arena_magazine_hits;
+    misses = parsec_arena_magazine_misses;
+    snprintf(meminfo, 128, "ARENA - Magazines - %lld hits %lld misses (%.1f%% hit rate)",
+             (long long)hits, (long long)misses,
+             (0 == hits + misses) ? 0.0 : (100.0 * hits) / (double)(hits + misses));
+    parsec_profiling_add_information("MEMORY_USAGE", meminfo);
+
+    snprintf(meminfo, 128, "ARENA - Slabs - %lld bytes", (long long)parsec_arena_slab_memory);
+    parsec_profiling_add_information("MEMORY_USAGE", meminfo);
+
+    for(i = 0; i < parsec_arena_nb_numa_nodes; i++) {
+        snprintf(meminfo, 128, "ARENA - NUMA node %d - %lld allocations %lld reuses %lld bytes", i,
+                 (long long)parsec_arena_numa_counters[i].nb_allocs,
+                 (long long)parsec_arena_numa_counters[i].nb_reuses,
+                 (long long)parsec_arena_numa_counters[i].bytes);
+        parsec_profiling_add_information("MEMORY_USAGE", meminfo);
+    }
 }
 #endif
 
@@ -1121,6 +1230,11 @@ static void parsec_vp_fini( parsec_vp_t *vp )
         free(vp->execution_streams[i]);
         vp->execution_streams[i] = NULL;
     }
+    free(vp->numa_first);
+    vp->numa_first = NULL;
+    free(vp->numa_streams);
+    vp->numa_streams = NULL;
+    vp->nb_numa_nodes = 0;
 }
 
 void parsec_context_at_fini(parsec_external_fini_cb_t cb, void *data)
@@ -1242,11 +1356,15 @@ int parsec_fini( parsec_context_t** pcontext )
 
     parsec_mca_device_fini();
 
+    /* The execution streams are going away, the main thread should not
+     * refer to its own anymore (arenas can be used after parsec_fini). */
+    PARSEC_TLS_SET_SPECIFIC(parsec_tls_execution_stream, NULL);
     for(p = 0; p < context->nb_vp; p++) {
         parsec_vp_fini(context->virtual_processes[p]);
         free(context->virtual_processes[p]);
         context->virtual_processes[p] = NULL;
     }
+    parsec_metrics_fini();
 
     if(parsec_dot_file) {
 #if defined(PARSEC_PROF_GRAPHER)
@@ -1398,9 +1516,10 @@ static parsec_ontask_iterate_t count_deps_fct(struct parsec_execution_stream_s*
     return PARSEC_ITERATE_CONTINUE;
 }
 
+/* Count the input dependencies of a task by walking the flows of its task class */
 static parsec_dependency_t
-parsec_check_IN_dependencies_with_counter( const parsec_taskpool_t *tp,
-                                           const parsec_task_t* task )
+parsec_count_IN_dependencies( const parsec_taskpool_t *tp,
+                              const parsec_task_t* task )
 {
     const parsec_task_class_t* tc = task->task_class;
     int i, j, active;
@@ -1408,14 +1527,6 @@ parsec_check_IN_dependencies_with_counter( const parsec_taskpool_t *tp,
     const parsec_dep_t* dep;
     parsec_dependency_t ret = 0;
 
-    if( !(tc->flags & PARSEC_HAS_CTL_GATHER) &&
-        !(tc->flags & PARSEC_HAS_IN_IN_DEPENDENCIES) ) {
-        /* If the number of goal does not depend on this particular task instance,
-         * it is pre-computed by the parsec_ptgpp compiler
-         */
-        return tc->dependencies_goal;
-    }
-
     for( i = 0; (i < MAX_PARAM_COUNT) && (NULL != tc->in[i]); i++ ) {
         flow = tc->in[i];
 
@@ -1485,6 +1596,38 @@ parsec_check_IN_dependencies_with_counter( const parsec_taskpool_t *tp,
     return ret;
 }
 
+static parsec_dependency_t
+parsec_check_IN_dependencies_with_counter( const parsec_taskpool_t *tp,
+                                           const parsec_task_t* task )
+{
+    const parsec_task_class_t* tc = task->task_class;
+
+    if( !(tc->flags & PARSEC_HAS_CTL_GATHER) &&
+        !(tc->flags & PARSEC_HAS_IN_IN_DEPENDENCIES) ) {
+        /* If the number of goal does not depend on this particular task instance,
+         * it is pre-computed by the parsec_ptgpp compiler
+         */
+        return tc->dependencies_goal;
+    }
+    if( NULL != tc->count_deps ) {
+        /* The same count, generated for this task class */
+#if defined(PARSEC_DEBUG_PARANOID)
+        parsec_dependency_t generated = tc->count_deps(tp, task);
+        parsec_dependency_t generic = parsec_count_IN_dependencies(tp, task);
+        if( generated != generic ) {
+            char tmp[MAX_TASK_STRLEN];
+            parsec_fatal("The generated count of input dependencies of %s is %u instead of %u",
+                         parsec_task_snprintf(tmp, MAX_TASK_STRLEN, task),
+                         (unsigned int)generated, (unsigned int)generic);
+        }
+        return generated;
+#else
+        return tc->count_deps(tp, task);
+#endif  /* defined(PARSEC_DEBUG_PARANOID) */
+    }
+    return parsec_count_IN_dependencies(tp, task);
+}
+
 parsec_dependency_t*
 parsec_default_find_deps(const parsec_taskpool_t *tp,
                          parsec_execution_stream_t *es,
@@ -1684,6 +1827,7 @@ parsec_release_local_OUT_dependencies(parsec_execution_stream_t* es,
                                       const parsec_flow_t* PARSEC_RESTRICT dest_flow,
                                       parsec_dep_data_description_t* data,
                                       parsec_task_t** pready_ring,
+                                      int32_t* pready_count,
                                       data_repo_t* target_repo,
                                       parsec_data_copy_t* target_dc,
                                       data_repo_entry_t* target_repo_entry)
@@ -1754,6 +1898,7 @@ parsec_release_local_OUT_dependencies(parsec_execution_stream_t* es,
                     parsec_list_item_ring_push_sorted( (parsec_list_item_t*)(*pready_ring),
                                                        &new_context->super,
                                                        parsec_execution_context_priority_comparator );
+                (*pready_count)++;
             }
         }
     } else { /* Service not ready */
@@ -1898,6 +2043,7 @@ parsec_release_dep_fct(parsec_execution_stream_t *es,
                                               dep->flow,
                                               data,
                                               &arg->ready_lists[dst_vpid],
+                                              &arg->ready_counts[dst_vpid],
                                               target_repo, target_dc, target_repo_entry);
     }
 
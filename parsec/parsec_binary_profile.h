@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011-2020 The University of Tennessee and The University
+ * Copyright (c) 2011-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  */
@@ -17,6 +17,7 @@
  */
 
 #include "parsec/parsec_config.h"
+#include <stddef.h>
 #include <inttypes.h>
 #include <pthread.h>
 
@@ -42,6 +43,7 @@ typedef struct parsec_profiling_output_s {
 #define PROFILING_BUFFER_TYPE_THREAD      3
 #define PROFILING_BUFFER_TYPE_GLOBAL_INFO 4
 #define PROFILING_BUFFER_TYPE_HEADER      5
+#define PROFILING_BUFFER_TYPE_COMPRESSED_EVENTS 6
 typedef struct parsec_profiling_buffer_s {
     off_t    this_buffer_file_offset;    /* Used by the malloc / write method. MUST BE THE FIRST ELEMENT */
     off_t    next_buffer_file_offset;
@@ -55,6 +57,61 @@ typedef struct parsec_profiling_buffer_s {
     char     buffer[1];
 } parsec_profiling_buffer_t;
 
+/**
+ * Events buffers of a compressed profile (profile_compress MCA parameter)
+ * are not stored in fixed-size segments: each full events buffer is
+ * re-encoded and written back to back with the others, as a
+ * parsec_profiling_buffer_t of type PROFILING_BUFFER_TYPE_COMPRESSED_EVENTS
+ * whose buffer holds the structure below. this_buffer.nb_events and
+ * next_buffer_file_offset keep their meaning. Buffers that do not shrink
+ * are written as plain PROFILING_BUFFER_TYPE_EVENTS buffers, truncated to
+ * their used bytes.
+ *
+ * PROFILING_CODEC_DELTA_VARINT encodes each event as LEB128 varints:
+ * key, flags, then the zigzag deltas of taskpool_id, event_id and
+ * timestamp with the previous event of the buffer (0 for the first),
+ * followed by the raw info bytes if the event has some.
+ */
+#define PROFILING_CODEC_DELTA_VARINT 1
+typedef struct {
+    int32_t codec;                     /* PROFILING_CODEC_* used to encode the payload */
+    int32_t encoded_size;              /* Number of bytes in the payload */
+    int64_t raw_size;                  /* Number of bytes of the events once decoded */
+    char    payload[1];                /* Follow: encoded events */
+} parsec_profiling_compressed_events_t;
+
+#define PARSEC_PROFILING_ZIGZAG(d)   ((((uint64_t)(d)) << 1) ^ (uint64_t)(((int64_t)(d)) >> 63))
+#define PARSEC_PROFILING_UNZIGZAG(u) ((uint64_t)((u) >> 1) ^ (uint64_t)(-(int64_t)((u) & 1)))
+
+static inline size_t parsec_profiling_varint_encode(uint64_t v, unsigned char *out)
+{
+    size_t n = 0;
+    while( v >= 0x80 ) {
+        out[n++] = (unsigned char)(v | 0x80);
+        v >>= 7;
+    }
+    out[n++] = (unsigned char)v;
+    return n;
+}
+
+/* Returns the number of bytes consumed, 0 if the varint is truncated or too long */
+static inline size_t parsec_profiling_varint_decode(const unsigned char *in, size_t avail, uint64_t *v)
+{
+    uint64_t r = 0;
+    size_t n = 0;
+    int shift = 0;
+    do {
+        if( (n == avail) || (shift > 63) )
+            return 0;
+        r |= ((uint64_t)(in[n] & 0x7f)) << shift;
+        shift += 7;
+    } while( in[n++] & 0x80 );
+    *v = r;
+    return n;
+}
+/* Worst case of an encoded event, without its info */
+#define PROFILING_CODEC_MAX_EVENT_LENGTH (3 + 3 + 10 + 10 + 10)
+
 typedef struct {
     int32_t info_size;                 /* Number of bytes in this structure for the info */
     int32_t value_size;                /* Number of bytes in this structure for the value 
@@ -122,7 +179,8 @@ typedef struct parsec_profiling_info_s {
 #if defined(PARSEC_PROFILING_USE_HELPER_THREAD)
 #define PERF_USER_WAITING 7
 #endif
-#define PERF_MAX      8
+#define PERF_STALL    8
+#define PERF_MAX      9
 typedef struct parsec_profiling_perf_s {
     uint64_t perf_time_spent;
     uint32_t perf_number_calls;
@@ -142,6 +200,8 @@ struct parsec_profiling_stream_s {
     off_t                      first_events_buffer_offset; /* Offset (in the file) of the first events buffer */
     pthread_t                  thread_owner;
     off_t                      current_events_buffer_offset;
+    off_t                      last_events_buffer_offset;  /* Compressed profiles: offset of the last events buffer
+                                                            *   written, to link the next one to it */
     parsec_profiling_buffer_t *current_events_buffer;     /* points to the events buffer in which we are writing. */
 };
 
@@ -153,6 +213,7 @@ typedef struct {
 } parsec_profiling_key_t;
 
 #define PARSEC_PROFILING_MAGICK "#PARSEC BINARY PROFILE "
+#define PARSEC_PROFILING_COMPRESSED_MAGICK "#PARSEC PACKED PROFILE "
 
 /** here key is the key given to the USER */
 #define BASE_KEY(key)     ((key) >> 1)
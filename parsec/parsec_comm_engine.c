@@ -1,12 +1,17 @@
 /*
- * Copyright (c) 2009-2023 The University of Tennessee and The University
+ * Copyright (c) 2009-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  */
 
+#include <mpi.h>
 #include <assert.h>
+#include <string.h>
 #include "parsec/parsec_mpi_funnelled.h"
+#include "parsec/parsec_mpi_multithreaded.h"
 #include "parsec/remote_dep.h"
+#include "parsec/utils/debug.h"
+#include "parsec/utils/mca_param.h"
 
 parsec_comm_engine_t parsec_ce;
 
@@ -14,8 +19,31 @@ parsec_comm_engine_t parsec_ce;
 parsec_comm_engine_t *
 parsec_comm_engine_init(parsec_context_t *parsec_context)
 {
+    parsec_comm_engine_t *ce = NULL;
+    char *engine = NULL;
+    int thread_level_support;
+
+    parsec_mca_param_reg_string_name("runtime", "comm_engine",
+                                     "Select the MPI communication engine: funnelled (all communications are done by the communication thread)"
+                                     " or multithreaded (the computing threads inject their active messages directly, requires MPI_THREAD_MULTIPLE)",
+                                     false, false, "funnelled", &engine);
+
     /* call the selected module init */
-    parsec_comm_engine_t *ce = mpi_funnelled_init(parsec_context);
+    if( (NULL != engine) && (0 == strcmp(engine, "multithreaded")) ) {
+        MPI_Query_thread(&thread_level_support);
+        if( thread_level_support >= MPI_THREAD_MULTIPLE ) {
+            ce = mpi_multithreaded_init(parsec_context);
+        } else {
+            parsec_warning("The multithreaded communication engine requires MPI_THREAD_MULTIPLE.\n"
+                           "\t* PaRSEC will continue with the funnelled communication engine.\n");
+        }
+    }
+    else if( (NULL != engine) && (0 != strcmp(engine, "funnelled")) ) {
+        parsec_warning("Unknown communication engine '%s', using the funnelled communication engine.", engine);
+    }
+    if( NULL == ce ) {
+        ce = mpi_funnelled_init(parsec_context);
+    }
 
     assert(ce->capabilites.sided > 0 && ce->capabilites.sided < 3);
     return ce;
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2009-2023 The University of Tennessee and The University
+ * Copyright (c) 2009-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  */
@@ -21,7 +21,7 @@ typedef enum {
  * To avoid runtime conflicts, the AM tags must be manually reserved
  * in the section below.
  */
-#define PARSEC_MAX_REGISTERED_TAGS  12
+#define PARSEC_MAX_REGISTERED_TAGS  13
 
 /* Internal TAG for GET and PUT activation message,
  * for two sides to agree on a "TAG" to post Irecv and Isend on
@@ -36,6 +36,9 @@ typedef enum {
     PARSEC_TERMDET_USER_TRIGGER_MSG_TAG,
     PARSEC_DSL_TTG_TAG,
     PARSEC_DSL_TTG_RMA_TAG,
+    PARSEC_CE_REMOTE_DEP_EAGER_TAG,
+    PARSEC_CE_REMOTE_DEP_CREDIT_TAG,
+    PARSEC_TERMDET_HIERARCHICAL_MSG_TAG,
     PARSEC_CE_REMOTE_DEP_MAX_CTRL_TAG
 } parsec_remote_dep_tag_t;
 
@@ -64,6 +67,14 @@ typedef int (*parsec_ce_tag_register_fn_t)(parsec_ce_tag_t tag,
 
 typedef int (*parsec_ce_tag_unregister_fn_t)(parsec_ce_tag_t tag);
 
+/* Number of messages of a tag that can be received ahead of their callbacks
+ * (the default depends on the engine). Senders that never have more than
+ * depth messages in flight toward a process on this tag cannot be blocked by
+ * the lack of a matching receive. Must be called right after registering the
+ * tag, before the engine starts receiving on it.
+ */
+typedef int (*parsec_ce_tag_set_depth_fn_t)(parsec_ce_tag_t tag, int depth);
+
 /* PaRSEC will try to use non-contiguous type for lower layer capable of
  * supporting it.
  * For non-contiguous type the lower layer will expect layout and count and for
@@ -176,12 +187,14 @@ struct parsec_comm_engine_capabilites_s {
 struct parsec_comm_engine_s {
     parsec_context_t                      *parsec_context;
     parsec_comm_engine_capabilites_t       capabilites;
+    int                                   *node_of;  /* node of each rank (its lowest rank), NULL if unknown */
     parsec_ce_enable_fn_t                  enable;
     parsec_ce_disable_fn_t                 disable;
     parsec_ce_set_ctx_fn_t                 set_ctx;
     parsec_ce_fini_fn_t                    fini;
     parsec_ce_tag_register_fn_t            tag_register;
     parsec_ce_tag_unregister_fn_t          tag_unregister;
+    parsec_ce_tag_set_depth_fn_t           tag_set_depth;
     parsec_ce_mem_register_fn_t            mem_register;
     parsec_ce_mem_unregister_fn_t          mem_unregister;
     parsec_ce_get_mem_reg_handle_size_fn_t get_mem_handle_size;
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010-2022 The University of Tennessee and The University
+ * Copyright (c) 2010-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  */
@@ -298,15 +298,95 @@ int parsec_hwloc_numa_id(int core_id )
     hwloc_obj_t core =  hwloc_get_obj_by_type(topology, HWLOC_OBJ_CORE, core_id);
     hwloc_obj_t node = NULL;
     if( NULL == core ) return PARSEC_ERR_NOT_FOUND;  /* protect against NULL objects */
+#if HWLOC_API_VERSION >= 0x00020000
+    /* NUMA nodes are memory children, not ancestors of the cores anymore */
+    while( NULL != (node = hwloc_get_next_obj_by_type(topology, HWLOC_OBJ_NUMANODE, node)) ) {
+        if( hwloc_bitmap_isincluded(core->cpuset, node->cpuset) )
+            return node->logical_index;
+    }
+#else
     if( NULL != (node = hwloc_get_ancestor_obj_by_type(topology , HWLOC_OBJ_NODE, core)) ) {
         return node->logical_index;
     }
+#endif  /* HWLOC_API_VERSION >= 0x00020000 */
 #else
     (void)core_id;
 #endif  /* defined(PARSEC_HAVE_HWLOC) */
     return PARSEC_ERR_NOT_IMPLEMENTED;
 }
 
+int parsec_hwloc_nb_numa_nodes(void)
+{
+#if defined(PARSEC_HAVE_HWLOC)
+    return hwloc_get_nbobjs_by_type(topology, HWLOC_OBJ_NODE);
+#else
+    return PARSEC_ERR_NOT_IMPLEMENTED;
+#endif  /* defined(PARSEC_HAVE_HWLOC) */
+}
+
+void *parsec_hwloc_alloc_membind(size_t size, int node_id)
+{
+#if defined(PARSEC_HAVE_HWLOC)
+    hwloc_obj_t node = hwloc_get_obj_by_type(topology, HWLOC_OBJ_NODE, node_id);
+    if( NULL == node ) return NULL;
+#if HWLOC_API_VERSION >= 0x00020000
+    return hwloc_alloc_membind(topology, size, node->nodeset, HWLOC_MEMBIND_BIND, HWLOC_MEMBIND_BYNODESET);
+#else
+    return hwloc_alloc_membind_nodeset(topology, size, node->nodeset, HWLOC_MEMBIND_BIND, 0);
+#endif  /* HWLOC_API_VERSION >= 0x00020000 */
+#else
+    (void)size; (void)node_id;
+    return NULL;
+#endif  /* defined(PARSEC_HAVE_HWLOC) */
+}
+
+void parsec_hwloc_free_membind(void *ptr, size_t size)
+{
+#if defined(PARSEC_HAVE_HWLOC)
+    hwloc_free(topology, ptr, size);
+#else
+    (void)ptr; (void)size;
+#endif  /* defined(PARSEC_HAVE_HWLOC) */
+}
+
+int parsec_hwloc_bind_memory(void *ptr, size_t size, int node_id)
+{
+#if defined(PARSEC_HAVE_HWLOC)
+    hwloc_obj_t node = hwloc_get_obj_by_type(topology, HWLOC_OBJ_NODE, node_id);
+    if( NULL == node ) return PARSEC_ERR_NOT_FOUND;
+#if HWLOC_API_VERSION >= 0x00020000
+    if( 0 != hwloc_set_area_membind(topology, ptr, size, node->nodeset, HWLOC_MEMBIND_BIND, HWLOC_MEMBIND_BYNODESET) )
+#else
+    if( 0 != hwloc_set_area_membind_nodeset(topology, ptr, size, node->nodeset, HWLOC_MEMBIND_BIND, 0) )
+#endif  /* HWLOC_API_VERSION >= 0x00020000 */
+        return PARSEC_ERROR;
+    return PARSEC_SUCCESS;
+#else
+    (void)ptr; (void)size; (void)node_id;
+    return PARSEC_ERR_NOT_IMPLEMENTED;
+#endif  /* defined(PARSEC_HAVE_HWLOC) */
+}
+
+int parsec_hwloc_memory_node(const void *ptr)
+{
+#if defined(PARSEC_HAVE_HWLOC) && HWLOC_API_VERSION >= 0x00020000
+    hwloc_nodeset_t nodeset = hwloc_bitmap_alloc();
+    hwloc_obj_t node;
+    int node_id = PARSEC_ERR_NOT_FOUND;
+
+    if( 0 == hwloc_get_area_memlocation(topology, ptr, 1, nodeset, HWLOC_MEMBIND_BYNODESET) &&
+        1 == hwloc_bitmap_weight(nodeset) ) {
+        node = hwloc_get_numanode_obj_by_os_index(topology, hwloc_bitmap_first(nodeset));
+        if( NULL != node ) node_id = (int)node->logical_index;
+    }
+    hwloc_bitmap_free(nodeset);
+    return node_id;
+#else
+    (void)ptr;
+    return PARSEC_ERR_NOT_IMPLEMENTED;
+#endif  /* defined(PARSEC_HAVE_HWLOC) && HWLOC_API_VERSION >= 0x00020000 */
+}
+
 unsigned int parsec_hwloc_nb_cores_per_obj( int level, int index )
 {
 #if defined(PARSEC_HAVE_HWLOC)
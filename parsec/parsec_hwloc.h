@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010-2017 The University of Tennessee and The University
+ * Copyright (c) 2010-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  */
@@ -93,6 +93,36 @@ int parsec_hwloc_socket_id(int core_id);
  */
 int parsec_hwloc_numa_id(int core_id);
 
+/**
+ * Return the number of NUMA nodes of the machine.
+ */
+int parsec_hwloc_nb_numa_nodes(void);
+
+/**
+ * Allocate size bytes of memory bound to the NUMA node node_id (logical
+ * index). Returns NULL if the allocation or the binding is not possible.
+ * The memory must be released with parsec_hwloc_free_membind.
+ */
+void *parsec_hwloc_alloc_membind(size_t size, int node_id);
+
+/**
+ * Release memory allocated by parsec_hwloc_alloc_membind.
+ */
+void parsec_hwloc_free_membind(void *ptr, size_t size);
+
+/**
+ * Bind the pages of an existing memory area to the NUMA node node_id.
+ * Pages that have not yet been touched will be allocated on that node.
+ */
+int parsec_hwloc_bind_memory(void *ptr, size_t size, int node_id);
+
+/**
+ * Return the NUMA node (logical index) holding the page at address ptr, or
+ * a negative value if it cannot be determined (e.g. the page has not been
+ * touched yet, or the memory is spread over several nodes).
+ */
+int parsec_hwloc_memory_node(const void *ptr);
+
 /**
  * Return the depth of the first core hardware ancestor: NUMA node or socket.
  */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2012-2024 The University of Tennessee and The University
+ * Copyright (c) 2012-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * Copyright (c) 2024      NVIDIA Corporation.  All rights reserved.
@@ -362,6 +362,12 @@ parsec_dependency_t *parsec_default_find_deps(const parsec_taskpool_t *tp,
 parsec_dependency_t *parsec_hash_find_deps(const parsec_taskpool_t *tp,
                                            parsec_execution_stream_t *es,
                                            const parsec_task_t* task);
+/**
+ * Count the input dependencies a task must wait for, when they depend on the
+ * task and are tracked with a counter.
+ */
+typedef parsec_dependency_t (parsec_count_dependency_fn_t)(const parsec_taskpool_t *tp,
+                                                           const parsec_task_t* task);
 typedef int (parsec_update_dependency_fn_t)(parsec_taskpool_t* tp,
                                             const parsec_task_t* PARSEC_RESTRICT task,
                                             parsec_dependency_t *deps,
@@ -446,6 +452,7 @@ struct parsec_task_class_s {
 
     parsec_find_dependency_fn_t   *find_deps;
     parsec_update_dependency_fn_t *update_deps;
+    parsec_count_dependency_fn_t  *count_deps;  /**< Optional, specialized parsec_check_IN_dependencies_with_counter */
 
     parsec_traverse_function_t  *iterate_successors;
     parsec_traverse_function_t  *iterate_predecessors;
@@ -492,6 +499,21 @@ PARSEC_DECLSPEC extern int parsec_slow_bind_warning;
  * the scheduler, but can provide a better cache reuse.
  */
 PARSEC_DECLSPEC extern int parsec_runtime_keep_highest_priority_task;
+/**
+ * Global configuration variable controlling the locality-aware scheduling.
+ * If enabled, a ready task whose input data lives mostly on another NUMA
+ * node is handed to an execution stream of that node instead of the one
+ * that released it.
+ */
+PARSEC_DECLSPEC extern int parsec_runtime_sched_locality;
+/**
+ * Global configuration variable controlling the automatic task priorities.
+ * If enabled (the default), the tasks of PTG task classes compiled with
+ * --auto-priority and without a priority expression get their estimated
+ * bottom level (the length of the longest path to the end of the DAG) as
+ * priority.
+ */
+PARSEC_DECLSPEC extern int parsec_runtime_auto_priority;
 
 /**
  * Description of the state of the task. It indicates what will be the next
@@ -629,6 +651,8 @@ typedef struct {
                                                 * consume appropriately.
                                                 */
     parsec_task_t              **ready_lists;
+    int32_t                     *ready_counts; /* Number of tasks in each of the ready_lists, so that
+                                                * the rings can be scheduled in bulk */
 #if defined(DISTRIBUTED)
     struct parsec_remote_deps_s *remote_deps;
 #endif
@@ -704,6 +728,7 @@ parsec_release_local_OUT_dependencies(parsec_execution_stream_t* es,
                                       const parsec_flow_t* dest_flow,
                                       parsec_dep_data_description_t* data,
                                       parsec_task_t** pready_ring,
+                                      int32_t* pready_count,
                                       data_repo_t* target_repo,
                                       parsec_data_copy_t* target_dc,
                                       data_repo_entry_t* target_repo_entry);
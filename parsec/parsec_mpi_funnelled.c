@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2009-2023 The University of Tennessee and The University
+ * Copyright (c) 2009-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  */
@@ -95,7 +95,8 @@ static parsec_atomic_lock_t parsec_ce_am_build_lock = PARSEC_ATOMIC_UNLOCKED;
 static int mpi_funnelled_tag_unregister_unsafe_internal(parsec_ce_tag_t tag);
 
 /* Range of index allowed for each type of request.
- * For registered tags, each will get EACH_STATIC_REQ_RANGE spots in the array of requests.
+ * For registered tags, each will get EACH_STATIC_REQ_RANGE spots in the array of requests,
+ * unless the tag asked for a different depth.
  * For dynamic tags, there will be a total of MAX_DYNAMIC_REQ_RANGE
  * spots in the request array.
  */
@@ -115,6 +116,7 @@ typedef struct mpi_funnelled_tag_s {
     int16_t start_idx; /* Records the starting index for every TAG
                         * to unregister from the array_of_[requests/indices/statuses]
                         */
+    int16_t nb_reqs;   /* Number of persistent receives posted for this TAG */
     parsec_ce_tag_status_t status;  /* The current status of this tag (inactive/active, enable/disable) */
     size_t  msg_length; /* Maximum length allowed to send for this TAG */
     parsec_ce_am_callback_t callback;  /* callback to call upon reception of the
@@ -553,6 +555,7 @@ mpi_funnelled_init(parsec_context_t *context)
     parsec_ce.fini                = mpi_funnelled_fini;
     parsec_ce.tag_register        = mpi_no_thread_tag_register;
     parsec_ce.tag_unregister      = mpi_no_thread_tag_unregister;
+    parsec_ce.tag_set_depth       = mpi_no_thread_tag_set_depth;
     parsec_ce.mem_register        = NULL;
     parsec_ce.mem_unregister      = NULL;
     parsec_ce.get_mem_handle_size = NULL;
@@ -571,6 +574,8 @@ mpi_funnelled_init(parsec_context_t *context)
     parsec_ce.parsec_context      = context;
     parsec_ce.capabilites.sided   = 2;
     parsec_ce.capabilites.supports_noncontiguous_datatype = 1;
+    parsec_ce.capabilites.multithreaded = 0;
+    parsec_ce.node_of             = NULL;
 
     /* Define some sensible values. We assume the application will initialize PaRSEC using
      * the entire MPI_COMM_WORLD, but we need to prepare some decent default values. */
@@ -593,6 +598,17 @@ mpi_funnelled_init(parsec_context_t *context)
     return &parsec_ce;
 }
 
+/**
+ * Return the communicator used for the active messages of a tag, as an opaque
+ * handle similar to the context comm_ctx. Only valid once the engine is enabled.
+ */
+intptr_t
+mpi_funnelled_am_comm(parsec_ce_tag_t tag)
+{
+    assert(tag < PARSEC_MAX_REGISTERED_TAGS);
+    return (intptr_t)parsec_ce_mpi_am_comm[tag];
+}
+
 /**
  * The communication engine is now completely disabled. All internal resources
  * are released, and no future communications are possible.
@@ -643,6 +659,7 @@ mpi_funnelled_fini(parsec_comm_engine_t *ce)
         }
         ce->parsec_context->comm_ctx = -1; /* We use -1 for the opaque comm_ctx, rather than the MPI specific MPI_COMM_NULL */
     }
+    free(ce->node_of); ce->node_of = NULL;
     assert(MPI_COMM_NULL == parsec_ce_mpi_comm );  /* no communicator */
     assert(MPI_COMM_NULL == parsec_ce_mpi_am_comm[0] );  /* no communicator */
     MAX_MPI_TAG = -1;  /* mark the layer as uninitialized */
@@ -686,9 +703,10 @@ mpi_no_thread_tag_register(parsec_ce_tag_t tag,
     tag_struct->callback = callback;
     tag_struct->cb_data = cb_data;
     tag_struct->status = PARSEC_CE_TAG_STATUS_ENABLE;
+    tag_struct->nb_reqs = EACH_STATIC_REQ_RANGE;
 
     /* Update the total number of requests we know about */
-    size_of_total_reqs += EACH_STATIC_REQ_RANGE;
+    size_of_total_reqs += tag_struct->nb_reqs;
     /* Make sure the AM infrastructure is rebuilt at the next progress cycle */
     parsec_ce_am_design_version++;
     parsec_atomic_unlock(&parsec_ce_am_build_lock);
@@ -721,28 +739,28 @@ static int parsec_ce_rebuild_am_requests(void)
             (tag_struct->status == PARSEC_CE_TAG_STATUS_INACTIVE) )  /* No changes for this tag */
             continue;
         if( tag_struct->status == PARSEC_CE_TAG_STATUS_DISABLE ) {
+            old_idx += tag_struct->nb_reqs;
             mpi_funnelled_tag_unregister_unsafe_internal(tag);
-            old_idx += EACH_STATIC_REQ_RANGE;
             continue;
         }
         if( tag_struct->status == PARSEC_CE_TAG_STATUS_ACTIVE ) {
             memcpy(&tmp_array_cb[idx], &array_of_callbacks[old_idx],
-                   sizeof(mpi_funnelled_callback_t) * EACH_STATIC_REQ_RANGE);
+                   sizeof(mpi_funnelled_callback_t) * tag_struct->nb_reqs);
             memcpy(&tmp_array_req[idx], &array_of_requests[old_idx],
-                   sizeof(MPI_Request) * EACH_STATIC_REQ_RANGE);
-            idx     += EACH_STATIC_REQ_RANGE;
-            old_idx += EACH_STATIC_REQ_RANGE;
+                   sizeof(MPI_Request) * tag_struct->nb_reqs);
+            idx     += tag_struct->nb_reqs;
+            old_idx += tag_struct->nb_reqs;
             continue;
         }
         assert(PARSEC_CE_TAG_STATUS_ENABLE == tag_struct->status);
 
-        char *buf = (char *) calloc(EACH_STATIC_REQ_RANGE, tag_struct->msg_length * sizeof(char));
+        char *buf = (char *) calloc(tag_struct->nb_reqs, tag_struct->msg_length * sizeof(char));
 
         tag_struct->am_backend_memory = buf;
         tag_struct->start_idx  = idx;
         tag_struct->status = PARSEC_CE_TAG_STATUS_ACTIVE;
 
-        for(int i = 0; i < EACH_STATIC_REQ_RANGE; i++) {
+        for(int i = 0; i < tag_struct->nb_reqs; i++) {
             buf = tag_struct->am_backend_memory + i * tag_struct->msg_length * sizeof(char);
 
             /* Even though the address of array_of_requests changes after every
@@ -764,7 +782,7 @@ static int parsec_ce_rebuild_am_requests(void)
             idx++;
         }
         /* Tag ready to receive data, start all persistent receives */
-        MPI_Startall(EACH_STATIC_REQ_RANGE, &tmp_array_req[idx - EACH_STATIC_REQ_RANGE]);
+        MPI_Startall(tag_struct->nb_reqs, &tmp_array_req[idx - tag_struct->nb_reqs]);
     }
     /* Replace the arrays of callbacks and requests with the newly populated ones */
     free(array_of_callbacks);
@@ -790,7 +808,7 @@ mpi_funnelled_tag_unregister_unsafe_internal(parsec_ce_tag_t tag)
         (PARSEC_CE_TAG_STATUS_DISABLE == tag_struct->status) ) {
         MPI_Status status;
 
-        for(int flag, i = tag_struct->start_idx; i < tag_struct->start_idx + EACH_STATIC_REQ_RANGE; i++) {
+        for(int flag, i = tag_struct->start_idx; i < tag_struct->start_idx + tag_struct->nb_reqs; i++) {
 #if !defined(CRAY_MPICH_VERSION)
             // MPI Cancel broken on Cray
             MPI_Cancel(&array_of_requests[i]);
@@ -836,6 +854,24 @@ mpi_no_thread_tag_unregister(parsec_ce_tag_t tag)
     return PARSEC_SUCCESS;
 }
 
+int
+mpi_no_thread_tag_set_depth(parsec_ce_tag_t tag, int depth)
+{
+    mpi_funnelled_tag_t *tag_struct = &parsec_mpi_funnelled_array_of_registered_tags[tag];
+    if( (depth < 1) || (depth > INT16_MAX) )
+        return PARSEC_ERR_VALUE_OUT_OF_BOUNDS;
+    parsec_atomic_lock(&parsec_ce_am_build_lock);
+    if( PARSEC_CE_TAG_STATUS_ENABLE != tag_struct->status ) {
+        /* the receives are already posted (or the tag is not registered) */
+        parsec_atomic_unlock(&parsec_ce_am_build_lock);
+        return PARSEC_ERR_NOT_SUPPORTED;
+    }
+    size_of_total_reqs += depth - tag_struct->nb_reqs;
+    tag_struct->nb_reqs = depth;
+    parsec_atomic_unlock(&parsec_ce_am_build_lock);
+    return PARSEC_SUCCESS;
+}
+
 int
 mpi_no_thread_mem_register(void *mem, parsec_mem_type_t mem_type,
                            size_t count, parsec_datatype_t datatype,
@@ -1332,6 +1368,28 @@ parsec_check_overlapping_binding(parsec_context_t *context)
 #endif
 }
 
+/**
+ * @brief Find the node hosting each rank of the communicator, identified by the
+ *        lowest rank sharing its memory. Collective over the communicator.
+ */
+static void
+mpi_funnelled_discover_nodes(parsec_comm_engine_t *ce, MPI_Comm comm)
+{
+    MPI_Comm comml = MPI_COMM_NULL;
+    int size, leader;
+
+    MPI_Comm_size(comm, &size);
+    MPI_Comm_rank(comm, &leader);
+    /* ranks keep their relative order in the local communicator, local rank 0 is the lowest */
+    MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &comml);
+    MPI_Bcast(&leader, 1, MPI_INT, 0, comml);
+    MPI_Comm_free(&comml);
+
+    free(ce->node_of);
+    ce->node_of = (int*)malloc(size * sizeof(int));
+    MPI_Allgather(&leader, 1, MPI_INT, ce->node_of, 1, MPI_INT, comm);
+}
+
 int
 mpi_no_thread_enable(parsec_comm_engine_t *ce)
 {
@@ -1406,6 +1464,7 @@ mpi_no_thread_enable(parsec_comm_engine_t *ce)
     }
 
     parsec_check_overlapping_binding(context);
+    mpi_funnelled_discover_nodes(ce, parsec_ce_mpi_comm);
 
     parsec_ce_rebuild_am_requests();
     return 1;
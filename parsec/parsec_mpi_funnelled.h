@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2009-2022 The University of Tennessee and The University
+ * Copyright (c) 2009-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  */
@@ -12,6 +12,8 @@
 parsec_comm_engine_t * mpi_funnelled_init(parsec_context_t *parsec_context);
 int mpi_funnelled_fini(parsec_comm_engine_t *comm_engine);
 
+intptr_t mpi_funnelled_am_comm(parsec_ce_tag_t tag);
+
 int mpi_no_thread_tag_register(parsec_ce_tag_t tag,
                                parsec_ce_am_callback_t cb,
                                void *cb_data,
@@ -19,6 +21,8 @@ int mpi_no_thread_tag_register(parsec_ce_tag_t tag,
 
 int mpi_no_thread_tag_unregister(parsec_ce_tag_t tag);
 
+int mpi_no_thread_tag_set_depth(parsec_ce_tag_t tag, int depth);
+
 int
 mpi_no_thread_mem_register(void *mem, parsec_mem_type_t mem_type,
                            size_t count, parsec_datatype_t datatype,
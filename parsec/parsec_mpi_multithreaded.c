@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+#include <mpi.h>
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "parsec/parsec_mpi_multithreaded.h"
+#include "parsec/parsec_mpi_funnelled.h"
+#include "parsec/remote_dep.h"
+#include "parsec/execution_stream.h"
+#include "parsec/utils/debug.h"
+#include "parsec/utils/mca_param.h"
+
+/* The state of a send request. A request is FREE when its owner thread can
+ * post a new send in it, POSTED while the send is in flight, and TESTING
+ * while the communication thread checks its completion. The owner thread
+ * only moves it from FREE to POSTED, all other transitions are done by the
+ * communication thread (or by a thread draining the engine), so MPI never
+ * sees the same request used concurrently by two threads.
+ */
+#define MPI_MULTITHREADED_REQ_FREE     0
+#define MPI_MULTITHREADED_REQ_POSTED   1
+#define MPI_MULTITHREADED_REQ_TESTING  2
+
+typedef struct mpi_multithreaded_send_req_s {
+    volatile int32_t state;
+    MPI_Request      request;
+    size_t           capacity;  /* size of buffer */
+    char            *buffer;    /* copy of the active message, the caller keeps its own */
+} mpi_multithreaded_send_req_t;
+
+/* Pool of send requests of a thread. There is one pool per computing thread,
+ * used without synchronization by its owner, and a shared pool protected by
+ * a lock for all the other threads (including the communication thread).
+ */
+typedef struct mpi_multithreaded_pool_s {
+    mpi_multithreaded_send_req_t *reqs;
+    volatile int32_t              nb_posted;  /* requests POSTED or TESTING */
+    int32_t                       next;       /* where to start looking for a FREE request */
+    parsec_atomic_lock_t          lock;       /* only used for the shared pool */
+    uint8_t                       padding[64 - sizeof(void*) - 2*sizeof(int32_t) - sizeof(parsec_atomic_lock_t)];
+} mpi_multithreaded_pool_t;
+
+static mpi_multithreaded_pool_t *mpi_multithreaded_pools = NULL;
+static int mpi_multithreaded_nb_pools = 0;  /* the last one is the shared pool */
+static int mpi_multithreaded_nb_reqs = 16;   /* per pool */
+
+/* Statistics */
+static volatile int64_t mpi_multithreaded_injected_sends = 0;
+static volatile int64_t mpi_multithreaded_blocking_sends = 0;
+
+/* Return the pool of the calling thread, and whether it is the shared one */
+static inline mpi_multithreaded_pool_t*
+mpi_multithreaded_my_pool(int *shared)
+{
+    parsec_execution_stream_t *es = parsec_my_execution_stream();
+    int id;
+
+    if( (NULL != es) && (&parsec_comm_es != es) ) {
+        parsec_context_t *context = es->virtual_process->parsec_context;
+        id = es->th_id;
+        for( int p = 0; p < es->virtual_process->vp_id; p++ )
+            id += context->virtual_processes[p]->nb_cores;
+        if( id < mpi_multithreaded_nb_pools - 1 ) {
+            *shared = 0;
+            return &mpi_multithreaded_pools[id];
+        }
+    }
+    *shared = 1;
+    return &mpi_multithreaded_pools[mpi_multithreaded_nb_pools - 1];
+}
+
+/* Check the completion of the posted sends, waiting for them if blocking.
+ * Returns the number of completed sends.
+ */
+static int
+mpi_multithreaded_recycle_sends(int blocking)
+{
+    mpi_multithreaded_pool_t *pool;
+    mpi_multithreaded_send_req_t *req;
+    int p, i, flag, completed = 0;
+
+    for( p = 0; p < mpi_multithreaded_nb_pools; p++ ) {
+        pool = &mpi_multithreaded_pools[p];
+        if( 0 == pool->nb_posted ) continue;
+        for( i = 0; i < mpi_multithreaded_nb_reqs; i++ ) {
+            req = &pool->reqs[i];
+            if( MPI_MULTITHREADED_REQ_POSTED != req->state ) continue;
+            if( !parsec_atomic_cas_int32(&req->state, MPI_MULTITHREADED_REQ_POSTED,
+                                         MPI_MULTITHREADED_REQ_TESTING) ) continue;
+            if( blocking ) {
+                MPI_Wait(&req->request, MPI_STATUS_IGNORE);
+                flag = 1;
+            } else {
+                MPI_Test(&req->request, &flag, MPI_STATUS_IGNORE);
+            }
+            if( flag ) {
+                parsec_atomic_fetch_dec_int32(&pool->nb_posted);
+                parsec_atomic_wmb();
+                req->state = MPI_MULTITHREADED_REQ_FREE;
+                completed++;
+            } else {
+                req->state = MPI_MULTITHREADED_REQ_POSTED;
+            }
+        }
+    }
+    return completed;
+}
+
+parsec_comm_engine_t *
+mpi_multithreaded_init(parsec_context_t *context)
+{
+    parsec_comm_engine_t *ce = mpi_funnelled_init(context);
+    if( NULL == ce )
+        return NULL;
+
+    parsec_mca_param_reg_int_name("runtime", "comm_mt_send_requests",
+                                  "Number of active messages each thread can have in flight with the multithreaded communication engine."
+                                  " Once they are all in flight the thread falls back to blocking sends.",
+                                  false, false, mpi_multithreaded_nb_reqs, &mpi_multithreaded_nb_reqs);
+    if( mpi_multithreaded_nb_reqs < 1 )
+        mpi_multithreaded_nb_reqs = 1;
+
+    ce->enable = mpi_multithreaded_enable;
+    ce->fini   = mpi_multithreaded_fini;
+    ce->capabilites.multithreaded = 1;
+    return ce;
+}
+
+int
+mpi_multithreaded_fini(parsec_comm_engine_t *ce)
+{
+    if( NULL != mpi_multithreaded_pools ) {
+        mpi_multithreaded_recycle_sends(1);
+        for( int p = 0; p < mpi_multithreaded_nb_pools; p++ ) {
+            for( int i = 0; i < mpi_multithreaded_nb_reqs; i++ )
+                free(mpi_multithreaded_pools[p].reqs[i].buffer);
+            free(mpi_multithreaded_pools[p].reqs);
+        }
+        free(mpi_multithreaded_pools);
+        mpi_multithreaded_pools = NULL;
+        mpi_multithreaded_nb_pools = 0;
+        parsec_debug_verbose(3, parsec_comm_output_stream,
+                             "MPI:\tmultithreaded engine injected %lld active messages (%lld blocking sends when all requests were in flight)",
+                             (long long)mpi_multithreaded_injected_sends, (long long)mpi_multithreaded_blocking_sends);
+    }
+    mpi_multithreaded_injected_sends = mpi_multithreaded_blocking_sends = 0;
+    ce->capabilites.multithreaded = 0;
+    return mpi_funnelled_fini(ce);
+}
+
+int
+mpi_multithreaded_enable(parsec_comm_engine_t *ce)
+{
+    parsec_context_t *context = ce->parsec_context;
+    int rc, nb_threads = 0;
+
+    rc = mpi_no_thread_enable(ce);
+
+    /* Replace the funnelled send path with the multithreaded one */
+    parsec_ce.send_am  = mpi_multithreaded_send_active_message;
+    parsec_ce.progress = mpi_multithreaded_progress;
+    parsec_ce.sync     = mpi_multithreaded_sync;
+
+    if( NULL != mpi_multithreaded_pools )
+        return rc;
+
+    for( int p = 0; p < context->nb_vp; p++ )
+        nb_threads += context->virtual_processes[p]->nb_cores;
+    mpi_multithreaded_nb_pools = nb_threads + 1;
+    if( 0 != posix_memalign((void**)&mpi_multithreaded_pools, 64,
+                            mpi_multithreaded_nb_pools * sizeof(mpi_multithreaded_pool_t)) ) {
+        parsec_fatal("MPI:\tUnable to allocate the send requests of the multithreaded communication engine");
+    }
+    for( int p = 0; p < mpi_multithreaded_nb_pools; p++ ) {
+        mpi_multithreaded_pool_t *pool = &mpi_multithreaded_pools[p];
+        pool->reqs = (mpi_multithreaded_send_req_t*)calloc(mpi_multithreaded_nb_reqs, sizeof(mpi_multithreaded_send_req_t));
+        for( int i = 0; i < mpi_multithreaded_nb_reqs; i++ ) {
+            pool->reqs[i].state   = MPI_MULTITHREADED_REQ_FREE;
+            pool->reqs[i].request = MPI_REQUEST_NULL;
+        }
+        pool->nb_posted = 0;
+        pool->next = 0;
+        parsec_atomic_lock_init(&pool->lock);
+    }
+    return rc;
+}
+
+int
+mpi_multithreaded_send_active_message(parsec_comm_engine_t *ce,
+                                      parsec_ce_tag_t tag,
+                                      int remote,
+                                      void *addr, size_t size)
+{
+    mpi_multithreaded_pool_t *pool;
+    mpi_multithreaded_send_req_t *req = NULL;
+    int i, idx, shared;
+
+    pool = mpi_multithreaded_my_pool(&shared);
+    if( shared ) parsec_atomic_lock(&pool->lock);
+
+    if( pool->nb_posted < mpi_multithreaded_nb_reqs ) {
+        for( i = 0; i < mpi_multithreaded_nb_reqs; i++ ) {
+            idx = (pool->next + i) % mpi_multithreaded_nb_reqs;
+            if( MPI_MULTITHREADED_REQ_FREE == pool->reqs[idx].state ) {
+                req = &pool->reqs[idx];
+                pool->next = (idx + 1) % mpi_multithreaded_nb_reqs;
+                break;
+            }
+        }
+    }
+    if( NULL == req ) {
+        /* All our requests are in flight: send it the funnelled way */
+        if( shared ) parsec_atomic_unlock(&pool->lock);
+        parsec_atomic_fetch_inc_int64(&mpi_multithreaded_blocking_sends);
+        return mpi_no_thread_send_active_message(ce, tag, remote, addr, size);
+    }
+
+    parsec_atomic_rmb();
+    if( req->capacity < size ) {
+        free(req->buffer);
+        req->capacity = (size + 63) & ~(size_t)63;
+        req->buffer = (char*)malloc(req->capacity);
+    }
+    memcpy(req->buffer, addr, size);
+    MPI_Isend(req->buffer, size, MPI_BYTE, remote, tag,
+              (MPI_Comm)mpi_funnelled_am_comm(tag), &req->request);
+    parsec_atomic_fetch_inc_int32(&pool->nb_posted);
+    parsec_atomic_wmb();
+    req->state = MPI_MULTITHREADED_REQ_POSTED;
+
+    if( shared ) parsec_atomic_unlock(&pool->lock);
+    parsec_atomic_fetch_inc_int64(&mpi_multithreaded_injected_sends);
+    return 1;
+}
+
+int
+mpi_multithreaded_progress(parsec_comm_engine_t *ce)
+{
+    int ret = mpi_no_thread_progress(ce);
+    return ret + mpi_multithreaded_recycle_sends(0);
+}
+
+int
+mpi_multithreaded_sync(parsec_comm_engine_t *ce)
+{
+    mpi_multithreaded_recycle_sends(1);
+    return mpi_no_thread_sync(ce);
+}
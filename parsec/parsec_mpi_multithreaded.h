@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+#ifndef __USE_PARSEC_MPI_MULTITHREADED_H__
+#define __USE_PARSEC_MPI_MULTITHREADED_H__
+
+#include "parsec/parsec_comm_engine.h"
+
+/* ------- Multithreaded MPI implementation below -------
+ *
+ * This engine extends the funnelled one for MPI_THREAD_MULTIPLE: the
+ * active messages are injected directly by the calling threads, each one
+ * using its own pool of send requests, while the communication thread only
+ * drives the receives, the one-sided emulation and the callbacks, and
+ * recycles the completed send requests.
+ */
+parsec_comm_engine_t * mpi_multithreaded_init(parsec_context_t *parsec_context);
+int mpi_multithreaded_fini(parsec_comm_engine_t *comm_engine);
+
+int mpi_multithreaded_enable(parsec_comm_engine_t *comm_engine);
+
+int mpi_multithreaded_send_active_message(parsec_comm_engine_t *comm_engine,
+                                          parsec_ce_tag_t tag,
+                                          int remote,
+                                          void *addr, size_t size);
+
+int mpi_multithreaded_progress(parsec_comm_engine_t *comm_engine);
+
+int mpi_multithreaded_sync(parsec_comm_engine_t *comm_engine);
+
+#endif /* __USE_PARSEC_MPI_MULTITHREADED_H__ */
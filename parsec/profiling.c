@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2009-2023 The University of Tennessee and The University
+ * Copyright (c) 2009-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  */
@@ -124,19 +124,20 @@ static parsec_profiling_perf_t parsec_profiling_global_perf[PERF_MAX];
     } while(0)
 
 /**
- * Reserve space for the next batch of event. If the backend file
- * still has room for additional pages return the offset of the next
- * page, otherwise extend the backend file and return the offset of
- * the next page.
+ * Reserve length bytes (a multiple of event_buffer_size) in the backend
+ * file. If the backend file still has room return the offset of the
+ * next free page, otherwise extend the backend file and return the
+ * offset of the next page.
  * If the file cannot be extended, return a negative value.
  */
-static off_t find_free_segment(void)
+static off_t find_free_extent(size_t length)
 {
     off_t my_offset;
     do_and_measure_perf(PERF_WAITING,
       pthread_mutex_lock( &file_backend_lock ));
-    if( file_backend_next_offset + event_buffer_size > file_backend_size ) {
-        file_backend_size += parsec_profiling_file_multiplier * event_buffer_size;
+    if( file_backend_next_offset + length > file_backend_size ) {
+        while( file_backend_next_offset + length > file_backend_size )
+            file_backend_size += parsec_profiling_file_multiplier * event_buffer_size;
         do_and_measure_perf(PERF_RESIZE,
           if( ftruncate(file_backend_fd, file_backend_size) == -1 ) {
               fprintf(stderr, "### Profiling: unable to resize backend file to %"PRIu64" bytes: %s\n",
@@ -147,11 +148,19 @@ static off_t find_free_segment(void)
           });
     }
     my_offset = file_backend_next_offset;
-    file_backend_next_offset += event_buffer_size;
+    file_backend_next_offset += length;
     pthread_mutex_unlock(&file_backend_lock);
     return my_offset;
 }
 
+/**
+ * Reserve space for the next batch of event.
+ */
+static off_t find_free_segment(void)
+{
+    return find_free_extent(event_buffer_size);
+}
+
 /**
  * Allocate a new profiling buffer either from the pending
  * buffers previously allocated, or from an extended allocation.
@@ -430,6 +439,321 @@ static void io_helper_thread_init(void)
 }
 #endif /* PARSEC_PROFILING_USE_HELPER_THREAD */
 
+/**
+ * Compressed events writer (profile_compress)
+ *
+ * Full events buffers are not written in place, but handed over to a
+ * compression thread that re-encodes them (see
+ * parsec_profiling_compressed_events_t) and appends them to the backend
+ * file, in extents reserved with find_free_extent. At most
+ * parsec_profiling_compress_inflight buffers wait for or are under
+ * compression; when this limit is reached, the thread that needs a new
+ * events buffer either waits (stall), or discards the events of its full
+ * buffer and reuses it (drop). Written buffers are recycled through
+ * compress_free_buffers, so the memory used by the events buffers is
+ * bounded by the number of streams plus the in-flight limit.
+ */
+typedef struct compress_cmd_s {
+    parsec_profiling_stream_t *stream;
+    parsec_profiling_buffer_t *buffer;
+    size_t                     length;
+} compress_cmd_t;
+
+static int      parsec_profiling_compress = 0;
+static int      parsec_profiling_compress_inflight = 64;
+static int      parsec_profiling_compress_drop = 0;
+static uint64_t parsec_profiling_dropped_events = 0;
+static uint64_t parsec_profiling_stalled_buffers = 0;
+
+static pthread_mutex_t       compress_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t        compress_work_cond = PTHREAD_COND_INITIALIZER;  /* a buffer is queued, or stop */
+static pthread_cond_t        compress_room_cond = PTHREAD_COND_INITIALIZER;  /* an in-flight buffer was written */
+static compress_cmd_t       *compress_queue = NULL;  /* ring of parsec_profiling_compress_inflight commands */
+static int                   compress_queue_head = 0;
+static int                   compress_queued = 0;
+static int                   compress_inflight = 0;
+static int                   compress_stop = 0;
+static tl_freelist_buffer_t *compress_free_buffers = NULL;
+static pthread_t             compress_thread_id;
+
+/* Extent of the backend file in which the compression thread appends buffers */
+static off_t compress_extent_next = 0;
+static off_t compress_extent_end = 0;
+#define COMPRESS_EXTENT_BUFFERS 16
+
+/**
+ * Encode the events of buffer in out, using PROFILING_CODEC_DELTA_VARINT.
+ * Returns the number of encoded bytes, or 0 if they do not fit in out_length.
+ */
+static size_t compress_encode_events(const parsec_profiling_buffer_t *buffer,
+                                     unsigned char *out, size_t out_length)
+{
+    const parsec_profiling_output_t *ev;
+    uint64_t prev_event_id = 0, prev_timestamp = 0;
+    uint32_t prev_taskpool_id = 0;
+    size_t pos = 0, out_pos = 0, info_length;
+    int64_t i;
+
+    for( i = 0; i < buffer->this_buffer.nb_events; i++ ) {
+        ev = (const parsec_profiling_output_t*)&buffer->buffer[pos];
+        info_length = EVENT_HAS_INFO(ev) ? (size_t)parsec_prof_keys[BASE_KEY(ev->event.key)].info_length : 0;
+        if( out_pos + PROFILING_CODEC_MAX_EVENT_LENGTH + info_length > out_length )
+            return 0;
+        out_pos += parsec_profiling_varint_encode(ev->event.key, out + out_pos);
+        out_pos += parsec_profiling_varint_encode(ev->event.flags, out + out_pos);
+        out_pos += parsec_profiling_varint_encode(PARSEC_PROFILING_ZIGZAG((int32_t)(ev->event.taskpool_id - prev_taskpool_id)), out + out_pos);
+        out_pos += parsec_profiling_varint_encode(PARSEC_PROFILING_ZIGZAG(ev->event.event_id - prev_event_id), out + out_pos);
+        out_pos += parsec_profiling_varint_encode(PARSEC_PROFILING_ZIGZAG(ev->event.timestamp - prev_timestamp), out + out_pos);
+        if( 0 != info_length ) {
+            memcpy(out + out_pos, ev->info, info_length);
+            out_pos += info_length;
+        }
+        prev_taskpool_id = ev->event.taskpool_id;
+        prev_event_id = ev->event.event_id;
+        prev_timestamp = ev->event.timestamp;
+        pos += sizeof(parsec_profiling_output_base_event_t) + info_length;
+    }
+    return out_pos;
+}
+
+/**
+ * Reserve length bytes for the compression thread, which is the only
+ * user of the current extent.
+ */
+static off_t compress_reserve(size_t length)
+{
+    off_t my_offset;
+    size_t extent;
+
+    if( compress_extent_next + (off_t)length > compress_extent_end ) {
+        extent = COMPRESS_EXTENT_BUFFERS * event_buffer_size;
+        while( extent < length )
+            extent += event_buffer_size;
+        my_offset = find_free_extent(extent);
+        if( (off_t)-1 == my_offset )
+            return my_offset;
+        compress_extent_next = my_offset;
+        compress_extent_end = my_offset + extent;
+    }
+    my_offset = compress_extent_next;
+    compress_extent_next += length;
+    return my_offset;
+}
+
+static void compress_write_buffer(compress_cmd_t *cmd, parsec_profiling_buffer_t *scratch)
+{
+    parsec_profiling_compressed_events_t *ce = (parsec_profiling_compressed_events_t*)scratch->buffer;
+    parsec_profiling_buffer_t *out = scratch;
+    size_t head_length = (char*)&scratch->buffer[0] - (char*)scratch;
+    size_t ce_length = (char*)&ce->payload[0] - (char*)ce;
+    size_t encoded, length;
+    off_t offset, link;
+
+    encoded = compress_encode_events(cmd->buffer, (unsigned char*)ce->payload,
+                                     event_avail_space - ce_length);
+    if( (0 != encoded) && (ce_length + encoded < cmd->length) ) {
+        scratch->this_buffer.nb_events = cmd->buffer->this_buffer.nb_events;
+        scratch->buffer_type = PROFILING_BUFFER_TYPE_COMPRESSED_EVENTS;
+        ce->codec = PROFILING_CODEC_DELTA_VARINT;
+        ce->encoded_size = (int32_t)encoded;
+        ce->raw_size = (int64_t)cmd->length;
+        length = head_length + ce_length + encoded;
+    } else {
+        out = cmd->buffer;
+        length = head_length + cmd->length;
+    }
+    length = (length + 7) & ~((size_t)7);
+
+    offset = compress_reserve(length);
+    if( (off_t)-1 == offset ) {
+        pthread_mutex_lock(&compress_lock);
+        parsec_profiling_dropped_events += cmd->buffer->this_buffer.nb_events;
+        pthread_mutex_unlock(&compress_lock);
+        return;
+    }
+    out->this_buffer_file_offset = offset;
+    out->next_buffer_file_offset = (off_t)-1;
+    if( pwrite(file_backend_fd, out, length, offset) != (ssize_t)length ) {
+        fprintf(stderr, "Warning profiling system: write in the events backend file at %ld failed: %s. Events trace will be truncated.\n",
+                (long)offset, strerror(errno));
+        return;
+    }
+    if( (off_t)-1 == cmd->stream->last_events_buffer_offset ) {
+        cmd->stream->first_events_buffer_offset = offset;
+    } else {
+        link = cmd->stream->last_events_buffer_offset + offsetof(parsec_profiling_buffer_t, next_buffer_file_offset);
+        if( pwrite(file_backend_fd, &offset, sizeof(off_t), link) != (ssize_t)sizeof(off_t) ) {
+            fprintf(stderr, "Warning profiling system: write in the events backend file at %ld failed: %s. Events trace will be truncated.\n",
+                    (long)link, strerror(errno));
+        }
+    }
+    cmd->stream->last_events_buffer_offset = offset;
+}
+
+static void *compress_thread_fct(void *_)
+{
+    parsec_profiling_buffer_t *scratch;
+    tl_freelist_buffer_t *b;
+    compress_cmd_t cmd;
+    (void)_;
+
+    scratch = (parsec_profiling_buffer_t*)malloc(event_buffer_size);
+    pthread_mutex_lock(&compress_lock);
+    while( 1 ) {
+        while( (0 == compress_queued) && !compress_stop ) {
+            pthread_cond_wait(&compress_work_cond, &compress_lock);
+        }
+        if( 0 == compress_queued )
+            break;
+        cmd = compress_queue[compress_queue_head];
+        compress_queue_head = (compress_queue_head + 1) % parsec_profiling_compress_inflight;
+        compress_queued--;
+        pthread_mutex_unlock(&compress_lock);
+
+        compress_write_buffer(&cmd, scratch);
+
+        pthread_mutex_lock(&compress_lock);
+        b = (tl_freelist_buffer_t*)cmd.buffer;
+        b->next = compress_free_buffers;
+        compress_free_buffers = b;
+        compress_inflight--;
+        pthread_cond_broadcast(&compress_room_cond);
+    }
+    pthread_mutex_unlock(&compress_lock);
+    free(scratch);
+    return NULL;
+}
+
+/* Must be called with compress_lock held, and room in the queue */
+static void compress_enqueue(parsec_profiling_stream_t *stream,
+                             parsec_profiling_buffer_t *buffer, size_t length)
+{
+    compress_cmd_t *cmd;
+
+    assert( compress_inflight < parsec_profiling_compress_inflight );
+    cmd = &compress_queue[(compress_queue_head + compress_queued) % parsec_profiling_compress_inflight];
+    cmd->stream = stream;
+    cmd->buffer = buffer;
+    cmd->length = length;
+    compress_queued++;
+    compress_inflight++;
+    pthread_cond_signal(&compress_work_cond);
+}
+
+/* Must be called with compress_lock held. Only the actual waits are
+ * accounted as stalls. */
+static void compress_wait_for_room(void)
+{
+    if( compress_inflight < parsec_profiling_compress_inflight )
+        return;
+    parsec_profiling_stalled_buffers++;
+    do_and_measure_perf(PERF_STALL,
+      while( compress_inflight == parsec_profiling_compress_inflight ) {
+          pthread_cond_wait(&compress_room_cond, &compress_lock);
+      });
+}
+
+static int compress_switch_event_buffer(parsec_profiling_stream_t *context)
+{
+    parsec_profiling_buffer_t *old_buffer = context->current_events_buffer;
+    parsec_profiling_buffer_t *new_buffer = NULL;
+
+    pthread_mutex_lock(&compress_lock);
+    if( NULL != old_buffer ) {
+        if( compress_inflight == parsec_profiling_compress_inflight ) {
+            if( parsec_profiling_compress_drop ) {
+                parsec_profiling_dropped_events += old_buffer->this_buffer.nb_events;
+                context->nb_events -= old_buffer->this_buffer.nb_events;
+                new_buffer = old_buffer;
+                old_buffer = NULL;
+            } else {
+                compress_wait_for_room();
+            }
+        }
+        if( NULL != old_buffer ) {
+            compress_enqueue(context, old_buffer, context->next_event_position);
+        }
+    }
+    if( (NULL == new_buffer) && (NULL != compress_free_buffers) ) {
+        new_buffer = (parsec_profiling_buffer_t*)compress_free_buffers;
+        compress_free_buffers = compress_free_buffers->next;
+    }
+    pthread_mutex_unlock(&compress_lock);
+
+    if( NULL == new_buffer ) {
+        new_buffer = (parsec_profiling_buffer_t*)malloc(event_buffer_size);
+        if( NULL == new_buffer ) {
+            context->current_events_buffer = NULL;
+            return PARSEC_ERR_OUT_OF_RESOURCE;
+        }
+    }
+    new_buffer->this_buffer_file_offset = (off_t)-1;
+    new_buffer->next_buffer_file_offset = (off_t)-1;
+    new_buffer->buffer_type = PROFILING_BUFFER_TYPE_EVENTS;
+    new_buffer->this_buffer.nb_events = 0;
+
+    context->current_events_buffer = new_buffer;
+    context->next_event_position = 0;
+    return 0;
+}
+
+/**
+ * Hand the last events buffer of a stream to the compression thread,
+ * waiting for room if necessary: events are never dropped at that point.
+ */
+static void compress_flush_stream(parsec_profiling_stream_t *stream)
+{
+    tl_freelist_buffer_t *b = (tl_freelist_buffer_t*)stream->current_events_buffer;
+
+    if( NULL == b )
+        return;
+    pthread_mutex_lock(&compress_lock);
+    if( 0 != stream->next_event_position ) {
+        compress_wait_for_room();
+        compress_enqueue(stream, stream->current_events_buffer, stream->next_event_position);
+    } else {
+        b->next = compress_free_buffers;
+        compress_free_buffers = b;
+    }
+    pthread_mutex_unlock(&compress_lock);
+    stream->current_events_buffer = NULL;
+}
+
+static void compress_thread_init(void)
+{
+    if( parsec_profiling_compress_inflight <= 0 )
+        parsec_profiling_compress_inflight = 1;
+    compress_queue = (compress_cmd_t*)malloc(parsec_profiling_compress_inflight * sizeof(compress_cmd_t));
+    compress_queue_head = 0;
+    compress_queued = 0;
+    compress_inflight = 0;
+    compress_stop = 0;
+    compress_extent_next = compress_extent_end = 0;
+    parsec_profiling_dropped_events = 0;
+    parsec_profiling_stalled_buffers = 0;
+    pthread_create(&compress_thread_id, NULL, compress_thread_fct, NULL);
+}
+
+/* Write all the queued buffers, and stop the compression thread */
+static void compress_thread_fini(void)
+{
+    tl_freelist_buffer_t *b;
+
+    pthread_mutex_lock(&compress_lock);
+    compress_stop = 1;
+    pthread_cond_signal(&compress_work_cond);
+    pthread_mutex_unlock(&compress_lock);
+    pthread_join(compress_thread_id, NULL);
+
+    while( NULL != compress_free_buffers ) {
+        b = compress_free_buffers;
+        compress_free_buffers = b->next;
+        free(b);
+    }
+    free(compress_queue);
+    compress_queue = NULL;
+}
+
 
 static void set_last_error(const char *format, ...)
 {
@@ -505,6 +829,15 @@ int parsec_profiling_init( int process_id )
     parsec_mca_param_reg_int_name("profile", "show_profiling_performance", "Print profiling performance at the end of the execution"
                                       " (default is no/0)",
                                       false, false, parsec_profiling_show_profiling_performance, &parsec_profiling_show_profiling_performance);
+    parsec_mca_param_reg_int_name("profile", "compress", "Compress the events buffers with a delta/varint encoding, in a"
+                                  " background thread, before writing them (default is no/0)",
+                                  false, false, parsec_profiling_compress, &parsec_profiling_compress);
+    parsec_mca_param_reg_int_name("profile", "compress_inflight", "Maximum number of full events buffers waiting to be"
+                                  " compressed and written, when profile_compress is set (default is 64)",
+                                  false, false, parsec_profiling_compress_inflight, &parsec_profiling_compress_inflight);
+    parsec_mca_param_reg_int_name("profile", "compress_drop", "When profile_compress is set and the compression falls behind,"
+                                  " drop the events of full buffers instead of stalling the application (default is no/0)",
+                                  false, false, parsec_profiling_compress_drop, &parsec_profiling_compress_drop);
     if( parsec_profiling_minimal_ebs <= 0 )
         parsec_profiling_minimal_ebs = 10;
     if( parsec_profiling_file_multiplier <= 0 )
@@ -634,6 +967,7 @@ parsec_profiling_stream_t* parsec_profiling_stream_init( size_t length, const ch
     sprof->infos = NULL;
 
     sprof->first_events_buffer_offset = (off_t)-1;
+    sprof->last_events_buffer_offset = (off_t)-1;
     sprof->current_events_buffer = NULL;
 
     parsec_list_push_back( &threads, (parsec_list_item_t*)sprof );
@@ -752,6 +1086,12 @@ int parsec_profiling_fini( void )
 #endif
                 ti, pa[PERF_MEMSET].perf_time_spent, TIMER_UNIT, pa[PERF_MEMSET].perf_number_calls,
                 ti, pa[PERF_WAITING].perf_time_spent, TIMER_UNIT, pa[PERF_WAITING].perf_number_calls);
+        if( parsec_profiling_compress ) {
+            fprintf(stderr,
+                    "#   Compressed Events: %"PRIu64" events dropped. Time spent waiting for the compression: %"PRIu64" %s. Number of stalls: %u\n",
+                    parsec_profiling_dropped_events,
+                    pa[PERF_STALL].perf_time_spent, TIMER_UNIT, pa[PERF_STALL].perf_number_calls);
+        }
     }
     memset(parsec_profiling_global_perf, 0, sizeof(parsec_profiling_perf_t)*PERF_MAX);
 
@@ -936,6 +1276,10 @@ static int switch_event_buffer( parsec_profiling_stream_t *context )
     parsec_profiling_buffer_t *old_buffer;
     off_t off;
 
+    if( parsec_profiling_compress ) {
+        return compress_switch_event_buffer(context);
+    }
+
     new_buffer = allocate_empty_buffer(context->buffers_freelist, &off, PROFILING_BUFFER_TYPE_EVENTS);
     if( NULL == new_buffer ) {  /* no more profiling */
         return PARSEC_ERR_OUT_OF_RESOURCE;
@@ -1339,11 +1683,18 @@ int parsec_profiling_dbp_dump( void )
         it != PARSEC_LIST_ITERATOR_END( &threads );
         it = PARSEC_LIST_ITERATOR_NEXT( it ) ) {
         t = (parsec_profiling_stream_t*)it;
-        if( NULL != t->current_events_buffer && t->next_event_position != 0 ) {
+        if( parsec_profiling_compress ) {
+            compress_flush_stream(t);
+        } else if( NULL != t->current_events_buffer && t->next_event_position != 0 ) {
             write_down_existing_buffer(t->buffers_freelist, t->current_events_buffer, t->next_event_position);
             t->current_events_buffer = NULL;
         }
     }
+    if( parsec_profiling_compress ) {
+        compress_thread_fini();
+        profiling_save_uint64info("PROFILING_DROPPED_EVENTS", parsec_profiling_dropped_events);
+        profiling_save_uint64info("PROFILING_STALLED_BUFFERS", parsec_profiling_stalled_buffers);
+    }
 
     profile_head->dictionary_offset = dump_dictionary(&nb_dico);
     profile_head->dictionary_size = nb_dico;
@@ -1355,7 +1706,10 @@ int parsec_profiling_dbp_dump( void )
     profile_head->nb_threads = nb_threads;
 
     /* Now commit the file as OK. If we fail before we unmap the rest, it's fine, it's excess bytes in the file */
-    memcpy(profile_head->magick, PARSEC_PROFILING_MAGICK, strlen(PARSEC_PROFILING_MAGICK) + 1);
+    if( parsec_profiling_compress )
+        memcpy(profile_head->magick, PARSEC_PROFILING_COMPRESSED_MAGICK, strlen(PARSEC_PROFILING_COMPRESSED_MAGICK) + 1);
+    else
+        memcpy(profile_head->magick, PARSEC_PROFILING_MAGICK, strlen(PARSEC_PROFILING_MAGICK) + 1);
 
     /* The head is now complete. Last flush. */
     write_down_existing_buffer(default_freelist,
@@ -1472,6 +1826,10 @@ int parsec_profiling_dbp_start( const char *basefile, const char *hr_info )
         default_freelist->nb_allocated++;
     }
 
+    if( parsec_profiling_compress ) {
+        compress_thread_init();
+    }
+
     /* Create the header of the profiling file */
     profile_head = (parsec_profiling_binary_file_header_t*)allocate_empty_buffer(default_freelist, &zero, PROFILING_BUFFER_TYPE_HEADER);
     if( NULL == profile_head )
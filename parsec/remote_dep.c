@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2009-2023 The University of Tennessee and The University
+ * Copyright (c) 2009-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  */
@@ -40,9 +40,17 @@ static int remote_dep_bcast_star_child(int me, int him);
 #ifdef PARSEC_DIST_COLLECTIVES
 /* comm_coll_bcast: see values in the corresponding mca_register */
 static int parsec_param_comm_coll_bcast = 1;
+/* comm_coll_bcast_arity: children of each process in the k-ary and hierarchical trees */
+static int parsec_param_comm_coll_bcast_arity = 4;
+/* comm_coll_bcast_node_size: ranks per node, to override the node discovery */
+static int parsec_param_comm_coll_bcast_node_size = 0;
 static int remote_dep_bcast_chainpipeline_child(int me, int him);
 static int remote_dep_bcast_binomial_child(int me, int him);
+static int remote_dep_bcast_kary_child(int me, int him);
 static int (*remote_dep_bcast_child)(int me, int him) = remote_dep_bcast_chainpipeline_child;
+/* The hierarchical topology depends on the location of the participants, it
+ * cannot be decided from their index alone */
+static int remote_dep_bcast_hierarchical = 0;
 #else
 #define remote_dep_bcast_child(me, him) remote_dep_bcast_start_child(me, him)
 #endif
@@ -263,8 +271,20 @@ int parsec_remote_dep_init(parsec_context_t* context)
     parsec_mca_param_reg_int_name("runtime", "comm_coll_bcast", "Controls the default broadcast algorithm topology.\n"
                                                                 "  0: star topology (direct one to all).\n"
                                                                 "  1: chain topology.\n"
-                                                                "  2: binomial topology.\n",
+                                                                "  2: binomial topology.\n"
+                                                                "  3: pipelined k-ary topology (see comm_coll_bcast_arity).\n"
+                                                                "  4: hierarchical topology, a k-ary tree between one leader per node, and"
+                                                                " a k-ary tree inside each node from its leader.\n",
                                   false, false, parsec_param_comm_coll_bcast, &parsec_param_comm_coll_bcast);
+    parsec_mca_param_reg_int_name("runtime", "comm_coll_bcast_arity", "Number of children of each process in the k-ary"
+                                  " and hierarchical broadcast topologies.",
+                                  false, false, parsec_param_comm_coll_bcast_arity, &parsec_param_comm_coll_bcast_arity);
+    if( parsec_param_comm_coll_bcast_arity < 1 )
+        parsec_param_comm_coll_bcast_arity = 1;
+    parsec_mca_param_reg_int_name("runtime", "comm_coll_bcast_node_size", "Number of consecutive ranks the hierarchical broadcast"
+                                  " topology considers to be on the same node (0: use the nodes discovered by the communication engine).",
+                                  false, false, parsec_param_comm_coll_bcast_node_size, &parsec_param_comm_coll_bcast_node_size);
+    remote_dep_bcast_hierarchical = 0;
     switch(parsec_param_comm_coll_bcast) {
     case 0:
         remote_dep_bcast_child = remote_dep_bcast_star_child;
@@ -275,6 +295,13 @@ int parsec_remote_dep_init(parsec_context_t* context)
     case 2:
         remote_dep_bcast_child = remote_dep_bcast_binomial_child;
         break;
+    case 3:
+        remote_dep_bcast_child = remote_dep_bcast_kary_child;
+        break;
+    case 4:
+        remote_dep_bcast_child = remote_dep_bcast_kary_child;  /* when the locations are unknown */
+        remote_dep_bcast_hierarchical = 1;
+        break;
     default:
         parsec_warning("Invalid collective type requested %d; using star topology.", parsec_param_comm_coll_bcast);
         remote_dep_bcast_child = remote_dep_bcast_star_child;
@@ -357,6 +384,91 @@ static int remote_dep_bcast_binomial_child(int me, int him)
     return him == me;
 }
 
+static int remote_dep_bcast_kary_child(int me, int him)
+{
+    assert(him >= 0);
+    if(him == 0) return 0; /* root is child to nobody */
+    if(me == -1) return 0;
+    return ((him - 1) / parsec_param_comm_coll_bcast_arity) == me;
+}
+
+static inline int remote_dep_bcast_node_of(int rank)
+{
+    if( parsec_param_comm_coll_bcast_node_size > 0 )
+        return rank - (rank % parsec_param_comm_coll_bcast_node_size);
+    return (NULL != parsec_ce.node_of) ? parsec_ce.node_of[rank] : rank;
+}
+
+/**
+ * Build the hierarchical broadcast tree of an output, and return the index of
+ * the parent of each participant, indexed as in parsec_remote_dep_activate
+ * (the root is 0). The first participant of each node is its leader, the
+ * leaders are organized in a k-ary tree rooted at the root, and the other
+ * participants of each node in a k-ary tree rooted at their leader. The
+ * children of a process are attached in the order of the participants, so the
+ * tree is built in one pass by keeping, for each list, the process currently
+ * receiving children and how many it already has.
+ */
+static int*
+remote_dep_bcast_hierarchical_parents(parsec_execution_stream_t* es,
+                                      parsec_remote_deps_t* remote_deps,
+                                      struct remote_dep_output_param_s* output)
+{
+    int nb_nodes = es->virtual_process->parsec_context->nb_nodes;
+    int arity = parsec_param_comm_coll_bcast_arity;
+    int n = output->count_bits + 1, idx, rank, node, current_mask;
+    int *parents, *next_local, *next_leader, *last, *current, *count;
+    int leader_last, leader_current, leader_count = 0;
+    unsigned int array_index, count_bits, bit_index;
+
+    parents = (int*)malloc((3 * n + 3 * nb_nodes) * sizeof(int));
+    next_local = parents + n;
+    next_leader = next_local + n;
+    last = next_leader + n;      /* last participant of each node */
+    current = last + nb_nodes;   /* participant of each node receiving children */
+    count = current + nb_nodes;  /* number of children it already has */
+    for( node = 0; node < nb_nodes; node++ ) last[node] = -1;
+
+    /* the root is the first leader */
+    node = remote_dep_bcast_node_of(remote_deps->root);
+    parents[0] = -1;
+    last[node] = current[node] = 0; count[node] = 0;
+    leader_last = leader_current = 0;
+
+    for( idx = 0, array_index = count_bits = 0; count_bits < output->count_bits; array_index++ ) {
+        current_mask = output->rank_bits[array_index];
+        for( bit_index = 0; current_mask != 0; bit_index++ ) {
+            if( !(current_mask & (1 << bit_index)) ) continue;
+            current_mask ^= (1 << bit_index);
+            count_bits++;
+            remote_dep_bit_to_rank(&rank, array_index, bit_index, remote_deps->root);
+            if( remote_dep_is_forwarded(es, remote_deps, rank) ) continue;
+            idx++;
+
+            node = remote_dep_bcast_node_of(rank);
+            if( -1 == last[node] ) {  /* a new leader */
+                next_leader[leader_last] = idx;
+                leader_last = idx;
+                parents[idx] = leader_current;
+                if( ++leader_count == arity ) {
+                    leader_current = next_leader[leader_current];
+                    leader_count = 0;
+                }
+                current[node] = idx; count[node] = 0;
+            } else {
+                next_local[last[node]] = idx;
+                parents[idx] = current[node];
+                if( ++count[node] == arity ) {
+                    current[node] = next_local[current[node]];
+                    count[node] = 0;
+                }
+            }
+            last[node] = idx;
+        }
+    }
+    return parents;
+}
+
 /**
  * This function is called from the successor iterator in order to rebuilt
  * the information needed to propagate the collective in a meaningful way. In
@@ -444,7 +556,7 @@ int parsec_remote_dep_activate(parsec_execution_stream_t* es,
                                uint32_t propagation_mask)
 {
     const parsec_task_class_t* tc = task->task_class;
-    int i, my_idx, idx, current_mask, keeper = 0;
+    int i, my_idx, idx, current_mask, keeper = 0, *parents = NULL;
     unsigned int array_index, count, bit_index;
     struct remote_dep_output_param_s* output;
 
@@ -494,6 +606,10 @@ int parsec_remote_dep_activate(parsec_execution_stream_t* es,
             assert( !parsec_is_CTL_dep(&output->data) );
             PARSEC_OBJ_RETAIN(output->data.data);
         }
+#ifdef PARSEC_DIST_COLLECTIVES
+        if( remote_dep_bcast_hierarchical && (PARSEC_TASKPOOL_TYPE_DTD != task->taskpool->taskpool_type) )
+            parents = remote_dep_bcast_hierarchical_parents(es, remote_deps, output);
+#endif  /* PARSEC_DIST_COLLECTIVES */
 
         for( array_index = count = 0; count < remote_deps->output[i].count_bits; array_index++ ) {
             current_mask = output->rank_bits[array_index];
@@ -532,7 +648,10 @@ int parsec_remote_dep_activate(parsec_execution_stream_t* es,
                     remote_dep_bcast_child_permits = remote_dep_bcast_star_child(my_idx, idx);
                 } else {
 #ifdef PARSEC_DIST_COLLECTIVES
-                    remote_dep_bcast_child_permits = remote_dep_bcast_child(my_idx, idx);
+                    if( NULL != parents )
+                        remote_dep_bcast_child_permits = (parents[idx] == my_idx);
+                    else
+                        remote_dep_bcast_child_permits = remote_dep_bcast_child(my_idx, idx);
 #else
                     remote_dep_bcast_child_permits = remote_dep_bcast_star_child(my_idx, idx);
 #endif  /* PARSEC_DIST_COLLECTIVES */
@@ -573,6 +692,7 @@ int parsec_remote_dep_activate(parsec_execution_stream_t* es,
                 remote_dep_mark_forwarded(es, remote_deps, rank);
             }
         }
+        free(parents); parents = NULL;
     }
     remote_dep_complete_and_cleanup(&remote_deps, (keeper ? 1 : 0));
     return 0;
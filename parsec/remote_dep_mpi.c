@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2009-2024 The University of Tennessee and The University
+ * Copyright (c) 2009-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * Copyright (c) 2023      NVIDIA CORPORATION. All rights reserved.
@@ -16,6 +16,7 @@
 #include "parsec/debug_marks.h"
 #include "parsec/data.h"
 #include "parsec/papi_sde.h"
+#include "parsec/metrics.h"
 #include "parsec/interfaces/dtd/insert_function_internal.h"
 #include "parsec/remote_dep.h"
 #include "parsec/class/dequeue.h"
@@ -48,6 +49,15 @@ static int parsec_param_nb_tasks_extracted = 20;
  */
 static size_t parsec_param_short_limit = RDEP_MSG_SHORT_LIMIT;
 static int parsec_param_enable_aggregate = 0;
+/* For the coalescing refer to comm_coalesce_delay, comm_coalesce_size and
+ * comm_coalesce_priority.
+ */
+static int parsec_param_coalesce_delay = 0;
+static size_t parsec_param_coalesce_size = 0;
+static int parsec_param_coalesce_priority = INT32_MAX;
+/* For the medium messages refer to comm_eager_limit and comm_eager_credits. */
+static size_t parsec_param_eager_limit = 0;
+static int parsec_param_eager_credits = 4;
 
 parsec_mempool_t *parsec_remote_dep_cb_data_mempool = NULL;
 
@@ -108,6 +118,43 @@ parsec_list_t    dep_put_fifo;             /* ordered non threaded fifo */
 static dep_cmd_item_t** parsec_mpi_same_pos_items;
 static int parsec_mpi_same_pos_items_size = 0;
 
+/* Activations waiting to be sent to a peer. Instead of being sent as soon as
+ * they are packed, the activations are accumulated in a per-peer buffer that
+ * is pushed out when it waited comm_coalesce_delay, when it cannot grow
+ * anymore, when a high priority activation is added, or when the
+ * communication thread becomes idle.
+ */
+typedef struct remote_dep_coalesce_s {
+    char               *buffer;    /* the packed activations */
+    int                 length;    /* allocated size of the buffer */
+    int                 position;  /* packed bytes */
+    int                 count;     /* number of packed activations */
+    int                 idx;       /* index in remote_dep_coalesce_peers */
+    parsec_list_item_t *ring;      /* the command items of the packed activations */
+    uint64_t            start;     /* when the first activation was packed (in us) */
+} remote_dep_coalesce_t;
+
+static remote_dep_coalesce_t *remote_dep_coalesce = NULL;  /* one per peer, NULL when not coalescing */
+static int remote_dep_coalesce_size = 0;      /* number of peers in remote_dep_coalesce */
+static int *remote_dep_coalesce_peers = NULL;  /* the peers with pending activations */
+static int remote_dep_coalesce_nb_peers = 0;
+/* Exposed through the profiling counters */
+static long long int remote_dep_coalesce_saved_msgs = 0;
+static long long int remote_dep_coalesce_bytes = 0;
+
+/* Medium messages: activations too large to be short are sent with all their
+ * data on the eager tag, instead of requiring a GET from the receiver. The
+ * receiver has a limited number of buffers for them, so each peer can only
+ * have comm_eager_credits medium messages in flight toward us. The credits
+ * are returned once the messages are consumed.
+ */
+static int32_t *remote_dep_eager_credits = NULL;   /* per peer, what we can still send */
+static int32_t *remote_dep_eager_consumed = NULL;  /* per peer, what we received and did not return yet */
+static int remote_dep_eager_size = 0;              /* number of peers */
+static int remote_dep_eager_depth = 0;             /* receives posted for the medium messages */
+static volatile int64_t remote_dep_eager_sent = 0;
+static volatile int64_t remote_dep_eager_no_credit = 0;
+
 static int mpi_initialized = 0;
 #if defined(PARSEC_REMOTE_DEP_USE_THREADS)
 static pthread_mutex_t mpi_thread_mutex;
@@ -118,10 +165,13 @@ parsec_execution_stream_t parsec_comm_es = {
     .th_id = 0,
     .core_id = -1,
     .socket_id = -1,
+    .numa_id = -1,
+    .arena_magazine_id = -1,  /* the magazines are private to the computation threads */
 #if defined(PARSEC_PROF_TRACE)
     .es_profile = NULL,
 #endif /* PARSEC_PROF_TRACE */
     .scheduler_object = NULL,
+    .metrics = NULL,
     .next_task = NULL,
 #if defined(PARSEC_SIM)
     .largest_simulation_date = 0,
@@ -154,6 +204,22 @@ remote_dep_mpi_get_end_cb(parsec_comm_engine_t *ce,
                           int src,
                           void *cb_data);
 
+static int
+remote_dep_mpi_save_eager_cb(parsec_comm_engine_t *ce,
+                             parsec_ce_tag_t tag,
+                             void *msg,
+                             size_t msg_size,
+                             int src,
+                             void *cb_data);
+
+static int
+remote_dep_mpi_credit_cb(parsec_comm_engine_t *ce,
+                         parsec_ce_tag_t tag,
+                         void *msg,
+                         size_t msg_size,
+                         int src,
+                         void *cb_data);
+
 static int
 remote_dep_mpi_put_end_cb(parsec_comm_engine_t *ce,
                        parsec_ce_mem_reg_handle_t lreg,
@@ -171,6 +237,8 @@ remote_dep_release_incoming(parsec_execution_stream_t* es,
 
 static int remote_dep_nothread_send(parsec_execution_stream_t* es,
                                     dep_cmd_item_t **head_item);
+static int remote_dep_mpi_coalesce_flush(parsec_execution_stream_t* es,
+                                         int all);
 int remote_dep_ce_init(parsec_context_t* context);
 
 static int local_dep_nothread_reshape(parsec_execution_stream_t* es,
@@ -209,6 +277,35 @@ static void remote_dep_mpi_params(parsec_context_t* context) {
 #endif
     parsec_mca_param_reg_int_name("runtime", "comm_aggregate", "Aggregate multiple dependencies in the same short message (1=true,0=false).",
                                   false, false, parsec_param_enable_aggregate, &parsec_param_enable_aggregate);
+    parsec_mca_param_reg_int_name("runtime", "comm_coalesce_delay", "Maximum time (in microseconds) an activation can be held to be sent"
+                                  " in the same message as the following activations to the same peer. Held activations are also sent"
+                                  " as soon as the communication thread becomes idle. 0 disables the coalescing.",
+                                  false, false, parsec_param_coalesce_delay, &parsec_param_coalesce_delay);
+    parsec_mca_param_reg_sizet_name("runtime", "comm_coalesce_size", "Maximum size of a message of coalesced activations, the pending buffers"
+                                    " grow up to this size before being sent. It must be the same on all processes, as it also sizes the"
+                                    " receives of the activations where the coalescing is disabled (0: 4 times the size of a short message).",
+                                    false, false, parsec_param_coalesce_size, &parsec_param_coalesce_size);
+    parsec_mca_param_reg_int_name("runtime", "comm_coalesce_priority", "Activations with a priority at or above this value are sent"
+                                  " without waiting for the coalescing delay.",
+                                  false, false, parsec_param_coalesce_priority, &parsec_param_coalesce_priority);
+    if( 0 == parsec_param_coalesce_size ) {
+        parsec_param_coalesce_size = 4 * DEP_SHORT_BUFFER_SIZE;
+    } else if( parsec_param_coalesce_size < DEP_SHORT_BUFFER_SIZE ) {
+        parsec_param_coalesce_size = DEP_SHORT_BUFFER_SIZE;
+    }
+    parsec_mca_param_reg_sizet_name("runtime", "comm_eager_limit", "Maximum size of a medium message. Activations with data too large"
+                                    " for a short message but fitting in a medium message are sent with their data, without waiting"
+                                    " for the receiver to get it. It must be the same on all processes (0: disabled).",
+                                    false, false, parsec_param_eager_limit, &parsec_param_eager_limit);
+    parsec_mca_param_reg_int_name("runtime", "comm_eager_credits", "Number of medium messages a process can have in flight toward each"
+                                  " of its peers. Once exhausted the data is sent with the rendezvous protocol until the peer"
+                                  " returns some credits.",
+                                  false, false, parsec_param_eager_credits, &parsec_param_eager_credits);
+    if( (0 == parsec_param_short_limit) || (parsec_param_eager_credits < 1) ) {
+        parsec_param_eager_limit = 0;  /* the receivers would not extract the data */
+    } else if( (0 != parsec_param_eager_limit) && (parsec_param_eager_limit <= DEP_SHORT_BUFFER_SIZE) ) {
+        parsec_param_eager_limit = 0;  /* everything that fits is already short */
+    }
 }
 
 int
@@ -257,7 +354,11 @@ remote_dep_dequeue_init(parsec_context_t* context)
         return PARSEC_ERR_NOT_FOUND;
     }
 
-    if(parsec_param_comm_thread_multiple) {
+    if( parsec_ce.capabilites.multithreaded ) {
+        /* The engine itself supports injection from the computing threads */
+        context->flags |= PARSEC_CONTEXT_FLAG_COMM_MT;
+    }
+    else if(parsec_param_comm_thread_multiple) {
         if( thread_level_support >= MPI_THREAD_MULTIPLE ) {
             context->flags |= PARSEC_CONTEXT_FLAG_COMM_MT;
         }
@@ -420,6 +521,9 @@ remote_dep_mpi_initialize_execution_stream(parsec_context_t *context)
     parsec_comm_es.scheduler_object = NULL;
     parsec_comm_es.core_id          = -1;
     parsec_comm_es.socket_id        = -1;
+    parsec_comm_es.numa_id          = -1;
+    parsec_comm_es.arena_magazine_id = -1;
+    parsec_comm_es.metrics          = parsec_metrics_stream(-1);  /* the last slot */
     parsec_comm_es.next_task        = (parsec_task_t*)0xdeadbeef;  /* should not be NULL, but it should also never be used */
 }
 
@@ -894,7 +998,9 @@ remote_dep_get_datatypes(parsec_execution_stream_t* es,
     } else {
         parsec_task_t task;
         task.taskpool   = origin->taskpool;
-        int idx, *data_sizes = (int*)origin->eager_msg;
+        /* the data sizes follow the termination detection piggybacked message */
+        int idx, *data_sizes = (int*)((char*)origin->eager_msg +
+                                      origin->taskpool->tdm.module->outgoing_message_piggyback_size);
 
         task.priority = 0;  /* unknown yet */
         task.task_class = task.taskpool->task_classes_array[origin->msg.task_class_id];
@@ -1133,6 +1239,11 @@ remote_dep_dequeue_nothread_progress(parsec_execution_stream_t* es,
         /* only progress MPI if necessary */
         if (context->nb_nodes > 1) {
             ret = remote_dep_mpi_progress(es);
+            if( remote_dep_coalesce_nb_peers > 0 ) {
+                /* Nothing new to pack: push out the activations that waited long
+                 * enough, or all of them if nothing progressed and we may back off. */
+                ret += remote_dep_mpi_coalesce_flush(es, (0 == ret) && (0 != comm_yield));
+            }
             if( 0 == ret
                 && ((comm_yield == 2)
                     || (comm_yield == 1  /* communication list is full, we need to forcefully drain the network */
@@ -1145,12 +1256,18 @@ remote_dep_dequeue_nothread_progress(parsec_execution_stream_t* es,
         }
         goto check_pending_queues;
     }
+    /* A busy fifo must not hold the pending activations past their delay */
+    if( remote_dep_coalesce_nb_peers > 0 )
+        remote_dep_mpi_coalesce_flush(es, 0);
     assert(DEP_CTL != item->action);
     executed_tasks++;  /* count all the tasks executed during this call */
   handle_now:
     position = (DEP_ACTIVATE == item->action) ? item->cmd.activate.peer : (context->nb_nodes + item->action);
     switch(item->action) {
     case DEP_CTL:
+        /* Don't leave any activation behind */
+        if( remote_dep_coalesce_nb_peers > 0 )
+            remote_dep_mpi_coalesce_flush(es, 1);
         ret = item->cmd.ctl.enable;
         PARSEC_OBJ_DESTRUCT(&temp_list);
         PARSEC_DEBUG_VERBOSE(10, parsec_comm_output_stream, "rank %d DISABLE MPI communication engine", parsec_debug_rank);
@@ -1311,10 +1428,11 @@ static int remote_dep_mpi_pack_dep(int peer,
     data_sizes[0] = data_idx;  /* save the total number of data */
     assert((0 != msg->output_mask) &&   /* this should be preset */
            (msg->output_mask & deps->outgoing_mask) == deps->outgoing_mask);
-    /* update the length of the message */
+    /* update the length of the message, the piggybacked message is already
+     * accounted for in the position */
     msg->length  = deps->taskpool->tdm.module->outgoing_message_piggyback_size;
     msg->length += (data_idx + 1) * (uint32_t)sizeof(uint32_t);
-    *position += msg->length;
+    *position += (data_idx + 1) * (int)sizeof(uint32_t);
     item->cmd.activate.task.output_mask = 0;  /* clean start */
     /* Treat for special cases: CTL, Short, etc... */
     for(k = 0, data_idx = 1; deps->outgoing_mask >> k; k++) {
@@ -1454,63 +1572,271 @@ static int local_dep_nothread_reshape(parsec_execution_stream_t* es,
     return (MPI_SUCCESS == rc ? 0 : -1);
 }
 
+/**
+ * Send a buffer of packed activations to a peer, and release the command
+ * items (and their dependencies) of all the activations it contains.
+ */
+static void remote_dep_mpi_send_packed(parsec_execution_stream_t* es,
+                                       parsec_ce_tag_t tag,
+                                       int peer,
+                                       char* packed_buffer,
+                                       int position,
+                                       parsec_list_item_t* ring)
+{
+    dep_cmd_item_t *item = (dep_cmd_item_t*)ring;
+    parsec_remote_deps_t *deps = (parsec_remote_deps_t*)item->cmd.activate.task.source_deps;
+
+    /* dep index is meaningless in this context, set to -1 */
+    TAKE_TIME_WITH_INFO(es->es_profile, MPI_Activate_sk, 0, -1,
+                        es->virtual_process->parsec_context->my_rank, peer,
+                        deps->msg, position, PARSEC_DATATYPE_PACKED);
+    parsec_ce.send_am(&parsec_ce, tag, peer, packed_buffer, position);
+    PARSEC_METRICS_ATOMIC_ADD(es, PARSEC_METRICS_BYTES_SENT, position);
+    TAKE_TIME(es->es_profile, MPI_Activate_ek, 0);
+    DEBUG_MARK_CTL_MSG_ACTIVATE_SENT(peer, (void*)&deps->msg, &deps->msg);
+
+    do {
+        item = (dep_cmd_item_t*)ring;
+        ring = parsec_list_item_ring_chop(ring);
+        deps = (parsec_remote_deps_t*)item->cmd.activate.task.source_deps;
+
+        free(item);  /* only large messages are left */
+
+        remote_dep_complete_and_cleanup(&deps, 1);
+    } while( NULL != ring );
+    (void)es;
+}
+
+/**
+ * Size of the activation of deps for peer with all its data embedded, or -1 if
+ * some of the data cannot be embedded.
+ */
+static int remote_dep_mpi_eager_size(int peer, parsec_remote_deps_t *deps)
+{
+    uint32_t peer_bank, peer_bit, peer_mask;
+    int k, dsize, size, nb_data = 0;
+
+    remote_dep_rank_to_bit(peer, &peer_bank, &peer_bit, deps->root);
+    peer_mask = 1U << peer_bit;
+
+    parsec_ce.pack_size(&parsec_ce, dep_count, dep_dtt, &size);
+    size += deps->taskpool->tdm.module->outgoing_message_piggyback_size;
+    for(k = 0; deps->outgoing_mask >> k; k++) {
+        if( !((1U << k) & deps->outgoing_mask )) continue;
+        if( !(deps->output[k].rank_bits[peer_bank] & peer_mask) ) continue;
+        nb_data++;
+
+        parsec_dep_data_description_t *data_desc = &deps->output[k].data;
+        if( parsec_is_CTL_dep(data_desc) ) continue;
+#ifdef PARSEC_RESHAPE_BEFORE_SEND_TO_REMOTE
+        if( NULL != data_desc->data_future ) return -1;
+#endif
+        parsec_ce.pack_size(&parsec_ce, data_desc->remote.src_count, data_desc->remote.src_datatype, &dsize);
+        size += dsize;
+    }
+    return size + (nb_data + 1) * (int)sizeof(uint32_t);
+}
+
+/**
+ * Send the activation of the head item as a medium message, with all its data,
+ * if it is too large to be short, fits in comm_eager_limit, and the peer has
+ * credits left. Returns 1 if the activation was sent, and moves head_item to
+ * the next activation for the same peer, 0 otherwise.
+ */
+static int remote_dep_nothread_send_medium(parsec_execution_stream_t* es,
+                                           dep_cmd_item_t **head_item)
+{
+    dep_cmd_item_t *item = *head_item;
+    parsec_list_item_t *next;
+    parsec_remote_deps_t *deps = (parsec_remote_deps_t*)item->cmd.activate.task.source_deps;
+    int peer = item->cmd.activate.peer, size, position = 0, rc;
+    char *buffer;
+
+    size = remote_dep_mpi_eager_size(peer, deps);
+    if( (size <= (int)DEP_SHORT_BUFFER_SIZE) || (size > (int)parsec_param_eager_limit) )
+        return 0;  /* short, or not worth sending eagerly */
+    if( parsec_atomic_fetch_dec_int32(&remote_dep_eager_credits[peer]) <= 0 ) {
+        parsec_atomic_fetch_inc_int32(&remote_dep_eager_credits[peer]);
+        parsec_atomic_fetch_inc_int64(&remote_dep_eager_no_credit);
+        return 0;  /* the peer has not consumed the previous ones yet */
+    }
+
+    buffer = (char*)malloc(size);
+    parsec_list_item_singleton((parsec_list_item_t*)item);
+    rc = remote_dep_mpi_pack_dep(peer, item, buffer, size, &position);
+    assert((0 == rc) && (0 == item->cmd.activate.task.output_mask));
+    (void)rc;
+    PARSEC_DEBUG_VERBOSE(20, parsec_comm_output_stream, "MPI:\tTO\t%d\tMedium activation of %d bytes", peer, position);
+
+    next = parsec_list_item_ring_chop(&item->pos_list);
+    remote_dep_mpi_send_packed(es, PARSEC_CE_REMOTE_DEP_EAGER_TAG, peer,
+                               buffer, position, (parsec_list_item_t*)item);
+    free(buffer);
+    parsec_atomic_fetch_inc_int64(&remote_dep_eager_sent);
+
+    *head_item = (NULL != next) ? container_of(next, dep_cmd_item_t, pos_list) : NULL;
+    return 1;
+}
+
+static inline uint64_t remote_dep_coalesce_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+}
+
+/**
+ * Send all the activations pending for a peer.
+ */
+static void remote_dep_mpi_coalesce_flush_peer(parsec_execution_stream_t* es,
+                                               int peer)
+{
+    remote_dep_coalesce_t *pending = &remote_dep_coalesce[peer];
+    int idx = pending->idx;
+
+    assert(pending->count > 0);
+    if( pending->count > 1 ) {
+        remote_dep_coalesce_saved_msgs += pending->count - 1;
+        remote_dep_coalesce_bytes += pending->position;
+    }
+    PARSEC_DEBUG_VERBOSE(20, parsec_comm_output_stream, "MPI:\tTO\t%d\tCoalesced %d activations in %d bytes",
+                         peer, pending->count, pending->position);
+    remote_dep_mpi_send_packed(es, PARSEC_CE_REMOTE_DEP_ACTIVATE_TAG, peer,
+                               pending->buffer, pending->position, pending->ring);
+    pending->ring = NULL;
+    pending->position = 0;
+    pending->count = 0;
+
+    /* This peer has nothing pending anymore */
+    remote_dep_coalesce_peers[idx] = remote_dep_coalesce_peers[--remote_dep_coalesce_nb_peers];
+    remote_dep_coalesce[remote_dep_coalesce_peers[idx]].idx = idx;
+}
+
+/**
+ * Send the pending activations that waited for at least comm_coalesce_delay,
+ * or all of them if all is set. Returns the number of messages sent.
+ */
+static int remote_dep_mpi_coalesce_flush(parsec_execution_stream_t* es,
+                                         int all)
+{
+    uint64_t now = all ? 0 : remote_dep_coalesce_now();
+    int i = 0, flushed = 0, peer;
+
+    while( i < remote_dep_coalesce_nb_peers ) {
+        peer = remote_dep_coalesce_peers[i];
+        if( !all && ((now - remote_dep_coalesce[peer].start) < (uint64_t)parsec_param_coalesce_delay) ) {
+            i++;
+            continue;
+        }
+        /* the last pending peer moves to index i */
+        remote_dep_mpi_coalesce_flush_peer(es, peer);
+        flushed++;
+    }
+    return flushed;
+}
+
+/**
+ * Pack all the activations of the item ring in the pending buffer of their
+ * peer, where they wait for remote_dep_mpi_coalesce_flush. The buffer grows on
+ * demand up to comm_coalesce_size, and is sent when it cannot hold the next
+ * activation, or right away if one of the activations has a high priority.
+ */
+static int remote_dep_nothread_coalesce(parsec_execution_stream_t* es,
+                                        dep_cmd_item_t **head_item)
+{
+    dep_cmd_item_t *item = *head_item;
+    parsec_list_item_t *next;
+    int peer = item->cmd.activate.peer, urgent = 0;
+    remote_dep_coalesce_t *pending = &remote_dep_coalesce[peer];
+
+    while( NULL != item ) {
+        assert(peer == item->cmd.activate.peer);
+        if( (NULL != remote_dep_eager_credits) && remote_dep_nothread_send_medium(es, &item) )
+            continue;
+        if( NULL == pending->buffer ) {
+            pending->length = DEP_SHORT_BUFFER_SIZE;
+            pending->buffer = (char*)malloc(pending->length);
+        }
+        parsec_list_item_singleton((parsec_list_item_t*)item);
+        if( 0 != remote_dep_mpi_pack_dep(peer, item, pending->buffer,
+                                         pending->length, &pending->position) ) {
+            /* Not enough room left: make the buffer grow, or push it out */
+            if( (size_t)pending->length < parsec_param_coalesce_size ) {
+                pending->length = (2 * (size_t)pending->length < parsec_param_coalesce_size) ?
+                    2 * pending->length : (int)parsec_param_coalesce_size;
+                pending->buffer = (char*)realloc(pending->buffer, pending->length);
+            } else {
+                remote_dep_mpi_coalesce_flush_peer(es, peer);
+            }
+            continue;
+        }
+        if( 0 == pending->count++ ) {
+            pending->start = remote_dep_coalesce_now();
+            pending->idx = remote_dep_coalesce_nb_peers;
+            remote_dep_coalesce_peers[remote_dep_coalesce_nb_peers++] = peer;
+        }
+        if( item->priority >= parsec_param_coalesce_priority )
+            urgent = 1;
+        next = parsec_list_item_ring_chop(&item->pos_list);
+        if( NULL == pending->ring ) pending->ring = (parsec_list_item_t*)item;
+        else parsec_list_item_ring_push(pending->ring, (parsec_list_item_t*)item);
+        item = (NULL != next) ? container_of(next, dep_cmd_item_t, pos_list) : NULL;
+    }
+    *head_item = NULL;
+    if( urgent )
+        remote_dep_mpi_coalesce_flush_peer(es, peer);
+    return 0;
+}
+
 /**
  * Starting with a particular item pack as many remote_dep_wire_activate
  * messages with the same destination (from the item ring associated with
  * pos_list) into a buffer. Upon completion the entire buffer is send to the
  * remote peer, the completed messages are released and the header is updated to
- * the next unsent message.
+ * the next unsent message. When the activations are coalesced they are only
+ * packed here, and sent later.
  */
 static int remote_dep_nothread_send(parsec_execution_stream_t* es,
                                     dep_cmd_item_t **head_item)
 {
-    (void)es;
-    parsec_remote_deps_t *deps;
     dep_cmd_item_t *item = *head_item;
     parsec_list_item_t* ring = NULL;
     char packed_buffer[DEP_SHORT_BUFFER_SIZE];
     int peer, position = 0;
 
+    if( NULL != remote_dep_coalesce )
+        return remote_dep_nothread_coalesce(es, head_item);
+
     peer = item->cmd.activate.peer;  /* this doesn't change */
 
   pack_more:
     assert(peer == item->cmd.activate.peer);
-    deps = (parsec_remote_deps_t*)item->cmd.activate.task.source_deps;
 
-    parsec_list_item_singleton((parsec_list_item_t*)item);
-    if( 0 == remote_dep_mpi_pack_dep(peer, item, packed_buffer,
-                                     DEP_SHORT_BUFFER_SIZE, &position) ) {
-        /* space left on the buffer. Move to the next item with the same destination */
-        dep_cmd_item_t* next = (dep_cmd_item_t*)parsec_list_item_ring_chop(&item->pos_list);
-        if( NULL == ring ) ring = (parsec_list_item_t*)item;
-        else parsec_list_item_ring_push(ring, (parsec_list_item_t*)item);
-        if( NULL != next ) {
-            item = container_of(next, dep_cmd_item_t, pos_list);
-            assert(DEP_ACTIVATE == item->action);
-            if( parsec_param_enable_aggregate )
-                goto pack_more;
-        } else item = NULL;
+    if( (NULL != remote_dep_eager_credits) && remote_dep_nothread_send_medium(es, &item) ) {
+        /* sent in its own message, move to the next item with the same destination */
+        if( (NULL != item) && ((NULL == ring) || parsec_param_enable_aggregate) )
+            goto pack_more;
+    } else {
+        parsec_list_item_singleton((parsec_list_item_t*)item);
+        if( 0 == remote_dep_mpi_pack_dep(peer, item, packed_buffer,
+                                         DEP_SHORT_BUFFER_SIZE, &position) ) {
+            /* space left on the buffer. Move to the next item with the same destination */
+            dep_cmd_item_t* next = (dep_cmd_item_t*)parsec_list_item_ring_chop(&item->pos_list);
+            if( NULL == ring ) ring = (parsec_list_item_t*)item;
+            else parsec_list_item_ring_push(ring, (parsec_list_item_t*)item);
+            if( NULL != next ) {
+                item = container_of(next, dep_cmd_item_t, pos_list);
+                assert(DEP_ACTIVATE == item->action);
+                if( parsec_param_enable_aggregate )
+                    goto pack_more;
+            } else item = NULL;
+        }
     }
     *head_item = item;
-    assert(NULL != ring);
-
-    /* dep index is meaningless in this context, set to -1 */
-    TAKE_TIME_WITH_INFO(es->es_profile, MPI_Activate_sk, 0, -1,
-                        es->virtual_process->parsec_context->my_rank, peer,
-                        deps->msg, position, PARSEC_DATATYPE_PACKED);
-    parsec_ce.send_am(&parsec_ce, PARSEC_CE_REMOTE_DEP_ACTIVATE_TAG, peer, packed_buffer, position);
-    TAKE_TIME(es->es_profile, MPI_Activate_ek, 0);
-    DEBUG_MARK_CTL_MSG_ACTIVATE_SENT(peer, (void*)&deps->msg, &deps->msg);
-
-    do {
-        item = (dep_cmd_item_t*)ring;
-        ring = parsec_list_item_ring_chop(ring);
-        deps = (parsec_remote_deps_t*)item->cmd.activate.task.source_deps;
-
-        free(item);  /* only large messages are left */
 
-        remote_dep_complete_and_cleanup(&deps, 1);
-    } while( NULL != ring );
+    if( NULL != ring )
+        remote_dep_mpi_send_packed(es, PARSEC_CE_REMOTE_DEP_ACTIVATE_TAG, peer,
+                                   packed_buffer, position, ring);
     return 0;
 }
 
@@ -1730,6 +2056,11 @@ remote_dep_mpi_put_start(parsec_execution_stream_t* es,
                       (parsec_ce_tag_t)task->callback_fn, &task->remote_callback_data, sizeof(uintptr_t));
 
         parsec_comm_puts++;
+        {
+            int size = 0;
+            parsec_type_size(dtt, &size);
+            PARSEC_METRICS_ATOMIC_ADD(es, PARSEC_METRICS_BYTES_SENT, (int64_t)size * nbdtt);
+        }
     }
 #endif  /* !defined(PARSEC_PROF_DRY_DEP) */
     if(0 == task->output_mask) {
@@ -1790,7 +2121,7 @@ static void remote_dep_mpi_recv_activate(parsec_execution_stream_t* es,
     (void) packed_buffer;
     remote_dep_datakey_t complete_mask = 0;
     int k, dsize, ds_idx;
-    uint32_t *data_sizes = (uint32_t*)(packed_buffer + *position);
+    uint32_t *data_sizes;
 #if defined(PARSEC_DEBUG) || defined(PARSEC_DEBUG_NOISIER)
     char tmp[MAX_TASK_STRLEN];
     remote_dep_cmd_to_string(&deps->msg, tmp, MAX_TASK_STRLEN);
@@ -1806,6 +2137,8 @@ static void remote_dep_mpi_recv_activate(parsec_execution_stream_t* es,
     deps->taskpool->tdm.module->incoming_message_start(deps->taskpool, deps->from, packed_buffer, position,
                                                        length, deps);
 
+    /* the data sizes follow the termination detection piggybacked message */
+    data_sizes = (uint32_t*)(packed_buffer + *position);
     /* move the position after the data sizes */
     *position += (data_sizes[0] + 1) * (uint32_t)sizeof(uint32_t);
     ds_idx = 0;
@@ -1923,6 +2256,7 @@ remote_dep_mpi_save_activate_cb(parsec_comm_engine_t *ce, parsec_ce_tag_t tag,
         ce->unpack(ce, msg, length, &position, &deps->msg, dep_count, dep_dtt);
         deps->from = src;
         deps->eager_msg = (char*)msg + position;
+        PARSEC_METRICS_ATOMIC_ADD(es, PARSEC_METRICS_REMOTE_ACTIVATIONS, 1);
 
         /* Retrieve the data arenas and update the msg.incoming_mask to reflect
          * the data we should be receiving from the predecessor.
@@ -1956,7 +2290,6 @@ remote_dep_mpi_save_activate_cb(parsec_comm_engine_t *ce, parsec_ce_tag_t tag,
         /* Import the activation message and prepare for the reception */
         remote_dep_mpi_recv_activate(es, deps, msg,
                                      position + deps->msg.length, &position);
-        assert( parsec_param_enable_aggregate || (position == length));
         deps->eager_msg = NULL;  /* this buffer will now be reused, not safe to store here */
     }
     assert(position == length);
@@ -1964,6 +2297,51 @@ remote_dep_mpi_save_activate_cb(parsec_comm_engine_t *ce, parsec_ce_tag_t tag,
     return 1;
 }
 
+/**
+ * Medium activations are handled as the short ones, their data is extracted
+ * (or saved aside) before returning, so the buffer is consumed and the credit
+ * can be returned to the sender. Credits are returned in batches of half the
+ * window to limit the number of messages.
+ */
+static int
+remote_dep_mpi_save_eager_cb(parsec_comm_engine_t *ce,
+                             parsec_ce_tag_t tag,
+                             void *msg,
+                             size_t msg_size,
+                             int src,
+                             void *cb_data)
+{
+    int32_t credits;
+
+    remote_dep_mpi_save_activate_cb(ce, tag, msg, msg_size, src, cb_data);
+
+    if( NULL == remote_dep_eager_consumed ) return 1;  /* being reconfigured */
+    if( ++remote_dep_eager_consumed[src] >= (parsec_param_eager_credits + 1) / 2 ) {
+        credits = remote_dep_eager_consumed[src];
+        remote_dep_eager_consumed[src] = 0;
+        ce->send_am(ce, PARSEC_CE_REMOTE_DEP_CREDIT_TAG, src, &credits, sizeof(int32_t));
+    }
+    return 1;
+}
+
+static int
+remote_dep_mpi_credit_cb(parsec_comm_engine_t *ce,
+                         parsec_ce_tag_t tag,
+                         void *msg,
+                         size_t msg_size,
+                         int src,
+                         void *cb_data)
+{
+    int32_t credits;
+    (void)ce; (void)tag; (void)cb_data;
+
+    assert(sizeof(int32_t) == msg_size); (void)msg_size;
+    memcpy(&credits, msg, sizeof(int32_t));
+    if( NULL == remote_dep_eager_credits ) return 1;  /* being reconfigured */
+    parsec_atomic_fetch_add_int32(&remote_dep_eager_credits[src], credits);
+    return 1;
+}
+
 void
 remote_dep_mpi_new_taskpool(parsec_execution_stream_t* es,
                             dep_cmd_item_t *dep_cmd_item)
@@ -2207,6 +2585,42 @@ remote_dep_mpi_get_end_cb(parsec_comm_engine_t *ce,
     return 1;
 }
 
+/**
+ * Release the coalescing buffers. All the activations must have been sent.
+ */
+static void remote_dep_coalesce_fini(void)
+{
+    if( NULL == remote_dep_coalesce ) return;
+    assert(0 == remote_dep_coalesce_nb_peers);
+    if( remote_dep_coalesce_saved_msgs > 0 ) {
+        parsec_debug_verbose(3, parsec_comm_output_stream,
+                             "MPI:\tcoalescing saved %lld activation messages (%lld bytes sent coalesced)",
+                             remote_dep_coalesce_saved_msgs, remote_dep_coalesce_bytes);
+    }
+    for( int i = 0; i < remote_dep_coalesce_size; i++ )
+        free(remote_dep_coalesce[i].buffer);
+    free(remote_dep_coalesce); remote_dep_coalesce = NULL;
+    free(remote_dep_coalesce_peers); remote_dep_coalesce_peers = NULL;
+    remote_dep_coalesce_size = 0;
+}
+
+/**
+ * Release the credits of the medium messages.
+ */
+static void remote_dep_eager_fini(void)
+{
+    if( NULL == remote_dep_eager_credits ) return;
+    if( remote_dep_eager_sent > 0 ) {
+        parsec_debug_verbose(3, parsec_comm_output_stream,
+                             "MPI:\tsent %lld medium activations (%lld fell back to the rendezvous for lack of credits)",
+                             (long long)remote_dep_eager_sent, (long long)remote_dep_eager_no_credit);
+    }
+    free(remote_dep_eager_credits); remote_dep_eager_credits = NULL;
+    free(remote_dep_eager_consumed); remote_dep_eager_consumed = NULL;
+    remote_dep_eager_size = 0;
+    remote_dep_eager_sent = remote_dep_eager_no_credit = 0;
+}
+
 /**
  * @brief Called in the context of the communication thread once a change in the
  * configuration has been noticed. This allows the full reconfiguration of the
@@ -2234,6 +2648,34 @@ int remote_dep_ce_reconfigure(parsec_context_t* context)
     parsec_mpi_same_pos_items = (dep_cmd_item_t**)calloc(parsec_mpi_same_pos_items_size,
                                                         sizeof(dep_cmd_item_t*));
 
+    /* The coalescing buffers are only used by the communication thread, they
+     * cannot be used when the computing threads send their own activations. */
+    remote_dep_coalesce_fini();
+    if( (parsec_param_coalesce_delay > 0) && (1 < context->nb_nodes) ) {
+        if( context->flags & PARSEC_CONTEXT_FLAG_COMM_MT ) {
+            static int coalesce_warned = 0;
+            if( (0 == context->my_rank) && !coalesce_warned++ )
+                parsec_warning("runtime_comm_coalesce_delay is ignored when the computing threads send their own activations"
+                               " (multithreaded communication engine): the activations are not coalesced");
+        } else {
+            remote_dep_coalesce = (remote_dep_coalesce_t*)calloc(context->nb_nodes, sizeof(remote_dep_coalesce_t));
+            remote_dep_coalesce_peers = (int*)malloc(context->nb_nodes * sizeof(int));
+            remote_dep_coalesce_size = context->nb_nodes;
+        }
+    }
+
+    /* Everybody starts with all its credits toward all its peers, as long as
+     * all the peers together cannot exhaust the receives posted by a process */
+    remote_dep_eager_fini();
+    if( (parsec_param_eager_limit > 0) &&
+        (remote_dep_eager_depth >= parsec_param_eager_credits * (context->nb_nodes - 1)) ) {
+        remote_dep_eager_credits = (int32_t*)malloc(context->nb_nodes * sizeof(int32_t));
+        remote_dep_eager_consumed = (int32_t*)calloc(context->nb_nodes, sizeof(int32_t));
+        for( int i = 0; i < context->nb_nodes; i++ )
+            remote_dep_eager_credits[i] = parsec_param_eager_credits;
+        remote_dep_eager_size = context->nb_nodes;
+    }
+
     if(1 < context->nb_nodes) {
         /* if nb_nodes==1, the parsec comm engine does not run with its own thread, so don't change the thread
          * execution stream to parsec_comm_es. */
@@ -2253,9 +2695,10 @@ remote_dep_ce_init(parsec_context_t* context)
     PARSEC_OBJ_CONSTRUCT(&dep_activates_noobj_fifo, parsec_list_t);
     PARSEC_OBJ_CONSTRUCT(&dep_put_fifo, parsec_list_t);
 
-    /* Register Persistant requests */
+    /* Register Persistant requests. The peers may coalesce their activations
+     * even if we do not, so the receives must hold a coalesced message. */
     rc = parsec_ce.tag_register(PARSEC_CE_REMOTE_DEP_ACTIVATE_TAG, remote_dep_mpi_save_activate_cb, context,
-                                DEP_SHORT_BUFFER_SIZE * sizeof(char));
+                                parsec_param_coalesce_size * sizeof(char));
     if( PARSEC_SUCCESS != rc ) {
         parsec_warning("[CE] Failed to register communication tag PARSEC_CE_REMOTE_DEP_ACTIVATE_TAG (error %d)\n", rc);
         parsec_comm_engine_fini(&parsec_ce);
@@ -2269,12 +2712,42 @@ remote_dep_ce_init(parsec_context_t* context)
         parsec_comm_engine_fini(&parsec_ce);
         return rc;
     }
+    if( parsec_param_eager_limit > 0 ) {
+        rc = parsec_ce.tag_register(PARSEC_CE_REMOTE_DEP_EAGER_TAG, remote_dep_mpi_save_eager_cb, context,
+                                    parsec_param_eager_limit * sizeof(char));
+        if( PARSEC_SUCCESS == rc ) {
+            /* The sends are blocking, a medium message must always find a posted
+             * receive, whatever the number of peers sending to us. */
+            remote_dep_eager_depth = parsec_param_eager_credits * (context->nb_nodes > 1 ? context->nb_nodes - 1 : 1);
+            rc = (NULL == parsec_ce.tag_set_depth) ? PARSEC_ERR_NOT_SUPPORTED :
+                parsec_ce.tag_set_depth(PARSEC_CE_REMOTE_DEP_EAGER_TAG, remote_dep_eager_depth);
+            if( PARSEC_SUCCESS == rc )
+                rc = parsec_ce.tag_register(PARSEC_CE_REMOTE_DEP_CREDIT_TAG, remote_dep_mpi_credit_cb, context,
+                                            sizeof(int32_t));
+            if( PARSEC_SUCCESS != rc )
+                parsec_ce.tag_unregister(PARSEC_CE_REMOTE_DEP_EAGER_TAG);
+        }
+        if( PARSEC_SUCCESS != rc ) {
+            parsec_warning("[CE] Failed to register the communication tags for medium messages (error %d), they are disabled\n", rc);
+            parsec_param_eager_limit = 0;
+        }
+    }
 
     parsec_remote_dep_cb_data_mempool = (parsec_mempool_t*) malloc (sizeof(parsec_mempool_t));
     parsec_mempool_construct(parsec_remote_dep_cb_data_mempool,
                              PARSEC_OBJ_CLASS(remote_dep_cb_data_t), sizeof(remote_dep_cb_data_t),
                              offsetof(remote_dep_cb_data_t, mempool_owner),
                              1);
+#if defined(PARSEC_PAPI_SDE)
+    parsec_papi_sde_register_counter("COMMUNICATION::ACTIVATIONS::SAVED_MESSAGES", PAPI_SDE_RO|PAPI_SDE_DELTA,
+                                     PAPI_SDE_long_long, &remote_dep_coalesce_saved_msgs);
+    parsec_papi_sde_describe_counter("COMMUNICATION::ACTIVATIONS::SAVED_MESSAGES",
+                                     "Number of activation messages saved by coalescing activations to the same peer");
+    parsec_papi_sde_register_counter("COMMUNICATION::ACTIVATIONS::COALESCED_BYTES", PAPI_SDE_RO|PAPI_SDE_DELTA,
+                                     PAPI_SDE_long_long, &remote_dep_coalesce_bytes);
+    parsec_papi_sde_describe_counter("COMMUNICATION::ACTIVATIONS::COALESCED_BYTES",
+                                     "Number of bytes sent in messages holding more than one coalesced activation");
+#endif  /* defined(PARSEC_PAPI_SDE) */
     /* Lazy or delayed initializations */
     remote_dep_mpi_initialize_execution_stream(context);
     return PARSEC_SUCCESS;
@@ -2289,6 +2762,11 @@ int remote_dep_ce_fini(parsec_context_t* context)
     parsec_ce.tag_unregister(PARSEC_CE_REMOTE_DEP_ACTIVATE_TAG);
     parsec_ce.tag_unregister(PARSEC_CE_REMOTE_DEP_GET_DATA_TAG);
     //parsec_ce.tag_unregister(PARSEC_CE_REMOTE_DEP_PUT_END_TAG);
+    if( parsec_param_eager_limit > 0 ) {
+        parsec_ce.tag_unregister(PARSEC_CE_REMOTE_DEP_EAGER_TAG);
+        parsec_ce.tag_unregister(PARSEC_CE_REMOTE_DEP_CREDIT_TAG);
+        remote_dep_eager_depth = 0;
+    }
 
     if( NULL != parsec_remote_dep_cb_data_mempool ) {
         parsec_mempool_destruct(parsec_remote_dep_cb_data_mempool);
@@ -2298,6 +2776,12 @@ int remote_dep_ce_fini(parsec_context_t* context)
         free(parsec_mpi_same_pos_items); parsec_mpi_same_pos_items = NULL;
         parsec_mpi_same_pos_items_size = 0;
     }
+    remote_dep_coalesce_fini();
+    remote_dep_eager_fini();
+#if defined(PARSEC_PAPI_SDE)
+    parsec_papi_sde_unregister_counter("COMMUNICATION::ACTIVATIONS::SAVED_MESSAGES");
+    parsec_papi_sde_unregister_counter("COMMUNICATION::ACTIVATIONS::COALESCED_BYTES");
+#endif  /* defined(PARSEC_PAPI_SDE) */
 
     PARSEC_OBJ_DESTRUCT(&dep_activates_fifo);
     PARSEC_OBJ_DESTRUCT(&dep_activates_noobj_fifo);
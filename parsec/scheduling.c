@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2009-2024 The University of Tennessee and The University
+ * Copyright (c) 2009-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * Copyright (c) 2025      NVIDIA Corporation.  All rights reserved.
@@ -27,6 +27,10 @@
 #include "parsec/utils/debug.h"
 #include "parsec/dictionary.h"
 #include "parsec/utils/backoff.h"
+#include "parsec/data_internal.h"
+#include "parsec/parsec_hwloc.h"
+#include "parsec/arena.h"
+#include "parsec/metrics.h"
 
 #include <signal.h>
 #if defined(PARSEC_HAVE_STRING_H)
@@ -148,9 +152,16 @@ int __parsec_execute( parsec_execution_stream_t* es,
                          task->selected_device->device_index, task->selected_device->name);
 
     parsec_hook_t *hook = tc->incarnations[task->selected_chore].hook;
+    parsec_time_t start;
     assert( NULL != hook );
     PARSEC_PINS(es, EXEC_BEGIN, task);
+    if( NULL != es->metrics ) start = take_time();
     rc = hook( es, task );
+    if( NULL != es->metrics ) {
+        PARSEC_METRICS_RECORD(es, PARSEC_METRICS_EXEC_LATENCY, diff_time(start, take_time()));
+        if( PARSEC_HOOK_RETURN_DONE == rc )
+            PARSEC_METRICS_INC(es, PARSEC_METRICS_TASKS_EXECUTED);
+    }
 #if defined(PARSEC_PROF_TRACE)
     task->prof_info.task_return_code = rc;
 #endif
@@ -241,6 +252,120 @@ int parsec_set_scheduler( parsec_context_t *parsec )
     return PARSEC_SUCCESS;
 }
 
+/*
+ * NUMA node of a data copy, probed from the page holding the data the first
+ * time it is needed. Pages that have not been touched yet are not located
+ * anywhere, so a failure is only remembered once the data has been produced.
+ * Concurrent probes of the same copy store the same value.
+ */
+static inline int parsec_data_copy_numa_node(parsec_data_copy_t *copy)
+{
+    int node = copy->numa_node;
+
+    if( PARSEC_DATA_COPY_NUMA_UNPROBED != node )
+        return node;
+    if( NULL == copy->device_private )
+        return -1;
+    node = parsec_hwloc_memory_node(copy->device_private);
+    if( (node < 0) || (node >= PARSEC_ARENA_MAX_NUMA_NODES) ) {
+        if( 0 == copy->version ) return -1;
+        node = -1;
+    }
+    copy->numa_node = (int8_t)node;
+    return node;
+}
+
+int parsec_task_locality_hint(const parsec_task_t *task)
+{
+    const parsec_task_class_t *tc = task->task_class;
+    int32_t nodes[MAX_PARAM_COUNT + 1];
+    size_t bytes[MAX_PARAM_COUNT + 1];
+    int i, j, nb = 0, best = -1;
+    size_t best_bytes = 0;
+    parsec_data_copy_t *copy;
+
+    for( i = 0; i < tc->nb_flows; i++ ) {
+        copy = task->data[i].data_in;
+        /* only the main memory copies are located on a NUMA node */
+        if( (NULL == copy) || (0 != copy->device_index) || (NULL == copy->original) ) continue;
+        int node = parsec_data_copy_numa_node(copy);
+        if( node < 0 ) continue;
+        for( j = 0; (j < nb) && (nodes[j] != node); j++ );
+        if( j == nb ) { nodes[nb] = node; bytes[nb] = 0; nb++; }
+        bytes[j] += copy->original->nb_elts;
+    }
+    if( (0 == nb) && (NULL != tc->data_affinity) ) {
+        /* The inputs have not been looked up yet (e.g. they are read directly
+         * from a data collection): use the data the task is bound to instead. */
+        parsec_data_ref_t ref;
+        parsec_data_t *data;
+        tc->data_affinity(task, &ref);
+        if( (NULL != ref.dc) && (NULL != ref.dc->data_of_key) &&
+            (NULL != (data = ref.dc->data_of_key(ref.dc, ref.key))) &&
+            (NULL != (copy = data->device_copies[0])) ) {
+            return parsec_data_copy_numa_node(copy);
+        }
+        return -1;
+    }
+    for( j = 0; j < nb; j++ ) {
+        if( bytes[j] > best_bytes ) { best = nodes[j]; best_bytes = bytes[j]; }
+    }
+    return best;
+}
+
+/*
+ * Move the tasks of the ring whose input data lives mostly on another NUMA
+ * node than es to an execution stream of that node (in the same virtual
+ * process). The relative order of the tasks is preserved, so sorted rings
+ * remain sorted. On return, tasks_ring is the ring of the tasks left to es
+ * (NULL if none), and nb_tasks (if known) is updated accordingly.
+ */
+static int
+__parsec_schedule_by_locality(parsec_execution_stream_t* es,
+                              parsec_task_t** tasks_ring,
+                              int32_t* nb_tasks,
+                              int32_t distance)
+{
+    parsec_vp_t* vp = es->virtual_process;
+    parsec_task_t *rings[PARSEC_ARENA_MAX_NUMA_NODES] = { NULL }, *local = NULL, *task, **dest;
+    int32_t counts[PARSEC_ARENA_MAX_NUMA_NODES] = { 0 }, nb_local = 0;
+    parsec_execution_stream_t *target_es;
+    int node, first, nb, ret = PARSEC_SUCCESS;
+
+    while( NULL != *tasks_ring ) {
+        task = *tasks_ring;
+        *tasks_ring = (parsec_task_t*)parsec_list_item_ring_chop(&task->super);
+        PARSEC_LIST_ITEM_SINGLETON(task);
+        node = parsec_task_locality_hint(task);
+        if( (node < 0) || (node == es->numa_id) || (node >= vp->nb_numa_nodes) ||
+            (vp->numa_first[node] == vp->numa_first[node+1]) ) {
+            dest = &local;
+            nb_local++;
+        } else {
+            dest = &rings[node];
+            counts[node]++;
+        }
+        if( NULL == *dest ) *dest = task;
+        else parsec_list_item_ring_push(&(*dest)->super, &task->super);
+    }
+
+    for( node = 0; (node < vp->nb_numa_nodes) && (PARSEC_SUCCESS == ret); node++ ) {
+        if( NULL == rings[node] ) continue;
+        first = vp->numa_first[node];
+        nb = vp->numa_first[node+1] - first;
+        /* spread the pushes from the different streams over the node */
+        target_es = vp->numa_streams[first + es->th_id % nb];
+        if( (*nb_tasks > 0) && (NULL != parsec_current_scheduler->module.schedule_chain) ) {
+            ret = parsec_current_scheduler->module.schedule_chain(target_es, rings[node], counts[node], distance);
+        } else {
+            ret = parsec_current_scheduler->module.schedule(target_es, rings[node], distance);
+        }
+    }
+    if( *nb_tasks > 0 ) *nb_tasks = nb_local;
+    *tasks_ring = local;
+    return ret;
+}
+
 /*
  * Dispatch a ring of tasks to the requested execution stream, using the provided
  * distance. This function provides little benefit by itself, but it allows to
@@ -250,11 +375,13 @@ int parsec_set_scheduler( parsec_context_t *parsec )
  * In general, this is where we end up after the release_dep_fct is called and
  * generates a readylist.
  */
-inline int
-__parsec_schedule(parsec_execution_stream_t* es,
-                  parsec_task_t* tasks_ring,
-                  int32_t distance)
+static inline int
+__parsec_schedule_internal(parsec_execution_stream_t* es,
+                           parsec_task_t* tasks_ring,
+                           int32_t nb_tasks,
+                           int32_t distance)
 {
+    parsec_task_t* ring;
     int ret;
 #ifdef PARSEC_PROF_PINS
     parsec_execution_stream_t* local_es = parsec_my_execution_stream();
@@ -296,20 +423,63 @@ __parsec_schedule(parsec_execution_stream_t* es,
 
 #if defined(PARSEC_PAPI_SDE)
     {
-        int len = 0;
+        int len = nb_tasks;
         parsec_task_t *task = tasks_ring;
-        _LIST_ITEM_ITERATOR(task, &task->super, item, {len++; });
+        if( len < 0 ) {
+            len = 0;
+            _LIST_ITEM_ITERATOR(task, &task->super, item, {len++; });
+        }
         PARSEC_PAPI_SDE_COUNTER_ADD(PARSEC_PAPI_SDE_TASKS_ENABLED, len);
     }
 #endif  /* defined(PARSEC_PAPI_SDE) */
 
-    ret = parsec_current_scheduler->module.schedule(es, tasks_ring, distance);
+    ret = PARSEC_SUCCESS;
+    ring = tasks_ring;
+    if( parsec_runtime_sched_locality && (es->virtual_process->nb_numa_nodes > 1) ) {
+        ret = __parsec_schedule_by_locality(es, &ring, &nb_tasks, distance);
+    }
+    if( (NULL != ring) && (PARSEC_SUCCESS == ret) ) {
+        if( nb_tasks > 0 && NULL != parsec_current_scheduler->module.schedule_chain ) {
+            ret = parsec_current_scheduler->module.schedule_chain(es, ring, nb_tasks, distance);
+        } else {
+            ret = parsec_current_scheduler->module.schedule(es, ring, distance);
+        }
+    }
 
     PARSEC_PINS(local_es, SCHEDULE_END, tasks_ring);
 
     return ret;
 }
 
+inline int
+__parsec_schedule(parsec_execution_stream_t* es,
+                  parsec_task_t* tasks_ring,
+                  int32_t distance)
+{
+    return __parsec_schedule_internal(es, tasks_ring, -1, distance);
+}
+
+/*
+ * Same as __parsec_schedule, for a ring of nb_tasks tasks sorted by decreasing
+ * priority: the scheduler may then insert the whole ring at once.
+ */
+int
+__parsec_schedule_chain(parsec_execution_stream_t* es,
+                        parsec_task_t* tasks_ring,
+                        int32_t nb_tasks,
+                        int32_t distance)
+{
+#if defined(PARSEC_DEBUG_PARANOID)
+    {
+        int32_t len = 0;
+        parsec_task_t *task = tasks_ring;
+        _LIST_ITEM_ITERATOR(task, &task->super, item, {len++; });
+        assert(len == nb_tasks);
+    }
+#endif  /* defined(PARSEC_DEBUG_PARANOID) */
+    return __parsec_schedule_internal(es, tasks_ring, nb_tasks, distance);
+}
+
 /*
  * Schedule an array of rings of tasks with one entry per virtual process.
  * If an execution stream is provided, this function will save the highest
@@ -327,6 +497,20 @@ __parsec_schedule(parsec_execution_stream_t* es,
 int __parsec_schedule_vp(parsec_execution_stream_t* submission_es,
                          parsec_task_t** task_rings,
                          int32_t distance)
+{
+    return __parsec_schedule_vp_chains(submission_es, task_rings, NULL, distance);
+}
+
+/*
+ * Same as __parsec_schedule_vp, but each ring in task_rings is sorted by
+ * decreasing priority and counted in task_counts (if task_counts is not NULL),
+ * so that the scheduler can insert it in bulk. The counts are updated with the
+ * rings.
+ */
+int __parsec_schedule_vp_chains(parsec_execution_stream_t* submission_es,
+                                parsec_task_t** task_rings,
+                                int32_t* task_counts,
+                                int32_t distance)
 {
     parsec_execution_stream_t *target_es,
                               *es = (NULL == submission_es ? parsec_my_execution_stream() : submission_es);
@@ -341,11 +525,12 @@ int __parsec_schedule_vp(parsec_execution_stream_t* submission_es,
 
             target_es = context->virtual_processes[vp]->execution_streams[0];
 
-            ret = __parsec_schedule(target_es, ring, distance);
+            ret = __parsec_schedule_internal(target_es, ring, NULL == task_counts ? -1 : task_counts[vp], distance);
             if( 0 != ret )
                 return ret;
 
             task_rings[vp] = NULL;  /* remove the tasks already scheduled */
+            if( NULL != task_counts ) task_counts[vp] = 0;
         }
         return ret;
     }
@@ -366,6 +551,7 @@ int __parsec_schedule_vp(parsec_execution_stream_t* submission_es,
             if( NULL == submission_es->next_task ) {
                 submission_es->next_task = ring;
                 ring = (parsec_task_t*)parsec_list_item_ring_chop(&ring->super);
+                if( NULL != task_counts ) task_counts[vp]--;
                 if( NULL == ring ) {
                     task_rings[vp] = NULL;  /* remove the tasks already scheduled */
                     continue;
@@ -374,11 +560,12 @@ int __parsec_schedule_vp(parsec_execution_stream_t* submission_es,
             /* Beware we are changing the submission execution stream for the local vp */
             target_es = submission_es;
         }
-        ret = __parsec_schedule(target_es, ring, distance);
+        ret = __parsec_schedule_internal(target_es, ring, NULL == task_counts ? -1 : task_counts[vp], distance);
         if( 0 != ret )
             return ret;
 
         task_rings[vp] = NULL;  /* remove the tasks already scheduled */
+        if( NULL != task_counts ) task_counts[vp] = 0;
     }
     return ret;
 }
@@ -535,6 +722,21 @@ int __parsec_task_progress( parsec_execution_stream_t* es,
     return rc;
 }
 
+/**
+ * Sleep for lack of work, accounting the time as idle in the metrics.
+ */
+static inline void
+parsec_metrics_sleep( parsec_execution_stream_t *es, const struct timespec *rqtp )
+{
+    if( NULL != es->metrics ) {
+        parsec_time_t start = take_time();
+        nanosleep(rqtp, NULL);
+        PARSEC_METRICS_ADD(es, PARSEC_METRICS_IDLE_TIME, diff_time(start, take_time()));
+        return;
+    }
+    nanosleep(rqtp, NULL);
+}
+
 /**
  * Get the next task to execute, either from local storage or from the scheduler.
  * Update the distance accordingly.
@@ -548,7 +750,20 @@ __parsec_get_next_task( parsec_execution_stream_t *es,
     parsec_task_t* task;
 
     if( NULL == (task = es->next_task) ) {
-        task = parsec_current_scheduler->module.select(es, distance);
+        if( NULL != es->metrics ) {
+            parsec_time_t start = take_time();
+            uint64_t duration;
+            task = parsec_current_scheduler->module.select(es, distance);
+            duration = diff_time(start, take_time());
+            PARSEC_METRICS_ADD(es, PARSEC_METRICS_SELECT_TIME, duration);
+            PARSEC_METRICS_RECORD(es, PARSEC_METRICS_SELECT_LATENCY, duration);
+            if( NULL == task )
+                PARSEC_METRICS_INC(es, PARSEC_METRICS_SELECT_MISSES);
+            else if( *distance > 0 )
+                PARSEC_METRICS_INC(es, PARSEC_METRICS_TASKS_STOLEN);
+        } else {
+            task = parsec_current_scheduler->module.select(es, distance);
+        }
     } else {
         es->next_task = NULL;
         *distance = 1;
@@ -641,7 +856,7 @@ static int __parsec_taskpool_wait( parsec_taskpool_t* tp, parsec_execution_strea
 
         if( misses_in_a_row > 1 ) {
             rqtp.tv_nsec = parsec_exponential_backoff(es, misses_in_a_row);
-            nanosleep(&rqtp, NULL);
+            parsec_metrics_sleep(es, &rqtp);
         }
         misses_in_a_row++;  /* assume we fail to extract a task */
 
@@ -767,7 +982,7 @@ int __parsec_context_wait( parsec_execution_stream_t* es )
 
         if( misses_in_a_row > 1 ) {
             rqtp.tv_nsec = parsec_exponential_backoff(es, misses_in_a_row);
-            nanosleep(&rqtp, NULL);
+            parsec_metrics_sleep(es, &rqtp);
         }
         misses_in_a_row++;  /* assume we fail to extract a task */
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2009-2022 The University of Tennessee and The University
+ * Copyright (c) 2009-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  */
@@ -68,6 +68,37 @@ int __parsec_schedule_vp( parsec_execution_stream_t*,
                           parsec_task_t**,
                           int32_t distance);
 
+/**
+ * Locality hint of a ready task: the NUMA node (logical index) holding most
+ * of the bytes of its input data copies, or, if the inputs have not been
+ * looked up yet, the node holding the data the task has affinity with.
+ *
+ * @return the NUMA node, or -1 if the location of the data is unknown.
+ */
+int parsec_task_locality_hint(const parsec_task_t *task);
+
+/**
+ * Same as __parsec_schedule, for a ring of exactly nb_tasks tasks sorted by
+ * decreasing priority (as built by the release of the dependencies of a task).
+ * Schedulers that provide a schedule_chain function insert the ring in bulk,
+ * the others are called through their schedule function.
+ */
+int __parsec_schedule_chain( parsec_execution_stream_t*,
+                             parsec_task_t*,
+                             int32_t nb_tasks,
+                             int32_t distance);
+
+/**
+ * Same as __parsec_schedule_vp, with rings sorted by decreasing priority, and
+ * task_counts[vp] holding the number of tasks in task_rings[vp]. Both arrays are
+ * reset for the rings that have been scheduled. If task_counts is NULL, this is
+ * equivalent to __parsec_schedule_vp.
+ */
+int __parsec_schedule_vp_chains( parsec_execution_stream_t*,
+                                 parsec_task_t**,
+                                 int32_t* task_counts,
+                                 int32_t distance);
+
 /**
  * Some runtime systems (e.g. MADNESS) that use PaRSEC as a task scheduler may detect
  * late that a task that already scheduled new work may block on the
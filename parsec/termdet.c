@@ -11,8 +11,11 @@
 #include "parsec/class/parsec_hash_table.h"
 #include "parsec/mca/mca.h"
 #include "parsec/mca/mca_repository.h"
+#include "parsec/utils/mca_param.h"
 
 static parsec_hash_table_t parsec_termdet_opened_modules;
+/* termdet_dynamic: module monitoring the taskpools that ask for a dynamic termination detection */
+static char *parsec_termdet_dynamic_module = NULL;
 
 typedef struct {
     parsec_hash_table_item_t ht_item;
@@ -58,6 +61,10 @@ int parsec_termdet_init(void)
 {
     parsec_hash_table_init(&parsec_termdet_opened_modules, offsetof(parsec_termdet_opened_module_t, ht_item), 4,
                            parsec_termdet_opened_module_key_fn, NULL);
+    parsec_mca_param_reg_string_name("termdet", "dynamic",
+                                     "Termination detection module of the taskpools that require a distributed "
+                                     "termination detection (fourcounter, hierarchical)",
+                                     false, false, "fourcounter", &parsec_termdet_dynamic_module);
     return PARSEC_SUCCESS;
 }
 
@@ -103,8 +110,9 @@ int parsec_termdet_open_module(parsec_taskpool_t *tp, char *name)
 
 int parsec_termdet_open_dyn_module(parsec_taskpool_t *tp)
 {
-    //TODO Once there are multiple choices for a dynamic module, this function should evolve
-    return parsec_termdet_open_module(tp, "fourcounter");
+    if( (NULL == parsec_termdet_dynamic_module) || ('\0' == parsec_termdet_dynamic_module[0]) )
+        return parsec_termdet_open_module(tp, "fourcounter");
+    return parsec_termdet_open_module(tp, parsec_termdet_dynamic_module);
 }
 
 static void parsec_termdet_close_module(void *item, void *data)
@@ -123,5 +131,7 @@ int parsec_termdet_fini(void)
     parsec_hash_table_for_all(&parsec_termdet_opened_modules, parsec_termdet_close_module,
                               &parsec_termdet_opened_modules);
     parsec_hash_table_fini(&parsec_termdet_opened_modules);
+    free(parsec_termdet_dynamic_module);
+    parsec_termdet_dynamic_module = NULL;
     return PARSEC_SUCCESS;
 }
@@ -11,6 +11,7 @@
 #include "project.h"
 #include "walk_utils.h" /** Must be included before walk.h */
 #include "walk.h"
+#include "tests/tests_timing.h"
 
 #include <unistd.h>
 #include <string.h>
@@ -23,6 +24,9 @@ extern int optreset;
 
 #define SUM_VALUE 0xbdae8a4ea45fc32eLL
 
+double time_elapsed = 0.0;
+double sync_time_elapsed = 0.0;
+
 typedef struct {
     int n;
     int l;
@@ -233,13 +237,18 @@ int main(int argc, char *argv[])
     project = parsec_project_new(treeA, world, (parsec_data_collection_t*)&fakeDesc, 1e-3, be_verbose, 1.0);
     project->arenas_datatypes[PARSEC_project_DEFAULT_ADT_IDX] = adt;
     PARSEC_OBJ_RETAIN(adt.arena);
+    SYNC_TIME_START();
     rc = parsec_context_add_taskpool(parsec, &project->super);
     PARSEC_CHECK_ERROR(rc, "parsec_context_add_taskpool");
     rc = parsec_context_start(parsec);
     PARSEC_CHECK_ERROR(rc, "parsec_context_start");
     rc = parsec_context_wait(parsec);
     PARSEC_CHECK_ERROR(rc, "parsec_context_wait");
-        
+    SYNC_TIME_STOP();
+    /* stdout may hold the DOT output of the tree */
+    if( 0 == rank )
+        fprintf(stderr, "[****] TIME(s) %12.5f : project\n", sync_time_elapsed);
+
     project->arenas_datatypes[PARSEC_project_DEFAULT_ADT_IDX].arena = NULL;
     parsec_taskpool_free(&project->super);
     ret = 0;
@@ -13,6 +13,10 @@
 #include <string.h>
 #endif  /* defined(PARSEC_HAVE_STRING_H) */
 #include "sort_data.h"
+#include "tests/tests_timing.h"
+
+double time_elapsed = 0.0;
+double sync_time_elapsed = 0.0;
 
 int main(int argc, char *argv[])
 {
@@ -54,12 +58,14 @@ int main(int argc, char *argv[])
 
     msort = merge_sort_new(dcA, nb, nt);
 
+    SYNC_TIME_START();
     rc = parsec_context_add_taskpool(parsec, msort);
     PARSEC_CHECK_ERROR(rc, "parsec_context_add_taskpool");
     rc = parsec_context_start(parsec);
     PARSEC_CHECK_ERROR(rc, "parsec_context_start");
     rc = parsec_context_wait(parsec);
     PARSEC_CHECK_ERROR(rc, "parsec_context_wait");
+    SYNC_TIME_PRINT(rank, ("merge_sort\tNT= %d NB= %d\n", nt, nb));
 
     parsec_taskpool_free((parsec_taskpool_t*)msort);
     free_data(dcA);
@@ -1,7 +1,49 @@
 parsec_addtest_cmd(apps/stencil ${SHM_TEST_CMD_LIST} apps/stencil/testing_stencil_1D -t 100 -T 100 -N 1000 -M 1000 -I 10 -R 2 -m 1)
+parsec_addtest_cmd(apps/stencil:numa ${SHM_TEST_CMD_LIST} apps/stencil/testing_stencil_1D -t 100 -T 100 -N 1000 -M 1000 -I 10 -R 2 -m 1)
+if(TEST apps/stencil:numa)
+  set_property(TEST apps/stencil:numa APPEND PROPERTY ENVIRONMENT PARSEC_MCA_arena_numa=1)
+endif()
+if(PARSEC_PROF_PINS)
+  parsec_addtest_cmd(apps/stencil:locality ${SHM_TEST_CMD_LIST} apps/stencil/testing_stencil_1D -t 100 -T 100 -N 1000 -M 1000 -I 10 -R 2 -m 1 -- --mca mca_pins numa_locality)
+  if(TEST apps/stencil:locality)
+    set_property(TEST apps/stencil:locality APPEND PROPERTY ENVIRONMENT
+      PARSEC_MCA_runtime_sched_locality=1 PARSEC_MCA_arena_numa=1)
+  endif()
+endif(PARSEC_PROF_PINS)
 if( MPI_C_FOUND )
   parsec_addtest_cmd(apps/stencil:mp ${MPI_TEST_CMD_LIST} 8 apps/stencil/testing_stencil_1D -t 100 -T 100 -N 1000 -M 1000 -I 10 -R 2 -m 1)
   if(TEST apps/stencil:mp)
     set_tests_properties(apps/stencil:mp PROPERTIES DEPENDS launch:mp)
   endif()
+  parsec_addtest_cmd(apps/stencil:mp:slabs ${MPI_TEST_CMD_LIST} 4 apps/stencil/testing_stencil_1D -t 100 -T 100 -N 1000 -M 1000 -I 10 -R 2 -m 1)
+  if(TEST apps/stencil:mp:slabs)
+    set_tests_properties(apps/stencil:mp:slabs PROPERTIES DEPENDS launch:mp)
+    set_property(TEST apps/stencil:mp:slabs APPEND PROPERTY ENVIRONMENT
+      PARSEC_MCA_arena_hugepages=1 PARSEC_MCA_arena_magazine_size=2)
+  endif()
+  parsec_addtest_cmd(apps/stencil:mp:mt ${MPI_TEST_CMD_LIST} 4 apps/stencil/testing_stencil_1D -t 100 -T 100 -N 1000 -M 1000 -I 10 -R 2 -m 1)
+  if(TEST apps/stencil:mp:mt)
+    set_tests_properties(apps/stencil:mp:mt PROPERTIES DEPENDS launch:mp)
+    set_property(TEST apps/stencil:mp:mt APPEND PROPERTY ENVIRONMENT
+      PARSEC_MCA_runtime_comm_engine=multithreaded PARSEC_MCA_runtime_comm_mt_send_requests=4)
+  endif()
+  parsec_addtest_cmd(apps/stencil:mp:coalesce ${MPI_TEST_CMD_LIST} 4 apps/stencil/testing_stencil_1D -t 100 -T 100 -N 1000 -M 1000 -I 10 -R 2)
+  if(TEST apps/stencil:mp:coalesce)
+    set_tests_properties(apps/stencil:mp:coalesce PROPERTIES DEPENDS launch:mp)
+    set_property(TEST apps/stencil:mp:coalesce APPEND PROPERTY ENVIRONMENT
+      PARSEC_MCA_runtime_comm_coalesce_delay=100)
+  endif()
+  # Only half of the processes coalesce: the others must still receive the coalesced activations
+  parsec_addtest_cmd(apps/stencil:mp:coalesce_mixed ${MPI_TEST_CMD_LIST} 2 env PARSEC_MCA_runtime_comm_coalesce_delay=100
+                     apps/stencil/testing_stencil_1D -t 100 -T 100 -N 1000 -M 1000 -I 10 -R 2
+                     : -n 2 apps/stencil/testing_stencil_1D -t 100 -T 100 -N 1000 -M 1000 -I 10 -R 2)
+  if(TEST apps/stencil:mp:coalesce_mixed)
+    set_tests_properties(apps/stencil:mp:coalesce_mixed PROPERTIES DEPENDS launch:mp)
+  endif()
+  parsec_addtest_cmd(apps/stencil:mp:eager ${MPI_TEST_CMD_LIST} 4 apps/stencil/testing_stencil_1D -t 100 -T 100 -N 1000 -M 1000 -I 10 -R 2)
+  if(TEST apps/stencil:mp:eager)
+    set_tests_properties(apps/stencil:mp:eager PROPERTIES DEPENDS launch:mp)
+    set_property(TEST apps/stencil:mp:eager APPEND PROPERTY ENVIRONMENT
+      PARSEC_MCA_runtime_comm_eager_limit=65536 PARSEC_MCA_runtime_comm_eager_credits=2)
+  endif()
 endif( MPI_C_FOUND )
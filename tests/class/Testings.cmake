@@ -5,6 +5,15 @@ add_test(class/rwlock ${SHM_TEST_CMD_LIST} class/rwlock -c 4)
 add_test(class/lifo ${SHM_TEST_CMD_LIST} class/lifo -c 4)
 add_test(class/list ${SHM_TEST_CMD_LIST} class/list -c 4)
 add_test(class/hash ${SHM_TEST_CMD_LIST} class/hash -\# 65536 -r 4 -n)
+add_test(class/hash:lockfree ${SHM_TEST_CMD_LIST} class/hash -\# 65536 -r 4 -n)
+set_property(TEST class/hash:lockfree APPEND PROPERTY ENVIRONMENT
+  PARSEC_MCA_parsec_hash_table_lockfree=1)
+add_test(class/hash_bench ${SHM_TEST_CMD_LIST} class/hash_bench -M 4 -k 4096 -o 100000)
+# More keys than a quarter of the largest table allowed: the lock-free table must stop growing
+add_test(class/hash_bench:capped ${SHM_TEST_CMD_LIST} class/hash_bench -M 4 -k 1900 -o 100000 -l 1)
+set_property(TEST class/hash_bench:capped APPEND PROPERTY ENVIRONMENT
+  PARSEC_MCA_parsec_hash_table_max_table_nb_bits=12)
+add_test(class/multiqueue_bench ${SHM_TEST_CMD_LIST} class/multiqueue_bench -M 4 -t 16384 -o 100000)
 add_test(class/future ${SHM_TEST_CMD_LIST} class/future -c 4)
 add_test(class/future_datacopy ${SHM_TEST_CMD_LIST} class/future_datacopy)
 
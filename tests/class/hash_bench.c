@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+/*
+ * Throughput of the hash tables under a mixed find / insert / remove
+ * workload, for 1 to N threads, with the locked and the lock-free
+ * implementations (MCA parameter parsec_hash_table_lockfree).
+ *
+ * Each thread owns a disjoint set of keys, so that keys stay unique in the
+ * table as required by the API, but all threads share the same table.
+ * Half of the keys are inserted before the timed phase, and the table
+ * starts small so that the timed phase also exercises the resizes.
+ */
+
+#include "parsec/runtime.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include "parsec/class/barrier.h"
+#include "parsec/bindthread.h"
+#include "parsec/parsec_hwloc.h"
+#include "parsec/utils/mca_param.h"
+#include "parsec/utils/debug.h"
+
+#include "parsec/class/parsec_hash_table.h"
+
+static inline uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static parsec_hash_table_t hash_table;
+static parsec_barrier_t barrier;
+static int nbcores;
+
+typedef struct {
+    parsec_hash_table_item_t ht_item;
+    int                      present;
+} bench_item_t;
+
+static parsec_key_fn_t key_functions = {
+    .key_equal = parsec_hash_table_generic_64bits_key_equal,
+    .key_print = parsec_hash_table_generic_64bits_key_print,
+    .key_hash  = parsec_hash_table_generic_64bits_key_hash
+};
+
+typedef struct {
+    int id;
+    int nbthreads;
+    int nb_keys;        /* per thread */
+    int nb_ops;         /* per thread */
+    int find_pct;       /* the rest is split between inserts and removes */
+    int errors;
+} param_t;
+
+static void *do_bench(void *_param)
+{
+    param_t *param = (param_t*)_param;
+    int id = param->id, nb_keys = param->nb_keys;
+    unsigned int seed = 1 + id;
+    bench_item_t *items;
+    uint64_t t0, duration;
+    void *rc;
+
+    parsec_bindthread(id%nbcores, 0);
+
+    items = malloc(sizeof(bench_item_t) * nb_keys);
+    for(int k = 0; k < nb_keys; k++) {
+        /* spread the keys of all threads over the key space */
+        items[k].ht_item.key = (parsec_key_t)(uintptr_t)(((uint64_t)k * param->nbthreads + id) * 2654435761ULL + 1);
+        items[k].present = 0;
+    }
+
+    if( 0 == id ) {
+        parsec_hash_table_init(&hash_table, offsetof(bench_item_t, ht_item), 4, key_functions, NULL);
+    }
+    parsec_barrier_wait(&barrier);
+    for(int k = 0; k < nb_keys; k += 2) {
+        parsec_hash_table_insert(&hash_table, &items[k].ht_item);
+        items[k].present = 1;
+    }
+    parsec_barrier_wait(&barrier);
+
+    t0 = now_ns();
+    for(int o = 0; o < param->nb_ops; o++) {
+        int r = rand_r(&seed);
+        bench_item_t *it = &items[(r >> 8) % nb_keys];
+        if( (r & 0x7f) % 100 < param->find_pct ) {
+            rc = parsec_hash_table_find(&hash_table, it->ht_item.key);
+            if( rc != (it->present ? it : NULL) ) param->errors++;
+        } else if( it->present ) {
+            rc = parsec_hash_table_remove(&hash_table, it->ht_item.key);
+            if( rc != it ) param->errors++;
+            it->present = 0;
+        } else {
+            parsec_hash_table_insert(&hash_table, &it->ht_item);
+            it->present = 1;
+        }
+    }
+    duration = now_ns() - t0;
+
+    for(int k = 0; k < nb_keys; k++) {
+        if( items[k].present ) {
+            rc = parsec_hash_table_remove(&hash_table, items[k].ht_item.key);
+            if( rc != &items[k] ) param->errors++;
+        }
+    }
+    parsec_barrier_wait(&barrier);
+    if( 0 == id ) {
+        parsec_hash_table_fini(&hash_table);
+    }
+    free(items);
+    return (void*)(uintptr_t)duration;
+}
+
+int main(int argc, char *argv[])
+{
+    pthread_t *threads;
+    param_t *params;
+    int ch, e, nbthreads, maxthreads, lf, lf_min = 0, lf_max = 1, errors = 0;
+    int nb_keys = 16384, nb_ops = 1000000, find_pct = 80;
+    int lf_index;
+    uint64_t maxtime, t;
+    char *m;
+
+    parsec_debug_init();
+    parsec_hwloc_init();
+    parsec_mca_param_init();
+    parsec_hash_tables_init();
+
+    nbcores = parsec_hwloc_nb_real_cores();
+    maxthreads = nbcores;
+
+    while( (ch = getopt(argc, argv, "M:k:o:f:l:h?")) != -1 ) {
+        switch(ch) {
+        case 'M':
+            maxthreads = strtol(optarg, &m, 0);
+            if( (maxthreads <= 0) || (m[0] != '\0') ) {
+                fprintf(stderr, "%s: %s\n", argv[0], "invalid -M value");
+                exit(1);
+            }
+            break;
+        case 'k':
+            nb_keys = strtol(optarg, &m, 0);
+            if( (nb_keys <= 0) || (m[0] != '\0') ) {
+                fprintf(stderr, "%s: %s\n", argv[0], "invalid -k value");
+                exit(1);
+            }
+            break;
+        case 'o':
+            nb_ops = strtol(optarg, &m, 0);
+            if( (nb_ops <= 0) || (m[0] != '\0') ) {
+                fprintf(stderr, "%s: %s\n", argv[0], "invalid -o value");
+                exit(1);
+            }
+            break;
+        case 'f':
+            find_pct = strtol(optarg, &m, 0);
+            if( (find_pct < 0) || (find_pct > 100) || (m[0] != '\0') ) {
+                fprintf(stderr, "%s: %s\n", argv[0], "invalid -f value");
+                exit(1);
+            }
+            break;
+        case 'l':
+            lf_min = lf_max = strtol(optarg, &m, 0);
+            if( (lf_min < 0) || (lf_min > 1) || (m[0] != '\0') ) {
+                fprintf(stderr, "%s: %s\n", argv[0], "invalid -l value");
+                exit(1);
+            }
+            break;
+        case 'h':
+        case '?':
+        default:
+            fprintf(stderr,
+                    "Usage: %s [-M maxthreads][-k keys per thread][-o operations per thread]\n"
+                    "          [-f percentage of find operations (80)]\n"
+                    "          [-l 0|1 (only run the locked / lock-free implementation)]\n", argv[0]);
+            exit(1);
+        }
+    }
+
+    lf_index = parsec_mca_param_find("parsec", NULL, "hash_table_lockfree");
+    if( PARSEC_ERROR == lf_index ) {
+        fprintf(stderr, "Unable to find the MCA parameter parsec_hash_table_lockfree\n");
+        exit(1);
+    }
+
+    threads = calloc(maxthreads, sizeof(pthread_t));
+    params = calloc(maxthreads, sizeof(param_t));
+
+    printf("#impl threads keys/thread ops/thread find%% time(s) Mops/s\n");
+    for(lf = lf_min; lf <= lf_max; lf++) {
+        parsec_mca_param_set_int(lf_index, lf);
+        for(nbthreads = 1; nbthreads <= maxthreads; nbthreads++) {
+            parsec_barrier_init(&barrier, NULL, nbthreads);
+            for(e = 0; e < nbthreads; e++) {
+                params[e].id = e;
+                params[e].nbthreads = nbthreads;
+                params[e].nb_keys = nb_keys;
+                params[e].nb_ops = nb_ops;
+                params[e].find_pct = find_pct;
+                params[e].errors = 0;
+            }
+            for(e = 1; e < nbthreads; e++) {
+                pthread_create(&threads[e], NULL, do_bench, &params[e]);
+            }
+            maxtime = (uint64_t)(uintptr_t)do_bench(&params[0]);
+            for(e = 1; e < nbthreads; e++) {
+                void *retval;
+                pthread_join(threads[e], &retval);
+                t = (uint64_t)(uintptr_t)retval;
+                if( t > maxtime ) maxtime = t;
+            }
+            for(e = 0; e < nbthreads; e++) {
+                errors += params[e].errors;
+            }
+            parsec_barrier_destroy(&barrier);
+            printf("%s %d %d %d %d %g %g\n", lf ? "lockfree" : "locked",
+                   nbthreads, nb_keys, nb_ops, find_pct, (double)maxtime / 1e9,
+                   (double)nb_ops * nbthreads / ((double)maxtime / 1e3));
+        }
+    }
+
+    free(params);
+    free(threads);
+    parsec_mca_param_finalize();
+    parsec_hwloc_fini();
+    parsec_debug_fini();
+
+    if( errors ) {
+        fprintf(stderr, "%d errors detected\n", errors);
+        return 1;
+    }
+    return 0;
+}
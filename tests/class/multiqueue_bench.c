@@ -0,0 +1,334 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+/*
+ * Throughput of the local priority queues of the schedulers under a mixed
+ * push / pop workload of prioritized tasks, for 1 to N threads: a bounded
+ * buffer (parsec_hbbuffer_push_all_by_priority / parsec_hbbuffer_pop_best,
+ * overflowing in a dequeue as in the pbq scheduler) shared by all threads,
+ * and a MultiQueue with a few heaps per thread.
+ *
+ * Every task is marked when popped, so that a task popped twice, or never
+ * popped once the queues are drained, is reported as an error. The
+ * relaxation of the MultiQueue is measured, with a single thread, as the
+ * average number of priority levels between the popped task and the best
+ * task in the queue.
+ */
+
+#include "parsec/runtime.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include "parsec/class/barrier.h"
+#include "parsec/bindthread.h"
+#include "parsec/parsec_hwloc.h"
+#include "parsec/parsec_internal.h"
+#include "parsec/utils/mca_param.h"
+#include "parsec/utils/debug.h"
+
+#include "parsec/hbbuffer.h"
+#include "parsec/class/dequeue.h"
+#include "parsec/class/parsec_multiqueue.h"
+
+static inline uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+#define IMPL_HBBUFFER   0
+#define IMPL_MULTIQUEUE 1
+
+static parsec_hbbuffer_t  *hbbuffer;
+static parsec_dequeue_t    overflow;
+static parsec_multiqueue_t multiqueue;
+static parsec_barrier_t    barrier;
+static int nbcores;
+
+typedef struct {
+    parsec_task_t task;
+    int32_t       popped;
+} bench_task_t;
+
+typedef struct {
+    int id;
+    int impl;
+    int nb_tasks;       /* per thread */
+    int nb_ops;         /* per thread */
+    int nb_levels;      /* number of different priorities */
+    int errors;
+    bench_task_t *tasks;
+} param_t;
+
+static void push_in_overflow(void *store, parsec_list_item_t *elt, int32_t distance)
+{
+    (void)distance;
+    parsec_dequeue_chain_back((parsec_dequeue_t*)store, elt);
+}
+
+static void push_task(int impl, bench_task_t *t, unsigned int *seed)
+{
+    PARSEC_LIST_ITEM_SINGLETON(&t->task.super);
+    if( IMPL_HBBUFFER == impl ) {
+        parsec_hbbuffer_push_all_by_priority(hbbuffer, &t->task.super, 0);
+    } else {
+        parsec_multiqueue_push_all(&multiqueue, &t->task.super, seed);
+    }
+}
+
+static bench_task_t *pop_task(int impl, unsigned int *seed)
+{
+    parsec_list_item_t *it;
+    if( IMPL_HBBUFFER == impl ) {
+        it = parsec_hbbuffer_pop_best(hbbuffer, parsec_execution_context_priority_comparator);
+        if( NULL == it )
+            it = parsec_dequeue_try_pop_front(&overflow);
+    } else {
+        it = parsec_multiqueue_pop(&multiqueue, seed);
+    }
+    return (bench_task_t*)it;
+}
+
+static void *do_bench(void *_param)
+{
+    param_t *param = (param_t*)_param;
+    int id = param->id, nb_tasks = param->nb_tasks, next = 0;
+    unsigned int seed = 1 + id;
+    bench_task_t *t;
+    uint64_t t0, duration;
+
+    parsec_bindthread(id%nbcores, 0);
+
+    for(int k = 0; k < nb_tasks; k++) {
+        PARSEC_OBJ_CONSTRUCT(&param->tasks[k].task, parsec_task_t);
+        param->tasks[k].popped = 0;
+    }
+    parsec_barrier_wait(&barrier);
+
+    /* Half of the tasks are ready before the timed phase */
+    for( ; next < nb_tasks / 2; next++ ) {
+        param->tasks[next].task.priority = rand_r(&seed) % param->nb_levels;
+        push_task(param->impl, &param->tasks[next], &seed);
+    }
+    parsec_barrier_wait(&barrier);
+
+    t0 = now_ns();
+    for(int o = 0; o < param->nb_ops; o++) {
+        if( (o & 1) && next < nb_tasks ) {
+            param->tasks[next].task.priority = rand_r(&seed) % param->nb_levels;
+            push_task(param->impl, &param->tasks[next], &seed);
+            next++;
+            continue;
+        }
+        if( NULL != (t = pop_task(param->impl, &seed)) ) {
+            if( 0 != parsec_atomic_fetch_inc_int32(&t->popped) ) param->errors++;
+        }
+    }
+    duration = now_ns() - t0;
+
+    /* Drain the queues */
+    parsec_barrier_wait(&barrier);
+    while( NULL != (t = pop_task(param->impl, &seed)) ) {
+        if( 0 != parsec_atomic_fetch_inc_int32(&t->popped) ) param->errors++;
+    }
+    parsec_barrier_wait(&barrier);
+    for(int k = 0; k < next; k++) {
+        if( 1 != param->tasks[k].popped ) param->errors++;
+    }
+    for(int k = 0; k < nb_tasks; k++) {
+        PARSEC_OBJ_DESTRUCT(&param->tasks[k].task);
+    }
+    return (void*)(uintptr_t)duration;
+}
+
+/* Average distance, in priority levels, between the task popped from the
+ * MultiQueue and the best task in the queue */
+static double relaxation(int nb_heaps, int nb_tasks, int nb_levels)
+{
+    int *count = calloc(nb_levels, sizeof(int));
+    bench_task_t *tasks = calloc(nb_tasks, sizeof(bench_task_t));
+    unsigned int seed = 1;
+    int best, k;
+    long long int distance = 0;
+    bench_task_t *t;
+
+    PARSEC_OBJ_CONSTRUCT(&multiqueue, parsec_multiqueue_t);
+    parsec_multiqueue_init(&multiqueue, parsec_execution_context_priority_comparator, nb_heaps);
+    for(k = 0; k < nb_tasks; k++) {
+        PARSEC_OBJ_CONSTRUCT(&tasks[k].task, parsec_task_t);
+        tasks[k].task.priority = rand_r(&seed) % nb_levels;
+        count[tasks[k].task.priority]++;
+        push_task(IMPL_MULTIQUEUE, &tasks[k], &seed);
+    }
+    best = nb_levels - 1;
+    for(k = 0; k < nb_tasks; k++) {
+        t = pop_task(IMPL_MULTIQUEUE, &seed);
+        while( 0 == count[best] ) best--;
+        distance += best - t->task.priority;
+        count[t->task.priority]--;
+    }
+    PARSEC_OBJ_DESTRUCT(&multiqueue);
+    for(k = 0; k < nb_tasks; k++) {
+        PARSEC_OBJ_DESTRUCT(&tasks[k].task);
+    }
+    free(tasks);
+    free(count);
+    return (double)distance / nb_tasks;
+}
+
+int main(int argc, char *argv[])
+{
+    pthread_t *threads;
+    param_t *params;
+    int ch, e, nbthreads, maxthreads, impl, impl_min = IMPL_HBBUFFER, impl_max = IMPL_MULTIQUEUE, errors = 0;
+    int nb_tasks = 65536, nb_ops = 1000000, buffer_size = 256, heaps_per_thread = 2, nb_levels = 1024;
+    uint64_t maxtime, t;
+    char *m;
+
+    parsec_debug_init();
+    parsec_hwloc_init();
+    parsec_mca_param_init();
+
+    nbcores = parsec_hwloc_nb_real_cores();
+    maxthreads = nbcores;
+
+    while( (ch = getopt(argc, argv, "M:t:o:s:q:p:i:h?")) != -1 ) {
+        switch(ch) {
+        case 'M':
+            maxthreads = strtol(optarg, &m, 0);
+            if( (maxthreads <= 0) || (m[0] != '\0') ) {
+                fprintf(stderr, "%s: %s\n", argv[0], "invalid -M value");
+                exit(1);
+            }
+            break;
+        case 't':
+            nb_tasks = strtol(optarg, &m, 0);
+            if( (nb_tasks <= 1) || (m[0] != '\0') ) {
+                fprintf(stderr, "%s: %s\n", argv[0], "invalid -t value");
+                exit(1);
+            }
+            break;
+        case 'o':
+            nb_ops = strtol(optarg, &m, 0);
+            if( (nb_ops <= 0) || (m[0] != '\0') ) {
+                fprintf(stderr, "%s: %s\n", argv[0], "invalid -o value");
+                exit(1);
+            }
+            break;
+        case 's':
+            buffer_size = strtol(optarg, &m, 0);
+            if( (buffer_size <= 0) || (m[0] != '\0') ) {
+                fprintf(stderr, "%s: %s\n", argv[0], "invalid -s value");
+                exit(1);
+            }
+            break;
+        case 'q':
+            heaps_per_thread = strtol(optarg, &m, 0);
+            if( (heaps_per_thread <= 0) || (m[0] != '\0') ) {
+                fprintf(stderr, "%s: %s\n", argv[0], "invalid -q value");
+                exit(1);
+            }
+            break;
+        case 'p':
+            nb_levels = strtol(optarg, &m, 0);
+            if( (nb_levels <= 0) || (m[0] != '\0') ) {
+                fprintf(stderr, "%s: %s\n", argv[0], "invalid -p value");
+                exit(1);
+            }
+            break;
+        case 'i':
+            impl_min = impl_max = strtol(optarg, &m, 0);
+            if( (impl_min < 0) || (impl_min > 1) || (m[0] != '\0') ) {
+                fprintf(stderr, "%s: %s\n", argv[0], "invalid -i value");
+                exit(1);
+            }
+            break;
+        case 'h':
+        case '?':
+        default:
+            fprintf(stderr,
+                    "Usage: %s [-M maxthreads][-t tasks per thread][-o operations per thread]\n"
+                    "          [-s size of the bounded buffer (256)][-q heaps per thread of the MultiQueue (2)]\n"
+                    "          [-p number of priorities (1024)]\n"
+                    "          [-i 0|1 (only run the bounded buffer / MultiQueue)]\n", argv[0]);
+            exit(1);
+        }
+    }
+
+    threads = calloc(maxthreads, sizeof(pthread_t));
+    params = calloc(maxthreads, sizeof(param_t));
+    for(e = 0; e < maxthreads; e++) {
+        params[e].tasks = calloc(nb_tasks, sizeof(bench_task_t));
+    }
+
+    printf("#impl threads tasks/thread ops/thread time(s) Mops/s\n");
+    for(impl = impl_min; impl <= impl_max; impl++) {
+        for(nbthreads = 1; nbthreads <= maxthreads; nbthreads++) {
+            if( IMPL_HBBUFFER == impl ) {
+                PARSEC_OBJ_CONSTRUCT(&overflow, parsec_dequeue_t);
+                hbbuffer = parsec_hbbuffer_new(buffer_size, 1, push_in_overflow, &overflow);
+            } else {
+                PARSEC_OBJ_CONSTRUCT(&multiqueue, parsec_multiqueue_t);
+                parsec_multiqueue_init(&multiqueue, parsec_execution_context_priority_comparator,
+                                       heaps_per_thread * nbthreads);
+            }
+            parsec_barrier_init(&barrier, NULL, nbthreads);
+            for(e = 0; e < nbthreads; e++) {
+                params[e].id = e;
+                params[e].impl = impl;
+                params[e].nb_tasks = nb_tasks;
+                params[e].nb_ops = nb_ops;
+                params[e].nb_levels = nb_levels;
+                params[e].errors = 0;
+            }
+            for(e = 1; e < nbthreads; e++) {
+                pthread_create(&threads[e], NULL, do_bench, &params[e]);
+            }
+            maxtime = (uint64_t)(uintptr_t)do_bench(&params[0]);
+            for(e = 1; e < nbthreads; e++) {
+                void *retval;
+                pthread_join(threads[e], &retval);
+                t = (uint64_t)(uintptr_t)retval;
+                if( t > maxtime ) maxtime = t;
+            }
+            for(e = 0; e < nbthreads; e++) {
+                errors += params[e].errors;
+            }
+            parsec_barrier_destroy(&barrier);
+            if( IMPL_HBBUFFER == impl ) {
+                parsec_hbbuffer_destruct(hbbuffer);
+                PARSEC_OBJ_DESTRUCT(&overflow);
+            } else {
+                PARSEC_OBJ_DESTRUCT(&multiqueue);
+            }
+            printf("%s %d %d %d %g %g\n", IMPL_HBBUFFER == impl ? "hbbuffer" : "multiqueue",
+                   nbthreads, nb_tasks, nb_ops, (double)maxtime / 1e9,
+                   (double)nb_ops * nbthreads / ((double)maxtime / 1e3));
+        }
+    }
+    printf("#relaxation: average priority levels below the best popped task, with %d heaps: %g\n",
+           heaps_per_thread * maxthreads,
+           relaxation(heaps_per_thread * maxthreads, nb_tasks, nb_levels));
+
+    for(e = 0; e < maxthreads; e++) {
+        free(params[e].tasks);
+    }
+    free(params);
+    free(threads);
+    parsec_mca_param_finalize();
+    parsec_hwloc_fini();
+    parsec_debug_fini();
+
+    if( errors ) {
+        fprintf(stderr, "%d errors detected\n", errors);
+        return 1;
+    }
+    return 0;
+}
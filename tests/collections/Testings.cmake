@@ -1,5 +1,9 @@
 
 parsec_addtest_cmd(collections/reduce ${SHM_TEST_CMD_LIST} collections/reduce)
+parsec_addtest_cmd(collections/matrix_io ${SHM_TEST_CMD_LIST} collections/matrix_io)
+if( MPI_C_FOUND )
+  parsec_addtest_cmd(collections/matrix_io:mp ${MPI_TEST_CMD_LIST} 4 collections/matrix_io)
+endif( MPI_C_FOUND )
 
 if( MPI_C_FOUND )
     parsec_addtest_cmd(collections/redistribute:mp ${MPI_TEST_CMD_LIST} 8 collections/redistribute/testing_redistribute -M 2400 -N 2400 -a 2400 -A 2400 -t 300 -T 300 -b 200 -B 200 -m 2000 -n 2000 -I 30 -J 40 -i 100 -j 121 -v -z -x -P 2 -Q 4 -p 4 -q 2)
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+#include "parsec/runtime.h"
+#include "parsec/execution_stream.h"
+#include "parsec/data_dist/matrix/two_dim_rectangle_cyclic.h"
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/*
+ * Write a matrix distributed on a 2D grid with one tiling, and read it back
+ * on a 1D grid with another tiling, checking that each element is where it
+ * belongs.
+ */
+
+#define MATRIX_IO_VALUE(i, j) ((double)(i) * 10000.0 + (double)(j))
+
+static int set_tile(parsec_execution_stream_t *es, const parsec_tiled_matrix_t *desc,
+                    void *tile, int uplo, int m, int n, void *args)
+{
+    double *A = (double*)tile;
+    int rows = (m == desc->mt-1) ? desc->m - m * desc->mb : desc->mb;
+    int cols = (n == desc->nt-1) ? desc->n - n * desc->nb : desc->nb;
+    (void)es; (void)uplo; (void)args;
+
+    for( int j = 0; j < cols; j++ )
+        for( int i = 0; i < rows; i++ )
+            A[j * desc->mb + i] = MATRIX_IO_VALUE(m * desc->mb + i, n * desc->nb + j);
+    return 0;
+}
+
+static int check_tile(parsec_execution_stream_t *es, const parsec_tiled_matrix_t *desc,
+                      void *tile, int uplo, int m, int n, void *args)
+{
+    double *A = (double*)tile;
+    int *errors = (int*)args;
+    int rows = (m == desc->mt-1) ? desc->m - m * desc->mb : desc->mb;
+    int cols = (n == desc->nt-1) ? desc->n - n * desc->nb : desc->nb;
+    (void)es; (void)uplo;
+
+    for( int j = 0; j < cols; j++ )
+        for( int i = 0; i < rows; i++ )
+            if( A[j * desc->mb + i] != MATRIX_IO_VALUE(m * desc->mb + i, n * desc->nb + j) ) {
+                if( 0 == parsec_atomic_fetch_inc_int32(errors) )
+                    fprintf(stderr, "Tile (%d, %d) element (%d, %d) is %g instead of %g\n", m, n, i, j,
+                            A[j * desc->mb + i], MATRIX_IO_VALUE(m * desc->mb + i, n * desc->nb + j));
+            }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    parsec_context_t* parsec;
+    parsec_matrix_block_cyclic_t dcA, dcB;
+    parsec_matrix_file_header_t header;
+    int rank = 0, world = 1, P, rc, errors = 0;
+    int M = 470, N = 330;
+    char filename[64];
+
+#if defined(PARSEC_HAVE_MPI)
+    {
+        int provided;
+        MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &provided);
+    }
+    MPI_Comm_size(MPI_COMM_WORLD, &world);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#endif
+    parsec = parsec_init(-1, &argc, &argv);
+    if( NULL == parsec ) {
+        exit(1);
+    }
+    snprintf(filename, sizeof(filename), "matrix_io_%d.bin", (int)getppid());
+
+    for( P = 1; (P+1) * (P+1) <= world; P++ );
+    while( 0 != world % P ) P--;
+    parsec_matrix_block_cyclic_init(&dcA, PARSEC_MATRIX_DOUBLE, PARSEC_MATRIX_TILE, rank,
+                                    40, 30, M, N, 0, 0, M, N, P, world / P, 1, 1, 0, 0);
+    dcA.mat = parsec_data_allocate((size_t)dcA.super.nb_local_tiles * (size_t)dcA.super.bsiz *
+                                   (size_t)parsec_datadist_getsizeoftype(dcA.super.mtype));
+    parsec_data_collection_set_key(&dcA.super.super, "A");
+
+    parsec_matrix_block_cyclic_init(&dcB, PARSEC_MATRIX_DOUBLE, PARSEC_MATRIX_TILE, rank,
+                                    25, 35, M, N, 0, 0, M, N, world, 1, 1, 1, 0, 0);
+    dcB.mat = parsec_data_allocate((size_t)dcB.super.nb_local_tiles * (size_t)dcB.super.bsiz *
+                                   (size_t)parsec_datadist_getsizeoftype(dcB.super.mtype));
+    parsec_data_collection_set_key(&dcB.super.super, "B");
+
+    rc = parsec_apply(parsec, PARSEC_MATRIX_FULL, &dcA.super, set_tile, NULL);
+    PARSEC_CHECK_ERROR(rc, "parsec_apply");
+    rc = parsec_tiled_matrix_file_write(parsec, &dcA.super, filename);
+    PARSEC_CHECK_ERROR(rc, "parsec_tiled_matrix_file_write");
+#if defined(PARSEC_HAVE_MPI)
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+
+    rc = parsec_tiled_matrix_file_header(filename, &header);
+    PARSEC_CHECK_ERROR(rc, "parsec_tiled_matrix_file_header");
+    if( (header.m != M) || (header.n != N) || (header.mb != 40) || (header.nb != 30) ||
+        (header.mtype != PARSEC_MATRIX_DOUBLE) || (header.nodes != world) ) {
+        fprintf(stderr, "Wrong header: %dx%d tiles %dx%d type %d nodes %d\n",
+                header.m, header.n, header.mb, header.nb, header.mtype, header.nodes);
+        errors++;
+    }
+
+    /* Read with another tiling and distribution, then with the same */
+    rc = parsec_tiled_matrix_file_read(parsec, &dcB.super, filename);
+    PARSEC_CHECK_ERROR(rc, "parsec_tiled_matrix_file_read");
+    rc = parsec_apply(parsec, PARSEC_MATRIX_FULL, &dcB.super, check_tile, &errors);
+    PARSEC_CHECK_ERROR(rc, "parsec_apply");
+
+    memset(dcA.mat, 0, (size_t)dcA.super.nb_local_tiles * (size_t)dcA.super.bsiz * sizeof(double));
+    rc = parsec_tiled_matrix_file_read(parsec, &dcA.super, filename);
+    PARSEC_CHECK_ERROR(rc, "parsec_tiled_matrix_file_read");
+    rc = parsec_apply(parsec, PARSEC_MATRIX_FULL, &dcA.super, check_tile, &errors);
+    PARSEC_CHECK_ERROR(rc, "parsec_apply");
+
+#if defined(PARSEC_HAVE_MPI)
+    MPI_Allreduce(MPI_IN_PLACE, &errors, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+    if( 0 == rank ) {
+        unlink(filename);
+        printf("%s: %d errors\n", 0 == errors ? "SUCCESS" : "FAILURE", errors);
+    }
+
+    parsec_data_free(dcA.mat);
+    parsec_tiled_matrix_destroy(&dcA.super);
+    parsec_data_free(dcB.mat);
+    parsec_tiled_matrix_destroy(&dcB.super);
+
+    parsec_fini(&parsec);
+#if defined(PARSEC_HAVE_MPI)
+    MPI_Finalize();
+#endif
+    return (0 == errors) ? 0 : 1;
+}
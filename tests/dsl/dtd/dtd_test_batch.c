@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+/* parsec things */
+#include "parsec/runtime.h"
+
+/* system and io */
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "tests/tests_data.h"
+#include "parsec/data_dist/matrix/two_dim_rectangle_cyclic.h"
+#include "parsec/interfaces/dtd/insert_function_internal.h"
+#include "parsec/utils/debug.h"
+
+#if defined(PARSEC_HAVE_STRING_H)
+#include <string.h>
+#endif  /* defined(PARSEC_HAVE_STRING_H) */
+
+#if defined(PARSEC_HAVE_MPI)
+#include <mpi.h>
+#endif  /* defined(PARSEC_HAVE_MPI) */
+
+/*
+ * The tasks of each step are inserted in batches of a single task class:
+ * first several rounds of additions on every tile, which are INOUT chains
+ * interleaved in the same batch, then a propagation from each tile to the
+ * next one, where each task reads the tile written by the previous task of
+ * the batch. The tiles are distributed over the processes, so the
+ * propagation reads remote tiles, and the data are flushed in the middle of
+ * the steps, so the following batches work on new tiles. The tiles must
+ * hold the result of the same operations done sequentially.
+ */
+
+/* IDs for the Arena Datatypes */
+static int TILE_FULL;
+
+int
+task_add( parsec_execution_stream_t *es,
+          parsec_task_t *this_task )
+{
+    (void)es;
+    double value, *x;
+
+    parsec_dtd_unpack_args(this_task, &value, &x);
+    x[0] += value;
+
+    return PARSEC_HOOK_RETURN_DONE;
+}
+
+int
+task_propagate( parsec_execution_stream_t *es,
+                parsec_task_t *this_task )
+{
+    (void)es;
+    double *x, *y;
+
+    parsec_dtd_unpack_args(this_task, &x, &y);
+    y[0] += 0.5 * x[0];
+
+    return PARSEC_HOOK_RETURN_DONE;
+}
+
+int main(int argc, char ** argv)
+{
+    parsec_context_t* parsec;
+    int rank = 0, world = 1, cores = -1, rc;
+    int nt = 200, nb_rounds = 4, nb_steps = 10, nb_errors = 0;
+    int s, r, k, t;
+    parsec_tiled_matrix_t *dcA;
+    parsec_data_collection_t *A;
+    parsec_arena_datatype_t *adt;
+    parsec_taskpool_t *dtd_tp;
+    parsec_task_class_t *add_tc, *propagate_tc;
+    double *expected, *values, *x;
+    void **args;
+    int add_flags[2], propagate_flags[2];
+
+#if defined(PARSEC_HAVE_MPI)
+    {
+        int provided;
+        MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &provided);
+    }
+    MPI_Comm_size(MPI_COMM_WORLD, &world);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#endif
+
+    if(argv[1] != NULL){
+        cores = atoi(argv[1]);
+    }
+
+    parsec = parsec_init( cores, &argc, &argv );
+
+    adt = parsec_dtd_create_arena_datatype(parsec, &TILE_FULL);
+    parsec_add2arena_rect( adt,
+                           parsec_datatype_double_t,
+                           1, 1, 1);
+
+    dcA = create_and_distribute_data(rank, world, 1, nt);
+    memset(((parsec_matrix_block_cyclic_t *)dcA)->mat,
+           0,
+           (size_t)dcA->nb_local_tiles *
+           (size_t)dcA->bsiz *
+           (size_t)parsec_datadist_getsizeoftype(dcA->mtype));
+    parsec_data_collection_set_key((parsec_data_collection_t *)dcA, "A");
+    A = (parsec_data_collection_t *)dcA;
+    parsec_dtd_data_collection_init(A);
+
+    expected = (double *)calloc(nt, sizeof(double));
+    for( s = 0; s < nb_steps; s++ ) {
+        for( r = 0; r < nb_rounds; r++ ) {
+            for( k = 0; k < nt; k++ ) {
+                expected[k] += (double)(s * nb_rounds + r + 1);
+            }
+        }
+        for( k = 1; k < nt; k++ ) {
+            expected[k] += 0.5 * expected[k - 1];
+        }
+    }
+
+    dtd_tp = parsec_dtd_taskpool_new();
+    rc = parsec_context_add_taskpool( parsec, dtd_tp );
+    PARSEC_CHECK_ERROR(rc, "parsec_context_add_taskpool");
+    rc = parsec_context_start(parsec);
+    PARSEC_CHECK_ERROR(rc, "parsec_context_start");
+
+    add_tc = parsec_dtd_create_task_class(dtd_tp, "Add",
+                                          sizeof(double), PARSEC_VALUE,
+                                          PASSED_BY_REF, PARSEC_INOUT,
+                                          PARSEC_DTD_ARG_END);
+    parsec_dtd_task_class_add_chore(dtd_tp, add_tc, PARSEC_DEV_CPU, task_add);
+    propagate_tc = parsec_dtd_create_task_class(dtd_tp, "Propagate",
+                                                PASSED_BY_REF, PARSEC_INPUT,
+                                                PASSED_BY_REF, PARSEC_INOUT,
+                                                PARSEC_DTD_ARG_END);
+    parsec_dtd_task_class_add_chore(dtd_tp, propagate_tc, PARSEC_DEV_CPU, task_propagate);
+
+    /* The tasks run where the tile they write is */
+    add_flags[0] = 0;
+    add_flags[1] = TILE_FULL | PARSEC_AFFINITY;
+    propagate_flags[0] = TILE_FULL;
+    propagate_flags[1] = TILE_FULL | PARSEC_AFFINITY;
+
+    values = (double *)malloc(nb_rounds * nt * sizeof(double));
+    args = (void **)malloc(2 * nb_rounds * nt * sizeof(void *));
+
+    for( s = 0; s < nb_steps; s++ ) {
+        if( nb_steps / 2 == s ) {
+            /* the following batches find new tiles */
+            parsec_dtd_data_flush_all( dtd_tp, A );
+            rc = parsec_taskpool_wait( dtd_tp );
+            PARSEC_CHECK_ERROR(rc, "parsec_taskpool_wait");
+        }
+
+        for( r = 0, t = 0; r < nb_rounds; r++ ) {
+            for( k = 0; k < nt; k++, t++ ) {
+                values[t] = (double)(s * nb_rounds + r + 1);
+                args[2 * t]     = &values[t];
+                args[2 * t + 1] = PARSEC_DTD_TILE_OF_KEY(A, A->data_key(A, k, 0));
+            }
+        }
+        parsec_dtd_insert_tasks_with_task_class(dtd_tp, add_tc, PARSEC_DEV_CPU,
+                                                t, NULL, add_flags, args);
+
+        for( k = 1, t = 0; k < nt; k++, t++ ) {
+            args[2 * t]     = PARSEC_DTD_TILE_OF_KEY(A, A->data_key(A, k - 1, 0));
+            args[2 * t + 1] = PARSEC_DTD_TILE_OF_KEY(A, A->data_key(A, k, 0));
+        }
+        parsec_dtd_insert_tasks_with_task_class(dtd_tp, propagate_tc, PARSEC_DEV_CPU,
+                                                t, NULL, propagate_flags, args);
+    }
+
+    parsec_dtd_data_flush_all( dtd_tp, A );
+    rc = parsec_taskpool_wait( dtd_tp );
+    PARSEC_CHECK_ERROR(rc, "parsec_taskpool_wait");
+
+    for( k = 0; k < nt; k++ ) {
+        parsec_data_key_t key = A->data_key(A, k, 0);
+        if( A->rank_of_key(A, key) != (uint32_t)rank )
+            continue;
+        x = (double *)parsec_data_copy_get_ptr(parsec_data_get_copy(A->data_of_key(A, key), 0));
+        if( x[0] != expected[k] ) {
+            parsec_warning("Tile %d is %g instead of %g\n", k, x[0], expected[k]);
+            nb_errors++;
+        }
+    }
+
+    parsec_dtd_task_class_release(dtd_tp, add_tc);
+    parsec_dtd_task_class_release(dtd_tp, propagate_tc);
+    parsec_taskpool_free( dtd_tp );
+
+    rc = parsec_context_wait(parsec);
+    PARSEC_CHECK_ERROR(rc, "parsec_context_wait");
+
+    if( 0 != nb_errors ) {
+        parsec_fatal("%d tiles do not hold the result of the batches\n", nb_errors);
+    }
+    parsec_output(0, "Batches of %d steps on %d tiles passed\n", nb_steps, nt);
+
+    free(args);
+    free(values);
+    free(expected);
+
+    parsec_dtd_data_collection_fini( A );
+    free_data(dcA);
+
+    parsec_del2arena(adt);
+    PARSEC_OBJ_RELEASE(adt->arena);
+    parsec_dtd_destroy_arena_datatype(parsec, TILE_FULL);
+
+    parsec_fini(&parsec);
+
+#ifdef PARSEC_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return EXIT_SUCCESS;
+}
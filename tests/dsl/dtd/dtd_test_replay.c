@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+/* parsec things */
+#include "parsec/runtime.h"
+
+/* system and io */
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "tests/tests_data.h"
+#include "parsec/data_dist/matrix/two_dim_rectangle_cyclic.h"
+#include "tests/tests_timing.h"
+#include "parsec/interfaces/dtd/insert_function_internal.h"
+#include "parsec/utils/debug.h"
+
+#if defined(PARSEC_HAVE_STRING_H)
+#include <string.h>
+#endif  /* defined(PARSEC_HAVE_STRING_H) */
+
+#if defined(PARSEC_HAVE_MPI)
+#include <mpi.h>
+#endif  /* defined(PARSEC_HAVE_MPI) */
+
+/*
+ * An iterative algorithm inserts the same tasks at each iteration: add the
+ * iteration number to each tile, then add half of the previous tile to
+ * each tile. The iterations are inserted one task at a time, or the first
+ * one is recorded and replayed for the others; both must give the result
+ * of the same operations done sequentially. The data are flushed in the
+ * middle of the replays, so the replayed tasks find their new tiles.
+ */
+
+double time_elapsed = 0.0;
+double sync_time_elapsed = 0.0;
+
+int
+task_add( parsec_execution_stream_t *es,
+          parsec_task_t *this_task )
+{
+    (void)es;
+    double value, *x;
+
+    parsec_dtd_unpack_args(this_task, &value, &x);
+    x[0] += value;
+
+    return PARSEC_HOOK_RETURN_DONE;
+}
+
+int
+task_propagate( parsec_execution_stream_t *es,
+                parsec_task_t *this_task )
+{
+    (void)es;
+    double *x, *y;
+
+    parsec_dtd_unpack_args(this_task, &x, &y);
+    y[0] += 0.5 * x[0];
+
+    return PARSEC_HOOK_RETURN_DONE;
+}
+
+/* The add tasks are the first and the odd tasks of an iteration */
+static void
+update_iteration( int task_index, int nb_params, void **values, void *cb_data )
+{
+    (void)nb_params;
+    if( 0 == task_index || 1 == task_index % 2 ) {
+        *(double *)values[0] = *(double *)cb_data;
+    }
+}
+
+static void
+insert_iteration( parsec_taskpool_t *dtd_tp, parsec_task_class_t *add_tc,
+                  parsec_data_collection_t *A, int nt, double value )
+{
+    int k;
+
+    for( k = 0; k < nt; k++ ) {
+        parsec_dtd_insert_task_with_task_class(dtd_tp, add_tc, 0, PARSEC_DEV_CPU,
+                                               PARSEC_DTD_EMPTY_FLAG, &value,
+                                               PARSEC_DTD_EMPTY_FLAG, PARSEC_DTD_TILE_OF_KEY(A, k),
+                                               PARSEC_DTD_ARG_END);
+        if( k > 0 ) {
+            parsec_dtd_insert_task(dtd_tp, task_propagate, 0, PARSEC_DEV_CPU, "Propagate",
+                                   PASSED_BY_REF, PARSEC_DTD_TILE_OF_KEY(A, k - 1), PARSEC_INPUT,
+                                   PASSED_BY_REF, PARSEC_DTD_TILE_OF_KEY(A, k), PARSEC_INOUT,
+                                   PARSEC_DTD_ARG_END);
+        }
+    }
+}
+
+static void
+run( parsec_context_t *parsec, parsec_matrix_block_cyclic_t *dcA, int replay,
+     int nt, int nb_iterations, const double *expected )
+{
+    parsec_data_collection_t *A = (parsec_data_collection_t *)dcA;
+    double *x = (double *)dcA->mat;
+    parsec_dtd_graph_t *graph = NULL;
+    parsec_taskpool_t *dtd_tp;
+    parsec_task_class_t *add_tc;
+    double value, start, insert_time = 0.0;
+    int i, k, rc;
+
+    /* complex double tiles of a single element */
+    memset(x, 0, nt * dcA->super.bsiz * parsec_datadist_getsizeoftype(dcA->super.mtype));
+
+    dtd_tp = parsec_dtd_taskpool_new();
+    rc = parsec_context_add_taskpool( parsec, dtd_tp );
+    PARSEC_CHECK_ERROR(rc, "parsec_context_add_taskpool");
+
+    add_tc = parsec_dtd_create_task_class(dtd_tp, "Add",
+                                          sizeof(double), PARSEC_VALUE,
+                                          PASSED_BY_REF, PARSEC_INOUT,
+                                          PARSEC_DTD_ARG_END);
+    parsec_dtd_task_class_add_chore(dtd_tp, add_tc, PARSEC_DEV_CPU, task_add);
+
+    TIME_START();
+    for( i = 0; i < nb_iterations; i++ ) {
+        value = (double)(i + 1);
+        if( !replay ) {
+            start = get_cur_time();
+            insert_iteration(dtd_tp, add_tc, A, nt, value);
+            /* the first iteration is recorded in the other run */
+            if( 0 < i ) insert_time += get_cur_time() - start;
+            continue;
+        }
+        if( 0 == i ) {
+            graph = parsec_dtd_graph_new();
+            rc = parsec_dtd_graph_record_start(dtd_tp, graph);
+            PARSEC_CHECK_ERROR(rc, "parsec_dtd_graph_record_start");
+            insert_iteration(dtd_tp, add_tc, A, nt, value);
+            rc = parsec_dtd_graph_record_stop(dtd_tp);
+            PARSEC_CHECK_ERROR(rc, "parsec_dtd_graph_record_stop");
+            if( parsec_dtd_graph_nb_tasks(graph) != 2 * nt - 1 ) {
+                parsec_fatal("Recorded %d tasks instead of %d\n", parsec_dtd_graph_nb_tasks(graph), 2 * nt - 1);
+            }
+            continue;
+        }
+        if( nb_iterations / 2 == i ) {
+            /* the tiles of the graph are released */
+            parsec_dtd_data_flush_all( dtd_tp, A );
+            rc = parsec_taskpool_wait( dtd_tp );
+            PARSEC_CHECK_ERROR(rc, "parsec_taskpool_wait");
+        }
+        start = get_cur_time();
+        rc = parsec_dtd_graph_replay(dtd_tp, graph, update_iteration, &value);
+        insert_time += get_cur_time() - start;
+        PARSEC_CHECK_ERROR(rc, "parsec_dtd_graph_replay");
+    }
+    parsec_dtd_data_flush_all( dtd_tp, A );
+    rc = parsec_taskpool_wait( dtd_tp );
+    PARSEC_CHECK_ERROR(rc, "parsec_taskpool_wait");
+    TIME_STOP();
+
+    /* the inserting thread also runs tasks once the window is full */
+    parsec_output(0, "%8s: %d iterations of %d tasks in %g s (%g tasks/s), the last %d inserted at %g tasks/s\n",
+                  replay ? "replayed" : "inserted", nb_iterations, 2 * nt - 1, time_elapsed,
+                  (double)nb_iterations * (2 * nt - 1) / time_elapsed, nb_iterations - 1,
+                  (double)(nb_iterations - 1) * (2 * nt - 1) / insert_time);
+
+    for( k = 0; k < nt; k++ ) {
+        if( x[2 * k] != expected[k] ) {
+            parsec_fatal("Tile %d is %g instead of %g when the iterations are %s\n",
+                         k, x[2 * k], expected[k], replay ? "replayed" : "inserted");
+        }
+    }
+
+    /* the graph retains its task classes until it is freed */
+    parsec_dtd_task_class_release(dtd_tp, add_tc);
+    parsec_dtd_graph_free(graph);
+    parsec_taskpool_free( dtd_tp );
+}
+
+int main(int argc, char ** argv)
+{
+    parsec_context_t* parsec;
+    int rank = 0, world = 1, cores = -1, rc;
+    int nt = 1000, nb_iterations = 20, i, k;
+    parsec_matrix_block_cyclic_t *dcA;
+    double *expected;
+
+#if defined(PARSEC_HAVE_MPI)
+    {
+        int provided;
+        MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &provided);
+    }
+    MPI_Comm_size(MPI_COMM_WORLD, &world);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#endif
+
+    if( world != 1 ) {
+        parsec_fatal( "Nope! world is not right, we need exactly one MPI process. "
+                      "Try with \"mpirun -np 1 .....\"\n" );
+    }
+
+    /* cores [nt [iterations]]: compare the insertion and the replay rates */
+    if(argv[1] != NULL){
+        cores = atoi(argv[1]);
+        if(argv[2] != NULL){
+            nt = atoi(argv[2]);
+            if(argv[3] != NULL){
+                nb_iterations = atoi(argv[3]);
+            }
+        }
+    }
+
+    parsec = parsec_init( cores, &argc, &argv );
+    rc = parsec_context_start( parsec );
+    PARSEC_CHECK_ERROR(rc, "parsec_context_start");
+
+    expected = (double *)calloc(nt, sizeof(double));
+    for( i = 0; i < nb_iterations; i++ ) {
+        for( k = 0; k < nt; k++ ) {
+            expected[k] += (double)(i + 1);
+            if( k > 0 ) {
+                expected[k] += 0.5 * expected[k - 1];
+            }
+        }
+    }
+
+    dcA = (parsec_matrix_block_cyclic_t *)create_and_distribute_data(rank, world, 1, nt);
+    parsec_data_collection_set_key((parsec_data_collection_t *)dcA, "A");
+    parsec_dtd_data_collection_init((parsec_data_collection_t *)dcA);
+
+    run(parsec, dcA, 0, nt, nb_iterations, expected);
+    run(parsec, dcA, 1, nt, nb_iterations, expected);
+
+    parsec_dtd_data_collection_fini((parsec_data_collection_t *)dcA);
+    free_data((parsec_tiled_matrix_t *)dcA);
+    free(expected);
+
+    rc = parsec_context_wait(parsec);
+    PARSEC_CHECK_ERROR(rc, "parsec_context_wait");
+    parsec_fini(&parsec);
+
+#ifdef PARSEC_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return EXIT_SUCCESS;
+}
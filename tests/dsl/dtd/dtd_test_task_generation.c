@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2023 The University of Tennessee and The University
+ * Copyright (c) 2017-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  */
@@ -12,6 +12,7 @@
 #include <stdio.h>
 
 #include "tests/tests_data.h"
+#include "parsec/data_dist/matrix/two_dim_rectangle_cyclic.h"
 #include "tests/tests_timing.h"
 #include "parsec/interfaces/dtd/insert_function_internal.h"
 #include "parsec/utils/debug.h"
@@ -115,6 +116,80 @@ task_to_check_overhead_15(parsec_execution_stream_t *es, parsec_task_t *this_tas
     return PARSEC_HOOK_RETURN_DONE;
 }
 
+int
+task_to_increment(parsec_execution_stream_t *es, parsec_task_t *this_task)
+{
+    (void)es;
+    double *data, *next;
+
+    parsec_dtd_unpack_args(this_task, &data, &next);
+    /* Not atomic: the accesses to the data must be serialized */
+    data[0] += 1.0;
+    next[0] += 1.0;
+
+    return PARSEC_HOOK_RETURN_DONE;
+}
+
+int
+task_to_generate_tasks(parsec_execution_stream_t *es, parsec_task_t *this_task)
+{
+    (void)es;
+    parsec_taskpool_t *dtd_tp = this_task->taskpool;
+    parsec_data_collection_t *A;
+    int first, count, nb_keys, increment, flows = 1, k;
+
+    parsec_dtd_unpack_args(this_task, &A, &first, &count, &nb_keys, &increment);
+
+    for( k = first; k < first + count; k++ ) {
+        if( increment ) {
+            /* 2 flows: the inserters race to set up both flows of the class */
+            parsec_dtd_insert_task(dtd_tp, task_to_increment, 0, PARSEC_DEV_CPU, "task_to_increment",
+                                   PASSED_BY_REF, PARSEC_DTD_TILE_OF_KEY(A, k % nb_keys), PARSEC_INOUT,
+                                   PASSED_BY_REF, PARSEC_DTD_TILE_OF_KEY(A, (k + 1) % nb_keys), PARSEC_INOUT,
+                                   PARSEC_DTD_ARG_END);
+        } else {
+            parsec_dtd_insert_task(dtd_tp, task_to_check_overhead_1, 0, PARSEC_DEV_CPU, "task_for_timing_overhead",
+                                   sizeof(int), &flows, PARSEC_VALUE,
+                                   PASSED_BY_REF, PARSEC_DTD_TILE_OF_KEY(A, k % nb_keys), PARSEC_INOUT,
+                                   PARSEC_DTD_ARG_END);
+        }
+    }
+
+    return PARSEC_HOOK_RETURN_DONE;
+}
+
+/* Insert total_tasks tasks on the nb_keys first tiles of A from nb_inserters
+ * tasks executed concurrently */
+static void
+insert_concurrently(parsec_context_t *parsec, parsec_data_collection_t *A, int nb_inserters,
+                    int total_tasks, int nb_keys, int increment)
+{
+    parsec_taskpool_t *dtd_tp = parsec_dtd_taskpool_new();
+    int i, first, count, rc;
+
+    rc = parsec_context_add_taskpool( parsec, dtd_tp );
+    PARSEC_CHECK_ERROR(rc, "parsec_context_add_taskpool");
+
+    for( i = 0, first = 0; i < nb_inserters; i++, first += count ) {
+        count = total_tasks / nb_inserters + (i < total_tasks % nb_inserters);
+        parsec_dtd_insert_task(dtd_tp, task_to_generate_tasks, 0, PARSEC_DEV_CPU, "task_to_generate_tasks",
+                               sizeof(parsec_data_collection_t*), &A, PARSEC_VALUE,
+                               sizeof(int), &first, PARSEC_VALUE,
+                               sizeof(int), &count, PARSEC_VALUE,
+                               sizeof(int), &nb_keys, PARSEC_VALUE,
+                               sizeof(int), &increment, PARSEC_VALUE,
+                               PARSEC_DTD_ARG_END);
+    }
+    /* the data can only be flushed once the inserters are done */
+    rc = parsec_taskpool_wait( dtd_tp );
+    PARSEC_CHECK_ERROR(rc, "parsec_taskpool_wait");
+    parsec_dtd_data_flush_all( dtd_tp, A );
+
+    rc = parsec_taskpool_wait( dtd_tp );
+    PARSEC_CHECK_ERROR(rc, "parsec_taskpool_wait");
+    parsec_taskpool_free( dtd_tp );
+}
+
 int main(int argc, char ** argv)
 {
     parsec_context_t* parsec;
@@ -187,6 +262,70 @@ int main(int argc, char ** argv)
     /****** End of checking task generation ******/
 
 
+    /****** Checking concurrent task generation ******/
+    int nb_inserters, cores_in_use = parsec_context_query(parsec, PARSEC_CONTEXT_QUERY_CORES);
+    int nb_keys = 4, tmp_window_size, tmp_threshold_size;
+    parsec_matrix_block_cyclic_t *dcB;
+    total_tasks = 10000;
+
+    if( 0 == rank ) {
+        parsec_output( 0, "\nChecking concurrent task generation. Up to %d tasks insert %d tasks "
+                       "incrementing 2 of %d shared data, and the data must be incremented %d times.\n\n",
+                       cores_in_use, total_tasks, nb_keys, 2 * total_tasks );
+    }
+
+    dcB = (parsec_matrix_block_cyclic_t *)create_and_distribute_data(rank, world, 1, nb_keys);
+    parsec_data_collection_set_key((parsec_data_collection_t *)dcB, "B");
+    parsec_dtd_data_collection_init((parsec_data_collection_t *)dcB);
+
+    for( nb_inserters = 1; nb_inserters <= cores_in_use; nb_inserters *= 2 ) {
+        double *B = (double*)dcB->mat;
+        memset(B, 0, nb_keys * dcB->super.bsiz * parsec_datadist_getsizeoftype(dcB->super.mtype));
+
+        insert_concurrently(parsec, (parsec_data_collection_t *)dcB, nb_inserters, total_tasks, nb_keys, 1);
+
+        for( j = 0, i = 0; j < nb_keys; j++ ) {
+            /* complex double tiles of a single element */
+            i += (int)B[2 * j];
+        }
+        if( i != 2 * total_tasks ) {
+            parsec_fatal( "Something is wrong, %d inserters incremented the data %d times instead of %d\n",
+                          nb_inserters, i, 2 * total_tasks );
+        }
+    }
+    parsec_dtd_data_collection_fini((parsec_data_collection_t *)dcB);
+    free_data((parsec_tiled_matrix_t *)dcB);
+
+    /* The inserters are tasks: do not let them block each other on the window */
+    tmp_window_size    = parsec_dtd_window_size;
+    tmp_threshold_size = parsec_dtd_threshold_size;
+    total_tasks = 100000;
+    parsec_dtd_window_size    = total_tasks;
+    parsec_dtd_threshold_size = total_tasks;
+
+    if( 0 == rank ) {
+        parsec_output( 0, "\nChecking time of inserting tasks concurrently. We insert %d independent tasks "
+                       "with 1 flow using an increasing number of inserting tasks.\n\n", total_tasks );
+    }
+
+    dcA = create_and_distribute_empty_data(rank, world, 1, total_tasks);
+    parsec_data_collection_set_key((parsec_data_collection_t *)dcA, "A");
+    parsec_dtd_data_collection_init((parsec_data_collection_t *)dcA);
+
+    for( nb_inserters = 1; nb_inserters <= cores_in_use; nb_inserters *= 2 ) {
+        SYNC_TIME_START();
+        insert_concurrently(parsec, (parsec_data_collection_t *)dcA, nb_inserters, total_tasks, total_tasks, 0);
+        SYNC_TIME_PRINT(rank, ("\tNo of inserters : %d \tTasks per second : %lf\n\n",
+                               nb_inserters, total_tasks/sync_time_elapsed));
+    }
+    parsec_dtd_data_collection_fini((parsec_data_collection_t *)dcA);
+    free_data(dcA);
+
+    parsec_dtd_window_size    = tmp_window_size;
+    parsec_dtd_threshold_size = tmp_threshold_size;
+    /****** End of checking concurrent task generation ******/
+
+
     /***** Start of timing overhead of task generation ******/
     int total_flows[6] = {1, 2, 3, 5, 10, 15};
     //int total_flows[6] = {1, 0, 0, 0, 0, 0};
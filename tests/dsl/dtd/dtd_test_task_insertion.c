@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2024 The University of Tennessee and The University
+ * Copyright (c) 2017-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  */
@@ -212,6 +212,60 @@ int main(int argc, char ** argv)
     }
     /****** END ******/
 
+    /****** Inserting tasks of a task class one at a time, and by arrays ******/
+    if( rank == 0 ) {
+        parsec_output( 0, "\nWe now insert %d tasks of a task class using the main thread, "
+                       "first one at a time and then with a single call\n\n", no_of_tasks );
+    }
+
+    parsec_task_class_t *tc = parsec_dtd_create_task_class(dtd_tp, "Test_Task",
+                                                           sizeof(int), PARSEC_VALUE,
+                                                           PARSEC_DTD_ARG_END);
+    parsec_dtd_task_class_add_chore(dtd_tp, tc, PARSEC_DEV_CPU, test_task);
+    void **args = (void**)malloc(no_of_tasks * sizeof(void*));
+
+    for( n = 0; n < 3; n++ ) {
+        count = 0;
+
+        TIME_START();
+
+        for( m = 0; m < no_of_tasks; m++ ) {
+            parsec_dtd_insert_task_with_task_class(dtd_tp, tc, 0, PARSEC_DEV_CPU,
+                                                   PARSEC_DTD_EMPTY_FLAG, &amount_of_work[n],
+                                                   PARSEC_DTD_ARG_END);
+        }
+
+        rc = parsec_taskpool_wait( dtd_tp );
+        PARSEC_CHECK_ERROR(rc, "parsec_taskpool_wait");
+        TIME_PRINT(rank, ("Tasks executed : %d : Amount of work: %d : %g tasks/s inserted one at a time\n",
+                          count, amount_of_work[n], (double)no_of_tasks / time_elapsed));
+        if( count != no_of_tasks ) {
+            parsec_fatal("Executed %d tasks instead of %d\n", count, no_of_tasks);
+        }
+
+        count = 0;
+        for( m = 0; m < no_of_tasks; m++ ) {
+            args[m] = &amount_of_work[n];
+        }
+
+        TIME_START();
+
+        parsec_dtd_insert_tasks_with_task_class(dtd_tp, tc, PARSEC_DEV_CPU, no_of_tasks,
+                                                NULL, NULL, args);
+
+        rc = parsec_taskpool_wait( dtd_tp );
+        PARSEC_CHECK_ERROR(rc, "parsec_taskpool_wait");
+        TIME_PRINT(rank, ("Tasks executed : %d : Amount of work: %d : %g tasks/s inserted by array\n",
+                          count, amount_of_work[n], (double)no_of_tasks / time_elapsed));
+        if( count != no_of_tasks ) {
+            parsec_fatal("Executed %d tasks instead of %d\n", count, no_of_tasks);
+        }
+    }
+
+    free(args);
+    parsec_dtd_task_class_release(dtd_tp, tc);
+    /****** END ******/
+
     rc = parsec_context_wait(parsec);
     PARSEC_CHECK_ERROR(rc, "parsec_context_wait");
 
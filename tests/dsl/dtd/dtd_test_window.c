@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+/* parsec things */
+#include "parsec/runtime.h"
+
+/* system and io */
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "tests/tests_timing.h"
+#include "parsec/interfaces/dtd/insert_function_internal.h"
+#include "parsec/utils/debug.h"
+
+#if defined(PARSEC_HAVE_MPI)
+#include <mpi.h>
+#endif  /* defined(PARSEC_HAVE_MPI) */
+
+/*
+ * Insert the same independent tasks with the static and the adaptive
+ * window, and compare the throughput and the peak number of tasks held by
+ * the task mempool: the adaptive window must not hold more tasks.
+ */
+
+double time_elapsed = 0.0;
+double sync_time_elapsed = 0.0;
+
+int32_t count = 0;
+
+int
+test_task( parsec_execution_stream_t *es,
+           parsec_task_t *this_task )
+{
+    (void)es;
+    volatile int sink = 0;
+    int amount_of_work, i;
+
+    parsec_dtd_unpack_args(this_task, &amount_of_work);
+    for( i = 0; i < amount_of_work; i++ ) {
+        sink += i;
+    }
+    (void)parsec_atomic_fetch_inc_int32(&count);
+
+    return PARSEC_HOOK_RETURN_DONE;
+}
+
+static uint32_t
+run( parsec_context_t *parsec, int adaptive, int no_of_tasks, int amount_of_work )
+{
+    parsec_dtd_task_class_t *dtd_tc;
+    parsec_taskpool_t *dtd_tp;
+    parsec_task_class_t *tc;
+    uint32_t peak = 0, i;
+    int m, rc;
+
+    parsec_dtd_window_adaptive = adaptive;
+    dtd_tp = parsec_dtd_taskpool_new();
+    rc = parsec_context_add_taskpool( parsec, dtd_tp );
+    PARSEC_CHECK_ERROR(rc, "parsec_context_add_taskpool");
+
+    tc = parsec_dtd_create_task_class(dtd_tp, "Test_Task",
+                                      sizeof(int), PARSEC_VALUE,
+                                      PARSEC_DTD_ARG_END);
+    parsec_dtd_task_class_add_chore(dtd_tp, tc, PARSEC_DEV_CPU, test_task);
+
+    count = 0;
+    TIME_START();
+    for( m = 0; m < no_of_tasks; m++ ) {
+        parsec_dtd_insert_task_with_task_class(dtd_tp, tc, 0, PARSEC_DEV_CPU,
+                                               PARSEC_DTD_EMPTY_FLAG, &amount_of_work,
+                                               PARSEC_DTD_ARG_END);
+    }
+    rc = parsec_taskpool_wait( dtd_tp );
+    PARSEC_CHECK_ERROR(rc, "parsec_taskpool_wait");
+    TIME_STOP();
+
+    /* mempools never shrink: the elements they own are the peak of the tasks alive */
+    dtd_tc = (parsec_dtd_task_class_t *)tc;
+    for( i = 0; i < dtd_tc->context_mempool.nb_thread_mempools; i++ ) {
+        peak += dtd_tc->context_mempool.thread_mempools[i].nb_elt;
+    }
+
+    parsec_output(0, "%8s window: %d tasks executed in %g s (%g tasks/s), %u tasks held at most\n",
+                  adaptive ? "adaptive" : "static", count, time_elapsed,
+                  (double)no_of_tasks / time_elapsed, peak);
+    if( count != no_of_tasks ) {
+        parsec_fatal("Executed %d tasks instead of %d\n", count, no_of_tasks);
+    }
+
+    parsec_dtd_task_class_release(dtd_tp, tc);
+    parsec_taskpool_free( dtd_tp );
+    return peak;
+}
+
+int main(int argc, char ** argv)
+{
+    parsec_context_t* parsec;
+    int cores = -1, rc;
+    int no_of_tasks = 100000, amount_of_work = 1000;
+    uint32_t peak_static, peak_adaptive;
+
+#if defined(PARSEC_HAVE_MPI)
+    {
+        int provided;
+        MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &provided);
+    }
+#endif
+
+    if(argv[1] != NULL){
+        cores = atoi(argv[1]);
+    }
+
+    parsec = parsec_init( cores, &argc, &argv );
+    rc = parsec_context_start( parsec );
+    PARSEC_CHECK_ERROR(rc, "parsec_context_start");
+
+    peak_static = run(parsec, 0, no_of_tasks, amount_of_work);
+    peak_adaptive = run(parsec, 1, no_of_tasks, amount_of_work);
+
+    rc = parsec_context_wait(parsec);
+    PARSEC_CHECK_ERROR(rc, "parsec_context_wait");
+    parsec_fini(&parsec);
+
+#ifdef PARSEC_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    if( peak_adaptive > peak_static ) {
+        fprintf(stderr, "The adaptive window held %u tasks, more than the %u of the static window\n",
+                peak_adaptive, peak_static);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
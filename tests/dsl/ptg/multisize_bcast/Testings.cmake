@@ -1,4 +1,15 @@
 parsec_addtest_cmd(dsl/ptg/multisize_bcast ${SHM_TEST_CMD_LIST} dsl/ptg/multisize_bcast/check_multisize_bcast)
 if( MPI_C_FOUND )
   parsec_addtest_cmd(dsl/ptg/multisize_bcast:mp ${MPI_TEST_CMD_LIST} 4 dsl/ptg/multisize_bcast/check_multisize_bcast)
+  parsec_addtest_cmd(dsl/ptg/multisize_bcast:mp:kary ${MPI_TEST_CMD_LIST} 4 dsl/ptg/multisize_bcast/check_multisize_bcast)
+  if(TEST dsl/ptg/multisize_bcast:mp:kary)
+    set_property(TEST dsl/ptg/multisize_bcast:mp:kary APPEND PROPERTY ENVIRONMENT
+      PARSEC_MCA_runtime_comm_coll_bcast=3 PARSEC_MCA_runtime_comm_coll_bcast_arity=2)
+  endif()
+  # Emulate two nodes with two ranks each
+  parsec_addtest_cmd(dsl/ptg/multisize_bcast:mp:hierarchical ${MPI_TEST_CMD_LIST} 4 dsl/ptg/multisize_bcast/check_multisize_bcast)
+  if(TEST dsl/ptg/multisize_bcast:mp:hierarchical)
+    set_property(TEST dsl/ptg/multisize_bcast:mp:hierarchical APPEND PROPERTY ENVIRONMENT
+      PARSEC_MCA_runtime_comm_coll_bcast=4 PARSEC_MCA_runtime_comm_coll_bcast_node_size=2 PARSEC_MCA_runtime_comm_coll_bcast_arity=1)
+  endif()
 endif( MPI_C_FOUND)
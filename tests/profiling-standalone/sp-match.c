@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+#include "parsec/parsec_config.h"
+#undef PARSEC_HAVE_MPI
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <unistd.h>
+#include <sys/time.h>
+
+#include "parsec/profiling.h"
+#include "parsec/parsec_binary_profile.h"
+#include "dbpreader.h"
+
+/*
+ * Measures how fast the start events of binary profiles find their end
+ * event, as the converters do: typically on a trace generated by
+ * sp-perf -c, where all the events end in another thread.
+ */
+
+int main(int argc, char *argv[])
+{
+    dbp_multifile_reader_t *dbp;
+    const dbp_file_t *file;
+    dbp_event_iterator_t *it;
+    const dbp_event_t *e, *g;
+    struct timeval start, end, duration;
+    uint64_t nb_starts = 0, nb_matched = 0, nb_wrong = 0;
+    long long int expected = -1;
+    double seconds;
+    int opt, f, t;
+
+    while( (opt = getopt(argc, argv, "n:h?")) != -1 ) {
+        switch( opt ) {
+        case 'n':
+            expected = atoll(optarg);
+            break;
+        default:
+            fprintf(stderr, "Usage: %s [-n number of events expected to match] file1.prof ...\n", argv[0]);
+            exit(EXIT_FAILURE);
+        }
+    }
+    if( optind >= argc ) {
+        fprintf(stderr, "Usage: %s [-n number of events expected to match] file1.prof ...\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    dbp = dbp_reader_open_files(argc - optind, argv + optind);
+
+    gettimeofday(&start, NULL);
+    for( f = 0; f < dbp_reader_nb_files(dbp); f++ ) {
+        file = dbp_reader_get_file(dbp, f);
+        if( 0 != dbp_file_error(file) )
+            continue;
+        for( t = 0; t < dbp_file_nb_threads(file); t++ ) {
+            it = dbp_iterator_new_from_thread(dbp_file_get_thread(file, t));
+            for( e = dbp_iterator_current(it); NULL != e; e = dbp_iterator_next(it) ) {
+                if( !KEY_IS_START(dbp_event_get_key(e)) )
+                    continue;
+                nb_starts++;
+                if( NULL == (g = dbp_file_find_matching_event(file, e)) )
+                    continue;
+                nb_matched++;
+                if( (BASE_KEY(dbp_event_get_key(g)) != BASE_KEY(dbp_event_get_key(e))) ||
+                    (dbp_event_get_taskpool_id(g) != dbp_event_get_taskpool_id(e)) ||
+                    (dbp_event_get_event_id(g) != dbp_event_get_event_id(e)) ||
+                    (dbp_event_get_timestamp(g) < dbp_event_get_timestamp(e)) )
+                    nb_wrong++;
+            }
+            dbp_iterator_delete(it);
+        }
+    }
+    gettimeofday(&end, NULL);
+    timersub(&end, &start, &duration);
+    seconds = (double)duration.tv_sec + (double)duration.tv_usec / 1e6;
+
+    printf("%"PRIu64" start events, %"PRIu64" matched in %g s (%g events/s)\n",
+           nb_starts, nb_matched, seconds, seconds > 0.0 ? (double)nb_starts / seconds : 0.0);
+
+    dbp_reader_close_files(dbp);
+    dbp_reader_destruct(dbp);
+
+    if( nb_wrong > 0 ) {
+        fprintf(stderr, "%"PRIu64" events matched an event with another identifier, or ending before they start\n", nb_wrong);
+        exit(EXIT_FAILURE);
+    }
+    if( (expected >= 0) && ((uint64_t)expected != nb_matched) ) {
+        fprintf(stderr, "%"PRIu64" events matched, %lld expected\n", nb_matched, expected);
+        exit(EXIT_FAILURE);
+    }
+    return EXIT_SUCCESS;
+}
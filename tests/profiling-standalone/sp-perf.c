@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2021 The University of Tennessee and The University
+ * Copyright (c) 2017-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  */
@@ -28,9 +28,14 @@ typedef struct {
 } per_thread_info_t;
 
 static int event_startkey, event_endkey;
-static pthread_barrier_t barrier;
+static pthread_barrier_t barrier, cross_barrier;
 static uint32_t tasks_per_thread = 100;
 static int profiling;
+static int nbthreads = 1;
+static int cross = 0;
+
+/* In cross mode, the events are ended by the next thread, by batches */
+#define CROSS_BATCH 1000
 
 #define D 32
 static void cpuburn(double *a, double *b, double *c)
@@ -63,12 +68,25 @@ static void *run_thread(void *_arg)
     pthread_barrier_wait(&barrier); // Then we wait that all threads are ready and that the main thread has called start
     gettimeofday(&start, NULL);
 
-    for(i = 0; i < tasks_per_thread; i++) {
-        if(profiling)
-            parsec_profiling_trace_flags(ti->prof, event_startkey, i, ti->thread_index, NULL, 0);
-        cpuburn(a, b, c);
-        if(profiling)
-            parsec_profiling_trace_flags(ti->prof, event_endkey, i, ti->thread_index, NULL, 0);
+    if( cross ) {
+        /* Each thread ends the events the previous thread started before
+         * the barrier: no end event follows its start event in a thread */
+        uint32_t batch;
+        for(batch = 0; batch < tasks_per_thread; batch += CROSS_BATCH) {
+            for(i = batch; i < batch + CROSS_BATCH && i < tasks_per_thread; i++)
+                parsec_profiling_trace_flags(ti->prof, event_startkey, i, ti->thread_index, NULL, 0);
+            pthread_barrier_wait(&cross_barrier);
+            for(i = batch; i < batch + CROSS_BATCH && i < tasks_per_thread; i++)
+                parsec_profiling_trace_flags(ti->prof, event_endkey, i, (ti->thread_index + nbthreads - 1) % nbthreads, NULL, 0);
+        }
+    } else {
+        for(i = 0; i < tasks_per_thread; i++) {
+            if(profiling)
+                parsec_profiling_trace_flags(ti->prof, event_startkey, i, ti->thread_index, NULL, 0);
+            cpuburn(a, b, c);
+            if(profiling)
+                parsec_profiling_trace_flags(ti->prof, event_endkey, i, ti->thread_index, NULL, 0);
+        }
     }
 
     gettimeofday(&end, NULL);
@@ -82,14 +100,13 @@ int main(int argc, char *argv[])
 {
     int i, opt;
     per_thread_info_t *thread_info;
-    int nbthreads = 1;
     char *filename = NULL;
     int mpi_rank;
 
     MPI_Init(&argc, &argv);
     MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
 
-    while ((opt = getopt(argc, argv, "f:n:N:h?")) != -1) {
+    while ((opt = getopt(argc, argv, "f:n:N:ch?")) != -1) {
         switch (opt) {
         case 'f':
             filename = strdup(optarg);
@@ -100,8 +117,12 @@ int main(int argc, char *argv[])
         case 'N':
             tasks_per_thread = atoi(optarg);
             break;
+        case 'c':
+            cross = 1;
+            break;
         default: /* '?' */
-            fprintf(stderr, "Usage: %s [-f filename] [-n number of threads] [-N number of tasks per thread]\n",
+            fprintf(stderr, "Usage: %s [-f filename] [-n number of threads] [-N number of tasks per thread] [-c]\n"
+                    "  -c: trace the end of each event in another thread than its start (requires -f)\n",
                     argv[0]);
             exit(EXIT_FAILURE);
         }
@@ -121,7 +142,13 @@ int main(int argc, char *argv[])
         parsec_profiling_add_dictionary_keyword("Event", "#FF0000", 0, NULL, &event_startkey, &event_endkey);
     }
 
+    if( cross && !profiling ) {
+        fprintf(stderr, "-c requires a trace file (-f)\n");
+        exit(EXIT_FAILURE);
+    }
+
     pthread_barrier_init(&barrier, NULL, nbthreads+1);
+    pthread_barrier_init(&cross_barrier, NULL, nbthreads);
     thread_info = (per_thread_info_t *)calloc(nbthreads, sizeof(per_thread_info_t));
 
     for(i = 0; i < nbthreads; i++) {
@@ -57,3 +57,66 @@ if(Python_FOUND AND PARSEC_PYTHON_TOOLS AND PARSEC_PROF_TRACE AND MPI_C_FOUND)
     set_property(TEST profiling/bwd_cleanup_files PROPERTY FIXTURES_CLEANUP bwd_prof_and_dot_files;bwd_prof_and_dot_h5_files)
   endif(PARSEC_PROF_GRAPHER)
 endif(Python_FOUND AND PARSEC_PYTHON_TOOLS AND PARSEC_PROF_TRACE AND MPI_C_FOUND)
+
+if(BUILD_TOOLS AND PARSEC_PROF_TRACE)
+  # The C analyzer does not need the python tools: check its report on its own traces
+  set(DBP_ANALYZE_CHECK ${CMAKE_COMMAND} -DANALYZER=${PROJECT_BINARY_DIR}/tools/profiling/parsec-dbp-analyze)
+
+  parsec_addtest_cmd(profiling/async_analyze_generate_prof ${SHM_TEST_CMD_LIST} profiling/async 100 -- --mca profile_filename asyncan  --mca mca_pins task_profiler)
+  set_property(TEST profiling/async_analyze_generate_prof PROPERTY FIXTURES_SETUP async_analyze_prof_files)
+
+  parsec_addtest_cmd(profiling/async_analyze ${SHM_TEST_CMD_LIST} ${DBP_ANALYZE_CHECK}
+                     -DARGS=asyncan-0.prof -DRANKS=1
+                     -DCLASSES=FULL_ASYNC=100,FULL_RESCHED=1,async::ASYNC=200,async::STARTUP=1
+                     -P ${CMAKE_CURRENT_SOURCE_DIR}/profiling/check-dbp-analyze.cmake)
+  set_property(TEST profiling/async_analyze PROPERTY FIXTURES_REQUIRED async_analyze_prof_files)
+
+  parsec_addtest_cmd(profiling/async_analyze_cleanup_files ${SHM_TEST_CMD_LIST} rm -f asyncan-0.prof)
+  set_property(TEST profiling/async_analyze_cleanup_files PROPERTY FIXTURES_CLEANUP async_analyze_prof_files)
+
+  if(MPI_C_FOUND)
+    if(PARSEC_PROF_GRAPHER)
+      # The critical path of the 15 tasks of the DAG needs the DOT files
+      parsec_addtest_cmd(profiling/bw_analyze_generate_prof:mp ${MPI_TEST_CMD_LIST} 2 apps/pingpong/bw_test -n 3 -f 2 -l 2097152 -- --mca profile_filename bwan  --mca mca_pins task_profiler --mca profile_dot bwan)
+      set(BW_ANALYZE_ARGS "-DARGS=-d bwan-0.dot -d bwan-1.dot bwan-0.prof bwan-1.prof" -DDOT_TASKS=15)
+    else(PARSEC_PROF_GRAPHER)
+      parsec_addtest_cmd(profiling/bw_analyze_generate_prof:mp ${MPI_TEST_CMD_LIST} 2 apps/pingpong/bw_test -n 3 -f 2 -l 2097152 -- --mca profile_filename bwan  --mca mca_pins task_profiler)
+      set(BW_ANALYZE_ARGS "-DARGS=bwan-0.prof bwan-1.prof")
+    endif(PARSEC_PROF_GRAPHER)
+    set_property(TEST profiling/bw_analyze_generate_prof:mp PROPERTY FIXTURES_SETUP bw_analyze_prof_files)
+
+    parsec_addtest_cmd(profiling/bw_analyze ${SHM_TEST_CMD_LIST} ${DBP_ANALYZE_CHECK}
+                       ${BW_ANALYZE_ARGS} -DRANKS=2
+                       -DCLASSES=bandwidth::PING=6,bandwidth::PONG=6,bandwidth::SYNC=3
+                       -P ${CMAKE_CURRENT_SOURCE_DIR}/profiling/check-dbp-analyze.cmake)
+    set_property(TEST profiling/bw_analyze PROPERTY FIXTURES_REQUIRED bw_analyze_prof_files)
+
+    parsec_addtest_cmd(profiling/bw_analyze_cleanup_files ${SHM_TEST_CMD_LIST} rm -f bwan-0.prof bwan-1.prof bwan-0.dot bwan-1.dot)
+    set_property(TEST profiling/bw_analyze_cleanup_files PROPERTY FIXTURES_CLEANUP bw_analyze_prof_files)
+  endif(MPI_C_FOUND)
+endif(BUILD_TOOLS AND PARSEC_PROF_TRACE)
+
+if(TARGET sp-perf AND TARGET sp-match)
+  # Matching speed of events that all end in another thread than their start
+  parsec_addtest_cmd(profiling/sp_cross_generate_prof ${SHM_TEST_CMD_LIST} profiling-standalone/sp-perf -f spcross -n 4 -N 100000 -c)
+  set_property(TEST profiling/sp_cross_generate_prof PROPERTY FIXTURES_SETUP sp_cross_prof_files)
+
+  parsec_addtest_cmd(profiling/sp_cross_match ${SHM_TEST_CMD_LIST} profiling-standalone/sp-match -n 400000 spcross-0.prof)
+  set_property(TEST profiling/sp_cross_match PROPERTY FIXTURES_REQUIRED sp_cross_prof_files)
+
+  parsec_addtest_cmd(profiling/sp_cross_cleanup_files ${SHM_TEST_CMD_LIST} rm -f spcross-0.prof)
+  set_property(TEST profiling/sp_cross_cleanup_files PROPERTY FIXTURES_CLEANUP sp_cross_prof_files)
+
+  # Compressed trace, with few buffers in flight so that the writers stall,
+  # read back through dbpreader
+  parsec_addtest_cmd(profiling/sp_compress_generate_prof ${SHM_TEST_CMD_LIST} profiling-standalone/sp-perf -f spcompress -n 4 -N 100000 -c)
+  set_property(TEST profiling/sp_compress_generate_prof APPEND PROPERTY ENVIRONMENT
+    PARSEC_MCA_profile_compress=1 PARSEC_MCA_profile_compress_inflight=2)
+  set_property(TEST profiling/sp_compress_generate_prof PROPERTY FIXTURES_SETUP sp_compress_prof_files)
+
+  parsec_addtest_cmd(profiling/sp_compress_match ${SHM_TEST_CMD_LIST} profiling-standalone/sp-match -n 400000 spcompress-0.prof)
+  set_property(TEST profiling/sp_compress_match PROPERTY FIXTURES_REQUIRED sp_compress_prof_files)
+
+  parsec_addtest_cmd(profiling/sp_compress_cleanup_files ${SHM_TEST_CMD_LIST} rm -f spcompress-0.prof)
+  set_property(TEST profiling/sp_compress_cleanup_files PROPERTY FIXTURES_CLEANUP sp_compress_prof_files)
+endif(TARGET sp-perf AND TARGET sp-match)
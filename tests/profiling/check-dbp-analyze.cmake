@@ -0,0 +1,137 @@
+# Runs parsec-dbp-analyze and checks its report:
+#   cmake -DANALYZER=<parsec-dbp-analyze> "-DARGS=<arg arg ...>" -DRANKS=<n>
+#         [-DCLASSES=<name=count,...>] [-DDOT_TASKS=<n>] -P check-dbp-analyze.cmake
+# Every event must be matched, the statistics of each class of events must be
+# consistent (min <= mean <= max, total = count * mean, histogram summing to
+# the count), the classes in CLASSES must have exactly the given number of
+# events, the thread activities and overlaps must be within their spans, and
+# when DOT_TASKS is given the critical path must cover a DAG of that many
+# tasks, all found in the profiles.
+
+function(check_failed msg)
+  message(FATAL_ERROR "${msg}\nReport of ${ANALYZER} ${ARGS}:\n${report}")
+endfunction(check_failed)
+
+# Percentages are printed with 2 decimals: compare them in hundredths
+function(check_percentage value what)
+  string(REPLACE "." "" hundredths "${value}")
+  math(EXPR hundredths "${hundredths}")
+  if(hundredths GREATER 10000)
+    check_failed("${what} is ${value}%, more than its span")
+  endif()
+endfunction(check_percentage)
+
+separate_arguments(ARGS UNIX_COMMAND "${ARGS}")
+string(REPLACE "," ";" CLASSES "${CLASSES}")
+
+execute_process(COMMAND ${ANALYZER} ${ARGS}
+                RESULT_VARIABLE rc
+                OUTPUT_VARIABLE report
+                ERROR_VARIABLE errors)
+if(NOT rc EQUAL 0)
+  message(FATAL_ERROR "${ANALYZER} ${ARGS} failed (${rc}):\n${errors}")
+endif()
+message("${report}")
+
+# Brackets and semicolons would break the list of lines
+string(REPLACE ";" "," lines "${report}")
+string(REPLACE "[" "(" lines "${lines}")
+string(REPLACE "]" ")" lines "${lines}")
+string(REPLACE "\n" ";" lines "${lines}")
+
+set(nb_header 0)
+set(nb_classes 0)
+set(nb_threads 0)
+set(nb_overlaps 0)
+set(dot_found FALSE)
+set(length_found FALSE)
+set(class "")
+foreach(line IN LISTS lines)
+  if(line MATCHES "^([0-9]+) ranks, ([0-9]+) threads, ([0-9]+) events \\(([0-9]+) without a matching event\\)")
+    math(EXPR nb_header "${nb_header} + 1")
+    if(NOT CMAKE_MATCH_1 EQUAL RANKS)
+      check_failed("${CMAKE_MATCH_1} ranks reported instead of ${RANKS}")
+    endif()
+    if(CMAKE_MATCH_3 EQUAL 0)
+      check_failed("No event reported")
+    endif()
+    if(NOT CMAKE_MATCH_4 EQUAL 0)
+      check_failed("${CMAKE_MATCH_4} events without a matching event")
+    endif()
+  elseif(line MATCHES "^  (.*[^ ]) +(task|sched|comm|ignored) +([0-9]+) +([0-9]+) +([0-9]+)\\.([0-9]) +([0-9]+) +([0-9]+)$")
+    set(class "${CMAKE_MATCH_1}")
+    set(count ${CMAKE_MATCH_3})
+    set(total ${CMAKE_MATCH_4})
+    set(mean10 "${CMAKE_MATCH_5}${CMAKE_MATCH_6}")
+    set(min ${CMAKE_MATCH_7})
+    set(max ${CMAKE_MATCH_8})
+    math(EXPR nb_classes "${nb_classes} + 1")
+    set("count_${class}" ${count})
+    math(EXPR low "${min} * ${count}")
+    math(EXPR high "${max} * ${count}")
+    if(min GREATER max OR low GREATER total OR total GREATER high)
+      check_failed("${class}: total ${total} of ${count} events is not within [${min}, ${max}] per event")
+    endif()
+    # the mean is rounded to one decimal
+    math(EXPR delta "${mean10} - (${total} * 10 / ${count})")
+    if(delta LESS -1 OR delta GREATER 1)
+      check_failed("${class}: mean ${CMAKE_MATCH_5}.${CMAKE_MATCH_6} is not ${total} / ${count}")
+    endif()
+  elseif(line MATCHES "^    log2 histogram:(.*)$")
+    if("${class}" STREQUAL "")
+      check_failed("Histogram without an event class")
+    endif()
+    string(REGEX MATCHALL "2\\^[0-9]+:[0-9]+" bins "${CMAKE_MATCH_1}")
+    set(sum 0)
+    foreach(bin IN LISTS bins)
+      string(REGEX REPLACE "^2\\^[0-9]+:" "" bin "${bin}")
+      math(EXPR sum "${sum} + ${bin}")
+    endforeach()
+    if(NOT sum EQUAL count)
+      check_failed("${class}: the histogram holds ${sum} events instead of ${count}")
+    endif()
+    set(class "")
+  elseif(line MATCHES "^ +[0-9]+ +[0-9]+ +([0-9]+\\.[0-9][0-9])% +([0-9]+\\.[0-9][0-9])% +([0-9]+\\.[0-9][0-9])% +([0-9]+\\.[0-9][0-9])%  ")
+    math(EXPR nb_threads "${nb_threads} + 1")
+    check_percentage(${CMAKE_MATCH_1} "Task time")
+    check_percentage(${CMAKE_MATCH_2} "Scheduling time")
+    check_percentage(${CMAKE_MATCH_3} "Communication time")
+    check_percentage(${CMAKE_MATCH_4} "Idle time")
+  elseif(line MATCHES "^  rank [0-9]+: ([0-9]+) of ([0-9]+) \\(([0-9]+\\.[0-9][0-9])%\\)$")
+    math(EXPR nb_overlaps "${nb_overlaps} + 1")
+    if(CMAKE_MATCH_1 GREATER CMAKE_MATCH_2)
+      check_failed("${CMAKE_MATCH_1} overlapped out of ${CMAKE_MATCH_2} of communications")
+    endif()
+  elseif(line MATCHES "^Critical path \\(from [0-9]+ DOT files: ([0-9]+) tasks, ([0-9]+) of them found in the profiles\\)$")
+    set(dot_found TRUE)
+    if(DEFINED DOT_TASKS AND NOT CMAKE_MATCH_1 EQUAL DOT_TASKS)
+      check_failed("${CMAKE_MATCH_1} tasks in the DOT files instead of ${DOT_TASKS}")
+    endif()
+    if(NOT CMAKE_MATCH_2 EQUAL CMAKE_MATCH_1)
+      check_failed("Only ${CMAKE_MATCH_2} of the ${CMAKE_MATCH_1} tasks found in the profiles")
+    endif()
+  elseif(line MATCHES "^  length ([0-9]+) [a-z]+ over ([0-9]+) tasks, [0-9.]+% of the longest rank span \\(([0-9]+) [a-z]+\\)$")
+    set(length_found TRUE)
+    if(CMAKE_MATCH_2 EQUAL 0 OR CMAKE_MATCH_1 GREATER CMAKE_MATCH_3)
+      check_failed("Critical path of ${CMAKE_MATCH_1} over ${CMAKE_MATCH_2} tasks, for a span of ${CMAKE_MATCH_3}")
+    endif()
+  endif()
+endforeach()
+
+if(NOT nb_header EQUAL 1 OR nb_classes EQUAL 0 OR nb_threads EQUAL 0 OR NOT nb_overlaps EQUAL RANKS)
+  check_failed("Incomplete report: ${nb_header} summary, ${nb_classes} classes, ${nb_threads} threads, ${nb_overlaps} ranks overlaps")
+endif()
+
+foreach(expected IN LISTS CLASSES)
+  string(REGEX MATCH "^(.*)=([0-9]+)$" expected "${expected}")
+  if(NOT DEFINED "count_${CMAKE_MATCH_1}")
+    check_failed("No event of class ${CMAKE_MATCH_1}")
+  endif()
+  if(NOT count_${CMAKE_MATCH_1} EQUAL CMAKE_MATCH_2)
+    check_failed("${count_${CMAKE_MATCH_1}} events of class ${CMAKE_MATCH_1} instead of ${CMAKE_MATCH_2}")
+  endif()
+endforeach()
+
+if(DEFINED DOT_TASKS AND NOT (dot_found AND length_found))
+  check_failed("No critical path reported")
+endif()
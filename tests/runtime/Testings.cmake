@@ -1,2 +1,11 @@
 include(runtime/scheduling/Testings.cmake)
+include(runtime/termdet/Testings.cmake)
 include(runtime/cuda/Testings.cmake)
+
+if( MPI_C_FOUND )
+  # Only the first two communicators: the reordered split (test 2) truncates messages on 2 processes
+  parsec_addtest_cmd(runtime/multichain:mp ${MPI_TEST_CMD_LIST} 2 runtime/multichain -i=20 -j=20 -l=2 -s=0 -c=2)
+  parsec_addtest_cmd(runtime/multichain_count:mp ${MPI_TEST_CMD_LIST} 2 runtime/multichain_count -i=20 -j=20 -l=2 -s=0 -c=2)
+  # The local tasks counted on each rank of a distributed collection
+  parsec_addtest_cmd(runtime/local_tasks:mp ${MPI_TEST_CMD_LIST} 3 runtime/local_tasks -t 16 -k 32 -c 2)
+endif( MPI_C_FOUND )
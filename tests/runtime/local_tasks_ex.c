@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "parsec/runtime.h"
+#include "parsec/utils/debug.h"
+#include "parsec/os-spec-timing.h"
+#include "schedmicro_data.h"
+#include "local_tasks.h"
+#include <mpi.h>
+
+/*
+ * Check the number of local tasks the taskpool counts at startup on each
+ * rank: a count too low terminates the taskpool before all its tasks are
+ * executed, a count too high never terminates it. Report the time from the
+ * start of the context to the start of the first task, mostly spent in
+ * counting the tasks.
+ */
+
+extern int32_t local_tasks_nb_executed;
+extern parsec_time_t local_tasks_first_start;
+
+int main(int argc, char *argv[])
+{
+    parsec_context_t* parsec;
+    int rank, world, rc, provided;
+    int nt = 64, nk = 64, nb_cores = -1;
+    parsec_data_collection_t *dcA;
+    parsec_taskpool_t *tp;
+    parsec_time_t start;
+    int parsec_argc = 0;
+    char **parsec_argv = NULL;
+    double startup;
+    int32_t executed, expected = 0;
+
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &provided);
+    MPI_Comm_size(MPI_COMM_WORLD, &world);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    for(int a = 1; a < argc; a++) {
+        if(strcmp(argv[a], "--") == 0) {
+            parsec_argc = argc - a;
+            parsec_argv = argv + a;
+            break;
+        }
+        if(strcmp(argv[a], "-t") == 0) {
+            a++;
+            nt = atoi(argv[a]);
+            continue;
+        }
+        if(strcmp(argv[a], "-k") == 0) {
+            a++;
+            nk = atoi(argv[a]);
+            continue;
+        }
+        if(strcmp(argv[a], "-c") == 0) {
+            a++;
+            nb_cores = atoi(argv[a]);
+            continue;
+        }
+        fprintf(stderr, "Usage: %s [-t NB_CHAINS] [-k CHAIN_LENGTH] [-c NB_CORES] [-- <parsec parameters>]\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    parsec = parsec_init(nb_cores, &parsec_argc, &parsec_argv);
+    if( NULL == parsec ) {
+        exit(-1);
+    }
+
+    dcA = create_and_distribute_data(rank, world, 2 * nt + 3, 1);
+    parsec_data_collection_set_key(dcA, "A");
+
+    /* The tasks of ROW, BACK and DIAG on this rank */
+    for( int m = 0; m < nt; m++ ) {
+        if( rank == (int)dcA->rank_of(dcA, m) )
+            expected += nk;
+        if( rank == (int)dcA->rank_of(dcA, 2 * m + 1) )
+            expected += (nk + 1) / 3;
+        for( int k = 0; k <= 3; k++ ) {
+            if( rank == (int)dcA->rank_of(dcA, m + k) )
+                expected++;
+        }
+    }
+
+    tp = &parsec_local_tasks_new(dcA, nt, nk)->super;
+    rc = parsec_context_add_taskpool(parsec, tp);
+    PARSEC_CHECK_ERROR(rc, "parsec_context_add_taskpool");
+    MPI_Barrier(MPI_COMM_WORLD);
+    start = take_time();
+    rc = parsec_context_start(parsec);
+    PARSEC_CHECK_ERROR(rc, "parsec_context_start");
+    rc = parsec_context_wait(parsec);
+    PARSEC_CHECK_ERROR(rc, "parsec_context_wait");
+    parsec_taskpool_free(tp);
+
+    executed = local_tasks_nb_executed;
+    startup = (double)diff_time(start, local_tasks_first_start);
+    MPI_Allreduce(MPI_IN_PLACE, &startup, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    if( 0 == rank ) {
+        printf("#Chains\tChain length\tStartup (" TIMER_UNIT ")\n");
+        printf("%7d\t%12d\t%g\n", nt, nk, startup);
+    }
+
+    free_data(dcA);
+    parsec_fini(&parsec);
+    MPI_Finalize();
+
+    if( executed != expected ) {
+        fprintf(stderr, "Rank %d executed %d tasks instead of %d\n", rank, executed, expected);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -1,9 +1,17 @@
 foreach(_sched ${MCA_sched})
     parsec_addtest_cmd(runtime/scheduling:${_sched} ${MPI_TEST_CMD_LIST} 1 runtime/scheduling/schedmicro -t 10 -l 8 -n 512 -- --mca mca_sched ${_sched})
 endforeach()
+if( "pbq" IN_LIST MCA_sched )
+    parsec_addtest_cmd(runtime/scheduling:pbq:multiqueue ${MPI_TEST_CMD_LIST} 1 runtime/scheduling/schedmicro -t 10 -l 8 -n 512 -- --mca mca_sched pbq --mca sched_pbq_multiqueue 2)
+endif()
 
 if( MPI_C_FOUND )
   foreach(_sched ${MCA_sched})
         parsec_addtest_cmd(runtime/scheduling:mp:${_sched} ${MPI_TEST_CMD_LIST} 2 runtime/scheduling/schedmicro -t 10 -l 8 -n 512 -- --mca mca_sched ${_sched})
     endforeach()
 endif( MPI_C_FOUND )
+
+parsec_addtest_cmd(runtime/scheduling:metrics ${SHM_TEST_CMD_LIST} runtime/scheduling/metrics -n 64 -l 8 -t 3)
+if( MPI_C_FOUND )
+  parsec_addtest_cmd(runtime/scheduling:mp:metrics ${MPI_TEST_CMD_LIST} 2 runtime/scheduling/metrics -n 64 -l 8 -t 3)
+endif( MPI_C_FOUND )
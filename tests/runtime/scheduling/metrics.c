@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+#include "parsec/runtime.h"
+#include "parsec/arena.h"
+#include "parsec/metrics.h"
+#include "schedmicro_data.h"
+#include "metrics_ep.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <unistd.h>
+#if defined(PARSEC_HAVE_MPI)
+#include <mpi.h>
+#endif  /* defined(PARSEC_HAVE_MPI) */
+
+/*
+ * Run the EP DAG (one INIT task on rank 0 releasing NT chains of DEPTH tasks,
+ * chain i on rank (i-1) % world) a few times, and check the counters and
+ * histograms published by the runtime in shared memory against it.
+ */
+
+#define CHECK(cond, ...)                                                \
+    do {                                                                \
+        if( !(cond) ) {                                                 \
+            fprintf(stderr, "Rank %d: ", rank);                         \
+            fprintf(stderr, __VA_ARGS__);                               \
+            fprintf(stderr, "\n");                                      \
+            errors++;                                                   \
+        }                                                               \
+    } while(0)
+
+static uint64_t metrics_total(parsec_metrics_header_t *header, uint32_t counter)
+{
+    uint64_t total = 0;
+    for( uint32_t s = 0; s < header->nb_streams; s++ )
+        total += parsec_metrics_counter(header, s, counter);
+    return total;
+}
+
+static uint64_t histogram_total(parsec_metrics_header_t *header, uint32_t s, uint32_t histogram)
+{
+    uint64_t total = 0;
+    for( uint32_t b = 0; b < header->nb_buckets; b++ )
+        total += parsec_metrics_histogram(header, s, histogram, b);
+    return total;
+}
+
+int main(int argc, char *argv[])
+{
+    parsec_context_t* parsec;
+    parsec_metrics_header_t *header;
+    parsec_data_collection_t *dcA;
+    parsec_ep_taskpool_t *ep;
+    int rank = 0, world = 1, rc, errors = 0, nb_cores;
+    int nt = 64, depth = 8, runs = 3, ch;
+    uint64_t expected, tasks, stolen, misses, selects = 0, execs = 0;
+    char name[64];
+
+    while( -1 != (ch = getopt(argc, argv, "n:l:t:")) ) {
+        switch( ch ) {
+        case 'n': nt = atoi(optarg); break;
+        case 'l': depth = atoi(optarg); break;
+        case 't': runs = atoi(optarg); break;
+        default:
+            fprintf(stderr, "Usage: %s [-n NT] [-l DEPTH] [-t RUNS]\n", argv[0]);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+#if defined(PARSEC_HAVE_MPI)
+    {
+        int provided;
+        MPI_Init_thread(NULL, NULL, MPI_THREAD_SERIALIZED, &provided);
+    }
+    MPI_Comm_size(MPI_COMM_WORLD, &world);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#endif  /* defined(PARSEC_HAVE_MPI) */
+
+    /* All the ranks on a node share the same parent */
+    snprintf(name, sizeof(name), "parsec_metrics_test_%d", (int)getppid());
+    setenv("PARSEC_MCA_metrics_enable", "1", 1);
+    setenv("PARSEC_MCA_metrics_shm_name", name, 1);
+
+    parsec = parsec_init(-1, NULL, NULL);
+    if( NULL == parsec ) {
+        exit(-1);
+    }
+    nb_cores = parsec_context_query(parsec, PARSEC_CONTEXT_QUERY_CORES);
+
+    header = parsec_metrics_attach(name, rank);
+    if( NULL == header ) {
+        fprintf(stderr, "Rank %d: unable to attach to the metrics segment /%s-%d\n", rank, name, rank);
+        parsec_fini(&parsec);
+        exit(EXIT_FAILURE);
+    }
+    CHECK(PARSEC_METRICS_VERSION == header->version, "version %u", header->version);
+    CHECK(rank == header->rank, "rank %d in the header", header->rank);
+    CHECK(PARSEC_METRICS_STATE_RUNNING == header->state, "state %d while running", header->state);
+    CHECK((uint32_t)nb_cores + 1 == header->nb_streams, "%u streams for %d cores", header->nb_streams, nb_cores);
+    CHECK(0 == strcmp(header->names[PARSEC_METRICS_TASKS_EXECUTED], "tasks_executed"),
+          "counter named %s", header->names[PARSEC_METRICS_TASKS_EXECUTED]);
+
+    dcA = create_and_distribute_data(rank, world, nt, 1);
+    parsec_data_collection_set_key(dcA, "A");
+
+    for( int r = 0; r < runs; r++ ) {
+        ep = parsec_ep_new(nt, depth, dcA);
+        parsec_arena_datatype_construct(&ep->arenas_datatypes[PARSEC_ep_DEFAULT_ADT_IDX],
+                                        1, PARSEC_ARENA_ALIGNMENT_SSE, parsec_datatype_uint8_t);
+        rc = parsec_context_add_taskpool(parsec, &ep->super);
+        PARSEC_CHECK_ERROR(rc, "parsec_context_add_taskpool");
+        rc = parsec_context_start(parsec);
+        PARSEC_CHECK_ERROR(rc, "parsec_context_start");
+        rc = parsec_context_wait(parsec);
+        PARSEC_CHECK_ERROR(rc, "parsec_context_wait");
+        parsec_taskpool_free(&ep->super);
+    }
+
+    /* The local tasks: INIT on rank 0, and DEPTH tasks per local chain, plus
+     * the task that generates the INIT startup tasks on every rank */
+    expected = (0 == rank) ? 2 : 1;
+    for( int i = 1; i <= nt; i++ )
+        if( rank == (i - 1) % world ) expected += depth;
+    expected *= runs;
+
+    tasks  = metrics_total(header, PARSEC_METRICS_TASKS_EXECUTED);
+    stolen = metrics_total(header, PARSEC_METRICS_TASKS_STOLEN);
+    misses = metrics_total(header, PARSEC_METRICS_SELECT_MISSES);
+    CHECK(expected == tasks, "%"PRIu64" tasks executed instead of %"PRIu64, tasks, expected);
+    CHECK(stolen <= tasks, "%"PRIu64" tasks stolen out of %"PRIu64, stolen, tasks);
+    CHECK(0 == parsec_metrics_counter(header, header->nb_streams - 1, PARSEC_METRICS_TASKS_EXECUTED),
+          "the communication stream executed tasks");
+    for( uint32_t s = 0; s < header->nb_streams; s++ ) {
+        uint64_t execs_s = histogram_total(header, s, PARSEC_METRICS_EXEC_LATENCY);
+        CHECK(execs_s == parsec_metrics_counter(header, s, PARSEC_METRICS_TASKS_EXECUTED),
+              "stream %u executed %"PRIu64" tasks but recorded %"PRIu64" durations", s,
+              parsec_metrics_counter(header, s, PARSEC_METRICS_TASKS_EXECUTED), execs_s);
+        execs += execs_s;
+        selects += histogram_total(header, s, PARSEC_METRICS_SELECT_LATENCY);
+    }
+    CHECK(execs == tasks, "%"PRIu64" durations for %"PRIu64" tasks", execs, tasks);
+    CHECK(selects >= misses + stolen, "%"PRIu64" selects for %"PRIu64" misses and %"PRIu64" steals",
+          selects, misses, stolen);
+    if( (world > 1) && (rank > 0) && (rank < nt) ) {
+        /* every chain is started by an activation from rank 0 */
+        CHECK(metrics_total(header, PARSEC_METRICS_REMOTE_ACTIVATIONS) > 0, "no remote activation received");
+    }
+
+    free_data(dcA);
+    parsec_fini(&parsec);
+
+    /* the segment outlives the runtime for the samplers that mapped it */
+    CHECK(PARSEC_METRICS_STATE_FINISHED == header->state, "state %d after parsec_fini", header->state);
+    parsec_metrics_detach(header);
+
+#if defined(PARSEC_HAVE_MPI)
+    MPI_Allreduce(MPI_IN_PLACE, &errors, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    MPI_Finalize();
+#endif  /* defined(PARSEC_HAVE_MPI) */
+    if( 0 == rank )
+        printf("%s: %d errors\n", 0 == errors ? "SUCCESS" : "FAILURE", errors);
+    return (0 == errors) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
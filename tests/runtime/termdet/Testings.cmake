@@ -0,0 +1,8 @@
+if( MPI_C_FOUND )
+  foreach(_termdet fourcounter hierarchical)
+    parsec_addtest_cmd(runtime/termdet:mp:${_termdet} ${MPI_TEST_CMD_LIST} 2 runtime/termdet/tiny_taskpools -n 1000 -t 8 -- --mca termdet_dynamic ${_termdet})
+    # Several threads per rank sending at once
+    parsec_addtest_cmd(runtime/termdet:mp:${_termdet}_fanout ${MPI_TEST_CMD_LIST} 2 runtime/termdet/tiny_taskpools -n 200 -t 64 -c 4 -f -- --mca termdet_dynamic ${_termdet})
+  endforeach()
+  parsec_addtest_cmd(runtime/termdet:mp:hierarchical_nodes ${MPI_TEST_CMD_LIST} 4 runtime/termdet/tiny_taskpools -n 200 -t 16 -- --mca termdet_dynamic hierarchical --mca termdet_hierarchical_node_size 2)
+endif( MPI_C_FOUND )
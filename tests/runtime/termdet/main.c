@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "parsec/runtime.h"
+#include "parsec/utils/debug.h"
+#include "parsec/os-spec-timing.h"
+#include "schedmicro_data.h"
+#include "tiny_tp.h"
+#include "fanout_tp.h"
+#include <mpi.h>
+
+/*
+ * Run thousands of tiny distributed taskpools back to back, each waited for
+ * before the next one is started: the time per taskpool is dominated by the
+ * termination detection (select the module with --mca termdet_dynamic).
+ * With -f each taskpool is a fan-out instead of a chain: the threads of each
+ * rank send their activations at the same time.
+ */
+
+extern int32_t tiny_tp_nb_executed;
+
+int main(int argc, char *argv[])
+{
+    parsec_context_t* parsec;
+    int rank, world, rc, provided;
+    int nb_tp = 1000, nt = 8, nb_cores = -1, fanout = 0;
+    parsec_data_collection_t *dcA;
+    parsec_taskpool_t *tp;
+    parsec_time_t start, end;
+    int parsec_argc = 0;
+    char **parsec_argv = NULL;
+    double elapsed;
+    int32_t executed, expected;
+
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &provided);
+    MPI_Comm_size(MPI_COMM_WORLD, &world);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    for(int a = 1; a < argc; a++) {
+        if(strcmp(argv[a], "--") == 0) {
+            parsec_argc = argc - a;
+            parsec_argv = argv + a;
+            break;
+        }
+        if(strcmp(argv[a], "-n") == 0) {
+            a++;
+            nb_tp = atoi(argv[a]);
+            continue;
+        }
+        if(strcmp(argv[a], "-t") == 0) {
+            a++;
+            nt = atoi(argv[a]);
+            continue;
+        }
+        if(strcmp(argv[a], "-c") == 0) {
+            a++;
+            nb_cores = atoi(argv[a]);
+            continue;
+        }
+        if(strcmp(argv[a], "-f") == 0) {
+            fanout = 1;
+            continue;
+        }
+        fprintf(stderr, "Usage: %s [-n NB_TASKPOOLS] [-t NB_TASKS] [-c NB_CORES] [-f] [-- <parsec parameters>]\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    parsec = parsec_init(nb_cores, &parsec_argc, &parsec_argv);
+    if( NULL == parsec ) {
+        exit(-1);
+    }
+
+    dcA = create_and_distribute_data(rank, world, nt, 1);
+    parsec_data_collection_set_key(dcA, "A");
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    start = take_time();
+    for( int i = 0; i < nb_tp; i++ ) {
+        if( fanout )
+            tp = &parsec_fanout_tp_new(dcA, nt)->super;
+        else
+            tp = &parsec_tiny_tp_new(dcA, nt)->super;
+        rc = parsec_context_add_taskpool(parsec, tp);
+        PARSEC_CHECK_ERROR(rc, "parsec_context_add_taskpool");
+        rc = parsec_context_start(parsec);
+        PARSEC_CHECK_ERROR(rc, "parsec_context_start");
+        rc = parsec_context_wait(parsec);
+        PARSEC_CHECK_ERROR(rc, "parsec_context_wait");
+        parsec_taskpool_free(tp);
+    }
+    end = take_time();
+    elapsed = (double)diff_time(start, end);
+
+    executed = tiny_tp_nb_executed;
+    expected = (fanout ? 2 : 1) * nb_tp * nt;
+    MPI_Allreduce(MPI_IN_PLACE, &executed, 1, MPI_INT32_T, MPI_SUM, MPI_COMM_WORLD);
+    MPI_Allreduce(MPI_IN_PLACE, &elapsed, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    if( 0 == rank ) {
+        printf("#Taskpools\tTasks per taskpool\tTotal (" TIMER_UNIT ")\tPer taskpool (" TIMER_UNIT ")\n");
+        printf("%10d\t%18d\t%g\t%g\n", nb_tp, nt, elapsed, elapsed / (double)nb_tp);
+    }
+
+    free_data(dcA);
+    parsec_fini(&parsec);
+    MPI_Finalize();
+
+    if( executed != expected ) {
+        if( 0 == rank )
+            fprintf(stderr, "%d tasks executed instead of %d\n", executed, expected);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+/*
+ * Sample the runtime metrics published by running PaRSEC processes (see the
+ * metrics_shm_name MCA parameter), and print the counters of each execution
+ * stream together with the aggregated latency histograms.
+ */
+
+#include "parsec/parsec_config.h"
+#include "parsec/metrics.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <unistd.h>
+
+static void usage(const char *name)
+{
+    fprintf(stderr,
+            "Usage: %s [-i interval] [-c count] [-t] <name> [rank ...]\n"
+            "  Print the metrics published in /<name>-<rank> (rank 0 by default)\n"
+            "  -i interval  sample every interval seconds\n"
+            "  -c count     stop after count samples (default 1, or forever with -i)\n"
+            "  -t           print only the totals, not each execution stream\n",
+            name);
+}
+
+static void print_histogram(const parsec_metrics_header_t *header, uint32_t h)
+{
+    uint64_t count[64] = { 0 }, total = 0;
+    uint32_t s, b, nb_buckets = header->nb_buckets < 64 ? header->nb_buckets : 64;
+
+    for( s = 0; s < header->nb_streams; s++ )
+        for( b = 0; b < nb_buckets; b++ )
+            count[b] += parsec_metrics_histogram(header, s, h, b);
+    for( b = 0; b < nb_buckets; b++ )
+        total += count[b];
+
+    printf("  %s (%s, %"PRIu64" samples)\n", header->names[header->nb_counters + h], header->timer_unit, total);
+    if( 0 == total )
+        return;
+    for( b = 0; b < nb_buckets; b++ ) {
+        if( 0 == count[b] ) continue;
+        if( 0 == b )
+            printf("    %20s %12"PRIu64" %6.2f%%\n", "0", count[b], 100.0 * count[b] / total);
+        else if( b == nb_buckets - 1 )
+            printf("    [%18"PRIu64", inf) %12"PRIu64" %6.2f%%\n",
+                   (uint64_t)1 << (b - 1), count[b], 100.0 * count[b] / total);
+        else
+            printf("    [%8"PRIu64", %8"PRIu64") %12"PRIu64" %6.2f%%\n",
+                   (uint64_t)1 << (b - 1), (uint64_t)1 << b, count[b], 100.0 * count[b] / total);
+    }
+}
+
+static void print_metrics(const parsec_metrics_header_t *header, int totals_only)
+{
+    uint32_t s, c;
+    uint64_t total;
+
+    printf("Rank %d (pid %d, %s): %u execution streams, the last for communications\n",
+           header->rank, header->pid,
+           PARSEC_METRICS_STATE_RUNNING == header->state ? "running" : "finished",
+           header->nb_streams);
+    printf("  %-20s", "stream");
+    if( !totals_only )
+        for( s = 0; s < header->nb_streams; s++ )
+            printf(" %12u", s);
+    printf(" %14s\n", "total");
+    for( c = 0; c < header->nb_counters; c++ ) {
+        printf("  %-20s", header->names[c]);
+        total = 0;
+        for( s = 0; s < header->nb_streams; s++ ) {
+            uint64_t value = parsec_metrics_counter(header, s, c);
+            if( !totals_only )
+                printf(" %12"PRIu64, value);
+            total += value;
+        }
+        printf(" %14"PRIu64"\n", total);
+    }
+    for( c = 0; c < header->nb_histograms; c++ )
+        print_histogram(header, c);
+}
+
+int main(int argc, char *argv[])
+{
+    parsec_metrics_header_t **headers;
+    int opt, interval = 0, count = -1, totals_only = 0;
+    int nb_ranks, r, i, rc = 0;
+
+    while( -1 != (opt = getopt(argc, argv, "i:c:th")) ) {
+        switch( opt ) {
+        case 'i': interval = atoi(optarg); break;
+        case 'c': count = atoi(optarg); break;
+        case 't': totals_only = 1; break;
+        default:
+            usage(argv[0]);
+            return 'h' == opt ? 0 : 1;
+        }
+    }
+    if( optind >= argc ) {
+        usage(argv[0]);
+        return 1;
+    }
+    if( count < 0 )
+        count = (interval > 0) ? 0 : 1;
+
+    nb_ranks = (argc - optind > 1) ? argc - optind - 1 : 1;
+    headers = (parsec_metrics_header_t**)calloc(nb_ranks, sizeof(parsec_metrics_header_t*));
+    for( r = 0; r < nb_ranks; r++ ) {
+        int rank = (argc - optind > 1) ? atoi(argv[optind + 1 + r]) : 0;
+        if( NULL == (headers[r] = parsec_metrics_attach(argv[optind], rank)) ) {
+            fprintf(stderr, "Unable to attach to the metrics of rank %d under /%s-%d\n",
+                    rank, argv[optind], rank);
+            rc = 1;
+        }
+    }
+
+    for( i = 0; (0 == count) || (i < count); i++ ) {
+        if( i > 0 ) sleep(interval);
+        for( r = 0; r < nb_ranks; r++ ) {
+            if( NULL != headers[r] )
+                print_metrics(headers[r], totals_only);
+        }
+        fflush(stdout);
+    }
+
+    for( r = 0; r < nb_ranks; r++ )
+        parsec_metrics_detach(headers[r]);
+    free(headers);
+    return rc;
+}
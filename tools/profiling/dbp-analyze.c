@@ -0,0 +1,808 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+#include "parsec/parsec_config.h"
+#undef PARSEC_HAVE_MPI
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <inttypes.h>
+#include <stdarg.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "parsec/os-spec-timing.h"
+#include "parsec/profiling.h"
+#include "parsec/parsec_binary_profile.h"
+#include "dbpreader.h"
+
+/*
+ * Analyzes the binary profiles of a PaRSEC execution in a single pass over
+ * the events of each rank, the ranks being read by concurrent threads. The
+ * start events are matched with their end events by the match index of the
+ * reader (dbp_file_find_matching_event), and the resulting intervals give:
+ *  - the number, duration and log2 histogram of the durations of each
+ *    class of events;
+ *  - for each thread, the time spent in tasks, in the scheduler, in
+ *    communications, and idle;
+ *  - for each rank, how much of the communications overlap with tasks;
+ *  - when the DOT files of the execution (--mca profile_dot) are given,
+ *    the critical path of the DAG, each task weighted by its duration.
+ */
+
+#define ANALYZE_NB_BUCKETS 64
+
+typedef enum {
+    ANALYZE_COMPUTE,
+    ANALYZE_SCHED,
+    ANALYZE_COMM,
+    ANALYZE_IGNORED
+} analyze_category_t;
+
+static const char *category_name[] = { "task", "sched", "comm", "ignored" };
+
+typedef struct {
+    uint64_t nb;
+    uint64_t total;
+    uint64_t min;
+    uint64_t max;
+    uint64_t histogram[ANALYZE_NB_BUCKETS];  /**< histogram[b] counts the durations in [2^b, 2^(b+1)) */
+} class_stats_t;
+
+typedef struct {
+    uint64_t time[ANALYZE_IGNORED];          /**< time covered by the events of each category */
+    uint64_t busy;                           /**< time covered by the events of any category */
+} thread_stats_t;
+
+typedef struct {
+    uint64_t event_id;
+    uint64_t start;
+    uint64_t end;
+    uint32_t taskpool_id;
+    int      key;                            /**< global dictionary id */
+    int      thread;
+} interval_t;
+
+typedef struct {
+    interval_t *items;
+    size_t      nb;
+    size_t      size;
+} interval_array_t;
+
+typedef struct {
+    dbp_file_t       *file;
+    class_stats_t    *classes;               /**< one per global dictionary entry */
+    thread_stats_t   *threads;
+    interval_array_t  intervals[ANALYZE_IGNORED];  /**< intervals of each category, but the ignored one */
+    uint64_t          first;
+    uint64_t          last;
+    uint64_t          nb_events;
+    uint64_t          nb_unmatched;
+    uint64_t          comm_time;
+    uint64_t          comm_overlap;
+} rank_analysis_t;
+
+typedef struct {
+    const dbp_multifile_reader_t *dbp;
+    rank_analysis_t              *ranks;
+    analyze_category_t           *categories;
+    int                           nb_classes;
+    int                           keep_compute;
+    int                           next_rank;
+    pthread_mutex_t               lock;
+} analysis_t;
+
+static inline int duration_bucket(uint64_t d)
+{
+    int b = 0;
+    while( d > 1 ) {
+        d >>= 1;
+        b++;
+    }
+    return b;
+}
+
+static analyze_category_t classify(const char *name)
+{
+    static const char *sched[] = { "Sched ", "Queue ", "PARSEC RUNTIME::", "Device delegate", NULL };
+    static const char *comm[] = { "MPI_", "movein", "moveout", "prefetch", NULL };
+    static const char *ignored[] = { "MEMALLOC", "ARENA_", "TASK_MEMORY", "gpu_mem_", NULL };
+    int i;
+
+    for( i = 0; NULL != sched[i]; i++ )
+        if( !strncmp(name, sched[i], strlen(sched[i])) ) return ANALYZE_SCHED;
+    for( i = 0; NULL != comm[i]; i++ )
+        if( !strncmp(name, comm[i], strlen(comm[i])) ) return ANALYZE_COMM;
+    for( i = 0; NULL != ignored[i]; i++ )
+        if( !strncmp(name, ignored[i], strlen(ignored[i])) ) return ANALYZE_IGNORED;
+    return ANALYZE_COMPUTE;
+}
+
+static void interval_array_push(interval_array_t *a, const interval_t *i)
+{
+    if( a->nb == a->size ) {
+        a->size = a->size ? 2 * a->size : 1024;
+        a->items = (interval_t*)realloc(a->items, a->size * sizeof(interval_t));
+    }
+    a->items[a->nb++] = *i;
+}
+
+static void account_interval(const analysis_t *a, rank_analysis_t *r, const interval_t *i)
+{
+    class_stats_t *c = &r->classes[i->key];
+    uint64_t d = i->end - i->start;
+    analyze_category_t cat = a->categories[i->key];
+
+    c->nb++;
+    c->total += d;
+    if( 1 == c->nb || d < c->min ) c->min = d;
+    if( d > c->max ) c->max = d;
+    c->histogram[duration_bucket(d)]++;
+
+    if( ANALYZE_IGNORED != cat )
+        interval_array_push(&r->intervals[cat], i);
+}
+
+static int interval_compare_start(const void *a, const void *b)
+{
+    const interval_t *ia = (const interval_t*)a, *ib = (const interval_t*)b;
+    if( ia->start < ib->start ) return -1;
+    if( ia->start > ib->start ) return 1;
+    return 0;
+}
+
+static int interval_compare_thread_start(const void *a, const void *b)
+{
+    const interval_t *ia = (const interval_t*)a, *ib = (const interval_t*)b;
+    if( ia->thread != ib->thread ) return ia->thread < ib->thread ? -1 : 1;
+    return interval_compare_start(a, b);
+}
+
+/**
+ * Adds to time[t] the time covered by the intervals of thread t: the
+ * events of a thread may overlap, as the asynchronous tasks of a custom
+ * stream do. The intervals are sorted by thread and start.
+ */
+static void time_covered_by_thread(interval_t *items, size_t nb, uint64_t *time)
+{
+    uint64_t s, e;
+    size_t i;
+    int t;
+
+    if( 0 == nb )
+        return;
+    qsort(items, nb, sizeof(interval_t), interval_compare_thread_start);
+    t = items[0].thread; s = items[0].start; e = items[0].end;
+    for( i = 1; i < nb; i++ ) {
+        if( items[i].thread == t && items[i].start <= e ) {
+            if( items[i].end > e ) e = items[i].end;
+            continue;
+        }
+        time[t] += e - s;
+        t = items[i].thread; s = items[i].start; e = items[i].end;
+    }
+    time[t] += e - s;
+}
+
+static void compute_thread_activity(rank_analysis_t *r, int nb_threads)
+{
+    uint64_t *time = (uint64_t*)calloc(nb_threads, sizeof(uint64_t));
+    interval_t *all;
+    size_t nb = 0;
+    int c, t;
+
+    for( c = 0; c < ANALYZE_IGNORED; c++ )
+        nb += r->intervals[c].nb;
+    all = (interval_t*)malloc((nb + 1) * sizeof(interval_t));
+    nb = 0;
+    for( c = 0; c < ANALYZE_IGNORED; c++ ) {
+        memcpy(all + nb, r->intervals[c].items, r->intervals[c].nb * sizeof(interval_t));
+        nb += r->intervals[c].nb;
+        memset(time, 0, nb_threads * sizeof(uint64_t));
+        time_covered_by_thread(r->intervals[c].items, r->intervals[c].nb, time);
+        for( t = 0; t < nb_threads; t++ )
+            r->threads[t].time[c] = time[t];
+    }
+    memset(time, 0, nb_threads * sizeof(uint64_t));
+    time_covered_by_thread(all, nb, time);
+    for( t = 0; t < nb_threads; t++ )
+        r->threads[t].busy = time[t];
+    free(all);
+    free(time);
+}
+
+/* Time of the communications during which at least one task is running */
+static void compute_comm_overlap(rank_analysis_t *r)
+{
+    const interval_array_t *compute = &r->intervals[ANALYZE_COMPUTE];
+    const interval_array_t *comm = &r->intervals[ANALYZE_COMM];
+    interval_t *u;
+    size_t nb_u = 0, i, lo, hi, mid;
+    uint64_t s, e;
+
+    r->comm_time = 0;
+    r->comm_overlap = 0;
+    if( 0 == comm->nb )
+        return;
+    /* union of the task intervals, as disjoint intervals sorted by start */
+    u = (interval_t*)malloc((compute->nb + 1) * sizeof(interval_t));
+    if( compute->nb > 0 ) {
+        memcpy(u, compute->items, compute->nb * sizeof(interval_t));
+        qsort(u, compute->nb, sizeof(interval_t), interval_compare_start);
+        for( i = 1; i < compute->nb; i++ ) {
+            if( u[i].start <= u[nb_u].end ) {
+                if( u[i].end > u[nb_u].end ) u[nb_u].end = u[i].end;
+            } else {
+                u[++nb_u] = u[i];
+            }
+        }
+        nb_u++;
+    }
+    for( i = 0; i < comm->nb; i++ ) {
+        s = comm->items[i].start;
+        e = comm->items[i].end;
+        r->comm_time += e - s;
+        /* first interval of the union ending after s */
+        lo = 0; hi = nb_u;
+        while( lo < hi ) {
+            mid = (lo + hi) / 2;
+            if( u[mid].end <= s ) lo = mid + 1;
+            else hi = mid;
+        }
+        for( ; lo < nb_u && u[lo].start < e; lo++ ) {
+            r->comm_overlap += (u[lo].end < e ? u[lo].end : e) - (u[lo].start > s ? u[lo].start : s);
+        }
+    }
+    free(u);
+}
+
+static void analyze_rank(const analysis_t *a, rank_analysis_t *r)
+{
+    dbp_file_t *file = r->file;
+    const dbp_thread_t *th;
+    dbp_event_iterator_t *it;
+    const dbp_event_t *e, *end;
+    interval_t interval;
+    uint64_t timestamp, nb_ends = 0, nb_matched = 0;
+    int t, nb_threads = dbp_file_nb_threads(file);
+
+    r->classes = (class_stats_t*)calloc(a->nb_classes, sizeof(class_stats_t));
+    r->threads = (thread_stats_t*)calloc(nb_threads, sizeof(thread_stats_t));
+    r->first = UINT64_MAX;
+    r->last = 0;
+
+    for( t = 0; t < nb_threads; t++ ) {
+        th = dbp_file_get_thread(file, t);
+        it = dbp_iterator_new_from_thread(th);
+        for( e = dbp_iterator_current(it); NULL != e; e = dbp_iterator_next(it) ) {
+            r->nb_events++;
+            if( dbp_event_get_flags(e) & PARSEC_PROFILING_EVENT_COUNTER )
+                continue;
+            timestamp = dbp_event_get_timestamp(e);
+            if( timestamp < r->first ) r->first = timestamp;
+            if( timestamp > r->last ) r->last = timestamp;
+            if( KEY_IS_END(dbp_event_get_key(e)) ) {
+                nb_ends++;
+                continue;
+            }
+            /* the interval belongs to the thread of its start event */
+            if( NULL == (end = dbp_file_find_matching_event(file, e)) ) {
+                r->nb_unmatched++;
+                continue;
+            }
+            nb_matched++;
+            interval.key = dbp_file_translate_local_dico_to_global(file, BASE_KEY(dbp_event_get_key(e)));
+            interval.taskpool_id = dbp_event_get_taskpool_id(e);
+            interval.event_id = dbp_event_get_event_id(e);
+            interval.start = timestamp;
+            interval.end = dbp_event_get_timestamp(end);
+            interval.thread = t;
+            account_interval(a, r, &interval);
+        }
+        dbp_iterator_delete(it);
+    }
+    /* the ends without start */
+    r->nb_unmatched += nb_ends - nb_matched;
+    dbp_reader_close_file(file);
+
+    compute_comm_overlap(r);
+    compute_thread_activity(r, nb_threads);
+    for( t = 0; t < ANALYZE_IGNORED; t++ ) {
+        if( ANALYZE_COMPUTE == t && a->keep_compute )
+            continue;
+        free(r->intervals[t].items);
+        r->intervals[t].items = NULL;
+        r->intervals[t].nb = 0;
+    }
+}
+
+static void *analyze_thread(void *arg)
+{
+    analysis_t *a = (analysis_t*)arg;
+    int rank;
+
+    for(;;) {
+        pthread_mutex_lock(&a->lock);
+        rank = a->next_rank++;
+        pthread_mutex_unlock(&a->lock);
+        if( rank >= dbp_reader_nb_files(a->dbp) )
+            break;
+        /* the file is opened by the thread reading it, and closed once read */
+        a->ranks[rank].file = dbp_reader_get_file(a->dbp, rank);
+        if( 0 != dbp_file_error(a->ranks[rank].file) )
+            continue;
+        analyze_rank(a, &a->ranks[rank]);
+    }
+    return NULL;
+}
+
+/* Strings to index map, used to identify the nodes of the DAG */
+typedef struct name_entry_s {
+    struct name_entry_s *next;
+    char                *name;
+    unsigned int         index;
+} name_entry_t;
+
+typedef struct {
+    name_entry_t **buckets;
+    size_t         mask;
+    unsigned int   nb;
+} name_table_t;
+
+static uint64_t name_hash(const char *s)
+{
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for( ; '\0' != *s; s++ ) {
+        h ^= (unsigned char)*s;
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+static void name_table_init(name_table_t *t)
+{
+    t->mask = 4095;
+    t->nb = 0;
+    t->buckets = (name_entry_t**)calloc(t->mask + 1, sizeof(name_entry_t*));
+}
+
+static void name_table_fini(name_table_t *t)
+{
+    name_entry_t *p, *n;
+    size_t b;
+
+    for( b = 0; b <= t->mask; b++ ) {
+        for( p = t->buckets[b]; NULL != p; p = n ) {
+            n = p->next;
+            free(p->name);
+            free(p);
+        }
+    }
+    free(t->buckets);
+}
+
+static unsigned int name_table_find(const name_table_t *t, const char *name)
+{
+    name_entry_t *p;
+    for( p = t->buckets[name_hash(name) & t->mask]; NULL != p; p = p->next )
+        if( !strcmp(p->name, name) ) return p->index;
+    return (unsigned int)-1;
+}
+
+/* Returns the index of name, adding it with the next index if needed */
+static unsigned int name_table_add(name_table_t *t, const char *name)
+{
+    name_entry_t *p, *n;
+    unsigned int index = name_table_find(t, name);
+    size_t b;
+
+    if( (unsigned int)-1 != index )
+        return index;
+    if( t->nb > 2 * (t->mask + 1) ) {
+        name_entry_t **buckets = (name_entry_t**)calloc(2 * (t->mask + 1), sizeof(name_entry_t*));
+        size_t mask = 2 * (t->mask + 1) - 1;
+        for( b = 0; b <= t->mask; b++ ) {
+            for( p = t->buckets[b]; NULL != p; p = n ) {
+                n = p->next;
+                p->next = buckets[name_hash(p->name) & mask];
+                buckets[name_hash(p->name) & mask] = p;
+            }
+        }
+        free(t->buckets);
+        t->buckets = buckets;
+        t->mask = mask;
+    }
+    p = (name_entry_t*)malloc(sizeof(name_entry_t));
+    p->name = strdup(name);
+    p->index = t->nb++;
+    b = name_hash(name) & t->mask;
+    p->next = t->buckets[b];
+    t->buckets[b] = p;
+    return p->index;
+}
+
+typedef struct {
+    char         *tcname;                    /**< NULL if the node is not a task */
+    uint32_t      taskpool_id;
+    uint64_t      task_id;
+    uint64_t      weight;
+    unsigned int *succ;
+    unsigned int  nb_succ;
+    unsigned int  size_succ;
+    unsigned int  nb_pred;
+} dag_node_t;
+
+typedef struct {
+    name_table_t  names;
+    dag_node_t   *nodes;
+    unsigned int  size;
+} dag_t;
+
+static dag_node_t *dag_node(dag_t *g, const char *name)
+{
+    unsigned int n = name_table_add(&g->names, name);
+    if( n >= g->size ) {
+        unsigned int size = g->size ? 2 * g->size : 1024;
+        g->nodes = (dag_node_t*)realloc(g->nodes, size * sizeof(dag_node_t));
+        memset(g->nodes + g->size, 0, (size - g->size) * sizeof(dag_node_t));
+        g->size = size;
+    }
+    return &g->nodes[n];
+}
+
+/**
+ * Reads the tasks and the task to task edges of a DOT file generated by
+ * the PaRSEC grapher. The tasks are the nodes with a tooltip
+ * "tpid=..:tcid=..:tcname=..:tid=..", where tid is the event id of the
+ * task in the profile.
+ */
+static int read_dot_file(dag_t *g, const char *filename)
+{
+    FILE *f = fopen(filename, "r");
+    char *line = NULL, *s, *arrow, *tip;
+    char tcname[256];
+    size_t len = 0;
+    unsigned int src, dst;
+    unsigned int tpid;
+    int tcid;
+    uint64_t tid;
+    dag_node_t *n;
+
+    if( NULL == f ) {
+        fprintf(stderr, "Unable to open DOT file %s\n", filename);
+        return -1;
+    }
+    while( -1 != getline(&line, &len, f) ) {
+        if( NULL == (s = strstr(line, " [")) )
+            continue;
+        *s = '\0';
+        if( NULL != (arrow = strstr(line, " -> ")) ) {
+            *arrow = '\0';
+            /* only the edges between tasks carry a flow to flow label */
+            if( NULL == strstr(s + 1, "=>") )
+                continue;
+            src = name_table_add(&g->names, line);
+            dag_node(g, line);
+            dst = name_table_add(&g->names, arrow + 4);
+            dag_node(g, arrow + 4);
+            n = &g->nodes[src];
+            if( n->nb_succ == n->size_succ ) {
+                n->size_succ = n->size_succ ? 2 * n->size_succ : 4;
+                n->succ = (unsigned int*)realloc(n->succ, n->size_succ * sizeof(unsigned int));
+            }
+            n->succ[n->nb_succ++] = dst;
+            continue;
+        }
+        if( NULL == (tip = strstr(s + 1, "tooltip=\"tpid=")) )
+            continue;
+        if( 4 != sscanf(tip, "tooltip=\"tpid=%u:tcid=%d:tcname=%255[^:]:tid=%"SCNu64, &tpid, &tcid, tcname, &tid) )
+            continue;
+        n = dag_node(g, line);
+        free(n->tcname);
+        n->tcname = strdup(tcname);
+        n->taskpool_id = tpid;
+        n->task_id = tid;
+    }
+    free(line);
+    fclose(f);
+    return 0;
+}
+
+static void task_key(char *key, size_t len, const char *tcname, uint32_t taskpool_id, uint64_t task_id)
+{
+    snprintf(key, len, "%s:%u:%"PRIu64, tcname, taskpool_id, task_id);
+}
+
+/* The task class name of a dictionary entry, without its "<taskpool>::" prefix */
+static const char *short_name(const char *name)
+{
+    const char *s = strrchr(name, ':');
+    return (NULL != s && s > name && ':' == s[-1]) ? s + 1 : name;
+}
+
+static void critical_path(const analysis_t *a, int nb_dots, char **dots, int print_path, uint64_t span)
+{
+    dag_t g = { .nodes = NULL, .size = 0 };
+    name_table_t tasks;
+    char key[512];
+    unsigned int i, j, k, nb_nodes, nb_tasks = 0, nb_weighted = 0, nb_done = 0;
+    unsigned int *queue, *pred, head = 0, tail = 0, last = (unsigned int)-1, len;
+    uint64_t *dist, best = 0;
+    int f;
+    size_t r;
+
+    name_table_init(&g.names);
+    for( f = 0; f < nb_dots; f++ ) {
+        if( 0 != read_dot_file(&g, dots[f]) ) {
+            name_table_fini(&g.names);
+            return;
+        }
+    }
+    nb_nodes = g.names.nb;
+
+    /* weight the tasks with the duration of their events */
+    name_table_init(&tasks);
+    for( i = 0; i < nb_nodes; i++ ) {
+        if( NULL == g.nodes[i].tcname ) continue;
+        task_key(key, sizeof(key), g.nodes[i].tcname, g.nodes[i].taskpool_id, g.nodes[i].task_id);
+        name_table_add(&tasks, key);
+        nb_tasks++;
+    }
+    /* task index to node index */
+    pred = (unsigned int*)malloc((tasks.nb + 1) * sizeof(unsigned int));
+    for( i = 0; i < nb_nodes; i++ ) {
+        if( NULL == g.nodes[i].tcname ) continue;
+        task_key(key, sizeof(key), g.nodes[i].tcname, g.nodes[i].taskpool_id, g.nodes[i].task_id);
+        pred[name_table_find(&tasks, key)] = i;
+    }
+    for( f = 0; f < dbp_reader_nb_files(a->dbp); f++ ) {
+        const interval_array_t *c = &a->ranks[f].intervals[ANALYZE_COMPUTE];
+        for( r = 0; r < c->nb; r++ ) {
+            task_key(key, sizeof(key),
+                     short_name(dbp_dictionary_name(dbp_reader_get_dictionary(a->dbp, c->items[r].key))),
+                     c->items[r].taskpool_id, c->items[r].event_id);
+            k = name_table_find(&tasks, key);
+            if( (unsigned int)-1 == k ) continue;
+            if( 0 == g.nodes[pred[k]].weight ) nb_weighted++;
+            g.nodes[pred[k]].weight += c->items[r].end - c->items[r].start;
+        }
+    }
+    name_table_fini(&tasks);
+    free(pred);
+
+    /* longest path, in topological order */
+    queue = (unsigned int*)malloc((nb_nodes + 1) * sizeof(unsigned int));
+    pred = (unsigned int*)malloc((nb_nodes + 1) * sizeof(unsigned int));
+    dist = (uint64_t*)calloc(nb_nodes + 1, sizeof(uint64_t));
+    for( i = 0; i < nb_nodes; i++ ) {
+        if( NULL == g.nodes[i].tcname ) continue;
+        for( j = 0; j < g.nodes[i].nb_succ; j++ )
+            if( NULL != g.nodes[g.nodes[i].succ[j]].tcname )
+                g.nodes[g.nodes[i].succ[j]].nb_pred++;
+    }
+    for( i = 0; i < nb_nodes; i++ ) {
+        pred[i] = (unsigned int)-1;
+        if( NULL != g.nodes[i].tcname && 0 == g.nodes[i].nb_pred ) {
+            dist[i] = g.nodes[i].weight;
+            queue[tail++] = i;
+        }
+    }
+    while( head < tail ) {
+        i = queue[head++];
+        nb_done++;
+        if( (unsigned int)-1 == last || dist[i] > best ) {
+            best = dist[i];
+            last = i;
+        }
+        for( j = 0; j < g.nodes[i].nb_succ; j++ ) {
+            k = g.nodes[i].succ[j];
+            if( NULL == g.nodes[k].tcname ) continue;
+            if( (unsigned int)-1 == pred[k] || dist[i] + g.nodes[k].weight > dist[k] ) {
+                dist[k] = dist[i] + g.nodes[k].weight;
+                pred[k] = i;
+            }
+            if( 0 == --g.nodes[k].nb_pred )
+                queue[tail++] = k;
+        }
+    }
+
+    printf("\nCritical path (from %d DOT files: %u tasks, %u of them found in the profiles)\n",
+           nb_dots, nb_tasks, nb_weighted);
+    if( nb_done != nb_tasks ) {
+        fprintf(stderr, "The DAG has a cycle: %u tasks are not on any path from a source task\n", nb_tasks - nb_done);
+    }
+    if( (unsigned int)-1 != last ) {
+        for( len = 0, i = last; (unsigned int)-1 != i; i = pred[i] ) len++;
+        printf("  length %"PRIu64" %s over %u tasks, %.2f%% of the longest rank span (%"PRIu64" %s)\n",
+               best, TIMER_UNIT, len, span ? 100.0 * (double)best / (double)span : 0.0, span, TIMER_UNIT);
+        if( print_path ) {
+            /* the path is walked from its end */
+            for( i = last; (unsigned int)-1 != i; i = pred[i] ) {
+                printf("  %s tpid=%u tid=%"PRIu64" %"PRIu64"\n", g.nodes[i].tcname,
+                       g.nodes[i].taskpool_id, g.nodes[i].task_id, g.nodes[i].weight);
+            }
+        }
+    }
+
+    for( i = 0; i < nb_nodes; i++ ) {
+        free(g.nodes[i].tcname);
+        free(g.nodes[i].succ);
+    }
+    free(g.nodes);
+    free(queue);
+    free(pred);
+    free(dist);
+    name_table_fini(&g.names);
+}
+
+static void print_report(const analysis_t *a, uint64_t *span)
+{
+    class_stats_t *c, total;
+    uint64_t nb_events = 0, nb_unmatched = 0, thread_span, idle;
+    int f, k, t, b, nb_threads = 0;
+    const rank_analysis_t *r;
+
+    *span = 0;
+    for( f = 0; f < dbp_reader_nb_files(a->dbp); f++ ) {
+        r = &a->ranks[f];
+        if( 0 != dbp_file_error(r->file) ) continue;
+        nb_events += r->nb_events;
+        nb_unmatched += r->nb_unmatched;
+        nb_threads += dbp_file_nb_threads(r->file);
+        if( r->last > r->first && r->last - r->first > *span )
+            *span = r->last - r->first;
+    }
+    printf("%d ranks, %d threads, %"PRIu64" events (%"PRIu64" without a matching event), times in %s\n",
+           dbp_reader_nb_files(a->dbp), nb_threads, nb_events, nb_unmatched, TIMER_UNIT);
+
+    printf("\nEvent classes\n"
+           "  %-40s %-7s %10s %14s %12s %12s %12s\n",
+           "class", "kind", "count", "total", "mean", "min", "max");
+    for( k = 0; k < a->nb_classes; k++ ) {
+        memset(&total, 0, sizeof(total));
+        for( f = 0; f < dbp_reader_nb_files(a->dbp); f++ ) {
+            if( 0 != dbp_file_error(a->ranks[f].file) ) continue;
+            c = &a->ranks[f].classes[k];
+            if( 0 == c->nb ) continue;
+            if( 0 == total.nb || c->min < total.min ) total.min = c->min;
+            if( c->max > total.max ) total.max = c->max;
+            total.nb += c->nb;
+            total.total += c->total;
+            for( b = 0; b < ANALYZE_NB_BUCKETS; b++ )
+                total.histogram[b] += c->histogram[b];
+        }
+        if( 0 == total.nb ) continue;
+        printf("  %-40s %-7s %10"PRIu64" %14"PRIu64" %12.1f %12"PRIu64" %12"PRIu64"\n",
+               dbp_dictionary_name(dbp_reader_get_dictionary(a->dbp, k)),
+               category_name[a->categories[k]], total.nb, total.total,
+               (double)total.total / (double)total.nb, total.min, total.max);
+        printf("    log2 histogram:");
+        for( b = 0; b < ANALYZE_NB_BUCKETS; b++ )
+            if( 0 != total.histogram[b] )
+                printf(" 2^%d:%"PRIu64, b, total.histogram[b]);
+        printf("\n");
+    }
+
+    printf("\nThreads (percentage of the rank span)\n"
+           "  %5s %6s %7s %7s %7s %7s  %s\n", "rank", "thread", "task", "sched", "comm", "idle", "name");
+    for( f = 0; f < dbp_reader_nb_files(a->dbp); f++ ) {
+        r = &a->ranks[f];
+        if( 0 != dbp_file_error(r->file) ) continue;
+        thread_span = r->last > r->first ? r->last - r->first : 0;
+        for( t = 0; t < dbp_file_nb_threads(r->file); t++ ) {
+            const uint64_t *time = r->threads[t].time;
+            idle = r->threads[t].busy < thread_span ? thread_span - r->threads[t].busy : 0;
+            printf("  %5d %6d %6.2f%% %6.2f%% %6.2f%% %6.2f%%  %s\n",
+                   dbp_file_get_rank(r->file), t,
+                   thread_span ? 100.0 * (double)time[ANALYZE_COMPUTE] / (double)thread_span : 0.0,
+                   thread_span ? 100.0 * (double)time[ANALYZE_SCHED] / (double)thread_span : 0.0,
+                   thread_span ? 100.0 * (double)time[ANALYZE_COMM] / (double)thread_span : 0.0,
+                   thread_span ? 100.0 * (double)idle / (double)thread_span : 0.0,
+                   dbp_thread_get_hr_id(dbp_file_get_thread(r->file, t)));
+        }
+    }
+
+    printf("\nCommunications overlapped by tasks\n");
+    for( f = 0; f < dbp_reader_nb_files(a->dbp); f++ ) {
+        r = &a->ranks[f];
+        if( 0 != dbp_file_error(r->file) ) continue;
+        printf("  rank %d: %"PRIu64" of %"PRIu64" (%.2f%%)\n", dbp_file_get_rank(r->file),
+               r->comm_overlap, r->comm_time,
+               r->comm_time ? 100.0 * (double)r->comm_overlap / (double)r->comm_time : 0.0);
+    }
+}
+
+static void usage(const char *prg)
+{
+    fprintf(stderr,
+            "Usage: %s [-j threads] [-d file.dot]... [-p] file1.prof file2.prof ...\n"
+            "  Reports the durations of each class of events, the activity of each thread,\n"
+            "  and the communications overlapped by tasks\n"
+            "  -j threads: number of threads reading the profiles (default: number of cores)\n"
+            "  -d file.dot: DOT file of the execution (--mca profile_dot), to compute the\n"
+            "               critical path of the DAG. Give all the DOT files of the execution\n"
+            "  -p: print the tasks on the critical path, from the last one\n",
+            prg);
+    exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+    dbp_multifile_reader_t *dbp;
+    analysis_t a;
+    pthread_t *threads;
+    char **dots = NULL;
+    int nb_dots = 0, nb_threads = 0, print_path = 0, opt, i;
+    uint64_t span;
+
+    while( -1 != (opt = getopt(argc, argv, "j:d:ph")) ) {
+        switch( opt ) {
+        case 'j':
+            nb_threads = atoi(optarg);
+            break;
+        case 'd':
+            dots = (char**)realloc(dots, (nb_dots + 1) * sizeof(char*));
+            dots[nb_dots++] = optarg;
+            break;
+        case 'p':
+            print_path = 1;
+            break;
+        default:
+            usage(argv[0]);
+        }
+    }
+    if( optind >= argc )
+        usage(argv[0]);
+
+    dbp = dbp_reader_open_files(argc - optind, argv + optind);
+    if( NULL == dbp || 0 == dbp_reader_nb_files(dbp) ) {
+        fprintf(stderr, "Unable to read the profile files\n");
+        return 1;
+    }
+
+    a.dbp = dbp;
+    a.nb_classes = dbp_reader_nb_dictionary_entries(dbp);
+    a.categories = (analyze_category_t*)malloc((a.nb_classes + 1) * sizeof(analyze_category_t));
+    for( i = 0; i < a.nb_classes; i++ )
+        a.categories[i] = classify(dbp_dictionary_name(dbp_reader_get_dictionary(dbp, i)));
+    a.ranks = (rank_analysis_t*)calloc(dbp_reader_nb_files(dbp), sizeof(rank_analysis_t));
+    a.keep_compute = (nb_dots > 0);
+    a.next_rank = 0;
+    pthread_mutex_init(&a.lock, NULL);
+
+    if( nb_threads <= 0 )
+        nb_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if( nb_threads > dbp_reader_nb_files(dbp) )
+        nb_threads = dbp_reader_nb_files(dbp);
+    if( nb_threads < 1 )
+        nb_threads = 1;
+    threads = (pthread_t*)malloc(nb_threads * sizeof(pthread_t));
+    for( i = 1; i < nb_threads; i++ )
+        pthread_create(&threads[i], NULL, analyze_thread, &a);
+    analyze_thread(&a);
+    for( i = 1; i < nb_threads; i++ )
+        pthread_join(threads[i], NULL);
+    free(threads);
+
+    print_report(&a, &span);
+    if( nb_dots > 0 )
+        critical_path(&a, nb_dots, dots, print_path, span);
+
+    for( i = 0; i < dbp_reader_nb_files(dbp); i++ ) {
+        free(a.ranks[i].classes);
+        free(a.ranks[i].threads);
+        free(a.ranks[i].intervals[ANALYZE_COMPUTE].items);
+    }
+    free(a.ranks);
+    free(a.categories);
+    free(dots);
+    pthread_mutex_destroy(&a.lock);
+    dbp_reader_close_files(dbp);
+    dbp_reader_destruct(dbp);
+
+    return 0;
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010-2022 The University of Tennessee and The University
+ * Copyright (c) 2010-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  */
@@ -63,7 +63,7 @@ static void dump_one_xml(FILE *tracefile, const dbp_file_t *file, int t)
 {
     int displayed_key, k;
     uint64_t start, end;
-    dbp_event_iterator_t *it, *m;
+    dbp_event_iterator_t *it;
     const dbp_event_t *e, *g;
     const dbp_thread_t *th = dbp_file_get_thread(file, t);
 
@@ -78,15 +78,13 @@ static void dump_one_xml(FILE *tracefile, const dbp_file_t *file, int t)
         while( (e = dbp_iterator_current(it)) != NULL ) {
             if( KEY_IS_START( dbp_event_get_key(e) ) &&
                 (BASE_KEY( dbp_event_get_key(e) ) == k) ) {
-                m = dbp_iterator_find_matching_event_all_threads(it);
-                if( NULL == m ) {
+                g = dbp_file_find_matching_event(file, e);
+                if( NULL == g ) {
                     WARNING("   Event of class %s id %"PRIu32":%"PRIu64" at %lu does not have a match anywhere\n",
                              dbp_dictionary_name(dbp_file_get_dictionary(file, BASE_KEY(dbp_event_get_key(e)))),
                              dbp_event_get_taskpool_id(e), dbp_event_get_event_id(e),
                              dbp_event_get_timestamp(e));
                 } else {
-                    g = dbp_iterator_current(m);
-
                     start = dbp_event_get_timestamp( e );
                     end = dbp_event_get_timestamp( g );
 
@@ -110,8 +108,6 @@ static void dump_one_xml(FILE *tracefile, const dbp_file_t *file, int t)
                         dump_info(tracefile, g, file);
                     }
                     fprintf(tracefile, "                  </EVENT>\n");
-
-                    dbp_iterator_delete(m);
                 }
             }
             dbp_iterator_next(it);
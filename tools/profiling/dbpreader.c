@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010-2023 The University of Tennessee and The University
+ * Copyright (c) 2010-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * Copyright (c) 2024      NVIDIA Corporation.  All rights reserved.
@@ -78,9 +78,12 @@ struct dbp_file {
     int    nb_threads;
     int    nb_dico_map;
     int    error;
+    int    compressed;
     int   *dico_map;
     struct dbp_info  **infos;
     struct dbp_thread *threads;
+    struct dbp_match_index *match_index;  /**< built on the first lookup of a matching event */
+    pthread_mutex_t         match_lock;
 };
 
 struct dbp_event {
@@ -216,37 +219,102 @@ int dbp_file_translate_local_dico_to_global(const dbp_file_t *file, int lid)
    (EVENT_HAS_INFO((dbp_event)->native) ?                   \
     (dbp_object)->parent->dico_keys[(dbp_object)->dico_map[BASE_KEY((dbp_event)->native->event.key)]].keylen : 0))
 
-typedef struct {
-    uint64_t timestamp;
-    off_t    offset;
-    int64_t  event_idx;
-} event_cache_item_t;
-
-typedef struct {
-    event_cache_item_t *items;
-    size_t              len;
-    size_t              size;
-} event_cache_key_t;
-
-typedef struct {
-    pthread_mutex_t    mtx;
-    event_cache_key_t *keys;
-    int                done;
-} event_cache_t;
-
 struct dbp_thread {
     const parsec_profiling_stream_t *profile;
     dbp_file_t                      *file;
     dbp_info_t                      *infos;
-    event_cache_t                    cache;
     int                              nb_infos;
 };
 
+static parsec_profiling_buffer_t *read_events_buffer( const dbp_file_t *file, int64_t offset )
+{
+    off_t pos = lseek(file->fd, offset, SEEK_SET);
+    if( -1 == pos ) {
+        return NULL;
+    }
+    parsec_profiling_buffer_t *res = (parsec_profiling_buffer_t*)malloc(event_buffer_size);
+    pos = read(file->fd, res, event_buffer_size);
+    if( pos <= 0 ) {
+        free(res);
+        res = NULL;
+    }
+    return res;
+}
+
+/**
+ * Decode in place a buffer of type PROFILING_BUFFER_TYPE_COMPRESSED_EVENTS
+ * into a PROFILING_BUFFER_TYPE_EVENTS one. A corrupted buffer is truncated
+ * to the events that could be decoded.
+ */
+static void inflate_events_buffer( const dbp_file_t *file, parsec_profiling_buffer_t *buffer )
+{
+    parsec_profiling_compressed_events_t *ce = (parsec_profiling_compressed_events_t*)buffer->buffer;
+    parsec_profiling_output_t *ev;
+    const unsigned char *in;
+    unsigned char *payload;
+    uint64_t key, flags, taskpool_id, event_id, timestamp;
+    uint64_t prev_taskpool_id = 0, prev_event_id = 0, prev_timestamp = 0;
+    int64_t i, nb_events = buffer->this_buffer.nb_events;
+    size_t in_pos = 0, pos = 0, n, avail, info_length;
+
+    avail = event_avail_space - ((char*)&ce->payload[0] - (char*)ce);
+    if( (PROFILING_CODEC_DELTA_VARINT != ce->codec) || (ce->encoded_size < 0) || ((size_t)ce->encoded_size > avail) ) {
+        WARNING("Events buffer at offset %"PRId64" of '%s' uses an unknown encoding. Its events are ignored\n",
+                (int64_t)buffer->this_buffer_file_offset, file->filename);
+        buffer->this_buffer.nb_events = 0;
+        buffer->buffer_type = PROFILING_BUFFER_TYPE_EVENTS;
+        return;
+    }
+    avail = ce->encoded_size;
+    payload = (unsigned char*)malloc(avail);
+    memcpy(payload, ce->payload, avail);
+    in = payload;
+
+    for( i = 0; i < nb_events; i++ ) {
+        if( 0 == (n = parsec_profiling_varint_decode(in + in_pos, avail - in_pos, &key)) ) break;
+        in_pos += n;
+        if( 0 == (n = parsec_profiling_varint_decode(in + in_pos, avail - in_pos, &flags)) ) break;
+        in_pos += n;
+        if( 0 == (n = parsec_profiling_varint_decode(in + in_pos, avail - in_pos, &taskpool_id)) ) break;
+        in_pos += n;
+        if( 0 == (n = parsec_profiling_varint_decode(in + in_pos, avail - in_pos, &event_id)) ) break;
+        in_pos += n;
+        if( 0 == (n = parsec_profiling_varint_decode(in + in_pos, avail - in_pos, &timestamp)) ) break;
+        in_pos += n;
+        if( BASE_KEY(key) >= (uint64_t)file->nb_dico_map ) break;
+        info_length = (flags & PARSEC_PROFILING_EVENT_HAS_INFO) ?
+            (size_t)file->parent->dico_keys[file->dico_map[BASE_KEY(key)]].keylen : 0;
+        if( (in_pos + info_length > avail) ||
+            (pos + sizeof(parsec_profiling_output_base_event_t) + info_length > (size_t)event_avail_space) ) break;
+
+        ev = (parsec_profiling_output_t*)&buffer->buffer[pos];
+        ev->event.key = (uint16_t)key;
+        ev->event.flags = (uint16_t)flags;
+        ev->event.taskpool_id = prev_taskpool_id = (uint32_t)(prev_taskpool_id + PARSEC_PROFILING_UNZIGZAG(taskpool_id));
+        ev->event.event_id = prev_event_id = prev_event_id + PARSEC_PROFILING_UNZIGZAG(event_id);
+        ev->event.timestamp = prev_timestamp = prev_timestamp + PARSEC_PROFILING_UNZIGZAG(timestamp);
+        memcpy(ev->info, in + in_pos, info_length);
+        in_pos += info_length;
+        pos += sizeof(parsec_profiling_output_base_event_t) + info_length;
+    }
+    if( i != nb_events ) {
+        WARNING("Events buffer at offset %"PRId64" of '%s' is corrupted: only %"PRId64" out of %"PRId64" events decoded\n",
+                (int64_t)buffer->this_buffer_file_offset, file->filename, i, nb_events);
+    }
+    free(payload);
+    buffer->this_buffer.nb_events = i;
+    buffer->buffer_type = PROFILING_BUFFER_TYPE_EVENTS;
+}
+
 #if defined(PARSEC_PROFILING_USE_MMAP)
-static void release_events_buffer(parsec_profiling_buffer_t *buffer)
+static void release_events_buffer( const dbp_file_t *file, parsec_profiling_buffer_t *buffer )
 {
     if( NULL == buffer )
         return;
+    if( file->compressed ) {
+        free(buffer);
+        return;
+    }
     if( munmap(buffer, event_buffer_size) == -1 ) {
         WARNING("Warning profiling system: unmap of the events backend file at %p failed: %s\n",
                  buffer, strerror(errno));
@@ -256,14 +324,22 @@ static void release_events_buffer(parsec_profiling_buffer_t *buffer)
 static parsec_profiling_buffer_t *refer_events_buffer( const dbp_file_t *file, int64_t offset )
 {
     parsec_profiling_buffer_t *res;
+    if( file->compressed ) {
+        /* Events buffers of compressed profiles are not aligned on pages */
+        res = read_events_buffer(file, offset);
+        if( (NULL != res) && (PROFILING_BUFFER_TYPE_COMPRESSED_EVENTS == res->buffer_type) )
+            inflate_events_buffer(file, res);
+        return res;
+    }
     res = mmap(NULL, event_buffer_size, PROT_READ, MAP_SHARED, file->fd, offset);
     if( MAP_FAILED == res )
         return NULL;
     return res;
 }
 #else
-static void release_events_buffer(parsec_profiling_buffer_t *buffer)
+static void release_events_buffer( const dbp_file_t *file, parsec_profiling_buffer_t *buffer )
 {
+    (void)file;
     if( NULL == buffer )
         return;
     free(buffer);
@@ -271,16 +347,9 @@ static void release_events_buffer(parsec_profiling_buffer_t *buffer)
 
 static parsec_profiling_buffer_t *refer_events_buffer( const dbp_file_t *file, int64_t offset )
 {
-    off_t pos = lseek(file->fd, offset, SEEK_SET);
-    if( -1 == pos ) {
-        return NULL;
-    }
-    parsec_profiling_buffer_t *res = (parsec_profiling_buffer_t*)malloc(event_buffer_size);
-    pos = read(file->fd, res, event_buffer_size);
-    if( pos <= 0 ) {
-        free(res);
-        res = NULL;
-    }
+    parsec_profiling_buffer_t *res = read_events_buffer(file, offset);
+    if( (NULL != res) && (PROFILING_BUFFER_TYPE_COMPRESSED_EVENTS == res->buffer_type) )
+        inflate_events_buffer(file, res);
     return res;
 }
 
@@ -357,7 +426,7 @@ static inline const dbp_event_t *
 dbp_iterator_set_offset(dbp_event_iterator_t *it, off_t offset)
 {
     if( it->current_events_buffer != NULL ) {
-        release_events_buffer( it->current_events_buffer );
+        release_events_buffer( it->thread->file, it->current_events_buffer );
         it->current_events_buffer = NULL;
         it->current_event.native = NULL;
     }
@@ -431,245 +500,293 @@ const dbp_thread_t *dbp_iterator_thread(const dbp_event_iterator_t *it)
 void dbp_iterator_delete(dbp_event_iterator_t *it)
 {
     if( NULL != it->current_events_buffer )
-        release_events_buffer(it->current_events_buffer);
+        release_events_buffer(it->thread->file, it->current_events_buffer);
     free(it);
 }
 
-static inline int dbp_events_match(const dbp_event_t *s, const dbp_event_t *e)
-{
-    int s_key = dbp_event_get_key(s);
-    int e_key = dbp_event_get_key(e  );
-    return ( (KEY_IS_START(s_key)          && KEY_IS_END(e_key))            &&
-             (BASE_KEY(    s_key)          == BASE_KEY(  e_key))            &&
-             (dbp_event_get_event_id(   s) == dbp_event_get_event_id(   e)) &&
-             (dbp_event_get_taskpool_id(s) == dbp_event_get_taskpool_id(e)) &&
-             (dbp_event_get_timestamp(  s) <= dbp_event_get_timestamp(  e)) );
-}
+/*
+ * Matching of the start and end events.
+ *
+ * The first lookup in a file builds, in one pass over the events of all
+ * its threads, an index of the end event of each start event, keyed by
+ * (key, taskpool id, event id, start timestamp). The events of a thread
+ * are matched first with the starts of the same thread, the most recent
+ * first; the ends left over are then matched with the most recent start
+ * of another thread. The index keeps a copy of each end event, so a match
+ * is found without reading the file again.
+ */
 
-/* minimum allocation count for cache */
-#define EVENT_CACHE_MIN_ALLOC 64
-static void add_cache_entry(dbp_thread_t *thr, int key, dbp_event_iterator_t *it, const dbp_event_t *ev)
-{
-    event_cache_key_t  *cache_key;
-    event_cache_item_t *cache_item;
-    size_t              cache_index;
-    off_t               offset;
+#define DBP_CHUNK_SIZE (1 << 20)
+
+typedef struct dbp_chunk {
+    struct dbp_chunk *next;
+    size_t            used;
+    size_t            size;
+} dbp_chunk_t;
+
+typedef struct dbp_match {
+    struct dbp_match   *next;
+    uint64_t            start_timestamp;
+    const dbp_thread_t *thread;            /**< thread of the end event */
+    off_t               buffer_offset;     /**< position of the end event in the thread */
+    int64_t             event_pos;
+    int64_t             event_idx;
+    dbp_event_t         end;               /**< copy of the end event, stored after the match */
+} dbp_match_t;
+
+typedef struct dbp_pending_start {
+    struct dbp_pending_start *next;
+    const dbp_thread_t       *thread;
+    uint64_t                  event_id;
+    uint64_t                  timestamp;
+    uint32_t                  taskpool_id;
+    int                       key;
+} dbp_pending_start_t;
+
+struct dbp_match_index {
+    dbp_match_t **buckets;
+    size_t        mask;
+    dbp_chunk_t  *chunks;
+};
 
-    cache_key = &thr->cache.keys[BASE_KEY(key)];
+static void *dbp_chunk_alloc(dbp_chunk_t **chunks, size_t len)
+{
+    dbp_chunk_t *c = *chunks;
+    void *p;
 
-    cache_index = cache_key->len++;
-    /* if index == size, we need to grow the array */
-    if( cache_index == cache_key->size ) {
-        /* if size == 0, this is the first mismatched event with this key */
-        cache_key->size = cache_key->size ? cache_key->size * 2 :
-                                            EVENT_CACHE_MIN_ALLOC;
-        cache_key->items = realloc(cache_key->items, sizeof(event_cache_item_t[cache_key->size]));
+    len = (len + 7) & ~(size_t)7;
+    if( NULL == c || c->used + len > c->size ) {
+        size_t size = len > DBP_CHUNK_SIZE ? len : DBP_CHUNK_SIZE;
+        c = (dbp_chunk_t*)malloc(sizeof(dbp_chunk_t) + size);
+        c->next = *chunks;
+        c->used = 0;
+        c->size = size;
+        *chunks = c;
     }
+    p = (char*)(c + 1) + c->used;
+    c->used += len;
+    return p;
+}
 
-    /* cache timestamp and buffer offset for this event
-     * note that we don't store the exact index of the event,
-     * so a consumer should make sure to search through the buffer */
-    cache_item = &cache_key->items[cache_index];
-
-    /* event pos it always less than event_avail_space
-     * and buffer offset is always a multiple of event_buffer_size
-     * so these can be combined together and recovered */
-    assert( it->current_event_position >= 0 );
-    assert( it->current_event_position < event_avail_space );
-    assert( (it->current_buffer_position % event_buffer_size) == 0 );
+static void dbp_chunks_free(dbp_chunk_t *c)
+{
+    dbp_chunk_t *n;
+    for( ; NULL != c; c = n ) {
+        n = c->next;
+        free(c);
+    }
+}
 
-    offset = it->current_buffer_position + it->current_event_position;
-    cache_item->timestamp = dbp_event_get_timestamp(ev);
-    cache_item->offset    = offset;
-    cache_item->event_idx = it->current_event_index;
+static inline size_t dbp_match_hash(int key, uint32_t taskpool_id, uint64_t event_id, uint64_t timestamp)
+{
+    uint64_t h = (event_id ^ ((uint64_t)taskpool_id << 32) ^ (uint64_t)key) * 0x9E3779B97F4A7C15ULL;
+    h ^= timestamp * 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 31;
+    return (size_t)h;
+}
 
-    assert( (offset % event_buffer_size) == it->current_event_position);
+static inline int dbp_same_event(const dbp_event_t *e, int key, uint32_t taskpool_id, uint64_t event_id)
+{
+    return (BASE_KEY(dbp_event_get_key(e)) == key) &&
+           (dbp_event_get_taskpool_id(e) == taskpool_id) &&
+           (dbp_event_get_event_id(e) == event_id);
 }
 
-/* build a "cache" of events where the end event
- * does not immediately follow the start event */
-static void build_unmatched_events_in_thread(dbp_thread_t *thr)
+static dbp_match_t *dbp_match_new(dbp_chunk_t **chunks, const dbp_event_iterator_t *it, const dbp_event_t *e)
 {
-    const dbp_event_t      *e1,  *e2;
-    dbp_event_iterator_t   *i1,  *i2;
-    int                     key1, key2;
+    size_t len = DBP_EVENT_LENGTH(e, it->thread->file);
+    dbp_match_t *m = (dbp_match_t*)dbp_chunk_alloc(chunks, sizeof(dbp_match_t) + len);
 
-    /* lock cache; we're modifying volatile state! */
-    pthread_mutex_lock(&thr->cache.mtx);
-    if( thr->cache.done ) {
-        /* cache already built, we don't need to do anything */
-        goto build_events_done;
-    }
+    m->thread = it->thread;
+    m->buffer_offset = it->current_buffer_position;
+    m->event_pos = it->current_event_position;
+    m->event_idx = it->current_event_index;
+    m->end.native = (parsec_profiling_output_t*)(m + 1);
+    memcpy(m->end.native, e->native, len);
+    return m;
+}
 
-    /* iterator 1 points to current event */
-    i1 = dbp_iterator_new_from_thread( thr );
-    e1 = dbp_iterator_current( i1 );
+static void dbp_match_insert(struct dbp_match_index *idx, dbp_match_t *m, uint64_t start_timestamp)
+{
+    size_t h = dbp_match_hash(BASE_KEY(dbp_event_get_key(&m->end)), dbp_event_get_taskpool_id(&m->end),
+                              dbp_event_get_event_id(&m->end), start_timestamp) & idx->mask;
+    m->start_timestamp = start_timestamp;
+    m->next = idx->buckets[h];
+    idx->buckets[h] = m;
+}
 
-    /* if e1 is already an end, it doesn't match the non-preceding event */
-    key1 = dbp_event_get_key(e1);
-    if(KEY_IS_END(key1)) {
-            add_cache_entry(thr, key1, i1, e1);
+static struct dbp_match_index *dbp_file_build_match_index(dbp_file_t *file)
+{
+    struct dbp_match_index *idx;
+    dbp_pending_start_t **pending, **pp, **best, *p, *free_starts = NULL;
+    dbp_chunk_t *pending_chunks = NULL;
+    dbp_match_t *m, *next, *leftover = NULL;
+    const dbp_thread_t *th;
+    dbp_event_iterator_t *it;
+    const dbp_event_t *e;
+    size_t nb_events = 0, mask, h;
+    uint64_t event_id, timestamp;
+    uint32_t taskpool_id;
+    int t, key;
+
+    for( t = 0; t < file->nb_threads; t++ )
+        nb_events += dbp_thread_nb_events(&file->threads[t]);
+    for( mask = 1023; mask < nb_events / 2; mask = 2 * mask + 1 );
+
+    idx = (struct dbp_match_index*)malloc(sizeof(struct dbp_match_index));
+    idx->mask = mask;
+    idx->buckets = (dbp_match_t**)calloc(mask + 1, sizeof(dbp_match_t*));
+    idx->chunks = NULL;
+    pending = (dbp_pending_start_t**)calloc(mask + 1, sizeof(dbp_pending_start_t*));
+
+    for( t = 0; t < file->nb_threads; t++ ) {
+        th = &file->threads[t];
+        it = dbp_iterator_new_from_thread(th);
+        for( e = dbp_iterator_current(it); NULL != e; e = dbp_iterator_next(it) ) {
+            key = BASE_KEY(dbp_event_get_key(e));
+            taskpool_id = dbp_event_get_taskpool_id(e);
+            event_id = dbp_event_get_event_id(e);
+            timestamp = dbp_event_get_timestamp(e);
+            h = dbp_match_hash(key, taskpool_id, event_id, 0) & mask;
+            if( KEY_IS_START(dbp_event_get_key(e)) ) {
+                if( NULL != (p = free_starts) ) {
+                    free_starts = p->next;
+                } else {
+                    p = (dbp_pending_start_t*)dbp_chunk_alloc(&pending_chunks, sizeof(dbp_pending_start_t));
+                }
+                p->thread = th;
+                p->key = key;
+                p->taskpool_id = taskpool_id;
+                p->event_id = event_id;
+                p->timestamp = timestamp;
+                p->next = pending[h];
+                pending[h] = p;
+                continue;
+            }
+            /* the starts are pushed in front: the first one is the most recent */
+            for( best = NULL, pp = &pending[h]; NULL != (p = *pp); pp = &p->next ) {
+                if( (p->thread == th) && (p->key == key) && (p->taskpool_id == taskpool_id) &&
+                    (p->event_id == event_id) && (p->timestamp <= timestamp) ) {
+                    best = pp;
+                    break;
+                }
+            }
+            m = dbp_match_new(&idx->chunks, it, e);
+            if( NULL == best ) {
+                m->next = leftover;
+                leftover = m;
+                continue;
+            }
+            p = *best;
+            *best = p->next;
+            dbp_match_insert(idx, m, p->timestamp);
+            p->next = free_starts;
+            free_starts = p;
+        }
+        dbp_iterator_delete(it);
     }
 
-    /* iterator 2 points to next event */
-    i2 = dbp_iterator_new_from_thread( thr );
-    e2 = dbp_iterator_next( i2 );
-
-    while( NULL != e2 ) {
-        key2 = dbp_event_get_key(e2);
-
-        /* if e2 is end event, but e1 doesn't match, e2 not in expected order
-         * store e2 position in cache to lookup later for potential match */
-        if( KEY_IS_END(key2) && !dbp_events_match(e1, e2) ) {
-            add_cache_entry(thr, key2, i2, e2);
+    /* the ends of events started by another thread */
+    for( m = leftover; NULL != m; m = next ) {
+        next = m->next;
+        key = BASE_KEY(dbp_event_get_key(&m->end));
+        taskpool_id = dbp_event_get_taskpool_id(&m->end);
+        event_id = dbp_event_get_event_id(&m->end);
+        timestamp = dbp_event_get_timestamp(&m->end);
+        for( best = NULL, pp = &pending[dbp_match_hash(key, taskpool_id, event_id, 0) & mask];
+             NULL != (p = *pp); pp = &p->next ) {
+            if( (p->key == key) && (p->taskpool_id == taskpool_id) && (p->event_id == event_id) &&
+                (p->timestamp <= timestamp) && ((NULL == best) || (p->timestamp > (*best)->timestamp)) )
+                best = pp;
         }
-
-        /* advance both iterators */
-        e1 = dbp_iterator_next( i1 );
-        e2 = dbp_iterator_next( i2 );
+        if( NULL == best )
+            continue;  /* an end without start, never looked up */
+        p = *best;
+        *best = p->next;
+        dbp_match_insert(idx, m, p->timestamp);
     }
 
-    dbp_iterator_delete( i1 );
-    dbp_iterator_delete( i2 );
-
-    /* set cache to done - it doesn't need to be rebuilt */
-    thr->cache.done = 1;
-
-build_events_done:
-    pthread_mutex_unlock(&thr->cache.mtx);
+    free(pending);
+    dbp_chunks_free(pending_chunks);
+    return idx;
 }
 
-typedef struct {
-    const dbp_event_t        *ref;
-    const event_cache_item_t *last;
-} bsearch_key_t;
-
-static int bsearch_compare(const void *key, const void *el)
+static void dbp_match_index_free(struct dbp_match_index *idx)
 {
-    /* technically does Bad Thing (shouldn't modify key), but probably works */
-    bsearch_key_t      *bsearch_key = (bsearch_key_t *)key;
-    const event_cache_item_t *cache_item  = (const event_cache_item_t *)el;
-    bsearch_key->last = cache_item;
-    if( dbp_event_get_timestamp(bsearch_key->ref) < cache_item->timestamp )
-        return -1;
-    if( dbp_event_get_timestamp(bsearch_key->ref) > cache_item->timestamp )
-        return 1;
-    return 0;
+    if( NULL == idx )
+        return;
+    dbp_chunks_free(idx->chunks);
+    free(idx->buckets);
+    free(idx);
 }
 
-static const event_cache_item_t*
-dbp_event_find_in_cache(const dbp_thread_t *thr,
-                        const dbp_event_t *ref)
+static const dbp_match_t *dbp_file_find_match(const dbp_file_t *file, const dbp_event_t *ref)
 {
-    event_cache_key_t *cache_key;
-    bsearch_key_t      bsearch_key = { ref, NULL };
+    dbp_file_t *f = (dbp_file_t*)file;  /* the index is built on demand */
+    struct dbp_match_index *idx;
+    const dbp_match_t *m;
+    int key = dbp_event_get_key(ref);
+    uint32_t taskpool_id = dbp_event_get_taskpool_id(ref);
+    uint64_t event_id = dbp_event_get_event_id(ref);
+    uint64_t timestamp = dbp_event_get_timestamp(ref);
 
-    /* ensure we have an unmatched event cache
-     * casts away const because build_unmatched_events_in_thread modifies thr
-     * thr should be memory we allocated anyway though, so this should be safe
-     * ... right? */
-    build_unmatched_events_in_thread((dbp_thread_t*)thr);
-
-    /* do binary search in cache of key for events at ref timestamp
-     * we throw away the results of the search, because it's very unlikely to
-     * find this EXACT timestamp; however, we use a side-effect of the search
-     * in the comparison function (bsearch_compare) to store the last item in
-     * the cache array that was considered; this is the "insertion point" for
-     * ref's timestamp and is the timestamp closest to ref's we could find, so
-     * we return it as the starting point for the subsequent search */
-    cache_key = &thr->cache.keys[BASE_KEY(dbp_event_get_key(ref))];
-    bsearch(&bsearch_key, cache_key->items, cache_key->len,
-            sizeof(event_cache_item_t), bsearch_compare);
+    if( !KEY_IS_START(key) )
+        return NULL;
+    pthread_mutex_lock(&f->match_lock);
+    if( NULL == f->match_index )
+        f->match_index = dbp_file_build_match_index(f);
+    idx = f->match_index;
+    pthread_mutex_unlock(&f->match_lock);
+
+    key = BASE_KEY(key);
+    for( m = idx->buckets[dbp_match_hash(key, taskpool_id, event_id, timestamp) & idx->mask];
+         NULL != m; m = m->next ) {
+        if( (m->start_timestamp == timestamp) && dbp_same_event(&m->end, key, taskpool_id, event_id) )
+            return m;
+    }
+    return NULL;
+}
 
-    return bsearch_key.last;
+const dbp_event_t *dbp_file_find_matching_event(const dbp_file_t *file, const dbp_event_t *ref)
+{
+    const dbp_match_t *m = dbp_file_find_match(file, ref);
+    return NULL == m ? NULL : &m->end;
 }
 
 int dbp_iterator_move_to_matching_event(dbp_event_iterator_t *pos,
                                         const dbp_event_t *ref)
 {
-    const event_cache_item_t *cache_item;
-    const event_cache_key_t  *cache_key;
-    const dbp_event_t        *e;
-    const dbp_thread_t       *thr = pos->thread;
-    off_t                     offset;
-    int64_t                   event_pos;
+    const dbp_match_t *m = dbp_file_find_match(pos->thread->file, ref);
 
-    cache_item = dbp_event_find_in_cache( thr, ref );
-    cache_key  = &thr->cache.keys[BASE_KEY(dbp_event_get_key(ref))];
-
-    /* dbp_event_find_in_cache can return NULL
-     * if the thread doesn't have a matching event */
-    if( NULL == cache_item ) {
+    if( (NULL == m) || (m->thread != pos->thread) ) {
         /* set iterator to past-the-end */
         dbp_iterator_set_offset(pos, (off_t)-1);
         return 0;
     }
-
-    assert(&cache_key->items[0]              <= cache_item);
-    assert(&cache_key->items[cache_key->len] >  cache_item);
-
-    /* iterate over all cached events containing possible matches */
-    while( cache_item < &cache_key->items[cache_key->len] ) {
-        /* we computed cache_item->offset as buffer_position + event_position,
-         * so we must recover these values */
-        event_pos = cache_item->offset % event_buffer_size;
-        offset = cache_item->offset - event_pos;
-        /* change buffer if necessary */
-        if( pos->current_buffer_position != offset )
-            dbp_iterator_set_offset(pos, offset);
-        /* set iterator to current cached event */
-        e = dbp_iterator_move_to_event(pos, event_pos, cache_item->event_idx);
-        /* check if event matches */
-        if( (NULL != e) && dbp_events_match(ref, e) )
-            return 1;
-        cache_item++;
-    }
-
-    /* set iterator to past-the-end */
-    dbp_iterator_set_offset(pos, (off_t)-1);
-    return 0;
+    if( pos->current_buffer_position != m->buffer_offset )
+        dbp_iterator_set_offset(pos, m->buffer_offset);
+    return NULL != dbp_iterator_move_to_event(pos, m->event_pos, m->event_idx);
 }
 
 dbp_event_iterator_t *dbp_iterator_find_matching_event_all_threads(const dbp_event_iterator_t *pos)
 {
+    const dbp_event_t *ref = dbp_iterator_current((dbp_event_iterator_t *)pos);
+    const dbp_match_t *m;
     dbp_event_iterator_t *it;
-    dbp_thread_t *thr;
-    const dbp_event_t *ref;
-    const dbp_event_t *e;
-    dbp_file_t *dbp_file;
-    int tid;
-
-    dbp_file = pos->thread->file;
-    ref = dbp_iterator_current((dbp_event_iterator_t *)pos);
-
-    /* most start events are immediately followed by their end event */
-    it = dbp_iterator_new_from_iterator(pos);
-    e = dbp_iterator_next(it);
-    /* e can be NULL if pos is last event in stream; there is no next event */
-    if( (NULL != e) && dbp_events_match(ref, e) )
-        return it;
-    dbp_iterator_delete(it);
-
-    /* search through possibly matching events in this thread */
-    it = dbp_iterator_new_from_thread( pos->thread );
-    if( dbp_iterator_move_to_matching_event(it, ref) )
-        return it;
-    dbp_iterator_delete(it);
-
-    /* try other threads */
-    for( tid = 0; tid < dbp_file_nb_threads(dbp_file); tid++) {
-        thr = dbp_file_get_thread(dbp_file, tid);
-        /* skip same thread */
-        if( pos->thread == thr )
-            continue;
-        /* same logic as above */
-        it = dbp_iterator_new_from_thread( thr );
-        if( dbp_iterator_move_to_matching_event(it, ref) )
-            return it;
-        dbp_iterator_delete(it);
-    }
 
-    return NULL;
+    if( (NULL == ref) || (NULL == (m = dbp_file_find_match(pos->thread->file, ref))) )
+        return NULL;
+
+    it = (dbp_event_iterator_t*)malloc(sizeof(dbp_event_iterator_t));
+    it->thread = m->thread;
+    it->current_event.native = NULL;
+    it->current_events_buffer = NULL;
+#ifndef _NDEBUG
+    it->last_event_date = 0;
+#endif
+    dbp_iterator_set_offset(it, m->buffer_offset);
+    (void)dbp_iterator_move_to_event(it, m->event_pos, m->event_idx);
+    return it;
 }
 
 char *dbp_info_get_key(const dbp_info_t *info)
@@ -766,6 +883,8 @@ void dbp_reader_close_file(dbp_file_t *dbp)
         close(dbp->fd);
         dbp->fd = -1;
     }
+    dbp_match_index_free(dbp->match_index);
+    dbp->match_index = NULL;
 }
 
 int dbp_reader_nb_files(const dbp_multifile_reader_t *dbp)
@@ -854,13 +973,13 @@ static void read_infos(dbp_file_t *dbp, parsec_profiling_binary_file_header_t *h
                 if( NULL == next ) {
                     fprintf(stderr, "Info entry %d is broken. Only %d entries read from '%s'\n",
                             dbp->nb_infos - nb, nb, dbp->filename);
-                    release_events_buffer( info );
+                    release_events_buffer( dbp, info );
                     dbp->nb_infos = nb;
                     free(id);
                     return;
                 }
                 assert( PROFILING_BUFFER_TYPE_GLOBAL_INFO == next->buffer_type );
-                release_events_buffer( info );
+                release_events_buffer( dbp, info );
                 info = next;
 
                 pos = 0;
@@ -878,19 +997,19 @@ static void read_infos(dbp_file_t *dbp, parsec_profiling_binary_file_header_t *h
             if( NULL == next ) {
                 fprintf(stderr, "Info entry %d is broken. Only %d entries read from '%s'\n",
                         dbp->nb_infos - nb, nb, dbp->filename);
-                release_events_buffer( info );
+                release_events_buffer( dbp, info );
                 dbp->nb_infos = nb;
                 return;
             }
             assert( PROFILING_BUFFER_TYPE_GLOBAL_INFO == next->buffer_type );
-            release_events_buffer( info );
+            release_events_buffer( dbp, info );
             info = next;
 
             pos = 0;
             nbthis = 0;
         }
     }
-    release_events_buffer( info );
+    release_events_buffer( dbp, info );
 }
 
 static int read_dictionary(dbp_file_t *file, const parsec_profiling_binary_file_header_t *head)
@@ -952,18 +1071,18 @@ static int read_dictionary(dbp_file_t *file, const parsec_profiling_binary_file_
             next = refer_events_buffer( file, dico->next_buffer_file_offset );
             if( NULL == next ) {
                 fprintf(stderr, "Dictionary entry %d is broken. Dictionary broken.\n", nb);
-                release_events_buffer( dico );
+                release_events_buffer( file, dico );
                 return -1;
             }
             assert( PROFILING_BUFFER_TYPE_DICTIONARY == dico->buffer_type );
-            release_events_buffer( dico );
+            release_events_buffer( file, dico );
             dico = next;
             nbthis = dico->this_buffer.nb_dictionary_entries;
 
             pos = 0;
         }
     }
-    release_events_buffer( dico );
+    release_events_buffer( file, dico );
     return 0;
 }
 
@@ -1025,10 +1144,6 @@ static int read_threads(dbp_file_t *dbp, const parsec_profiling_binary_file_head
         thr = &dbp->threads[head->nb_threads - nb];
         thr->file        = dbp;
         thr->profile     = res;
-        pthread_mutex_init(&thr->cache.mtx, NULL);
-        thr->cache.keys = (event_cache_key_t*)calloc(
-               dbp_file_nb_dictionary_entries(dbp), sizeof(event_cache_key_t));
-        thr->cache.done  = 0;
 
         pos += sizeof(parsec_profiling_stream_buffer_t) - sizeof(parsec_profiling_info_buffer_t);
         pos += read_thread_infos( res, thr, br->nb_infos, (char*)br->infos );
@@ -1043,11 +1158,11 @@ static int read_threads(dbp_file_t *dbp, const parsec_profiling_binary_file_head
             if( NULL == next ) {
                 fprintf(stderr, "Unable to read thread entry %d/%d at offset %lx: Profile file broken\n",
                         head->nb_threads-nb, head->nb_threads, (unsigned long)b->next_buffer_file_offset);
-                release_events_buffer( b );
+                release_events_buffer( dbp, b );
                 return -1;
             }
             assert( PROFILING_BUFFER_TYPE_THREAD == next->buffer_type );
-            release_events_buffer( b );
+            release_events_buffer( dbp, b );
             b = next;
 
             nbthis = b->this_buffer.nb_threads;
@@ -1056,7 +1171,7 @@ static int read_threads(dbp_file_t *dbp, const parsec_profiling_binary_file_head
         }
     }
 
-    release_events_buffer( b );
+    release_events_buffer( dbp, b );
     return 0;
 }
 
@@ -1091,6 +1206,9 @@ static dbp_multifile_reader_t *open_files(int nbfiles, char **filenames)
         dbp->files[n].parent = dbp;
         dbp->files[n].fd = fd;
         dbp->files[n].nb_infos = 0;
+        dbp->files[n].compressed = 0;
+        dbp->files[n].match_index = NULL;
+        pthread_mutex_init(&dbp->files[n].match_lock, NULL);
 
         if( (p = read( fd, &head, sizeof(parsec_profiling_binary_file_header_t) )) != sizeof(parsec_profiling_binary_file_header_t) ) {
             fprintf(stderr, "read %d bytes\n", p);
@@ -1100,7 +1218,8 @@ static dbp_multifile_reader_t *open_files(int nbfiles, char **filenames)
             goto close_and_continue;
         }
 
-        if( strncmp( head.magick, PARSEC_PROFILING_MAGICK, 24 ) ) {
+        dbp->files[n].compressed = !strncmp( head.magick, PARSEC_PROFILING_COMPRESSED_MAGICK, 24 );
+        if( !dbp->files[n].compressed && strncmp( head.magick, PARSEC_PROFILING_MAGICK, 24 ) ) {
             fprintf(stderr, "read %d bytes found '%s', expected '%s'\n", p, head.magick, PARSEC_PROFILING_MAGICK);
             fprintf(stderr, "File %s does not seem to be a correct PARSEC Binary Profile, ignored\n",
                     filenames[i]);
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010-2023 The University of Tennessee and The University
+ * Copyright (c) 2010-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  */
@@ -74,6 +74,10 @@ const dbp_event_t *dbp_iterator_next(dbp_event_iterator_t *it);
 void dbp_iterator_delete(dbp_event_iterator_t *it);
 int dbp_iterator_move_to_matching_event(dbp_event_iterator_t *pos, const dbp_event_t *ref);
 dbp_event_iterator_t *dbp_iterator_find_matching_event_all_threads(const dbp_event_iterator_t *pos);
+/* End event of the start event ref, or NULL. The first call indexes the
+ * matching events of all the threads of the file in one pass; the events
+ * returned remain valid until the file is closed. */
+const dbp_event_t *dbp_file_find_matching_event(const dbp_file_t *file, const dbp_event_t *ref);
 const dbp_thread_t *dbp_iterator_thread(const dbp_event_iterator_t *it);
 
 int dbp_event_get_key(const dbp_event_t *e);
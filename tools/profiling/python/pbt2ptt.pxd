@@ -80,6 +80,7 @@ cdef extern from "dbpreader.h":
    void dbp_iterator_delete(dbp_event_iterator_t *it)
    int dbp_iterator_move_to_matching_event(dbp_event_iterator_t *pos, dbp_event_t *ref)
    dbp_event_iterator_t *dbp_iterator_find_matching_event_all_threads(dbp_event_iterator_t *pos)
+   const dbp_event_t *dbp_file_find_matching_event(const dbp_file_t *file, const dbp_event_t *ref)
    dbp_thread_t *dbp_iterator_thread(dbp_event_iterator_t *it)
 
    int dbp_event_get_key(dbp_event_t *e)
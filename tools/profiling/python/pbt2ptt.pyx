@@ -606,7 +606,6 @@ cdef construct_stream(builder, skeleton_only, dbp_multifile_reader_t * dbp, dbp_
     """
     cdef dbp_thread_t * cstream = dbp_file_get_thread(cfile, stream_id)
     cdef dbp_event_iterator_t * it_s = dbp_iterator_new_from_thread(cstream)
-    cdef dbp_event_iterator_t * it_e = NULL
     cdef const dbp_event_t * event_s = dbp_iterator_current(it_s)
     cdef const dbp_event_t * event_e = NULL
     cdef dbp_info_t * th_info = NULL
@@ -686,51 +685,44 @@ cdef construct_stream(builder, skeleton_only, dbp_multifile_reader_t * dbp, dbp_
                             traceback.print_exc()
                             print('Failed to extract info from the start event (taskpool_id {0} event_id {1})'.format(taskpool_id, event_id))
 
-                it_e = dbp_iterator_find_matching_event_all_threads(it_s)
-                if it_e != NULL:
-
-                    event_e = dbp_iterator_current(it_e)
-
-                    if event_e != NULL:
-                        end = dbp_event_get_timestamp(event_e)
-
-                        event['node_id']     = node_id
-                        event['stream_id']   = stream_id
-                        event['taskpool_id'] = taskpool_id
-                        event['type']        = event_type
-                        event['begin']       = begin
-                        event['end']         = end
-                        event['flags']       = event_flags
-                        event['id']          = event_id
-
-                        cinfo = dbp_event_get_info(event_e)
-                        if cinfo != NULL:
-                            if None != builder.event_convertors[event_type]:
-                                try:
-                                    event_info = parse_info(builder, event_type, <char*>cinfo)
-                                    if None != event_info:
-                                        #print(event_type, event_name, event_info)
-                                        #event[builder.event_names[event_type] + '_stop'] = event_info
-                                        event.update(event_info)
-                                except:
-                                    print('Failed to extract info from the stop event (taskpoolid {0} event_id {1})'.format(taskpool_id, event_id))
-
-                        # 'end' and 'begin' are unsigned, so subtraction is invalid if they are
-                        if end >= begin and (end - begin) <= th_duration:
-                            # VALID EVENT FOUND
-                            builder.events.append(event)
-                            builder.keys.update(event.keys())
-                            if th_end < end:
-                                th_end = end
-                        else: # the event is 'not sane'
-                            event.update({'error_msg':'event has a unreasonable duration.'})
-                            # we still store error events, in the same format as a normal event
-                            # we simply add an error message column, and put them in a different table.
-                            # Users who wish to use these events can simply merge them with the events table.
-                            builder.errors.append(event)
-
-                    dbp_iterator_delete(it_e)
-                    it_e = NULL
+                event_e = dbp_file_find_matching_event(cfile, event_s)
+                if event_e != NULL:
+                    end = dbp_event_get_timestamp(event_e)
+
+                    event['node_id']     = node_id
+                    event['stream_id']   = stream_id
+                    event['taskpool_id'] = taskpool_id
+                    event['type']        = event_type
+                    event['begin']       = begin
+                    event['end']         = end
+                    event['flags']       = event_flags
+                    event['id']          = event_id
+
+                    cinfo = dbp_event_get_info(event_e)
+                    if cinfo != NULL:
+                        if None != builder.event_convertors[event_type]:
+                            try:
+                                event_info = parse_info(builder, event_type, <char*>cinfo)
+                                if None != event_info:
+                                    #print(event_type, event_name, event_info)
+                                    #event[builder.event_names[event_type] + '_stop'] = event_info
+                                    event.update(event_info)
+                            except:
+                                print('Failed to extract info from the stop event (taskpoolid {0} event_id {1})'.format(taskpool_id, event_id))
+
+                    # 'end' and 'begin' are unsigned, so subtraction is invalid if they are
+                    if end >= begin and (end - begin) <= th_duration:
+                        # VALID EVENT FOUND
+                        builder.events.append(event)
+                        builder.keys.update(event.keys())
+                        if th_end < end:
+                            th_end = end
+                    else: # the event is 'not sane'
+                        event.update({'error_msg':'event has a unreasonable duration.'})
+                        # we still store error events, in the same format as a normal event
+                        # we simply add an error message column, and put them in a different table.
+                        # Users who wish to use these events can simply merge them with the events table.
+                        builder.errors.append(event)
 
                 else: # the event is not complete
                     # this will change once singleton events are enabled.